@@ -17,13 +17,19 @@
 #ifndef IGNITION_GUI_APPLICATION_HH_
 #define IGNITION_GUI_APPLICATION_HH_
 
+#include <chrono>
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <ignition/transport/Node.hh>
+
 #include "ignition/gui/qt.h"
 #include "ignition/gui/Export.hh"
+#include "ignition/gui/SubscriptionStats.hh"
 
 namespace tinyxml2
 {
@@ -72,8 +78,176 @@ namespace ignition
       /// \return Pointer to QML engine
       public: QQmlApplicationEngine *Engine() const;
 
+      /// \brief Get the transport node shared by all plugins. Each node
+      /// spins up its own discovery and socket threads, so plugins which
+      /// subscribe on this node instead of constructing their own keep the
+      /// process-wide thread count flat no matter how many are loaded.
+      /// The node is created on first use, so applications which load no
+      /// transport plugins don't pay for it at all.
+      ///
+      /// Note that ignition::transport::Node::Unsubscribe removes all of a
+      /// node's handlers for a topic, and service response callbacks live
+      /// as long as the node. Plugins which unsubscribe and resubscribe
+      /// during their lifetime, or whose callbacks must not outlive them,
+      /// should keep a private node instead.
+      /// \return Pointer to the shared transport node.
+      public: transport::Node *TransportNode();
+
+      /// \brief Get the latency metrics registry for subscriptions made
+      /// through Subscribe. Created on first use, together with the
+      /// /gui/subscription_stats service which reports the same numbers
+      /// over transport.
+      /// \return Pointer to the registry.
+      /// \sa Subscribe
+      public: SubscriptionStats *SubscriptionMetrics();
+
+      /// \brief Subscribe to a topic on the shared transport node,
+      /// recording each callback's execution time and the delay work
+      /// queued to the GUI thread experiences, per subscription. The
+      /// metrics show up in the TopicStats panel and on the
+      /// /gui/subscription_stats service, so a plugin whose slow
+      /// callback drags the GUI down can be found without a profiler.
+      ///
+      /// The note on TransportNode about unsubscribing applies here
+      /// too.
+      /// \param[in] _topic Topic to subscribe to.
+      /// \param[in] _label Label identifying the subscriber, typically
+      /// the plugin title.
+      /// \param[in] _cb Callback invoked with each message.
+      /// \return True if subscribed.
+      /// \sa TransportNode
+      public: template<typename MessageT>
+      bool Subscribe(const std::string &_topic, const std::string &_label,
+          const std::function<void(const MessageT &)> &_cb)
+      {
+        auto metrics = this->SubscriptionMetrics()->Register(_topic, _label);
+        std::function<void(const MessageT &)> wrapped =
+            [this, metrics, _cb](const MessageT &_msg)
+        {
+          const auto start = std::chrono::steady_clock::now();
+          _cb(_msg);
+          metrics->execution.Record(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start));
+          this->ProbeQueueDelay(metrics);
+        };
+        return this->TransportNode()->Subscribe(_topic, wrapped);
+      }
+
+      /// \brief Get the message type published on each known topic, as
+      /// of the last discovery scan. Served from the in-memory index,
+      /// so it returns immediately.
+      /// \return Topic name to message type of its first publisher.
+      /// \sa RefreshTopicIndex
+      public: std::map<std::string, std::string> TopicTypes() const;
+
+      /// \brief Get all known topics publishing a given message type.
+      /// Served from the in-memory index, so refresh buttons fill their
+      /// lists in microseconds instead of stalling on per-topic
+      /// discovery round trips.
+      /// \param[in] _msgType Message type, e.g. "ignition.msgs.Image".
+      /// \return Topics publishing that type, in lexical order.
+      /// \sa RefreshTopicIndex
+      public: std::vector<std::string> TopicsOfType(
+          const std::string &_msgType) const;
+
+      /// \brief Schedule a background discovery scan to update the
+      /// topic index. Does nothing while a scan is already running or
+      /// the index is still fresh. The index updates incrementally as
+      /// the scan visits topics, and events::TopicIndexUpdated is
+      /// routed on the GUI thread once the scan completes, so plugins
+      /// can re-query then.
+      public: void RefreshTopicIndex();
+
+      /// \brief Enable or disable the startup timing report. When
+      /// enabled, each startup phase (QML engine creation, config
+      /// parsing, plugin loading, window setup) is timed and a summary
+      /// printed once loading finishes. Call before constructing the
+      /// application to cover all phases.
+      /// \param[in] _enabled True to print the report.
+      public: static void SetStartupTimingEnabled(const bool _enabled);
+
+      /// \brief Register a consumer for a custom event type. Events
+      /// routed through RouteEvent are dispatched via a direct call list
+      /// only to the consumers registered for their type, so plugins
+      /// don't pay a filtering cost for high-frequency events they
+      /// ignore. The callback runs on the thread which emits the event.
+      /// The consumer is removed automatically when destroyed.
+      /// \param[in] _type Event type to subscribe to.
+      /// \param[in] _consumer Object the subscription belongs to.
+      /// \param[in] _callback Called with each routed event.
+      /// \sa RouteEvent
+      public: void SubscribeToEvent(const QEvent::Type _type,
+          QObject *_consumer,
+          const std::function<void(QEvent *)> &_callback);
+
+      /// \brief Remove a consumer's subscription for an event type.
+      /// \param[in] _type Event type subscribed to.
+      /// \param[in] _consumer Object the subscription belongs to.
+      /// \sa SubscribeToEvent
+      public: void UnsubscribeFromEvent(const QEvent::Type _type,
+          QObject *_consumer);
+
+      /// \brief Register a periodic UI update callback, called on the
+      /// GUI thread. All callbacks registered here share one timer, so
+      /// periodic refreshes across plugins land in one aligned wakeup
+      /// per scheduler period instead of each plugin waking the thread
+      /// on its own QTimer. The callback runs every _intervalMs,
+      /// rounded up to the shared tick, and is removed automatically
+      /// when its owner is destroyed.
+      /// \param[in] _owner Object the callback belongs to. One callback
+      /// per owner; registering again replaces the previous one.
+      /// \param[in] _intervalMs Desired period between calls in ms.
+      /// \param[in] _cb The callback.
+      /// \sa RemoveUpdateCallback
+      /// \sa SetUpdatePeriod
+      public: void AddUpdateCallback(QObject *_owner, const int _intervalMs,
+          const std::function<void()> &_cb);
+
+      /// \brief Remove an owner's periodic update callback.
+      /// \param[in] _owner Object the callback belongs to.
+      /// \sa AddUpdateCallback
+      public: void RemoveUpdateCallback(QObject *_owner);
+
+      /// \brief Set the period all update callbacks align to. About one
+      /// display frame (16 ms) by default.
+      /// \param[in] _ms Period in ms, ignored unless positive.
+      /// \sa AddUpdateCallback
+      public: void SetUpdatePeriod(const int _ms);
+
+      /// \brief Dispatch an event to the consumers registered for its
+      /// type. When no consumer is registered the event is sent to the
+      /// main window instead, preserving the broadcast path for
+      /// consumers which filter events there. Ownership of the event
+      /// stays with the caller.
+      /// \param[in] _event Event to dispatch.
+      /// \sa SubscribeToEvent
+      public: void RouteEvent(QEvent *_event);
+
+      /// \brief Create an additional main window hosted by this
+      /// application. All windows share the QML engine, the plugin
+      /// library cache and the transport node, so a multi-monitor setup
+      /// can run as one process instead of one process per window.
+      /// Plugins and window configuration loaded after this call target
+      /// the new window, so a typical setup loads one configuration file
+      /// per window:
+      ///
+      ///     app.LoadConfig("station1.config");
+      ///     app.AddWindow();
+      ///     app.LoadConfig("station2.config");
+      ///
+      /// \return The new window, or nullptr if it failed to instantiate.
+      /// The application keeps ownership.
+      /// \sa LoadConfig
+      public: MainWindow *AddWindow();
+
       /// \brief Load a plugin from a file name. The plugin file must be in the
       /// path.
+      /// A plugin element with an `external="true"` attribute is hosted
+      /// in a child ign-gui process with its own window instead of a
+      /// card in this one, isolating this process from crashes or heavy
+      /// computation in that plugin. The child is terminated with the
+      /// application.
       /// If a window has been initialized, the plugin is added to the window.
       /// Otherwise, the plugin is stored and can be later added to a window or
       /// dialog.
@@ -102,6 +276,39 @@ namespace ignition
       /// \sa LoadConfig
       public: bool LoadDefaultConfig();
 
+      /// \brief Schedule a configuration file to be loaded right after
+      /// the main window presents its first frame. This gets an empty
+      /// window on screen before plugins start loading and subscribing,
+      /// so startup feels faster even though the total work is the same.
+      /// If there is no main window to stage against, the file is loaded
+      /// immediately instead. When the staged load fails, the
+      /// application exits with a non-zero code.
+      /// \param[in] _config Full path to configuration file.
+      /// \sa LoadConfig
+      public: void LoadConfigAfterFirstFrame(const std::string &_config);
+
+      /// \brief Run as a warm daemon: the application stays resident
+      /// with its window hidden and advertises the /gui/daemon service.
+      /// An attach request carries a configuration file path; the daemon
+      /// loads it and shows the window, so attaching costs milliseconds
+      /// instead of a cold start. Closing the window hides it and the
+      /// daemon waits for the next attach. Call before exec().
+      /// \return True if the service could be advertised
+      /// \sa RequestDaemonAttach
+      public: bool StartDaemon();
+
+      /// \brief Ask a running daemon to load a configuration file and
+      /// show its window. Doesn't need (or start) a Qt application, so
+      /// callers can try this before paying for a cold start.
+      /// \param[in] _config Path to a configuration file. Relative paths
+      /// are resolved against the caller's working directory, since the
+      /// daemon's differs.
+      /// \param[in] _timeoutMs How long to wait for a daemon to answer.
+      /// \return True if a daemon accepted the request
+      /// \sa StartDaemon
+      public: static bool RequestDaemonAttach(const std::string &_config,
+          const unsigned int _timeoutMs = 250u);
+
       /// \brief Specifies the location of the default configuration file.
       /// This is the file that stores the user settings when pressing
       /// "Save configuration".
@@ -134,12 +341,32 @@ namespace ignition
       /// 3. Path ~/.ignition/gui/plugins
       /// 4. The path where Ignition GUI plugins are installed
       ///
+      /// Listings are cached in ~/.ignition/gui/plugin_manifest.cache
+      /// keyed by directory modification time, so unchanged directories
+      /// aren't walked again.
+      ///
       /// \return A vector of pairs, where each pair contains:
       /// * A path
       /// * A vector of plugins in that path
       public: std::vector<std::pair<std::string, std::vector<std::string>>>
           PluginList();
 
+      /// \brief Get the list of available plugins without an application
+      /// instance. This performs the same discovery as PluginList, but
+      /// since it doesn't bring up Qt or the QML engine it's suitable for
+      /// quick queries such as `ign gui -l`, including on headless
+      /// shells with no display.
+      /// \param[in] _pluginPathEnv Environment variable holding extra
+      /// plugin paths.
+      /// \param[in] _pluginPaths Additional paths to look at.
+      /// \return A vector of pairs, where each pair contains:
+      /// * A path
+      /// * A vector of plugins in that path
+      public: static std::vector<
+          std::pair<std::string, std::vector<std::string>>> ListPlugins(
+          const std::string &_pluginPathEnv = "IGN_GUI_PLUGIN_PATH",
+          const std::vector<std::string> &_pluginPaths = {});
+
       /// \brief Remove plugin by name. The plugin is removed from the
       /// application and its shared library unloaded if this was its last
       /// instance.
@@ -154,6 +381,27 @@ namespace ignition
       /// \brief Callback when user requests to close a plugin
       public slots: void OnPluginClose();
 
+      /// \brief Handle queue delay probe events posted by
+      /// ProbeQueueDelay.
+      /// \param[in] _event The event.
+      /// \return True if the event was handled.
+      public: bool event(QEvent *_event) override;
+
+      /// \brief Measure how long work queued from a transport callback
+      /// waits before the GUI thread runs it, by posting a timestamped
+      /// event and recording its age on delivery. At most one probe per
+      /// subscription is in flight at a time, so a busy event loop isn't
+      /// loaded further by its own measurement.
+      /// \param[in] _metrics Metrics of the subscription to probe.
+      private: void ProbeQueueDelay(
+          const std::shared_ptr<SubscriptionStats::Metrics> &_metrics);
+
+      /// \brief Callback when the watched config file changes on disk.
+      /// Kicks the debounce timer; when it settles, the config is
+      /// reloaded through LoadConfig, which only reloads the plugins
+      /// whose configuration actually changed.
+      private slots: void OnConfigFileChanged();
+
       /// \brief Create a main window, populate with previously loaded plugins
       /// and apply previously loaded configuration.
       /// An empty window will be created if no plugins have been loaded.
@@ -184,6 +432,11 @@ namespace ignition
       /// initialized.
       private: bool ApplyConfig();
 
+      /// \brief Start or move the on-disk watch to a config file, so
+      /// edits to it hot-reload the layout without a restart.
+      /// \param[in] _path Path of the loaded config.
+      private: void WatchConfigFile(const std::string &_path);
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<ApplicationPrivate> dataPtr;
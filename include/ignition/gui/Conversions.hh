@@ -18,12 +18,18 @@
 #ifndef IGNITION_GUI_CONVERSIONS_HH_
 #define IGNITION_GUI_CONVERSIONS_HH_
 
+#include <ignition/msgs/image.pb.h>
+#include <ignition/msgs/pose_v.pb.h>
 #include <ignition/msgs/time.pb.h>
 #include <ignition/common/Time.hh>
 #include <ignition/math/Color.hh>
+#include <ignition/math/Quaternion.hh>
 #include <ignition/math/Vector2.hh>
 #include <ignition/math/Vector3.hh>
 
+#include <memory>
+#include <vector>
+
 #include "ignition/gui/qt.h"
 #include "ignition/gui/Export.hh"
 
@@ -92,6 +98,59 @@ namespace ignition
     /// \return An ignition::msgs::Time object
     IGNITION_GUI_VISIBLE
     msgs::Time convert(const common::Time &_t);
+
+    /// \brief Return the QImage format equivalent to a message pixel
+    /// format, for formats QImage can display without conversion.
+    /// \param[in] _format Message pixel format.
+    /// \return The QImage format, or QImage::Format_Invalid for formats
+    /// which need a conversion pass, such as floats and Bayer mosaics.
+    IGNITION_GUI_VISIBLE
+    QImage::Format convert(const msgs::PixelFormatType &_format);
+
+    /// \brief Return a QImage over an image message's pixel data,
+    /// without copying it. The QImage does not own the data: the
+    /// message must outlive it and any copies of it. Use the
+    /// shared_ptr overload when the QImage outlives the caller's
+    /// message handling.
+    /// \param[in] _img The image message to convert.
+    /// \return A QImage viewing the message payload, or a null QImage
+    /// for pixel formats which need a conversion pass.
+    IGNITION_GUI_VISIBLE
+    QImage convert(const msgs::Image &_img);
+
+    /// \brief Return a QImage over an image message's pixel data,
+    /// without copying it. The QImage shares ownership of the message,
+    /// which stays alive until the QImage and all its copies are gone.
+    /// \param[in] _img The image message to convert.
+    /// \return A QImage viewing the message payload, or a null QImage
+    /// for pixel formats which need a conversion pass.
+    IGNITION_GUI_VISIBLE
+    QImage convert(const std::shared_ptr<const msgs::Image> &_img);
+
+    /// \brief Structure-of-arrays copy of a Pose_V message. The three
+    /// arrays are the same length, with element i holding the id,
+    /// position and orientation of the message's i-th pose.
+    struct BatchedPoses
+    {
+      /// \brief Entity ids
+      std::vector<unsigned int> ids;
+
+      /// \brief Positions
+      std::vector<math::Vector3d> positions;
+
+      /// \brief Orientations
+      std::vector<math::Quaterniond> rotations;
+    };
+
+    /// \brief Convert a whole Pose_V message into structure-of-arrays
+    /// buffers in one pass, so per-frame pose ingestion is a tight loop
+    /// over contiguous memory instead of per-element protobuf
+    /// traversal. The buffers are resized, not cleared, so passing the
+    /// same batch every frame reuses its allocations.
+    /// \param[in] _msg The pose vector message to convert.
+    /// \param[out] _batch Batch to fill.
+    IGNITION_GUI_VISIBLE
+    void convert(const msgs::Pose_V &_msg, BatchedPoses &_batch);
   }
 }
 #endif
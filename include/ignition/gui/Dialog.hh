@@ -34,12 +34,32 @@ namespace ignition
     {
       Q_OBJECT
 
-      /// \brief Constructor
+      /// \brief Constructor. The dialog QML is only evaluated once the
+      /// window is first needed, see QuickWindow.
       public: Dialog();
 
       /// \brief Destructor
       public: virtual ~Dialog();
 
+      /// \brief Get a dialog from the reuse pool, or a new one if the
+      /// pool is empty. Reopening a pooled dialog is a visibility
+      /// toggle instead of a QML instantiation.
+      /// \return Pointer to a dialog. The caller keeps it until passing
+      /// it back to Release.
+      public: static Dialog *Acquire();
+
+      /// \brief Hide a dialog and return it to the reuse pool, where it
+      /// is kept warm for the next Acquire call. If the pool is full,
+      /// the dialog is scheduled for deletion instead.
+      /// \param[in] _dialog Dialog being closed.
+      public: static void Release(Dialog *_dialog);
+
+      /// \brief Delete all dialogs kept warm in the reuse pool. The
+      /// application calls this while tearing down: pooled dialogs are
+      /// backed by its QML engine and must not outlive it, much less be
+      /// handed out by a future application.
+      public: static void ClearPool();
+
       /// \brief Get the QtQuick window created by this object
       /// \return Pointer to the QtQuick window
       public: QQuickWindow *QuickWindow() const;
@@ -48,6 +68,10 @@ namespace ignition
       /// \return Pointer to the item
       public: QQuickItem *RootItem() const;
 
+      /// \brief Evaluate the dialog QML if it hasn't been evaluated
+      /// yet.
+      private: void EnsureLoaded() const;
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<DialogPrivate> dataPtr;
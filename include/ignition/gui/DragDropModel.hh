@@ -29,9 +29,28 @@ namespace gui
   class IGNITION_GUI_VISIBLE DragDropModel : public QStandardItemModel
   {
     /// \brief Overloaded from Qt. Custom MIME data function.
+    /// Besides the legacy "application/x-item" payload, which carries
+    /// only the first selected item as plain text, the returned mime
+    /// data holds the whole selection under
+    /// "application/x-ignition-items": one binary buffer with a table
+    /// of distinct URI queries and one table index per item, written in
+    /// a single serialization pass.
     /// \param[in] _indexes List of selected items.
     /// \return Mime data for the selected items.
     public: QMimeData *mimeData(const QModelIndexList &_indexes) const;
+
+    /// \brief Encode URI queries into the compact binary mime payload.
+    /// Distinct strings are interned so repeated queries cost one table
+    /// index each.
+    /// \param[in] _uriQueries One URI query per dragged item, in order.
+    /// \return Payload for the "application/x-ignition-items" MIME type.
+    public: static QByteArray EncodeUriQueries(const QStringList &_uriQueries);
+
+    /// \brief Decode a compact binary mime payload back into one URI
+    /// query per dragged item.
+    /// \param[in] _data Payload under "application/x-ignition-items".
+    /// \return URI queries in selection order, empty if malformed.
+    public: static QStringList DecodeUriQueries(const QByteArray &_data);
   };
 }
 }
@@ -18,6 +18,7 @@
 #define IGNITION_GUI_GUIEVENTS_HH_
 
 #include <QEvent>
+#include <chrono>
 #include <utility>
 #include <vector>
 #include <ignition/math/Vector3.hh>
@@ -43,6 +44,76 @@ namespace ignition
         /// \brief Unique type for this event.
         static const QEvent::Type kType = QEvent::Type(QEvent::MaxUser);
       };
+
+      /// \brief Event routed on the GUI thread after every presented
+      /// frame, carrying how long that frame took and how much of the
+      /// display's frame budget was left. Plugins doing optional work
+      /// (image conversions, plot refinement) can subscribe through
+      /// Application::SubscribeToEvent and shed load while the budget
+      /// runs negative, instead of every plugin stalling together.
+      class FrameBudget : public QEvent
+      {
+        /// \brief Constructor
+        /// \param[in] _lastFrameMs Duration of the last frame in ms.
+        /// \param[in] _remainingMs Budget left after that frame in ms,
+        /// negative when the frame overran it.
+        public: FrameBudget(const double _lastFrameMs,
+            const double _remainingMs)
+            : QEvent(kType), lastFrameMs(_lastFrameMs),
+              remainingMs(_remainingMs),
+              stamp(std::chrono::steady_clock::now())
+        {
+        }
+
+        /// \brief Get the duration of the last frame.
+        /// \return Frame time in ms.
+        public: double LastFrameTime() const
+        {
+          return this->lastFrameMs;
+        }
+
+        /// \brief Get the budget left after the last frame.
+        /// \return Remaining budget in ms, negative when over budget.
+        public: double RemainingBudget() const
+        {
+          return this->remainingMs;
+        }
+
+        /// \brief Get the time the event was emitted.
+        /// \return Steady clock timestamp.
+        public: std::chrono::steady_clock::time_point Stamp() const
+        {
+          return this->stamp;
+        }
+
+        /// \brief Unique type for this event.
+        static const QEvent::Type kType = QEvent::Type(QEvent::MaxUser - 1);
+
+        /// \brief Duration of the last frame in ms
+        private: double lastFrameMs{0.0};
+
+        /// \brief Budget left after the last frame in ms
+        private: double remainingMs{0.0};
+
+        /// \brief Time the event was emitted
+        private: std::chrono::steady_clock::time_point stamp;
+      };
+
+      /// \brief Event routed on the GUI thread after the application's
+      /// topic index finishes a discovery scan. Plugins holding topic
+      /// lists can subscribe through Application::SubscribeToEvent and
+      /// re-query Application::TopicsOfType, instead of each paying
+      /// for its own discovery round trips.
+      class TopicIndexUpdated : public QEvent
+      {
+        public: TopicIndexUpdated()
+            : QEvent(kType)
+        {
+        }
+
+        /// \brief Unique type for this event.
+        static const QEvent::Type kType = QEvent::Type(QEvent::MaxUser - 2);
+      };
     }
   }
 }
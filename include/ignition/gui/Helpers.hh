@@ -18,6 +18,9 @@
 #define IGNITION_GUI_HELPERS_HH_
 
 #include <string>
+#include <vector>
+
+#include <ignition/common/Time.hh>
 
 #include "ignition/gui/Enums.hh"
 #include "ignition/gui/Export.hh"
@@ -70,8 +73,77 @@ namespace ignition
     std::string uniqueFilePath(const std::string &_pathAndName,
                                const std::string &_extension);
 
+    /// \brief Format a time as "dd hh:mm:ss.mmm", like
+    /// common::Time::FormattedString, but through a reused per-thread
+    /// buffer so periodically refreshed readouts don't pay for stream
+    /// construction on every update.
+    /// \param[in] _time The time to format.
+    /// \return The formatted string.
+    IGNITION_GUI_VISIBLE
+    std::string formattedTime(const common::Time &_time);
+
+    /// \brief Format several times with a single call, such as the sim
+    /// and real time readouts of a stats display.
+    /// \param[in] _times The times to format.
+    /// \return One formatted string per input time, in the same order.
+    IGNITION_GUI_VISIBLE
+    std::vector<std::string> formattedTimes(
+        const std::vector<common::Time> &_times);
+
+    /// \brief Convert a string to a QString through a per-thread
+    /// interning table. Repeated conversions of the same stable
+    /// identifier — plugin filenames, titles, property and topic names —
+    /// return the cached QString (a refcount bump, since QString is
+    /// implicitly shared) instead of paying an allocation and UTF
+    /// conversion each time. Not meant for strings of unbounded variety
+    /// such as message contents; the table is cleared if it grows past
+    /// a sanity limit.
+    /// \param[in] _str The string to convert.
+    /// \return The converted QString.
+    IGNITION_GUI_VISIBLE
+    QString internedQString(const std::string &_str);
+
+    /// \brief Severities accepted by logAsync, mirroring the console
+    /// macros each one is written with.
+    enum class LogSeverity
+    {
+      /// \brief Written with igndbg
+      DBG,
+
+      /// \brief Written with ignmsg
+      MSG,
+
+      /// \brief Written with ignwarn
+      WARN,
+
+      /// \brief Written with ignerr
+      ERR
+    };
+
+    /// \brief Queue a message to be written by a background logger
+    /// thread instead of formatting and writing it in the caller.
+    /// Meant for hot paths such as per-message transport callbacks,
+    /// where a synchronous console write can stall the stream.
+    ///
+    /// Messages from the same site arriving within _rateLimitMs of the
+    /// previous one are dropped, and the drop count is reported with
+    /// the next message that gets through. When the queue is full the
+    /// message is dropped rather than blocking the caller.
+    /// \param[in] _severity Severity to write with.
+    /// \param[in] _site Rate limiting key, usually a string literal
+    /// naming the call site.
+    /// \param[in] _message Fully formatted message text.
+    /// \param[in] _rateLimitMs Minimum interval between writes from
+    /// this site, in milliseconds; 0 disables rate limiting.
+    IGNITION_GUI_VISIBLE
+    void logAsync(LogSeverity _severity, const std::string &_site,
+        const std::string &_message, int _rateLimitMs = 1000);
+
     /// \brief Returns the first element on a QList which matches the given
     /// property.
+    ///
+    /// Note that this is a linear scan. Callers looking elements up by
+    /// value on every update tick should maintain an IndexedMap instead.
     /// \param[in] _list The list to search through.
     /// \param[in] _key The property key value.
     /// \param[in] _value The property value.
@@ -87,6 +159,102 @@ namespace ignition
       }
       return nullptr;
     }
+
+    /// \brief A bidirectional map which keeps a value-to-key hash
+    /// alongside the key-to-value hash, so lookups in either direction
+    /// are constant time. Useful for panels which resolve widgets by
+    /// value on every update tick, where scanning with
+    /// findFirstByProperty would be linear.
+    ///
+    /// Both types must be hashable by QHash; the common QString and int
+    /// cases work out of the box. Values are expected to be unique: when
+    /// two keys hold the same value, the reverse lookup returns the key
+    /// inserted last.
+    template<class K, class V>
+    class IndexedMap
+    {
+      /// \brief Insert or update a key-value pair, keeping the reverse
+      /// index in sync.
+      /// \param[in] _key The key.
+      /// \param[in] _value The value.
+      public: void Insert(const K &_key, const V &_value)
+      {
+        auto it = this->keyToValue.find(_key);
+        if (it != this->keyToValue.end())
+          this->valueToKey.remove(it.value());
+
+        this->keyToValue.insert(_key, _value);
+        this->valueToKey.insert(_value, _key);
+      }
+
+      /// \brief Remove a pair by key.
+      /// \param[in] _key The key to remove.
+      /// \return True if the key was present.
+      public: bool Remove(const K &_key)
+      {
+        auto it = this->keyToValue.find(_key);
+        if (it == this->keyToValue.end())
+          return false;
+
+        this->valueToKey.remove(it.value());
+        this->keyToValue.erase(it);
+        return true;
+      }
+
+      /// \brief Get the value stored for a key.
+      /// \param[in] _key The key to look up.
+      /// \param[in] _default Value returned when the key is not present.
+      /// \return The value, or _default.
+      public: V Value(const K &_key, const V &_default = V()) const
+      {
+        return this->keyToValue.value(_key, _default);
+      }
+
+      /// \brief Get the key holding a value, in constant time.
+      /// \param[in] _value The value to look up.
+      /// \param[in] _default Key returned when the value is not present.
+      /// \return The key, or _default.
+      public: K Key(const V &_value, const K &_default = K()) const
+      {
+        return this->valueToKey.value(_value, _default);
+      }
+
+      /// \brief Check whether a key is present.
+      /// \param[in] _key The key to look for.
+      /// \return True if present.
+      public: bool ContainsKey(const K &_key) const
+      {
+        return this->keyToValue.contains(_key);
+      }
+
+      /// \brief Check whether a value is present.
+      /// \param[in] _value The value to look for.
+      /// \return True if present.
+      public: bool ContainsValue(const V &_value) const
+      {
+        return this->valueToKey.contains(_value);
+      }
+
+      /// \brief Remove all pairs.
+      public: void Clear()
+      {
+        this->keyToValue.clear();
+        this->valueToKey.clear();
+      }
+
+      /// \brief Get the number of pairs stored.
+      /// \return The pair count.
+      public: int Size() const
+      {
+        return this->keyToValue.size();
+      }
+
+      /// \brief Forward index.
+      private: QHash<K, V> keyToValue;
+
+      /// \brief Reverse index.
+      private: QHash<V, K> valueToKey;
+    };
   }
 }
 #endif
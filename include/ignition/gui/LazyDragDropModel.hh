@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GUI_LAZYDRAGDROPMODEL_HH_
+#define IGNITION_GUI_LAZYDRAGDROPMODEL_HH_
+
+#include <functional>
+#include <vector>
+
+#include "ignition/gui/Export.hh"
+#include "ignition/gui/qt.h"
+
+namespace ignition
+{
+namespace gui
+{
+  /// \brief Tree model which serves the same drag-drop views as
+  /// DragDropModel without allocating one heap item per row. Row data
+  /// lives in flat arrays indexed by a row handle, and rows flagged as
+  /// deferred only materialize their children when a view first expands
+  /// them, through canFetchMore / fetchMore.
+  ///
+  /// Meant for big trees such as topic browsers, where most branches
+  /// are never opened: startup only pays for the visible top level, and
+  /// resident memory stays proportional to what was expanded.
+  class IGNITION_GUI_VISIBLE LazyDragDropModel : public QAbstractItemModel
+  {
+    /// \brief Called when a deferred row is first expanded. The provider
+    /// adds the row's children with AddRow; the deferred flag is cleared
+    /// before it is called.
+    public: using ChildProvider = std::function<void (const int _row)>;
+
+    /// \brief Append a row.
+    /// \param[in] _name Text displayed for the user.
+    /// \param[in] _parentRow Handle previously returned by AddRow, or -1
+    /// for a top-level row.
+    /// \return Handle for the new row, used as a parent handle or with
+    /// the setters below.
+    public: int AddRow(const QString &_name, const int _parentRow = -1);
+
+    /// \brief Set the URI query carried during a drag-drop.
+    /// \param[in] _row Handle returned by AddRow.
+    /// \param[in] _uriQuery URI including detailed query.
+    public: void SetUriQuery(const int _row, const QString &_uriQuery);
+
+    /// \brief Set the data type name used to specialize display.
+    /// \param[in] _row Handle returned by AddRow.
+    /// \param[in] _type Type name, such as "Double" or "title".
+    public: void SetType(const int _row, const QString &_type);
+
+    /// \brief Flag a row whose children are fetched on first expansion
+    /// instead of being added up front.
+    /// \param[in] _row Handle returned by AddRow.
+    /// \param[in] _deferred True to defer the row's children.
+    /// \sa SetChildProvider
+    public: void SetDeferred(const int _row, const bool _deferred);
+
+    /// \brief Set the provider which materializes deferred children.
+    /// \param[in] _provider Provider callback.
+    /// \sa SetDeferred
+    public: void SetChildProvider(const ChildProvider &_provider);
+
+    // Documentation inherited
+    public: QModelIndex index(int _row, int _column,
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: QModelIndex parent(const QModelIndex &_index) const override;
+
+    // Documentation inherited
+    public: int rowCount(
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: int columnCount(
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    // Documentation inherited
+    public: QVariant data(const QModelIndex &_index,
+        int _role = Qt::DisplayRole) const override;
+
+    // Documentation inherited
+    public: bool setData(const QModelIndex &_index, const QVariant &_value,
+        int _role = Qt::EditRole) override;
+
+    // Documentation inherited
+    public: Qt::ItemFlags flags(const QModelIndex &_index) const override;
+
+    // Documentation inherited
+    public: bool hasChildren(
+        const QModelIndex &_parent = QModelIndex()) const override;
+
+    /// \brief Overloaded from Qt. True for deferred rows which haven't
+    /// fetched their children yet.
+    /// \param[in] _parent Parent index.
+    /// \return True if more rows can be fetched.
+    public: bool canFetchMore(const QModelIndex &_parent) const override;
+
+    /// \brief Overloaded from Qt. Materializes a deferred row's children
+    /// through the child provider.
+    /// \param[in] _parent Parent index.
+    public: void fetchMore(const QModelIndex &_parent) override;
+
+    /// \brief Overloaded from Qt. Custom MIME data function, matching
+    /// DragDropModel.
+    /// \param[in] _indexes List of selected items.
+    /// \return Mime data for the selected items.
+    public: QMimeData *mimeData(const QModelIndexList &_indexes) const
+        override;
+
+    /// \brief Get the row handle an index refers to.
+    /// \param[in] _index Model index.
+    /// \return The row handle, or -1 for the invisible root.
+    private: int RowFrom(const QModelIndex &_index) const;
+
+    /// \brief Text displayed for the user, per row.
+    private: std::vector<QString> names;
+
+    /// \brief URI query carried during drag-drop, per row.
+    private: std::vector<QString> uriQueries;
+
+    /// \brief Data type name, per row.
+    private: std::vector<QString> types;
+
+    /// \brief Whether the row should be expanded, per row.
+    private: std::vector<bool> toExpand;
+
+    /// \brief Whether the row's children haven't been fetched yet, per
+    /// row.
+    private: std::vector<bool> deferred;
+
+    /// \brief Parent row handle, -1 for top-level rows.
+    private: std::vector<int> parents;
+
+    /// \brief Position among the parent's children, per row.
+    private: std::vector<int> rowInParent;
+
+    /// \brief Child row handles, per row.
+    private: std::vector<std::vector<int>> childRows;
+
+    /// \brief Top-level row handles.
+    private: std::vector<int> topRows;
+
+    /// \brief Provider which materializes deferred children.
+    private: ChildProvider provider;
+  };
+}
+}
+#endif
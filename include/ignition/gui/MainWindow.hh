@@ -17,6 +17,7 @@
 #ifndef IGNITION_GUI_MAINWINDOW_HH_
 #define IGNITION_GUI_MAINWINDOW_HH_
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <set>
@@ -27,6 +28,7 @@
 
 #include "ignition/gui/qt.h"
 #include "ignition/gui/Export.hh"
+#include "ignition/gui/Plugin.hh"
 
 namespace ignition
 {
@@ -170,6 +172,94 @@ namespace ignition
         NOTIFY ShowPluginMenuChanged
       )
 
+      /// \brief Opt-in memory telemetry: when enabled, the window
+      /// periodically samples process and object statistics, exposes
+      /// them through the telemetry properties and publishes them on
+      /// the /gui/telemetry topic. Off by default.
+      Q_PROPERTY(
+        bool telemetryEnabled
+        READ TelemetryEnabled
+        WRITE SetTelemetryEnabled
+        NOTIFY TelemetryEnabledChanged
+      )
+
+      /// \brief Telemetry sampling interval in ms.
+      Q_PROPERTY(
+        int telemetryInterval
+        READ TelemetryInterval
+        WRITE SetTelemetryInterval
+        NOTIFY TelemetryIntervalChanged
+      )
+
+      /// \brief Latest sampled resident set size in kB, or -1 where the
+      /// platform doesn't expose it.
+      Q_PROPERTY(
+        int telemetryRss
+        READ TelemetryRss
+        NOTIFY TelemetryUpdated
+      )
+
+      /// \brief Latest sampled object count: all QObjects under this
+      /// window and its QML tree.
+      Q_PROPERTY(
+        int telemetryObjectCount
+        READ TelemetryObjectCount
+        NOTIFY TelemetryUpdated
+      )
+
+      /// \brief Scene graph frame statistics: when enabled, the window
+      /// tracks frame, sync and render phase times from the render
+      /// loop, shows them in a small HUD and adds them to telemetry
+      /// samples. Cheap enough to leave on. Off by default.
+      Q_PROPERTY(
+        bool frameStatsEnabled
+        READ FrameStatsEnabled
+        WRITE SetFrameStatsEnabled
+        NOTIFY FrameStatsEnabledChanged
+      )
+
+      /// \brief Frames per second over the last stats window.
+      Q_PROPERTY(
+        double frameFps
+        READ FrameFps
+        NOTIFY FrameStatsUpdated
+      )
+
+      /// \brief Average frame time in ms over the last stats window.
+      Q_PROPERTY(
+        double frameAvgMs
+        READ FrameAvgMs
+        NOTIFY FrameStatsUpdated
+      )
+
+      /// \brief Worst frame time in ms over the last stats window.
+      Q_PROPERTY(
+        double frameWorstMs
+        READ FrameWorstMs
+        NOTIFY FrameStatsUpdated
+      )
+
+      /// \brief Last measured scene graph sync phase in ms.
+      Q_PROPERTY(
+        double frameSyncMs
+        READ FrameSyncMs
+        NOTIFY FrameStatsUpdated
+      )
+
+      /// \brief Last measured scene graph render phase in ms.
+      Q_PROPERTY(
+        double frameRenderMs
+        READ FrameRenderMs
+        NOTIFY FrameStatsUpdated
+      )
+
+      /// \brief Frames longer than 33 ms since stats were enabled.
+      Q_PROPERTY(
+        int longFrameCount
+        READ LongFrameCount
+        NOTIFY FrameStatsUpdated
+      )
+
       /// \brief Constructor
       public: MainWindow();
 
@@ -183,14 +273,30 @@ namespace ignition
       /// \brief Save current window and plugin configuration to a file on disk.
       /// Will open an error dialog in case it's not possible to write to the
       /// path.
+      /// The state is snapshotted synchronously, but serialization and
+      /// file I/O happen on a background thread, so this returns before
+      /// the file hits the disk. \sa WaitForSave
       /// \param[in] _path The full destination path including filename.
       public: void SaveConfig(const std::string &_path);
 
+      /// \brief Block until any in-flight configuration save has
+      /// finished writing. Useful before reading the file back, for
+      /// example in tests.
+      public: void WaitForSave();
+
       /// \brief Apply a WindowConfig to this window and keep a copy of it.
       /// \param[in] _config The configuration to apply.
       /// \return True if successful.
       public: bool ApplyConfig(const WindowConfig &_config);
 
+      /// \brief Apply a WindowConfig to this window, taking ownership
+      /// of it. Same as the const reference overload, but the copy kept
+      /// by the window steals _config's buffers instead of duplicating
+      /// them.
+      /// \param[in] _config The configuration to apply.
+      /// \return True if successful.
+      public: bool ApplyConfig(WindowConfig &&_config);
+
       /// \brief Get the current window configuration.
       /// \return Updated window config
       public: WindowConfig CurrentWindowConfig() const;
@@ -203,6 +309,16 @@ namespace ignition
       /// \return List with plugin names
       public: Q_INVOKABLE QStringList PluginListModel() const;
 
+      /// \brief Get the model backing the plugins menu. Rows are
+      /// inserted and removed one at a time as the config changes, so
+      /// the menu's delegates aren't rebuilt wholesale.
+      /// \return The menu model, owned by this window.
+      public: Q_INVOKABLE QAbstractItemModel *PluginsModel() const;
+
+      /// \brief Sync the plugins menu model with the current plugin
+      /// list, inserting and removing individual rows.
+      private: void UpdatePluginListModel();
+
       /// \brief Returns the number of plugins current instantiated in the
       /// window.
       /// \return Number of plugins
@@ -337,6 +453,66 @@ namespace ignition
       /// \param[in] _showPluginMenu True to show.
       public: Q_INVOKABLE void SetShowPluginMenu(const bool _showPluginMenu);
 
+      /// \brief Get whether memory telemetry is enabled.
+      /// \return True when sampling.
+      public: Q_INVOKABLE bool TelemetryEnabled() const;
+
+      /// \brief Enable or disable memory telemetry. Each sample is a
+      /// procfs read and an object walk over this window, cheap enough
+      /// to leave on during long operator sessions.
+      /// \param[in] _enabled True to start sampling.
+      public: Q_INVOKABLE void SetTelemetryEnabled(const bool _enabled);
+
+      /// \brief Get the telemetry sampling interval.
+      /// \return Interval in ms.
+      public: Q_INVOKABLE int TelemetryInterval() const;
+
+      /// \brief Set the telemetry sampling interval.
+      /// \param[in] _intervalMs Interval in ms.
+      public: Q_INVOKABLE void SetTelemetryInterval(const int _intervalMs);
+
+      /// \brief Get the latest sampled resident set size.
+      /// \return RSS in kB, or -1 if unavailable.
+      public: Q_INVOKABLE int TelemetryRss() const;
+
+      /// \brief Get the latest sampled object count.
+      /// \return Number of QObjects under this window and its QML tree.
+      public: Q_INVOKABLE int TelemetryObjectCount() const;
+
+      /// \brief Check whether frame statistics are being collected.
+      /// \return True when enabled.
+      public: Q_INVOKABLE bool FrameStatsEnabled() const;
+
+      /// \brief Enable or disable frame statistics. The per-frame cost
+      /// is a few clock reads and relaxed atomic stores on the render
+      /// thread, so this is safe to ship enabled.
+      /// \param[in] _enabled True to start collecting.
+      public: Q_INVOKABLE void SetFrameStatsEnabled(const bool _enabled);
+
+      /// \brief Get the frame rate over the last stats window.
+      /// \return Frames per second.
+      public: Q_INVOKABLE double FrameFps() const;
+
+      /// \brief Get the average frame time over the last stats window.
+      /// \return Time in ms.
+      public: Q_INVOKABLE double FrameAvgMs() const;
+
+      /// \brief Get the worst frame time over the last stats window.
+      /// \return Time in ms.
+      public: Q_INVOKABLE double FrameWorstMs() const;
+
+      /// \brief Get the last sync phase duration.
+      /// \return Time in ms.
+      public: Q_INVOKABLE double FrameSyncMs() const;
+
+      /// \brief Get the last render phase duration.
+      /// \return Time in ms.
+      public: Q_INVOKABLE double FrameRenderMs() const;
+
+      /// \brief Get the number of long frames since enabling.
+      /// \return Frames which took longer than 33 ms.
+      public: Q_INVOKABLE int LongFrameCount() const;
+
       /// \brief Callback when load configuration is selected
       public slots: void OnLoadConfig(const QString &_path);
 
@@ -346,6 +522,28 @@ namespace ignition
       /// \brief Callback when "save configuration as" is selected
       public slots: void OnSaveConfigAs(const QString &_path);
 
+      /// \brief Request an asynchronous save of the current configuration
+      /// to the default config path. Rapid requests, such as those fired
+      /// while dragging a resize handle, are debounced into a single
+      /// save, and serialization plus the atomic file write happen on a
+      /// background thread so the GUI never stalls.
+      public slots: void AutoSaveConfig();
+
+      /// \brief Callback when the autosave debounce timer fires,
+      /// snapshotting the configuration and starting the background
+      /// write.
+      private slots: void OnAutoSaveTimeout();
+
+      /// \brief Callback when the telemetry timer fires: samples RSS
+      /// and object counts, updates the telemetry properties and
+      /// publishes the sample.
+      private slots: void OnTelemetryTimeout();
+
+      /// \brief Callback when the frame stats timer fires: folds the
+      /// ring of frame times collected on the render thread into the
+      /// summary properties the HUD binds to.
+      private slots: void OnFrameStatsTimeout();
+
       /// \brief Notifies when the number of plugins has changed.
       signals: void PluginCountChanged();
 
@@ -391,6 +589,21 @@ namespace ignition
       /// \brief Notifies when the show menu flag has changed.
       signals: void ShowPluginMenuChanged();
 
+      /// \brief Notifies when telemetry has been enabled or disabled.
+      signals: void TelemetryEnabledChanged();
+
+      /// \brief Notifies when the telemetry interval has changed.
+      signals: void TelemetryIntervalChanged();
+
+      /// \brief Notifies when a new telemetry sample is available.
+      signals: void TelemetryUpdated();
+
+      /// \brief Notifies when frame stats have been enabled or disabled.
+      signals: void FrameStatsEnabledChanged();
+
+      /// \brief Notifies when a new frame stats summary is available.
+      signals: void FrameStatsUpdated();
+
       /// \brief Notifies when the window config has changed.
       signals: void configChanged();
 
@@ -405,6 +618,28 @@ namespace ignition
     /// \brief Holds configurations related to a MainWindow.
     struct IGNITION_GUI_VISIBLE WindowConfig
     {
+      /// \brief Default constructor.
+      WindowConfig() = default;
+
+      /// \brief Copy constructor.
+      /// \param[in] _other Config to copy.
+      WindowConfig(const WindowConfig &_other) = default;
+
+      /// \brief Move constructor. Steals _other's dock state buffer,
+      /// strings and plugin configurations instead of copying them.
+      /// \param[in] _other Config to move from.
+      WindowConfig(WindowConfig &&_other) noexcept = default;
+
+      /// \brief Copy assignment.
+      /// \param[in] _other Config to copy.
+      /// \return Reference to this.
+      WindowConfig &operator=(const WindowConfig &_other) = default;
+
+      /// \brief Move assignment.
+      /// \param[in] _other Config to move from.
+      /// \return Reference to this.
+      WindowConfig &operator=(WindowConfig &&_other) noexcept = default;
+
       /// \brief Update this config from an XML string. Only fields present on
       /// the XML will be overriden / appended / created.
       /// \param[in] _xml A config XML file in string format
@@ -416,10 +651,30 @@ namespace ignition
       /// \return String containing a complete config file.
       std::string XMLString() const;
 
+      /// \brief Serialize this configuration to a compact binary buffer,
+      /// used to cache parsed configs between launches.
+      /// \return Buffer which can be restored with FromBinary.
+      /// \sa FromBinary
+      QByteArray ToBinary() const;
+
+      /// \brief Restore this configuration from a buffer created with
+      /// ToBinary. On failure the configuration is left unchanged.
+      /// \param[in] _buffer Serialized configuration.
+      /// \return True if the buffer was valid.
+      /// \sa ToBinary
+      bool FromBinary(const QByteArray &_buffer);
+
       /// \brief Get whether a property should be ignored
       /// \return True if it's being ignored
       bool IsIgnoring(const std::string &_prop) const;
 
+      /// \brief Cheap fingerprint over every field, so save paths can
+      /// skip serialization and file writes when two snapshots are
+      /// identical. Not a stable hash: values may differ between runs
+      /// and should only be compared within one.
+      /// \return Hash combining every field.
+      std::size_t Fingerprint() const;
+
       /// \brief Window X position in px
       int posX{-1};
 
@@ -489,6 +744,12 @@ namespace ignition
 
       /// \brief Concatenation of all plugin configurations.
       std::string plugins{""};
+
+      /// \brief Plugin snapshots not yet rendered to XML. Capturing
+      /// these is cheap, so CurrentWindowConfig fills this on the GUI
+      /// thread and XMLString renders them after `plugins`, possibly
+      /// on a worker thread.
+      std::vector<PluginConfigSnapshot> pluginSnapshots;
     };
   }
 }
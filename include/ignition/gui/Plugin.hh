@@ -20,6 +20,7 @@
 #include <tinyxml2.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "ignition/gui/qt.h"
 #include "ignition/gui/Export.hh"
@@ -30,6 +31,38 @@ namespace ignition
   {
     class PluginPrivate;
 
+    /// \brief Plain-data snapshot of everything needed to regenerate a
+    /// plugin's configuration XML. Capturing one only reads card
+    /// properties, so it is cheap enough for the GUI thread; rendering
+    /// it back to XML with Plugin::ConfigStrFromSnapshot is pure string
+    /// work and can run on a worker thread.
+    struct IGNITION_GUI_VISIBLE PluginConfigSnapshot
+    {
+      /// \brief One card property: the config key, the type name as
+      /// spelled in `<property type="...">` and the value already
+      /// rendered as a string.
+      struct Property
+      {
+        /// \brief Property name
+        std::string key;
+
+        /// \brief Config file type name
+        std::string type;
+
+        /// \brief Current value
+        std::string value;
+      };
+
+      /// \brief Configuration XML the plugin was loaded with.
+      std::string configStr;
+
+      /// \brief Whether the plugin's card is anchored.
+      bool anchored{false};
+
+      /// \brief Current card properties, in meta-object order.
+      std::vector<Property> properties;
+    };
+
     /// \brief Base class for Ignition GUI plugins.
     ///
     /// When inheriting from this plugin, the following are assumed:
@@ -61,6 +94,11 @@ namespace ignition
       /// Called when a plugin is first created.
       /// This function should not be blocking.
       ///
+      /// If the configuration sets the card's `visible` property to false,
+      /// only the common configuration is processed here; the plugin's QML
+      /// and custom configuration are deferred until the card first
+      /// becomes visible, and PluginItem() returns nullptr until then.
+      ///
       /// \sa Load
       /// \param[in] _pluginElem Element containing configuration
       public: void Load(const tinyxml2::XMLElement *_pluginElem);
@@ -69,11 +107,44 @@ namespace ignition
       /// \return Config element
       public: virtual std::string ConfigStr();
 
+      /// \brief Capture the plugin's current configuration as plain
+      /// data. This only reads card properties, so it is cheap enough
+      /// for the GUI thread's save hot path; pass the result to
+      /// ConfigStrFromSnapshot to generate the XML elsewhere.
+      /// \return Snapshot of the current configuration.
+      public: PluginConfigSnapshot ConfigSnapshot() const;
+
+      /// \brief Render a snapshot to configuration XML. Doesn't touch
+      /// the plugin or Qt, so it can run on any thread.
+      /// \param[in] _snapshot Snapshot taken with ConfigSnapshot.
+      /// \return Config element as a string.
+      public: static std::string ConfigStrFromSnapshot(
+          const PluginConfigSnapshot &_snapshot);
+
+      /// \brief Get the configuration XML the plugin was loaded with,
+      /// without the card property updates which ConfigStr applies.
+      /// \return Config element as stored by Load.
+      public: std::string OriginalConfigStr() const {return this->configStr;}
+
       /// \brief Get the card item which contains this plugin. The item is
-      /// generated the first time this function is run.
+      /// generated the first time this function is run, either fresh or
+      /// recycled from a recently closed plugin's card.
       /// \return Pointer to card item.
       public: QQuickItem *CardItem() const;
 
+      /// \brief Detach this plugin's card and return it to the pool of
+      /// recycled cards, so the next plugin added reuses it instead of
+      /// instantiating new card chrome.
+      /// \return True if the card was pooled. False if there is no card
+      /// or the pool is full, in which case the caller keeps ownership.
+      public: bool ReleaseCard();
+
+      /// \brief Delete all recycled cards kept warm for reuse. The
+      /// application calls this while tearing down: pooled cards belong
+      /// to its QML engine and must not outlive it, much less be handed
+      /// out by a future application.
+      public: static void ClearCardPool();
+
       /// \brief Get the plugin item.
       /// \return Pointer to plugin item.
       public: QQuickItem *PluginItem() const;
@@ -86,6 +157,12 @@ namespace ignition
       /// has a parent.
       public: void PostParentChanges();
 
+      /// \brief Do the blocking, non-Qt part of teardown, such as
+      /// transport unsubscription. Called from a worker thread during
+      /// application shutdown, before the plugin object is destroyed
+      /// on the GUI thread, so overrides must not touch Qt objects.
+      public: virtual void Shutdown() {}
+
       /// \brief Load the plugin with a configuration file. Override this
       /// on custom plugins to handle custom configurations.
       ///
@@ -129,6 +206,14 @@ namespace ignition
       /// through the <anchor> tag and any state properties.
       private: void ApplyAnchors();
 
+      /// \brief Create the plugin's QML context and item. No-op if the
+      /// item has already been created.
+      private: void InstantiateQml();
+
+      /// \brief Callback when a card holding a deferred plugin changes
+      /// visibility, instantiating the plugin's QML on first show.
+      private slots: void OnCardVisible();
+
       /// \internal
       /// \brief Pointer to private data
       private: std::unique_ptr<PluginPrivate> dataPtr;
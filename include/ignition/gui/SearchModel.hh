@@ -17,6 +17,11 @@
 #ifndef IGNITION_GUI_SEARCHMODEL_HH_
 #define IGNITION_GUI_SEARCHMODEL_HH_
 
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "ignition/gui/Export.hh"
 #include "ignition/gui/qt.h"
 
@@ -35,6 +40,11 @@ namespace gui
   ///
   class IGNITION_GUI_VISIBLE SearchModel : public QSortFilterProxyModel
   {
+    Q_OBJECT
+
+    /// \brief Destructor. Waits for a background filter pass in flight.
+    public: ~SearchModel() override;
+
     /// \brief Overloaded Qt method. Customize so we accept rows where:
     /// 1. Each of the words can be found in its ancestors or itself, but not
     /// necessarily all words on the same row, or
@@ -59,10 +69,11 @@ namespace gui
     public: bool filterAcceptsRow(const int _srcRow,
                                   const QModelIndex &_srcParent) const;
 
-    /// \brief Check if row contains the word on itself.
+    /// \brief Check if row matches the word on itself, as a prefix,
+    /// substring or fuzzy subsequence of its text.
     /// \param[in] _srcRow Row on the source model.
     /// \param[in] _srcParent Parent on the source model.
-    /// \param[in] _word Word to be checked.
+    /// \param[in] _word Word to be checked, in lowercase.
     /// \return True if row matches.
     public: bool FilterAcceptsRowItself(const int _srcRow,
                                         const QModelIndex &_srcParent,
@@ -77,17 +88,209 @@ namespace gui
 
     /// \brief Check if any of the children accepts a specific word.
     /// \param[in] _srcParent Parent on the source model.
-    /// \param[in] _word Word to be checked.
+    /// \param[in] _word Word to be checked, in lowercase.
     /// \return True if any of the children match.
     public: bool HasChildAcceptsItself(const QModelIndex &_srcParent,
                                        const QString &_word) const;
 
-    /// \brief Set a new search value.
+    /// \brief Overloaded Qt method. While a search is active, rows with
+    /// a higher match score sort first, so prefix matches beat
+    /// substring matches beat scattered fuzzy matches. Ties, and rows
+    /// without a search, compare cached collation keys, so resorting
+    /// after a filter change doesn't re-derive and case-convert the
+    /// role strings for every comparison.
+    /// \param[in] _left Left row on the source model.
+    /// \param[in] _right Right row on the source model.
+    /// \return True if left sorts before right.
+    protected: bool lessThan(const QModelIndex &_left,
+        const QModelIndex &_right) const override;
+
+    /// \brief Set the source model and subscribe to its change signals,
+    /// which keep the search caches in sync with it.
+    /// \param[in] _sourceModel The model to be filtered.
+    public: void setSourceModel(QAbstractItemModel *_sourceModel) override;
+
+    /// \brief Set a new search value. The search is compiled once and
+    /// each word matches rows as a prefix, substring or fuzzy
+    /// subsequence, with results ranked by match quality. A search
+    /// which extends the previous one refines its result set instead
+    /// of rescanning the whole source model. On models too big to filter within a frame,
+    /// the pass is debounced and runs on a worker thread against a
+    /// snapshot of the model, and the results are swapped in at once.
     /// \param[in] _search Full search string.
     public: void SetSearch(const QString &_search);
 
+    /// \brief Emitted by the background filter pass when its verdicts
+    /// are ready to be applied.
+    signals: void FilterReady();
+
+    /// \brief Run the debounced search: snapshot the source model and
+    /// start the background filter pass for the pending search.
+    private slots: void OnSearchTimeout();
+
+    /// \brief Swap in the verdicts of a finished background pass, unless
+    /// the model or the pending search changed since it started.
+    private slots: void OnFilterReady();
+
     /// \brief Full search string.
     public: QString search;
+
+    /// \brief One search word in compiled form, built once per
+    /// SetSearch so per-row matching never re-derives the pattern.
+    private: struct CompiledWord
+    {
+      /// \brief Lowercase word
+      QString word;
+
+      /// \brief Character fold of the word. A row whose own fold is
+      /// missing one of these bits can be rejected without scanning
+      /// its text.
+      quint64 mask{0};
+    };
+
+    /// \brief Compile a search string into lowered words with their
+    /// character folds.
+    /// \param[in] _search Full search string.
+    /// \return Compiled words, empty words skipped.
+    private: static std::vector<CompiledWord> Compile(const QString &_search);
+
+    /// \brief Score a row text against one compiled word.
+    /// \param[in] _word Compiled word.
+    /// \param[in] _text Lowercase row text.
+    /// \param[in] _mask Character fold of _text.
+    /// \return Negative when the word doesn't match. Higher is better:
+    /// prefix matches beat substring matches beat fuzzy subsequence
+    /// matches, and tighter subsequences score higher.
+    private: static double WordScore(const CompiledWord &_word,
+        const QString &_text, const quint64 _mask);
+
+    /// \brief Score a source row against one compiled word, using the
+    /// text index.
+    /// \param[in] _word Compiled word.
+    /// \param[in] _id Index on the source model.
+    /// \return Score, negative when the word doesn't match.
+    private: double MatchScore(const CompiledWord &_word,
+        const QModelIndex &_id) const;
+
+    /// \brief Check if any descendant matches a compiled word on
+    /// itself.
+    /// \param[in] _srcParent Parent on the source model.
+    /// \param[in] _word Compiled word.
+    /// \return True if any descendant matches.
+    private: bool HasChildAcceptsItself(const QModelIndex &_srcParent,
+        const CompiledWord &_word) const;
+
+    /// \brief Words of the current search in compiled form.
+    private: mutable std::vector<CompiledWord> compiledWords;
+
+    /// \brief Match score per accepted source index for the current
+    /// search, used to rank results. Dropped with the match cache.
+    private: mutable QHash<QPersistentModelIndex, double> matchScores;
+
+    /// \brief Snapshot of one source row, holding everything a filter
+    /// pass needs so it can run off the GUI thread.
+    private: struct RowSnapshot
+    {
+      /// \brief Lowercase filter-role text
+      QString text;
+
+      /// \brief Character fold of text
+      quint64 mask{0};
+
+      /// \brief Position of the parent row in the snapshot, or -1 for
+      /// top-level rows. Parents always precede their children.
+      int parent{-1};
+
+      /// \brief Positions of the immediate children in the snapshot
+      std::vector<int> children;
+
+      /// \brief True for title rows, which are never accepted
+      bool title{false};
+    };
+
+    /// \brief Build the source model snapshot if there isn't a current
+    /// one.
+    /// \return Number of snapshotted rows.
+    private: int EnsureSnapshot();
+
+    /// \brief Snapshot of the source model, dropped whenever the model
+    /// changes. Background passes keep a reference while they run.
+    private: std::shared_ptr<const std::vector<RowSnapshot>> snapshot;
+
+    /// \brief Source index of each snapshotted row, used to apply the
+    /// background pass' verdicts. Only touched on the GUI thread.
+    private: QVector<QPersistentModelIndex> snapshotIds;
+
+    /// \brief Bumped whenever the caches are dropped, so verdicts from
+    /// a pass over a stale snapshot are ignored.
+    private: int snapshotGeneration{0};
+
+    /// \brief Debounce timer for background passes, created on first
+    /// use.
+    private: QTimer *searchTimer{nullptr};
+
+    /// \brief Search string waiting for the debounce window to close.
+    private: QString pendingSearch;
+
+    /// \brief The background pass in flight, waited on at destruction.
+    private: std::future<void> filterResult;
+
+    /// \brief Protects the result* members, which the background pass
+    /// fills and OnFilterReady consumes.
+    private: std::mutex resultMutex;
+
+    /// \brief Search string the finished pass was run with.
+    private: QString resultSearch;
+
+    /// \brief Snapshot generation the finished pass was run against.
+    private: int resultGeneration{0};
+
+    /// \brief Verdict per snapshotted row.
+    private: std::vector<bool> resultAccepted;
+
+    /// \brief TO_EXPAND value per snapshotted row.
+    private: std::vector<bool> resultExpand;
+
+    /// \brief Match score per snapshotted row.
+    private: std::vector<double> resultScores;
+
+    /// \brief One entry of the text index.
+    private: struct IndexedEntry
+    {
+      /// \brief Lowercase filter-role text
+      QString text;
+
+      /// \brief Character fold of text, for the matcher's quick reject
+      quint64 mask{0};
+    };
+
+    /// \brief Get the lowercase filter-role text and its character
+    /// fold for a source index, from the text index. Filled lazily, so
+    /// only rows which are actually filtered pay for the lookup and
+    /// case conversion.
+    /// Assumes the filter role doesn't change once filtering started.
+    /// \param[in] _id Index on the source model.
+    /// \return The indexed entry.
+    private: const IndexedEntry &IndexedText(const QModelIndex &_id) const;
+
+    /// \brief Indexed text per source index, dropped whenever the
+    /// source model changes.
+    private: mutable QHash<QPersistentModelIndex, IndexedEntry> textIndex;
+
+    /// \brief Get the collation key for a source index, from the key
+    /// cache. Filled lazily.
+    /// \param[in] _id Index on the source model.
+    /// \return The cached key.
+    private: const QString &CollationKey(const QModelIndex &_id) const;
+
+    /// \brief Collation key per source index, dropped whenever the
+    /// source model changes.
+    private: mutable QHash<QPersistentModelIndex, QString> collationKeys;
+
+    /// \brief Verdict per source index for the current search. Dropped
+    /// when the source model changes; on a refining search only the
+    /// previous rejections are kept.
+    private: mutable QHash<QPersistentModelIndex, bool> matchCache;
   };
 }
 }
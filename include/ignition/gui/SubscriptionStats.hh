@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GUI_SUBSCRIPTIONSTATS_HH_
+#define IGNITION_GUI_SUBSCRIPTIONSTATS_HH_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ignition/gui/Export.hh"
+
+namespace ignition
+{
+namespace gui
+{
+  /// \brief Latency histogram with geometric buckets. Recording is a
+  /// single relaxed atomic increment, so transport threads can record
+  /// every callback without taking a lock or contending with readers.
+  ///
+  /// Bucket N counts durations in [2^N, 2^(N+1)) microseconds, so the
+  /// histogram resolves from microseconds to about half a minute in a
+  /// fixed, small footprint, HDR-style. Queries are approximate to one
+  /// bucket, which is plenty to tell a 1 ms callback from a 20 ms one.
+  class IGNITION_GUI_VISIBLE LatencyHistogram
+  {
+    /// \brief Number of buckets.
+    public: static constexpr unsigned int kBuckets{26u};
+
+    /// \brief Record one duration. Lock-free, safe from any thread.
+    /// \param[in] _duration Duration to record.
+    public: void Record(const std::chrono::nanoseconds _duration);
+
+    /// \brief Get the number of recorded durations.
+    /// \return Total count.
+    public: uint64_t Count() const;
+
+    /// \brief Get an approximate percentile.
+    /// \param[in] _percentile Percentile in [0, 100], e.g. 99.0.
+    /// \return Upper bound of the bucket holding the percentile, in ms,
+    /// or zero if nothing has been recorded.
+    public: double PercentileMs(const double _percentile) const;
+
+    /// \brief Get an approximation of the largest recorded duration.
+    /// \return Upper bound of the highest occupied bucket, in ms, or
+    /// zero if nothing has been recorded.
+    public: double MaxMs() const;
+
+    /// \brief Forget everything recorded so far, e.g. to keep a rolling
+    /// window. Not atomic against concurrent Record calls; a sample
+    /// racing the reset may be dropped, which a latency summary can
+    /// afford.
+    public: void Reset();
+
+    /// \brief Sample count per bucket.
+    private: std::array<std::atomic<uint64_t>, kBuckets> counts{};
+  };
+
+  /// \brief Registry of latency metrics for subscriptions on the shared
+  /// transport node, filled by Application::Subscribe and read by the
+  /// TopicStats panel and the /gui/subscription_stats service.
+  class IGNITION_GUI_VISIBLE SubscriptionStats
+  {
+    /// \brief Metrics of one subscription.
+    public: struct Metrics
+    {
+      /// \brief Subscribed topic
+      std::string topic;
+
+      /// \brief Label identifying the subscriber, typically the plugin
+      /// title
+      std::string label;
+
+      /// \brief Time spent inside the callback, recorded by the
+      /// subscribing transport thread
+      LatencyHistogram execution;
+
+      /// \brief Time work queued from the callback waits before the GUI
+      /// thread runs it
+      LatencyHistogram queueDelay;
+
+      /// \brief True while a queue delay probe is in flight, so at most
+      /// one is queued per subscription at a time
+      std::atomic<bool> probePending{false};
+    };
+
+    /// \brief Register a subscription, or look up an earlier
+    /// registration with the same topic and label so resubscribing
+    /// continues its history.
+    /// \param[in] _topic Subscribed topic.
+    /// \param[in] _label Label identifying the subscriber.
+    /// \return The subscription's metrics, never null. Shared: the
+    /// metrics outlive the subscription while anyone reads them.
+    public: std::shared_ptr<Metrics> Register(const std::string &_topic,
+        const std::string &_label);
+
+    /// \brief Get the metrics of all registered subscriptions.
+    /// \return One entry per subscription, in registration order.
+    public: std::vector<std::shared_ptr<Metrics>> AllMetrics() const;
+
+    /// \brief Protects metrics registration; recording doesn't take it.
+    private: mutable std::mutex mutex;
+
+    /// \brief Metrics per subscription, in registration order.
+    private: std::vector<std::shared_ptr<Metrics>> metrics;
+  };
+}
+}
+#endif
@@ -38,6 +38,11 @@ extern "C" IGNITION_GUI_VISIBLE void cmdConfig(const char *_config);
 /// \brief External hook to execute 'ign gui' from the command line.
 extern "C" IGNITION_GUI_VISIBLE void cmdEmptyWindow();
 
+/// \brief External hook to execute 'ign gui -d' from the command line.
+/// Runs a resident daemon which 'ign gui -c' attaches to for fast
+/// launches.
+extern "C" IGNITION_GUI_VISIBLE void cmdDaemon();
+
 /// \brief External hook when executing 'ign gui -t' from the command line.
 /// \param[in] _filename Path to a QSS file.
 extern "C" IGNITION_GUI_VISIBLE void cmdSetStyleFromFile(const char *_filename);
@@ -218,6 +218,34 @@ ApplicationWindow
     height: window.height
   }
 
+  /**
+   * Frame stats HUD
+   */
+  Rectangle {
+    visible: MainWindow.frameStatsEnabled
+    anchors.right: parent.right
+    anchors.bottom: parent.bottom
+    anchors.margins: 10
+    width: frameStatsText.width + 16
+    height: frameStatsText.height + 10
+    color: "#88000000"
+    radius: 4
+    z: 1000
+
+    Text {
+      id: frameStatsText
+      anchors.centerIn: parent
+      color: "white"
+      font.pixelSize: 11
+      text: MainWindow.frameFps.toFixed(0) + " fps  " +
+            MainWindow.frameAvgMs.toFixed(1) + " ms avg  " +
+            MainWindow.frameWorstMs.toFixed(1) + " ms worst\n" +
+            "sync " + MainWindow.frameSyncMs.toFixed(1) + " ms  " +
+            "render " + MainWindow.frameRenderMs.toFixed(1) + " ms  " +
+            "long " + MainWindow.longFrameCount
+    }
+  }
+
   /**
    * About dialog
    */
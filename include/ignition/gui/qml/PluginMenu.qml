@@ -20,29 +20,23 @@ import QtQuick.Controls 2.2
 Menu {
   id: pluginMenu
 
-  Connections {
-    target: MainWindow
-    onConfigChanged: {
-      pluginMenuListView.model = MainWindow.PluginListModel()
-    }
-  }
-
   ListView {
     id: pluginMenuListView
     height: pluginMenu.height
 
     delegate: ItemDelegate {
       width: parent.width
-      text: modelData
+      text: model.display
       highlighted: ListView.isCurrentItem
       onClicked: {
-        MainWindow.OnAddPlugin(modelData);
+        MainWindow.OnAddPlugin(model.display);
         drawer.close()
         pluginMenu.close()
       }
     }
 
-    model: MainWindow.PluginListModel()
+    // Incremental model, rows update in place when the config changes
+    model: MainWindow.PluginsModel()
 
     ScrollIndicator.vertical: ScrollIndicator {
       active: true
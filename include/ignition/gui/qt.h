@@ -39,6 +39,8 @@
 #include <QQuickStyle>
 #include <QQuickWindow>
 
+#include <QScreen>
+
 #include <QSGSimpleTextureNode>
 #include <QStandardItemModel>
 
@@ -15,40 +15,163 @@
  *
  */
 
+#include <sys/stat.h>
 #include <tinyxml2.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
 
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Profiler.hh>
 #include <ignition/common/SignalHandler.hh>
 #include <ignition/common/SystemPaths.hh>
 #include <ignition/common/Util.hh>
 
+#include <ignition/msgs/boolean.pb.h>
+#include <ignition/msgs/param_v.pb.h>
+#include <ignition/msgs/stringmsg.pb.h>
+
 #include <ignition/plugin/Loader.hh>
 
 #include "ignition/gui/Application.hh"
 #include "ignition/gui/config.hh"
 #include "ignition/gui/Dialog.hh"
+#include "ignition/gui/GuiEvents.hh"
 #include "ignition/gui/MainWindow.hh"
 #include "ignition/gui/Plugin.hh"
 
+/// \brief True when a startup timing report was requested, see
+/// Application::SetStartupTimingEnabled
+static bool g_startupTimingEnabled{false};
+
+/// \brief Get a path's modification time in seconds, or -1 on failure.
+/// \param[in] _path Path to check.
+/// \return Modification time.
+static int64_t PathMTime(const std::string &_path);
+
 namespace ignition
 {
   namespace gui
   {
+    /// \brief Event posted by Application::ProbeQueueDelay, carrying the
+    /// time it was posted so its age on delivery is the GUI queue delay.
+    class QueueDelayProbeEvent : public QEvent
+    {
+      /// \brief Constructor
+      /// \param[in] _metrics Metrics to record the delay on.
+      public: explicit QueueDelayProbeEvent(
+          const std::shared_ptr<SubscriptionStats::Metrics> &_metrics)
+          : QEvent(kType), metrics(_metrics),
+            posted(std::chrono::steady_clock::now())
+      {
+      }
+
+      /// \brief Registered type of this event
+      public: static const QEvent::Type kType;
+
+      /// \brief Metrics of the probed subscription
+      public: std::shared_ptr<SubscriptionStats::Metrics> metrics;
+
+      /// \brief Time the probe was posted
+      public: std::chrono::steady_clock::time_point posted;
+    };
+
+    const QEvent::Type QueueDelayProbeEvent::kType =
+        static_cast<QEvent::Type>(QEvent::registerEventType());
+
+    /// \brief Event posted by the /gui/daemon service callback, hopping
+    /// an attach request from the transport thread onto the GUI thread
+    class DaemonAttachEvent : public QEvent
+    {
+      /// \brief Constructor
+      /// \param[in] _config Configuration file to load.
+      public: explicit DaemonAttachEvent(const std::string &_config)
+          : QEvent(kType), config(_config)
+      {
+      }
+
+      /// \brief Registered type of this event
+      public: static const QEvent::Type kType;
+
+      /// \brief Configuration file to load
+      public: std::string config;
+    };
+
+    const QEvent::Type DaemonAttachEvent::kType =
+        static_cast<QEvent::Type>(QEvent::registerEventType());
+
+    /// \brief How long topic index scan results stay fresh, see
+    /// Application::RefreshTopicIndex
+    static const std::chrono::seconds kTopicIndexTtl{5};
+
+    /// \brief One periodic update callback registered with
+    /// Application::AddUpdateCallback
+    struct UpdateCallback
+    {
+      /// \brief Object the callback belongs to
+      QObject *owner{nullptr};
+
+      /// \brief Desired period between calls in ms
+      int intervalMs{0};
+
+      /// \brief The callback
+      std::function<void()> callback;
+
+      /// \brief Earliest tick the callback runs on, in steady clock ms
+      qint64 nextDueMs{0};
+    };
+
+    /// \brief A loaded plugin library
+    struct PluginLibrary
+    {
+      /// \brief Loader holding the library open, null if loading failed
+      std::shared_ptr<plugin::Loader> loader;
+
+      /// \brief Names of the plugins provided by the library
+      std::unordered_set<std::string> pluginNames;
+
+      /// \brief Full path the library was loaded from
+      std::string pathToLib;
+    };
+
     class ApplicationPrivate
     {
       /// \brief QML engine
       public: QQmlApplicationEngine *engine{nullptr};
 
-      /// \brief Pointer to main window
+      /// \brief Pointer to the main window which plugins and window
+      /// configuration currently target. This is the newest window, see
+      /// Application::AddWindow.
       public: MainWindow *mainWin{nullptr};
 
+      /// \brief All main windows hosted by this application, in creation
+      /// order.
+      public: std::vector<MainWindow *> mainWindows;
+
       /// \brief Vector of pointers to dialogs
       public: std::vector<Dialog *> dialogs;
 
       /// \brief Queue of plugins which should be added to the window
       public: std::queue<std::shared_ptr<Plugin>> pluginsToAdd;
 
+      /// \brief True while LoadConfig is instantiating plugins. Keeps
+      /// LoadPlugin from inserting each one into the window as it
+      /// loads; the whole queue is drained in one batch at the end of
+      /// the config load instead.
+      public: bool batchLoading{false};
+
       /// \brief Vector of pointers to plugins already added, we hang on to
       /// these until it is ok to unload the plugin's shared library.
       public: std::vector<std::shared_ptr<Plugin>> pluginsAdded;
@@ -67,6 +190,109 @@ namespace ignition
       /// \brief The path containing the default configuration file.
       public: std::string defaultConfigPath;
 
+      /// \brief Watches the loaded config file for edits, created the
+      /// first time a config loads successfully.
+      public: QFileSystemWatcher *configWatcher{nullptr};
+
+      /// \brief Debounces watcher events, since editors fire several
+      /// per save. Created together with the watcher.
+      public: QTimer *configReloadTimer{nullptr};
+
+      /// \brief Path currently being watched.
+      public: std::string watchedConfig;
+
+      /// \brief Loaded libraries keyed by the plugin filename they were
+      /// requested with, so repeat instantiations of the same plugin skip
+      /// the path search and dlopen and only construct the new plugin
+      /// object. Handles stay open for the application's lifetime.
+      public: std::map<std::string, PluginLibrary> libraryCache;
+
+      /// \brief Resolve a plugin filename and load its shared library.
+      /// This does no Qt work, so it's safe to call from worker threads.
+      /// \param[in] _filename Plugin library name.
+      /// \return The loaded library, with a null loader on failure.
+      public: PluginLibrary LoadLibrary(const std::string &_filename) const;
+
+      /// \brief Run a plugin in a child ign-gui process, forwarding its
+      /// configuration through a temporary file.
+      /// \param[in] _filename Plugin library name.
+      /// \param[in] _pluginElem Element containing configuration.
+      /// \return True if the child process started.
+      public: bool LoadExternalPlugin(const std::string &_filename,
+          const tinyxml2::XMLElement *_pluginElem);
+
+      /// \brief Processes hosting external plugins, terminated with the
+      /// application.
+      public: std::vector<QProcess *> externalPlugins;
+
+      /// \brief Configuration files handed to external plugins, deleted
+      /// with the application.
+      public: std::vector<QTemporaryFile *> externalConfigs;
+
+      /// \brief Transport node shared by all plugins, lazily created the
+      /// first time a plugin asks for it.
+      public: std::unique_ptr<transport::Node> transportNode;
+
+      /// \brief Latency metrics for subscriptions made through
+      /// Application::Subscribe, lazily created with the first one.
+      public: std::unique_ptr<SubscriptionStats> subscriptionStats;
+
+      /// \brief Topic name to message type of its first publisher, see
+      /// Application::TopicsOfType. Updated incrementally by the index
+      /// worker as its scan visits topics.
+      public: std::map<std::string, std::string> topicTypes;
+
+      /// \brief Protects topicTypes and topicIndexStamp
+      public: mutable std::mutex topicIndexMutex;
+
+      /// \brief When the last index scan finished. Refreshes requested
+      /// while the index is fresher than kTopicIndexTtl are skipped.
+      public: std::chrono::steady_clock::time_point topicIndexStamp;
+
+      /// \brief The running index scan, if any. As a member, its
+      /// destructor keeps the application alive until the scan is done.
+      public: std::future<void> topicIndexResult;
+
+      /// \brief Protects eventConsumers; events may be routed from
+      /// non-GUI threads such as the render thread.
+      public: std::mutex eventConsumersMutex;
+
+      /// \brief Event callbacks keyed by event type, see
+      /// Application::SubscribeToEvent.
+      public: std::map<int, std::vector<std::pair<QObject *,
+          std::function<void(QEvent *)>>>> eventConsumers;
+
+      /// \brief Shared timer all periodic update callbacks run on,
+      /// created with the first registration and stopped when the last
+      /// one is removed. Only touched on the GUI thread.
+      public: QTimer *updateTimer{nullptr};
+
+      /// \brief Period of the shared timer in ms
+      public: int updatePeriodMs{16};
+
+      /// \brief Registered update callbacks, see
+      /// Application::AddUpdateCallback. Only touched on the GUI
+      /// thread.
+      public: std::vector<UpdateCallback> updateCallbacks;
+
+      /// \brief Timed startup phases in completion order, with durations
+      /// in milliseconds.
+      public: std::vector<std::pair<std::string, double>> startupTimings;
+
+      /// \brief End of the last timed startup phase.
+      public: std::chrono::steady_clock::time_point startupMark =
+          std::chrono::steady_clock::now();
+
+      /// \brief True once the startup timing report has been printed.
+      public: bool startupReported{false};
+
+      /// \brief Record the time since the last mark as a startup phase.
+      /// \param[in] _name Phase description.
+      public: void MarkStartupPhase(const std::string &_name);
+
+      /// \brief Print the timing of all recorded startup phases.
+      public: void PrintStartupTiming();
+
       public: common::SignalHandler signalHandler;
 
       /// \brief QT message handler that pipes qt messages into our console
@@ -80,6 +306,45 @@ namespace ignition
 using namespace ignition;
 using namespace gui;
 
+/////////////////////////////////////////////////
+void ApplicationPrivate::MarkStartupPhase(const std::string &_name)
+{
+  const auto now = std::chrono::steady_clock::now();
+  this->startupTimings.push_back(std::make_pair(_name,
+      std::chrono::duration<double, std::milli>(
+      now - this->startupMark).count()));
+  this->startupMark = now;
+}
+
+/////////////////////////////////////////////////
+void ApplicationPrivate::PrintStartupTiming()
+{
+  if (this->startupReported)
+    return;
+  this->startupReported = true;
+
+  std::ostringstream report;
+  report << "Startup timing:" << std::endl;
+
+  auto total{0.0};
+  for (auto const &phase : this->startupTimings)
+  {
+    report << "  " << phase.first << ": "
+           << std::fixed << std::setprecision(1) << phase.second
+           << " ms" << std::endl;
+    total += phase.second;
+  }
+  report << "  Total: " << total << " ms";
+
+  ignmsg << report.str() << std::endl;
+}
+
+/////////////////////////////////////////////////
+void Application::SetStartupTimingEnabled(const bool _enabled)
+{
+  g_startupTimingEnabled = _enabled;
+}
+
 /////////////////////////////////////////////////
 Application::Application(int &_argc, char **_argv, const WindowType _type)
   : QApplication(_argc, _argv), dataPtr(new ApplicationPrivate)
@@ -91,6 +356,7 @@ Application::Application(int &_argc, char **_argv, const WindowType _type)
 
   // QML engine
   this->dataPtr->engine = new QQmlApplicationEngine();
+  this->dataPtr->MarkStartupPhase("QML engine creation");
 
   // Install signal handler for graceful shutdown
   this->dataPtr->signalHandler.AddCallback(
@@ -113,6 +379,7 @@ Application::Application(int &_argc, char **_argv, const WindowType _type)
   {
     if (!this->InitializeMainWindow())
       ignerr << "Failed to initialize main window." << std::endl;
+    this->dataPtr->MarkStartupPhase("Main window setup");
   }
   else if (_type == WindowType::kDialog)
   {
@@ -129,39 +396,100 @@ Application::~Application()
 {
   igndbg << "Terminating application." << std::endl;
 
-  if (this->dataPtr->mainWin && this->dataPtr->mainWin->QuickWindow())
+  // Covers applications which never went through LoadConfig, such as
+  // standalone dialogs
+  if (g_startupTimingEnabled)
+    this->dataPtr->PrintStartupTiming();
+
+  // Hide all windows right away, so the user doesn't watch teardown
+  for (auto win : this->dataPtr->mainWindows)
   {
-    // Detach object from main window and leave libraries for ign-common
-    auto plugins = this->dataPtr->mainWin->findChildren<Plugin *>();
-    for (auto plugin : plugins)
+    if (win && win->QuickWindow() && win->QuickWindow()->isVisible())
+      win->QuickWindow()->close();
+  }
+  for (auto dialog : this->dataPtr->dialogs)
+  {
+    if (dialog->QuickWindow())
+      dialog->QuickWindow()->hide();
+  }
+
+  // Take over the plugins and detach them from their windows, so
+  // deleting the windows below can't double-delete them
+  std::vector<std::shared_ptr<Plugin>> plugins;
+  plugins.swap(this->dataPtr->pluginsAdded);
+  while (!this->dataPtr->pluginsToAdd.empty())
+  {
+    plugins.push_back(this->dataPtr->pluginsToAdd.front());
+    this->dataPtr->pluginsToAdd.pop();
+  }
+  for (auto &plugin : plugins)
+    plugin->setParent(nullptr);
+
+  // Fan out the blocking part of teardown: each plugin's transport
+  // unsubscription is independent and can block for a while, so
+  // serializing them made shutdown linger for seconds. Only the non-Qt
+  // Shutdown work runs off-thread; the plugins are QObjects living on
+  // the GUI thread and must be destroyed here.
+  std::vector<std::thread> workers;
+  workers.reserve(plugins.size());
+  for (auto &plugin : plugins)
+  {
+    workers.push_back(std::thread([plugin = plugin.get()]()
     {
-      auto pluginName = plugin->CardItem()->objectName();
-      this->RemovePlugin(pluginName.toStdString());
-    }
-    if (this->dataPtr->mainWin->QuickWindow()->isVisible())
-      this->dataPtr->mainWin->QuickWindow()->close();
-    delete this->dataPtr->mainWin;
-    this->dataPtr->mainWin = nullptr;
+      plugin->Shutdown();
+    }));
   }
 
+  // All workers must be done before anything they may touch goes away
+  for (auto &worker : workers)
+    worker.join();
+
+  plugins.clear();
+
+  // Recycled cards belong to this application's QML engine; drop them
+  // before the engine goes, so a future application can't reuse them
+  Plugin::ClearCardPool();
+
+  // The newest window, which mainWin points at, is last in the vector,
+  // so it stays valid while earlier windows are deleted
+  for (auto win : this->dataPtr->mainWindows)
+  {
+    delete win;
+  }
+  this->dataPtr->mainWindows.clear();
+  this->dataPtr->mainWin = nullptr;
+
   for (auto dialog : this->dataPtr->dialogs)
   {
-    if (dialog->QuickWindow())
-      dialog->QuickWindow()->close();
     dialog->deleteLater();
   }
   this->dataPtr->dialogs.clear();
 
+  // Released dialogs left the list above for the reuse pool; they're
+  // backed by this application's engine, so they go down with it too
+  Dialog::ClearPool();
+
   if (this->dataPtr->engine)
   {
     this->dataPtr->engine->deleteLater();
   }
 
-  std::queue<std::shared_ptr<Plugin>> empty;
-  std::swap(this->dataPtr->pluginsToAdd, empty);
-  this->dataPtr->pluginsAdded.clear();
   this->dataPtr->pluginPaths.clear();
   this->dataPtr->pluginPathEnv = "IGN_GUI_PLUGIN_PATH";
+
+  // External plugins don't outlive the application
+  for (auto process : this->dataPtr->externalPlugins)
+  {
+    process->terminate();
+    if (!process->waitForFinished(3000))
+      process->kill();
+    delete process;
+  }
+  this->dataPtr->externalPlugins.clear();
+
+  for (auto configFile : this->dataPtr->externalConfigs)
+    delete configFile;
+  this->dataPtr->externalConfigs.clear();
 }
 
 /////////////////////////////////////////////////
@@ -170,6 +498,386 @@ QQmlApplicationEngine *Application::Engine() const
   return this->dataPtr->engine;
 }
 
+/////////////////////////////////////////////////
+transport::Node *Application::TransportNode()
+{
+  if (!this->dataPtr->transportNode)
+    this->dataPtr->transportNode.reset(new transport::Node());
+  return this->dataPtr->transportNode.get();
+}
+
+/////////////////////////////////////////////////
+SubscriptionStats *Application::SubscriptionMetrics()
+{
+  if (!this->dataPtr->subscriptionStats)
+  {
+    this->dataPtr->subscriptionStats.reset(new SubscriptionStats());
+
+    // The same numbers the TopicStats panel shows, queryable over
+    // transport so deployed consoles can be diagnosed remotely
+    std::function<bool(msgs::Param_V &)> cb =
+        [this](msgs::Param_V &_rep) -> bool
+    {
+      for (const auto &metrics :
+          this->dataPtr->subscriptionStats->AllMetrics())
+      {
+        auto param = _rep.add_param();
+        auto addString = [&param](const std::string &_key,
+            const std::string &_value)
+        {
+          msgs::Any value;
+          value.set_type(msgs::Any::STRING);
+          value.set_string_value(_value);
+          (*param->mutable_params())[_key] = value;
+        };
+        auto addDouble = [&param](const std::string &_key,
+            const double _value)
+        {
+          msgs::Any value;
+          value.set_type(msgs::Any::DOUBLE);
+          value.set_double_value(_value);
+          (*param->mutable_params())[_key] = value;
+        };
+        addString("topic", metrics->topic);
+        addString("label", metrics->label);
+        addDouble("count", static_cast<double>(
+            metrics->execution.Count()));
+        addDouble("exec_p50_ms", metrics->execution.PercentileMs(50.0));
+        addDouble("exec_p99_ms", metrics->execution.PercentileMs(99.0));
+        addDouble("exec_max_ms", metrics->execution.MaxMs());
+        addDouble("queue_p50_ms", metrics->queueDelay.PercentileMs(50.0));
+        addDouble("queue_p99_ms", metrics->queueDelay.PercentileMs(99.0));
+        addDouble("queue_max_ms", metrics->queueDelay.MaxMs());
+      }
+      return true;
+    };
+    if (!this->TransportNode()->Advertise("/gui/subscription_stats", cb))
+    {
+      ignwarn << "Failed to advertise [/gui/subscription_stats]"
+              << std::endl;
+    }
+  }
+  return this->dataPtr->subscriptionStats.get();
+}
+
+/////////////////////////////////////////////////
+void Application::ProbeQueueDelay(
+    const std::shared_ptr<SubscriptionStats::Metrics> &_metrics)
+{
+  if (_metrics->probePending.exchange(true))
+    return;
+
+  // postEvent is thread-safe, so the transport thread can launch the
+  // probe directly; event() on the GUI thread records its age
+  QCoreApplication::postEvent(this, new QueueDelayProbeEvent(_metrics));
+}
+
+/////////////////////////////////////////////////
+std::map<std::string, std::string> Application::TopicTypes() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->topicIndexMutex);
+  return this->dataPtr->topicTypes;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> Application::TopicsOfType(
+    const std::string &_msgType) const
+{
+  std::vector<std::string> topics;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->topicIndexMutex);
+  for (const auto &entry : this->dataPtr->topicTypes)
+  {
+    if (entry.second == _msgType)
+      topics.push_back(entry.first);
+  }
+
+  return topics;
+}
+
+/////////////////////////////////////////////////
+void Application::RefreshTopicIndex()
+{
+  // One scan at a time
+  if (this->dataPtr->topicIndexResult.valid() &&
+      this->dataPtr->topicIndexResult.wait_for(std::chrono::seconds(0)) !=
+      std::future_status::ready)
+  {
+    return;
+  }
+
+  // Recent results are good enough: the round trips are the expensive
+  // part of discovery, and their result rarely changes within the TTL
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->topicIndexMutex);
+    if (!this->dataPtr->topicTypes.empty() &&
+        std::chrono::steady_clock::now() - this->dataPtr->topicIndexStamp <
+        kTopicIndexTtl)
+    {
+      return;
+    }
+  }
+
+  this->dataPtr->topicIndexResult = std::async(std::launch::async, [this]()
+  {
+    // A local node, so the scan never races subscription changes on the
+    // shared one
+    transport::Node node;
+    std::vector<std::string> allTopics;
+    node.TopicList(allTopics);
+
+    for (const auto &topic : allTopics)
+    {
+      std::vector<transport::MessagePublisher> publishers;
+      node.TopicInfo(topic, publishers);
+      std::string type =
+          publishers.empty() ? "" : publishers.front().MsgTypeName();
+
+      // Update per topic, so queries issued during the scan already
+      // see the topics it has visited
+      std::lock_guard<std::mutex> lock(this->dataPtr->topicIndexMutex);
+      this->dataPtr->topicTypes[topic] = type;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->topicIndexMutex);
+
+      // Drop topics which are no longer advertised
+      for (auto it = this->dataPtr->topicTypes.begin();
+          it != this->dataPtr->topicTypes.end();)
+      {
+        if (std::find(allTopics.begin(), allTopics.end(), it->first) ==
+            allTopics.end())
+        {
+          it = this->dataPtr->topicTypes.erase(it);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+
+      this->dataPtr->topicIndexStamp = std::chrono::steady_clock::now();
+    }
+
+    // postEvent is thread-safe; event() routes the notification to
+    // subscribers on the GUI thread
+    QCoreApplication::postEvent(this, new events::TopicIndexUpdated());
+  });
+}
+
+/////////////////////////////////////////////////
+bool Application::event(QEvent *_event)
+{
+  if (_event->type() == QueueDelayProbeEvent::kType)
+  {
+    auto probe = static_cast<QueueDelayProbeEvent *>(_event);
+    probe->metrics->queueDelay.Record(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - probe->posted));
+    probe->metrics->probePending.store(false);
+    return true;
+  }
+  if (_event->type() == DaemonAttachEvent::kType)
+  {
+    auto attach = static_cast<DaemonAttachEvent *>(_event);
+    ignmsg << "Daemon attach request for [" << attach->config << "]"
+           << std::endl;
+    if (this->LoadConfig(attach->config))
+    {
+      auto win = this->findChild<MainWindow *>();
+      if (win && win->QuickWindow())
+      {
+        win->QuickWindow()->show();
+        win->QuickWindow()->raise();
+        win->QuickWindow()->requestActivate();
+      }
+    }
+    return true;
+  }
+  if (_event->type() == events::TopicIndexUpdated::kType)
+  {
+    // Posted by the index worker; route to subscribers from the GUI
+    // thread, like they expect
+    this->RouteEvent(_event);
+    return true;
+  }
+  return QApplication::event(_event);
+}
+
+/////////////////////////////////////////////////
+void Application::SubscribeToEvent(const QEvent::Type _type,
+    QObject *_consumer, const std::function<void(QEvent *)> &_callback)
+{
+  if (nullptr == _consumer)
+  {
+    ignerr << "Can't subscribe a null consumer to events." << std::endl;
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->eventConsumersMutex);
+    this->dataPtr->eventConsumers[_type].push_back(
+        std::make_pair(_consumer, _callback));
+  }
+
+  // Don't leave dangling callbacks behind
+  this->connect(_consumer, &QObject::destroyed, this,
+      [this, _type, _consumer]()
+      {
+        this->UnsubscribeFromEvent(_type, _consumer);
+      });
+}
+
+/////////////////////////////////////////////////
+void Application::UnsubscribeFromEvent(const QEvent::Type _type,
+    QObject *_consumer)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->eventConsumersMutex);
+
+  auto iter = this->dataPtr->eventConsumers.find(_type);
+  if (iter == this->dataPtr->eventConsumers.end())
+    return;
+
+  auto &consumers = iter->second;
+  consumers.erase(std::remove_if(consumers.begin(), consumers.end(),
+      [_consumer](const std::pair<QObject *,
+          std::function<void(QEvent *)>> &_entry)
+      {
+        return _entry.first == _consumer;
+      }), consumers.end());
+}
+
+/////////////////////////////////////////////////
+/// \brief Current steady clock time in ms, for update scheduling.
+/// \return Time in ms.
+static qint64 SteadyNowMs()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/////////////////////////////////////////////////
+void Application::AddUpdateCallback(QObject *_owner, const int _intervalMs,
+    const std::function<void()> &_cb)
+{
+  if (nullptr == _owner || !_cb)
+  {
+    ignerr << "Can't register a null update callback." << std::endl;
+    return;
+  }
+
+  this->RemoveUpdateCallback(_owner);
+
+  UpdateCallback entry;
+  entry.owner = _owner;
+  entry.intervalMs = std::max(_intervalMs, 1);
+  entry.callback = _cb;
+  // due on the next shared tick
+  entry.nextDueMs = SteadyNowMs();
+  this->dataPtr->updateCallbacks.push_back(std::move(entry));
+
+  // Don't leave dangling callbacks behind
+  this->connect(_owner, &QObject::destroyed, this,
+      [this, _owner]()
+      {
+        this->RemoveUpdateCallback(_owner);
+      });
+
+  if (nullptr == this->dataPtr->updateTimer)
+  {
+    this->dataPtr->updateTimer = new QTimer(this);
+    // a coarse timer lets the kernel merge this wakeup with others,
+    // which is the point of sharing it
+    this->dataPtr->updateTimer->setTimerType(Qt::CoarseTimer);
+    this->connect(this->dataPtr->updateTimer, &QTimer::timeout, this,
+        [this]()
+        {
+          const auto nowMs = SteadyNowMs();
+
+          // Collect first, so a callback registering or removing
+          // callbacks doesn't invalidate the iteration
+          std::vector<std::function<void()>> due;
+          for (auto &cb : this->dataPtr->updateCallbacks)
+          {
+            if (nowMs < cb.nextDueMs)
+              continue;
+            due.push_back(cb.callback);
+            cb.nextDueMs += cb.intervalMs;
+            // after a stall, skip the missed runs instead of bursting
+            if (cb.nextDueMs <= nowMs)
+              cb.nextDueMs = nowMs + cb.intervalMs;
+          }
+          for (const auto &cb : due)
+            cb();
+        });
+  }
+  if (!this->dataPtr->updateTimer->isActive())
+    this->dataPtr->updateTimer->start(this->dataPtr->updatePeriodMs);
+}
+
+/////////////////////////////////////////////////
+void Application::RemoveUpdateCallback(QObject *_owner)
+{
+  auto &callbacks = this->dataPtr->updateCallbacks;
+  callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+      [_owner](const UpdateCallback &_entry)
+      {
+        return _entry.owner == _owner;
+      }), callbacks.end());
+
+  // no registrations, no wakeups
+  if (callbacks.empty() && nullptr != this->dataPtr->updateTimer)
+    this->dataPtr->updateTimer->stop();
+}
+
+/////////////////////////////////////////////////
+void Application::SetUpdatePeriod(const int _ms)
+{
+  if (_ms <= 0)
+  {
+    ignwarn << "Ignoring update period [" << _ms << "], must be positive."
+            << std::endl;
+    return;
+  }
+
+  this->dataPtr->updatePeriodMs = _ms;
+  if (nullptr != this->dataPtr->updateTimer &&
+      this->dataPtr->updateTimer->isActive())
+  {
+    this->dataPtr->updateTimer->start(_ms);
+  }
+}
+
+/////////////////////////////////////////////////
+void Application::RouteEvent(QEvent *_event)
+{
+  // Copy the call list so a callback can't deadlock by subscribing
+  std::vector<std::function<void(QEvent *)>> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->eventConsumersMutex);
+    auto iter = this->dataPtr->eventConsumers.find(_event->type());
+    if (iter != this->dataPtr->eventConsumers.end())
+    {
+      for (auto const &consumer : iter->second)
+        callbacks.push_back(consumer.second);
+    }
+  }
+
+  if (callbacks.empty())
+  {
+    // No registered consumers: keep the broadcast path for consumers
+    // which filter events on the main window
+    auto win = this->findChild<MainWindow *>();
+    if (win)
+      this->sendEvent(win, _event);
+    return;
+  }
+
+  for (auto const &callback : callbacks)
+    callback(_event);
+}
+
 /////////////////////////////////////////////////
 Application *ignition::gui::App()
 {
@@ -188,16 +896,35 @@ bool Application::RemovePlugin(const std::string &_pluginName)
 
     if (cardItem->objectName().toStdString() == _pluginName)
     {
-      // Remove on QML
-      cardItem->deleteLater();
+      auto splitName = cardItem->parentItem() ?
+          cardItem->parentItem()->objectName() : QString();
+      auto quickWindow = cardItem->window();
+
+      // Pool the card chrome for the next plugin added; it's only
+      // destroyed when the pool is full
+      if (!plugin->ReleaseCard())
+        cardItem->deleteLater();
+
+      // Likewise pool the standalone dialog, if the card was on one, so
+      // reopening it is a visibility toggle
+      auto dialogIt = std::find_if(this->dataPtr->dialogs.begin(),
+          this->dataPtr->dialogs.end(), [quickWindow](Dialog *_dialog)
+          {
+            return _dialog->QuickWindow() == quickWindow;
+          });
+      if (dialogIt != this->dataPtr->dialogs.end())
+      {
+        Dialog::Release(*dialogIt);
+        this->dataPtr->dialogs.erase(dialogIt);
+      }
 
-      // Remove split on QML
-      auto bgItem = this->dataPtr->mainWin->QuickWindow()
-          ->findChild<QQuickItem *>("background");
-      if (bgItem)
+      // Remove split on QML, on whichever window the card was on
+      auto bgItem = quickWindow ?
+          quickWindow->findChild<QQuickItem *>("background") : nullptr;
+      if (bgItem && !splitName.isEmpty())
       {
         QMetaObject::invokeMethod(bgItem, "removeSplitItem",
-            Q_ARG(QVariant, cardItem->parentItem()->objectName()));
+            Q_ARG(QVariant, splitName));
       }
 
       // Unload shared library
@@ -220,6 +947,10 @@ bool Application::LoadConfig(const std::string &_config)
     return false;
   }
 
+  // Don't attribute idle time between construction and loading to the
+  // first config phase
+  this->dataPtr->startupMark = std::chrono::steady_clock::now();
+
   // Use tinyxml to read config
   tinyxml2::XMLDocument doc;
   auto success = !doc.LoadFile(_config.c_str());
@@ -239,53 +970,334 @@ bool Application::LoadConfig(const std::string &_config)
 
   ignmsg << "Loading config [" << _config << "]" << std::endl;
 
-  // Clear all previous plugins
+  // Gather the requested plugins and the configuration string of each,
+  // printed the same way Plugin::Load stores it
+  std::vector<const tinyxml2::XMLElement *> pluginElems;
+  std::vector<std::string> pluginStrs;
+  for (auto pluginElem = doc.FirstChildElement("plugin"); pluginElem != nullptr;
+      pluginElem = pluginElem->NextSiblingElement("plugin"))
+  {
+    pluginElems.push_back(pluginElem);
+
+    tinyxml2::XMLPrinter printer;
+    pluginElem->Accept(&printer);
+    pluginStrs.push_back(std::string(printer.CStr()));
+  }
+
+  std::map<std::string, int> requested;
+  for (auto const &pluginStr : pluginStrs)
+    ++requested[pluginStr];
+
+  // Keep already-loaded plugins whose configuration is unchanged and
+  // clear the rest, so switching between similar layouts only reloads
+  // the plugins which actually differ
+  auto reusable = requested;
+  std::size_t reused{0};
   auto plugins = this->dataPtr->mainWin->findChildren<Plugin *>();
   for (auto plugin : plugins)
   {
+    auto iter = reusable.find(plugin->OriginalConfigStr());
+    if (iter != reusable.end() && iter->second > 0)
+    {
+      --iter->second;
+      ++reused;
+      continue;
+    }
+
     auto pluginName = plugin->CardItem()->objectName();
     this->RemovePlugin(pluginName.toStdString());
   }
-  if (this->dataPtr->pluginsAdded.size() > 0)
+  if (this->dataPtr->pluginsAdded.size() != reused)
   {
     ignerr << "The plugin list was not properly cleaned up." << std::endl;
   }
-  this->dataPtr->pluginsAdded.clear();
 
-  // Process each plugin
-  for (auto pluginElem = doc.FirstChildElement("plugin"); pluginElem != nullptr;
-      pluginElem = pluginElem->NextSiblingElement("plugin"))
+  // Mark the requests covered by a reused instance; reusable now holds
+  // the number of fresh loads each configuration still needs
+  std::vector<bool> skipElem(pluginElems.size(), false);
   {
-    auto filename = pluginElem->Attribute("filename");
-    this->LoadPlugin(filename, pluginElem);
+    std::map<std::string, int> skipRemaining;
+    for (auto const &entry : requested)
+      skipRemaining[entry.first] = entry.second - reusable[entry.first];
+    for (std::size_t i = 0; i < pluginElems.size(); ++i)
+    {
+      auto &skip = skipRemaining[pluginStrs[i]];
+      if (skip > 0)
+      {
+        --skip;
+        skipElem[i] = true;
+      }
+    }
   }
 
-  // Process window properties
-  if (auto winElem = doc.FirstChildElement("window"))
+  // Resolve and load every plugin's library in parallel; this phase is
+  // I/O bound and does no Qt work. Instantiation below stays serial on
+  // the GUI thread.
+  std::vector<std::future<std::pair<std::string, PluginLibrary>>> libraries;
+  std::unordered_set<std::string> launched;
+  for (std::size_t i = 0; i < pluginElems.size(); ++i)
   {
-    igndbg << "Loading window config" << std::endl;
+    if (skipElem[i])
+      continue;
 
-    tinyxml2::XMLPrinter printer;
-    if (!winElem->Accept(&printer))
+    std::string filename = pluginElems[i]->Attribute("filename");
+
+    // Skip filenames already cached or already being loaded
+    if (this->dataPtr->libraryCache.find(filename) !=
+        this->dataPtr->libraryCache.end() || !launched.insert(filename).second)
     {
-      ignwarn << "There was an error parsing the <window> element"
-              << std::endl;
-      return false;
+      continue;
+    }
+
+    libraries.push_back(std::async(std::launch::async,
+        [this, filename]()
+        {
+          return std::make_pair(filename,
+              this->dataPtr->LoadLibrary(filename));
+        }));
+  }
+
+  this->dataPtr->MarkStartupPhase("Config parse [" + _config + "]");
+
+  for (auto &library : libraries)
+  {
+    auto result = library.get();
+    if (result.second.loader)
+      this->dataPtr->libraryCache[result.first] = result.second;
+  }
+  this->dataPtr->MarkStartupPhase("Plugin library loading");
+
+  // Process each plugin which isn't covered by a reused instance. They
+  // are only queued here; inserting a plugin into the window relays out
+  // every existing card, so the batch below pays that once rather than
+  // once per plugin.
+  this->dataPtr->batchLoading = true;
+  for (std::size_t i = 0; i < pluginElems.size(); ++i)
+  {
+    if (skipElem[i])
+      continue;
+
+    auto filename = pluginElems[i]->Attribute("filename");
+    this->LoadPlugin(filename, pluginElems[i]);
+    this->dataPtr->MarkStartupPhase("Load plugin [" +
+        std::string(filename) + "]");
+  }
+  this->dataPtr->batchLoading = false;
+
+  if (this->dataPtr->mainWin)
+  {
+    this->AddPluginsToWindow();
+    this->dataPtr->MarkStartupPhase("Plugin window insertion");
+  }
+
+  // Process window properties. Steady-state launches restore the parsed
+  // window configuration from a binary sidecar cache, skipping the XML
+  // printing and string conversion; the cache is keyed by the config
+  // file's modification time.
+  const auto sidecarPath = _config + ".wincache";
+  const auto configMTime = PathMTime(_config);
+  auto windowCached{false};
+  if (configMTime >= 0)
+  {
+    QFile sidecar(QString::fromStdString(sidecarPath));
+    if (sidecar.open(QIODevice::ReadOnly))
+    {
+      QDataStream stream(&sidecar);
+      qint64 cachedMTime;
+      QByteArray buffer;
+      stream >> cachedMTime >> buffer;
+      if (stream.status() == QDataStream::Ok &&
+          cachedMTime == configMTime &&
+          this->dataPtr->windowConfig.FromBinary(buffer))
+      {
+        igndbg << "Loading window config from cache" << std::endl;
+        windowCached = true;
+      }
+    }
+  }
+
+  if (!windowCached)
+  {
+    if (auto winElem = doc.FirstChildElement("window"))
+    {
+      igndbg << "Loading window config" << std::endl;
+
+      tinyxml2::XMLPrinter printer;
+      if (!winElem->Accept(&printer))
+      {
+        ignwarn << "There was an error parsing the <window> element"
+                << std::endl;
+        return false;
+      }
+      this->dataPtr->windowConfig.MergeFromXML(std::string(printer.CStr()));
+    }
+
+    // Refresh the sidecar for the next launch
+    if (configMTime >= 0)
+    {
+      QFile sidecar(QString::fromStdString(sidecarPath));
+      if (sidecar.open(QIODevice::WriteOnly))
+      {
+        QDataStream stream(&sidecar);
+        stream << qint64(configMTime)
+               << this->dataPtr->windowConfig.ToBinary();
+      }
     }
-    this->dataPtr->windowConfig.MergeFromXML(std::string(printer.CStr()));
   }
 
   this->ApplyConfig();
+  this->dataPtr->MarkStartupPhase("Window config");
+
+  if (g_startupTimingEnabled)
+    this->dataPtr->PrintStartupTiming();
+
+  // Hot-reload further edits to this file
+  this->WatchConfigFile(_config);
 
   return true;
 }
 
+/////////////////////////////////////////////////
+void Application::WatchConfigFile(const std::string &_path)
+{
+  if (!this->dataPtr->configWatcher)
+  {
+    this->dataPtr->configWatcher = new QFileSystemWatcher(this);
+    this->connect(this->dataPtr->configWatcher,
+        SIGNAL(fileChanged(QString)), this, SLOT(OnConfigFileChanged()));
+
+    this->dataPtr->configReloadTimer = new QTimer(this);
+    this->dataPtr->configReloadTimer->setSingleShot(true);
+    this->dataPtr->configReloadTimer->setInterval(100);
+    this->connect(this->dataPtr->configReloadTimer, &QTimer::timeout,
+        [this]()
+        {
+          auto path = this->dataPtr->watchedConfig;
+          ignmsg << "Config [" << path << "] changed, reloading"
+                 << std::endl;
+
+          // A successful load re-arms the watch; put it back ourselves
+          // if the file is mid-save and fails to parse
+          if (!this->LoadConfig(path))
+          {
+            this->dataPtr->configWatcher->addPath(
+                QString::fromStdString(path));
+          }
+        });
+  }
+
+  if (!this->dataPtr->watchedConfig.empty() &&
+      this->dataPtr->watchedConfig != _path)
+  {
+    this->dataPtr->configWatcher->removePath(
+        QString::fromStdString(this->dataPtr->watchedConfig));
+  }
+
+  this->dataPtr->watchedConfig = _path;
+
+  // Re-adding is required even for the same path: editors which save by
+  // renaming a temporary over the file drop the kernel watch
+  this->dataPtr->configWatcher->addPath(QString::fromStdString(_path));
+}
+
+/////////////////////////////////////////////////
+void Application::OnConfigFileChanged()
+{
+  // Editors fire several events per save; reload once they settle
+  this->dataPtr->configReloadTimer->start();
+}
+
 /////////////////////////////////////////////////
 bool Application::LoadDefaultConfig()
 {
   return this->LoadConfig(this->dataPtr->defaultConfigPath);
 }
 
+/////////////////////////////////////////////////
+void Application::LoadConfigAfterFirstFrame(const std::string &_config)
+{
+  auto win = this->dataPtr->mainWin;
+  if (nullptr == win || nullptr == win->QuickWindow())
+  {
+    // Nothing to stage against
+    if (!this->LoadConfig(_config))
+      QTimer::singleShot(0, []() { QCoreApplication::exit(-1); });
+    return;
+  }
+
+  // frameSwapped is emitted from the render thread; giving the
+  // connection a context on the GUI thread makes Qt queue the call back
+  // onto it. The connection removes itself so only the first frame
+  // triggers the load.
+  auto connection = std::make_shared<QMetaObject::Connection>();
+  *connection = this->connect(win->QuickWindow(), &QQuickWindow::frameSwapped,
+      this, [this, _config, connection]()
+      {
+        this->disconnect(*connection);
+
+        if (!this->LoadConfig(_config))
+          this->exit(-1);
+      });
+}
+
+/////////////////////////////////////////////////
+bool Application::StartDaemon()
+{
+  auto win = this->findChild<MainWindow *>();
+  if (nullptr == win || nullptr == win->QuickWindow())
+  {
+    ignerr << "Daemon mode needs a main window." << std::endl;
+    return false;
+  }
+
+  // The expensive startup work — Qt, the QML engine, the window and
+  // transport discovery — is done by now. Keep it all warm: closing the
+  // window only hides it, and the next attach maps it again.
+  this->setQuitOnLastWindowClosed(false);
+  win->QuickWindow()->hide();
+
+  std::function<bool(const msgs::StringMsg &, msgs::Boolean &)> cb =
+      [](const msgs::StringMsg &_req, msgs::Boolean &_rep)
+      {
+        // service callbacks run on a transport thread; postEvent is
+        // thread-safe and event() loads the config on the GUI thread
+        QCoreApplication::postEvent(App(),
+            new DaemonAttachEvent(_req.data()));
+        _rep.set_data(true);
+        return true;
+      };
+  if (!this->TransportNode()->Advertise("/gui/daemon", cb))
+  {
+    ignerr << "Failed to advertise [/gui/daemon]. Is another daemon "
+           << "running?" << std::endl;
+    return false;
+  }
+
+  ignmsg << "Daemon ready, waiting for [ign gui -c <file>] to attach."
+         << std::endl;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool Application::RequestDaemonAttach(const std::string &_config,
+    const unsigned int _timeoutMs)
+{
+  // the daemon's working directory isn't the caller's
+  auto config = _config;
+  if (!config.empty() && !common::isFile(config))
+    return false;
+  config = common::absPath(config);
+
+  transport::Node node;
+  msgs::StringMsg req;
+  req.set_data(config);
+  msgs::Boolean rep;
+  bool result{false};
+  const auto executed = node.Request("/gui/daemon", req, _timeoutMs, rep,
+      result);
+  return executed && result && rep.data();
+}
+
 /////////////////////////////////////////////////
 void Application::SetDefaultConfigPath(const std::string &_path)
 {
@@ -299,15 +1311,15 @@ std::string Application::DefaultConfigPath()
 }
 
 /////////////////////////////////////////////////
-bool Application::LoadPlugin(const std::string &_filename,
-    const tinyxml2::XMLElement *_pluginElem)
+PluginLibrary ApplicationPrivate::LoadLibrary(
+    const std::string &_filename) const
 {
-  igndbg << "Loading plugin [" << _filename << "]" << std::endl;
+  PluginLibrary library;
 
   common::SystemPaths systemPaths;
-  systemPaths.SetPluginPathEnv(this->dataPtr->pluginPathEnv);
+  systemPaths.SetPluginPathEnv(this->pluginPathEnv);
 
-  for (const auto &path : this->dataPtr->pluginPaths)
+  for (const auto &path : this->pluginPaths)
     systemPaths.AddPluginPaths(path);
 
   // Add default folder and install folder
@@ -316,33 +1328,134 @@ bool Application::LoadPlugin(const std::string &_filename,
   systemPaths.AddPluginPaths(home + "/.ignition/gui/plugins:" +
                              IGN_GUI_PLUGIN_INSTALL_DIR);
 
-  auto pathToLib = systemPaths.FindSharedLibrary(_filename);
-  if (pathToLib.empty())
+  library.pathToLib = systemPaths.FindSharedLibrary(_filename);
+  if (library.pathToLib.empty())
   {
     ignerr << "Failed to load plugin [" << _filename <<
               "] : couldn't find shared library." << std::endl;
-    return false;
+    return library;
   }
 
   // Load plugin
-  plugin::Loader pluginLoader;
+  library.loader = std::make_shared<plugin::Loader>();
 
-  auto pluginNames = pluginLoader.LoadLib(pathToLib);
-  if (pluginNames.empty())
+  library.pluginNames = library.loader->LoadLib(library.pathToLib);
+  if (library.pluginNames.empty())
   {
     ignerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't load library on path [" << pathToLib <<
+              "] : couldn't load library on path [" << library.pathToLib <<
               "]." << std::endl;
+    library.loader.reset();
+    return library;
+  }
+
+  return library;
+}
+
+/////////////////////////////////////////////////
+bool ApplicationPrivate::LoadExternalPlugin(const std::string &_filename,
+    const tinyxml2::XMLElement *_pluginElem)
+{
+  // Reprint the element without the external attribute, so the child
+  // doesn't try to spawn a grandchild
+  tinyxml2::XMLPrinter printer;
+  _pluginElem->Accept(&printer);
+
+  tinyxml2::XMLDocument doc;
+  doc.Parse(printer.CStr());
+  auto pluginElem = doc.FirstChildElement("plugin");
+  if (nullptr == pluginElem)
+  {
+    ignerr << "Failed to process config for external plugin [" << _filename
+           << "]" << std::endl;
+    return false;
+  }
+  pluginElem->DeleteAttribute("external");
+
+  tinyxml2::XMLPrinter cleanPrinter;
+  doc.Print(&cleanPrinter);
+
+  // Forward the configuration through a temporary file the child loads
+  auto configFile = new QTemporaryFile(QDir::tempPath() +
+      "/ign-gui-external-XXXXXX.config");
+  if (!configFile->open())
+  {
+    ignerr << "Failed to write config for external plugin [" << _filename
+           << "]" << std::endl;
+    delete configFile;
+    return false;
+  }
+  configFile->write(cleanPrinter.CStr());
+  configFile->flush();
+
+  auto process = new QProcess;
+  process->setProgram("ign");
+  process->setArguments({"gui", "-c", configFile->fileName()});
+  process->start();
+  if (!process->waitForStarted(3000))
+  {
+    ignerr << "Failed to start external process for plugin [" << _filename
+           << "]. Is ignition-tools installed?" << std::endl;
+    delete process;
+    delete configFile;
     return false;
   }
 
+  this->externalPlugins.push_back(process);
+  this->externalConfigs.push_back(configFile);
+
+  ignmsg << "Running plugin [" << _filename << "] in external process ["
+         << process->processId() << "]" << std::endl;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool Application::LoadPlugin(const std::string &_filename,
+    const tinyxml2::XMLElement *_pluginElem)
+{
+  IGN_PROFILE("Application::LoadPlugin");
+
+  igndbg << "Loading plugin [" << _filename << "]" << std::endl;
+
+  // Out-of-process hosting for heavy or crash-prone plugins: the plugin
+  // runs in a child ign-gui process with its own window, giving crash
+  // isolation and a core of its own. Qt offers no portable way to
+  // composite a child process' framebuffer into this window, so the
+  // child is a separate top-level window rather than a card.
+  if (nullptr != _pluginElem)
+  {
+    auto external = false;
+    _pluginElem->QueryBoolAttribute("external", &external);
+    if (external)
+      return this->dataPtr->LoadExternalPlugin(_filename, _pluginElem);
+  }
+
+  // Serve the library from the cache when this filename has been loaded
+  // before, whether by LoadConfig's parallel phase or an earlier call
+  PluginLibrary library;
+  auto cached = this->dataPtr->libraryCache.find(_filename);
+  if (cached != this->dataPtr->libraryCache.end())
+  {
+    library = cached->second;
+  }
+  else
+  {
+    library = this->dataPtr->LoadLibrary(_filename);
+    if (library.loader)
+      this->dataPtr->libraryCache[_filename] = library;
+  }
+
+  if (!library.loader)
+    return false;
+
   // Go over all plugin names and get the first one that implements the
   // ignition::gui::Plugin interface
   plugin::PluginPtr commonPlugin;
   std::shared_ptr<gui::Plugin> plugin{nullptr};
-  for (auto pluginName : pluginNames)
+  for (auto pluginName : library.pluginNames)
   {
-    commonPlugin = pluginLoader.Instantiate(pluginName);
+    commonPlugin = library.loader->Instantiate(pluginName);
     if (!commonPlugin)
       continue;
 
@@ -354,10 +1467,10 @@ bool Application::LoadPlugin(const std::string &_filename,
   if (!commonPlugin)
   {
     ignerr << "Failed to load plugin [" << _filename <<
-              "] : couldn't instantiate plugin on path [" << pathToLib <<
-              "]. Tried plugin names: " << std::endl;
+              "] : couldn't instantiate plugin on path [" <<
+              library.pathToLib << "]. Tried plugin names: " << std::endl;
 
-    for (auto pluginName : pluginNames)
+    for (auto pluginName : library.pluginNames)
     {
       ignerr << " * " << pluginName << std::endl;
     }
@@ -388,15 +1501,19 @@ bool Application::LoadPlugin(const std::string &_filename,
   // Store plugin in queue to be added to the window
   this->dataPtr->pluginsToAdd.push(plugin);
 
-  // Add to window or dialog
+  // Add to window or dialog. During a config load the queue is drained
+  // in one batch at the end instead, see LoadConfig.
   if (this->dataPtr->mainWin)
-    this->AddPluginsToWindow();
+  {
+    if (!this->dataPtr->batchLoading)
+      this->AddPluginsToWindow();
+  }
   else
     this->InitializeDialogs();
 
   this->PluginAdded(plugin->objectName());
-  ignmsg << "Loaded plugin [" << _filename << "] from path [" << pathToLib
-         << "]" << std::endl;
+  ignmsg << "Loaded plugin [" << _filename << "] from path ["
+         << library.pathToLib << "]" << std::endl;
 
   return true;
 }
@@ -411,10 +1528,33 @@ bool Application::InitializeMainWindow()
     return false;
 
   this->dataPtr->mainWin->setParent(this);
+  this->dataPtr->mainWindows.push_back(this->dataPtr->mainWin);
 
   return true;
 }
 
+/////////////////////////////////////////////////
+MainWindow *Application::AddWindow()
+{
+  igndbg << "Create additional main window" << std::endl;
+
+  auto win = new MainWindow();
+  if (!win->QuickWindow())
+  {
+    delete win;
+    return nullptr;
+  }
+
+  win->setParent(this);
+  this->dataPtr->mainWindows.push_back(win);
+
+  // Plugins and window configuration loaded from here on target the new
+  // window
+  this->dataPtr->mainWin = win;
+
+  return win;
+}
+
 /////////////////////////////////////////////////
 bool Application::ApplyConfig()
 {
@@ -441,6 +1581,14 @@ bool Application::AddPluginsToWindow()
     return false;
   }
 
+  // With several plugins queued, keep the background hidden while
+  // inserting: the split view still tracks each addition, but none of
+  // the intermediate layout passes reaches the screen, and showing the
+  // background again costs the one final relayout.
+  const bool batch = this->dataPtr->pluginsToAdd.size() > 1u;
+  if (batch)
+    bgItem->setVisible(false);
+
   // Create a widget for each plugin
   while (!this->dataPtr->pluginsToAdd.empty())
   {
@@ -470,6 +1618,8 @@ bool Application::AddPluginsToWindow()
     {
       ignerr << "Internal error: failed to create split ["
              << splitName.toString().toStdString() << "]" << std::endl;
+      if (batch)
+        bgItem->setVisible(true);
       return false;
     }
 
@@ -489,6 +1639,9 @@ bool Application::AddPluginsToWindow()
         std::endl;
   }
 
+  if (batch)
+    bgItem->setVisible(true);
+
   this->dataPtr->mainWin->SetPluginCount(this->dataPtr->pluginsAdded.size());
 
   return true;
@@ -509,8 +1662,8 @@ bool Application::InitializeDialogs()
     if (!cardItem)
       continue;
 
-    // Create dialog
-    auto dialog = new Dialog();
+    // Get a dialog, reusing a pooled one when available
+    auto dialog = Dialog::Acquire();
     if (!dialog || !dialog->QuickWindow())
       continue;
 
@@ -555,15 +1708,43 @@ void Application::AddPluginPath(const std::string &_path)
   this->dataPtr->pluginPaths.push_back(_path);
 }
 
+/////////////////////////////////////////////////
+static int64_t PathMTime(const std::string &_path)
+{
+  struct stat st;
+  if (stat(_path.c_str(), &st) != 0)
+    return -1;
+  return static_cast<int64_t>(st.st_mtime);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the path of the on-disk plugin manifest cache.
+/// \return Full path to the cache file.
+static std::string ManifestPath()
+{
+  std::string home;
+  common::env(IGN_HOMEDIR, home);
+  return common::joinPaths(home, ".ignition", "gui",
+      "plugin_manifest.cache");
+}
+
 /////////////////////////////////////////////////
 std::vector<std::pair<std::string, std::vector<std::string>>>
     Application::PluginList()
+{
+  return ListPlugins(this->dataPtr->pluginPathEnv, this->dataPtr->pluginPaths);
+}
+
+/////////////////////////////////////////////////
+std::vector<std::pair<std::string, std::vector<std::string>>>
+    Application::ListPlugins(const std::string &_pluginPathEnv,
+    const std::vector<std::string> &_pluginPaths)
 {
   // 1. Paths from env variable
-  auto paths = common::SystemPaths::PathsFromEnv(this->dataPtr->pluginPathEnv);
+  auto paths = common::SystemPaths::PathsFromEnv(_pluginPathEnv);
 
   // 2. Paths added by calling addPluginPath
-  for (auto const &path : this->dataPtr->pluginPaths)
+  for (auto const &path : _pluginPaths)
     paths.push_back(path);
 
   // 3. ~/.ignition/gui/plugins
@@ -574,13 +1755,64 @@ std::vector<std::pair<std::string, std::vector<std::string>>>
   // 4. Install path
   paths.push_back(IGN_GUI_PLUGIN_INSTALL_DIR);
 
+  // Load the manifest cache, which holds each directory's listing keyed by
+  // its modification time. Directories which haven't changed are served
+  // from this single small file read instead of a full walk, which is
+  // slow on network file systems. One line per directory:
+  // mtime <tab> path <tab> plugin <tab> plugin ...
+  std::map<std::string, std::pair<int64_t, std::vector<std::string>>>
+      manifest;
+  {
+    std::ifstream manifestFile(ManifestPath());
+    std::string line;
+    while (std::getline(manifestFile, line))
+    {
+      std::istringstream fields(line);
+      std::string mtimeStr;
+      std::string path;
+      if (!std::getline(fields, mtimeStr, '\t') ||
+          !std::getline(fields, path, '\t'))
+      {
+        continue;
+      }
+
+      auto &entry = manifest[path];
+      try
+      {
+        entry.first = std::stoll(mtimeStr);
+      }
+      catch (const std::exception &)
+      {
+        manifest.erase(path);
+        continue;
+      }
+
+      std::string plugin;
+      while (std::getline(fields, plugin, '\t'))
+        entry.second.push_back(plugin);
+    }
+  }
+
   // Populate map
   std::vector<std::pair<std::string, std::vector<std::string>>> plugins;
 
+  auto manifestDirty{false};
   for (auto const &path : paths)
   {
     std::vector<std::string> ps;
 
+    // Lazy revalidation: only walk directories whose modification time
+    // doesn't match the cached entry
+    const auto mtime = PathMTime(path);
+    auto entry = manifest.find(path);
+    if (entry != manifest.end() && mtime >= 0 &&
+        entry->second.first == mtime)
+    {
+      ps = entry->second.second;
+      plugins.push_back(std::make_pair(path, ps));
+      continue;
+    }
+
     common::DirIter endIter;
     for (common::DirIter dirIter(path);
         dirIter != endIter; ++dirIter)
@@ -594,9 +1826,32 @@ std::vector<std::pair<std::string, std::vector<std::string>>>
         ps.push_back(plugin);
     }
 
+    if (mtime >= 0)
+    {
+      manifest[path] = std::make_pair(mtime, ps);
+      manifestDirty = true;
+    }
+
     plugins.push_back(std::make_pair(path, ps));
   }
 
+  // Rewrite the cache if any directory was rescanned
+  if (manifestDirty)
+  {
+    std::string home;
+    common::env(IGN_HOMEDIR, home);
+    common::createDirectories(common::joinPaths(home, ".ignition", "gui"));
+
+    std::ofstream manifestFile(ManifestPath());
+    for (auto const &entry : manifest)
+    {
+      manifestFile << entry.second.first << '\t' << entry.first;
+      for (auto const &plugin : entry.second.second)
+        manifestFile << '\t' << plugin;
+      manifestFile << std::endl;
+    }
+  }
+
   return plugins;
 }
 
@@ -18,10 +18,13 @@
 #include <stdlib.h>
 #include <gtest/gtest.h>
 #include <ignition/common/Console.hh>
+#include <ignition/msgs/stringmsg.pb.h>
+#include <ignition/transport/Node.hh>
 
 #include "test_config.h"  // NOLINT(build/include)
 #include "ignition/gui/Application.hh"
 #include "ignition/gui/Dialog.hh"
+#include "ignition/gui/GuiEvents.hh"
 #include "ignition/gui/MainWindow.hh"
 #include "ignition/gui/Plugin.hh"
 
@@ -329,3 +332,106 @@ TEST(ApplicationTest, messageHandler)
   qCritical("This came from qCritical");
 }
 
+
+/////////////////////////////////////////////////
+TEST(ApplicationTest, UpdateCallbacks)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+
+  // Invalid registrations
+  app.AddUpdateCallback(nullptr, 100, [] {});
+  app.AddUpdateCallback(&app, 100, nullptr);
+
+  // Callback fires repeatedly at its interval
+  int count = 0;
+  app.AddUpdateCallback(&app, 50, [&count]
+  {
+    ++count;
+  });
+
+  QTimer::singleShot(300, &app, [&app]
+  {
+    app.quit();
+  });
+  app.exec();
+  EXPECT_GT(count, 1);
+
+  // Re-registering the same owner replaces the previous callback
+  int replaced = 0;
+  app.AddUpdateCallback(&app, 50, [&count]
+  {
+    ++count;
+  });
+  app.AddUpdateCallback(&app, 50, [&replaced]
+  {
+    ++replaced;
+  });
+
+  auto countBefore = count;
+  QTimer::singleShot(300, &app, [&app]
+  {
+    app.quit();
+  });
+  app.exec();
+  EXPECT_EQ(countBefore, count);
+  EXPECT_GT(replaced, 1);
+
+  // Removal stops the callback
+  app.RemoveUpdateCallback(&app);
+  auto replacedBefore = replaced;
+  QTimer::singleShot(300, &app, [&app]
+  {
+    app.quit();
+  });
+  app.exec();
+  EXPECT_EQ(replacedBefore, replaced);
+}
+
+//////////////////////////////////////////////////
+TEST(ApplicationTest, TopicIndex)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+
+  // Empty before any scan
+  EXPECT_TRUE(app.TopicTypes().empty());
+  EXPECT_TRUE(app.TopicsOfType("ignition.msgs.StringMsg").empty());
+
+  // Advertise a topic
+  transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/topic_index_test");
+  EXPECT_TRUE(pub);
+
+  // Scan completion is announced on the GUI thread
+  bool updated = false;
+  app.SubscribeToEvent(events::TopicIndexUpdated::kType, &app,
+      [&app, &updated](QEvent *)
+      {
+        updated = true;
+        app.quit();
+      });
+
+  app.RefreshTopicIndex();
+
+  // In case the event never comes
+  QTimer::singleShot(3000, &app, [&app]
+  {
+    app.quit();
+  });
+  app.exec();
+  EXPECT_TRUE(updated);
+
+  // The topic is served from the index
+  auto topics = app.TopicsOfType("ignition.msgs.StringMsg");
+  ASSERT_EQ(1u, topics.size());
+  EXPECT_EQ("/topic_index_test", topics[0]);
+
+  auto types = app.TopicTypes();
+  ASSERT_NE(types.end(), types.find("/topic_index_test"));
+  EXPECT_EQ("ignition.msgs.StringMsg", types["/topic_index_test"]);
+
+  EXPECT_TRUE(app.TopicsOfType("ignition.msgs.Image").empty());
+}
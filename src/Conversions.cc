@@ -129,3 +129,93 @@ ignition::msgs::Time ignition::gui::convert(const ignition::common::Time &_t)
   return result;
 }
 
+/////////////////////////////////////////////////
+QImage::Format ignition::gui::convert(
+    const ignition::msgs::PixelFormatType &_format)
+{
+  switch (_format)
+  {
+    case msgs::PixelFormatType::L_INT8:
+      return QImage::Format_Grayscale8;
+    case msgs::PixelFormatType::RGB_INT8:
+      return QImage::Format_RGB888;
+    case msgs::PixelFormatType::RGBA_INT8:
+      return QImage::Format_RGBA8888;
+    // Everything else, such as 16-bit, float and Bayer formats, has no
+    // displayable QImage equivalent and needs a conversion pass
+    default:
+      return QImage::Format_Invalid;
+  }
+}
+
+/////////////////////////////////////////////////
+QImage ignition::gui::convert(const ignition::msgs::Image &_img)
+{
+  auto format = convert(_img.pixel_format_type());
+  if (QImage::Format_Invalid == format)
+    return QImage();
+
+  // The payload is packed, so the row stride is the payload size over
+  // the number of rows
+  auto bytesPerLine = _img.height() > 0 ?
+      static_cast<int>(_img.data().size() / _img.height()) : 0;
+  if (bytesPerLine <= 0)
+    return QImage();
+
+  return QImage(reinterpret_cast<const uchar *>(_img.data().data()),
+      _img.width(), _img.height(), bytesPerLine, format);
+}
+
+/// \brief Cleanup callback releasing a shared image message once the
+/// QImage viewing its payload is gone.
+/// \param[in] _info The shared pointer keeping the message alive.
+static void releaseImageMsg(void *_info)
+{
+  delete static_cast<std::shared_ptr<const ignition::msgs::Image> *>(_info);
+}
+
+/////////////////////////////////////////////////
+QImage ignition::gui::convert(
+    const std::shared_ptr<const ignition::msgs::Image> &_img)
+{
+  if (!_img)
+    return QImage();
+
+  auto format = convert(_img->pixel_format_type());
+  if (QImage::Format_Invalid == format)
+    return QImage();
+
+  auto bytesPerLine = _img->height() > 0 ?
+      static_cast<int>(_img->data().size() / _img->height()) : 0;
+  if (bytesPerLine <= 0)
+    return QImage();
+
+  // The QImage holds a reference to the message, released when the
+  // image and all its copies are destroyed
+  auto holder = new std::shared_ptr<const ignition::msgs::Image>(_img);
+
+  return QImage(reinterpret_cast<const uchar *>(_img->data().data()),
+      _img->width(), _img->height(), bytesPerLine, format,
+      releaseImageMsg, holder);
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::convert(const ignition::msgs::Pose_V &_msg,
+    ignition::gui::BatchedPoses &_batch)
+{
+  const auto count = _msg.pose_size();
+  _batch.ids.resize(count);
+  _batch.positions.resize(count);
+  _batch.rotations.resize(count);
+
+  for (int i = 0; i < count; ++i)
+  {
+    const auto &pose = _msg.pose(i);
+    const auto &pos = pose.position();
+    const auto &rot = pose.orientation();
+
+    _batch.ids[i] = pose.id();
+    _batch.positions[i].Set(pos.x(), pos.y(), pos.z());
+    _batch.rotations[i].Set(rot.w(), rot.x(), rot.y(), rot.z());
+  }
+}
@@ -172,3 +172,84 @@ TEST(ConversionsTest, Time)
   }
 }
 
+
+/////////////////////////////////////////////////
+TEST(ConversionsTest, Image)
+{
+  // Displayable format: shares the payload instead of copying it
+  {
+    ignition::msgs::Image img;
+    img.set_width(2);
+    img.set_height(2);
+    img.set_pixel_format_type(ignition::msgs::PixelFormatType::RGB_INT8);
+    img.set_data(std::string(2 * 2 * 3, '\x7f'));
+
+    auto qImg = convert(img);
+    ASSERT_FALSE(qImg.isNull());
+    EXPECT_EQ(qImg.width(), 2);
+    EXPECT_EQ(qImg.height(), 2);
+    EXPECT_EQ(qImg.format(), QImage::Format_RGB888);
+    EXPECT_EQ(qImg.constBits(),
+        reinterpret_cast<const uchar *>(img.data().data()));
+  }
+
+  // Shared ownership keeps the payload alive past the message handle
+  {
+    auto img = std::make_shared<ignition::msgs::Image>();
+    img->set_width(2);
+    img->set_height(2);
+    img->set_pixel_format_type(ignition::msgs::PixelFormatType::RGBA_INT8);
+    img->set_data(std::string(2 * 2 * 4, '\x2a'));
+
+    auto qImg = convert(
+        std::shared_ptr<const ignition::msgs::Image>(img));
+    img.reset();
+
+    ASSERT_FALSE(qImg.isNull());
+    EXPECT_EQ(qImg.format(), QImage::Format_RGBA8888);
+    EXPECT_EQ(qImg.pixelColor(0, 0), QColor(0x2a, 0x2a, 0x2a, 0x2a));
+  }
+
+  // Formats which need a conversion pass return a null image
+  {
+    ignition::msgs::Image img;
+    img.set_width(2);
+    img.set_height(2);
+    img.set_pixel_format_type(ignition::msgs::PixelFormatType::R_FLOAT32);
+    img.set_data(std::string(2 * 2 * 4, '\0'));
+
+    EXPECT_TRUE(convert(img).isNull());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ConversionsTest, BatchedPoses)
+{
+  ignition::msgs::Pose_V msg;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    auto pose = msg.add_pose();
+    pose->set_id(i);
+    pose->mutable_position()->set_x(i);
+    pose->mutable_position()->set_y(i * 2);
+    pose->mutable_position()->set_z(i * 3);
+    pose->mutable_orientation()->set_w(1);
+  }
+
+  // Buffers are reused across calls, so start with stale content
+  BatchedPoses batch;
+  batch.ids.resize(10);
+
+  convert(msg, batch);
+
+  ASSERT_EQ(batch.ids.size(), 3u);
+  ASSERT_EQ(batch.positions.size(), 3u);
+  ASSERT_EQ(batch.rotations.size(), 3u);
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(batch.ids[i], i);
+    EXPECT_EQ(batch.positions[i], math::Vector3d(i, i * 2, i * 3));
+    EXPECT_EQ(batch.rotations[i], math::Quaterniond(1, 0, 0, 0));
+  }
+}
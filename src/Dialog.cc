@@ -15,6 +15,9 @@
  *
  */
 
+#include <string>
+#include <vector>
+
 #include <ignition/common/Console.hh>
 #include "ignition/gui/Application.hh"
 #include "ignition/gui/Dialog.hh"
@@ -25,7 +28,7 @@ namespace ignition
   {
     class DialogPrivate
     {
-      /// \brief Pointer to quick window
+      /// \brief Pointer to quick window, created on first use
       public: QQuickWindow *quickWindow{nullptr};
     };
   }
@@ -34,16 +37,95 @@ namespace ignition
 using namespace ignition;
 using namespace gui;
 
+/// \brief Most dialogs kept warm at a time; beyond this, released
+/// dialogs are destroyed as before
+static const size_t kMaxPooledDialogs{3};
+
+/// \brief Get the process-wide pool of dialogs recycled after being
+/// closed. Evaluating the dialog QML is the expensive part of opening
+/// one, so closed dialogs are kept around and handed out again. The
+/// dialogs are backed by the running application's QML engine, so
+/// ClearPool empties the pool before that engine is torn down.
+/// \return Reference to the pool
+static std::vector<Dialog *> &DialogPool()
+{
+  static std::vector<Dialog *> pool;
+  return pool;
+}
+
 /////////////////////////////////////////////////
 Dialog::Dialog()
   : dataPtr(new DialogPrivate)
 {
+  // QML is evaluated on first use, see EnsureLoaded
+}
+
+/////////////////////////////////////////////////
+Dialog::~Dialog()
+{
+}
+
+/////////////////////////////////////////////////
+Dialog *Dialog::Acquire()
+{
+  auto &pool = DialogPool();
+  if (!pool.empty())
+  {
+    auto dialog = pool.back();
+    pool.pop_back();
+
+    if (dialog->QuickWindow())
+      dialog->QuickWindow()->show();
+
+    return dialog;
+  }
+
+  return new Dialog();
+}
+
+/////////////////////////////////////////////////
+void Dialog::Release(Dialog *_dialog)
+{
+  if (!_dialog)
+    return;
+
+  if (_dialog->dataPtr->quickWindow)
+    _dialog->dataPtr->quickWindow->hide();
+
+  auto &pool = DialogPool();
+  if (pool.size() < kMaxPooledDialogs)
+  {
+    pool.push_back(_dialog);
+    return;
+  }
+
+  _dialog->deleteLater();
+}
+
+/////////////////////////////////////////////////
+void Dialog::ClearPool()
+{
+  auto &pool = DialogPool();
+  for (auto dialog : pool)
+    dialog->deleteLater();
+  pool.clear();
+}
+
+/////////////////////////////////////////////////
+void Dialog::EnsureLoaded() const
+{
+  if (this->dataPtr->quickWindow)
+    return;
+
   // Load QML and keep pointer to generated QQuickWindow
   std::string qmlFile("qrc:qml/StandaloneDialog.qml");
   App()->Engine()->load(QUrl(QString::fromStdString(qmlFile)));
 
+  // The engine appends root objects in load order, so this dialog's
+  // window is the last one
+  auto rootObjects = App()->Engine()->rootObjects();
   this->dataPtr->quickWindow = qobject_cast<QQuickWindow *>(
-      App()->Engine()->rootObjects().value(0));
+      rootObjects.value(rootObjects.size() - 1));
   if (!this->dataPtr->quickWindow)
   {
     ignerr << "Internal error: Failed to instantiate QML file [" << qmlFile
@@ -52,20 +134,20 @@ Dialog::Dialog()
   }
 }
 
-/////////////////////////////////////////////////
-Dialog::~Dialog()
-{
-}
-
 /////////////////////////////////////////////////
 QQuickWindow *Dialog::QuickWindow() const
 {
+  this->EnsureLoaded();
   return this->dataPtr->quickWindow;
 }
 
 /////////////////////////////////////////////////
 QQuickItem *Dialog::RootItem() const
 {
+  this->EnsureLoaded();
+  if (!this->dataPtr->quickWindow)
+    return nullptr;
+
   auto dialogItem = this->dataPtr->quickWindow->findChild<QQuickItem *>();
   if (!dialogItem)
   {
@@ -74,4 +156,3 @@ QQuickItem *Dialog::RootItem() const
 
   return dialogItem;
 }
-
@@ -26,6 +26,7 @@ QMimeData *DragDropModel::mimeData(const QModelIndexList &_indexes) const
 {
   QMimeData *curMimeData = new QMimeData();
 
+  // legacy single-item payload, kept for existing drop sites
   for (auto const &idx : _indexes)
   {
     if (idx.isValid())
@@ -37,6 +38,67 @@ QMimeData *DragDropModel::mimeData(const QModelIndexList &_indexes) const
     }
   }
 
+  // the whole selection in one buffer, so bulk drags serialize once
+  QStringList queries;
+  queries.reserve(_indexes.size());
+  for (auto const &idx : _indexes)
+  {
+    if (idx.isValid())
+      queries.append(this->data(idx, DataRole::URI_QUERY).toString());
+  }
+  curMimeData->setData("application/x-ignition-items",
+      EncodeUriQueries(queries));
+
   return curMimeData;
 }
 
+/////////////////////////////////////////////////
+QByteArray DragDropModel::EncodeUriQueries(const QStringList &_uriQueries)
+{
+  QByteArray buffer;
+  QDataStream stream(&buffer, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_5_9);
+
+  // intern the queries: each distinct string is serialized once and
+  // items refer to it by table index
+  QHash<QString, quint32> interned;
+  QStringList table;
+  QVector<quint32> items;
+  items.reserve(_uriQueries.size());
+  for (const auto &query : _uriQueries)
+  {
+    auto it = interned.find(query);
+    if (it == interned.end())
+    {
+      it = interned.insert(query, static_cast<quint32>(table.size()));
+      table.append(query);
+    }
+    items.append(it.value());
+  }
+
+  stream << table << items;
+  return buffer;
+}
+
+/////////////////////////////////////////////////
+QStringList DragDropModel::DecodeUriQueries(const QByteArray &_data)
+{
+  QDataStream stream(_data);
+  stream.setVersion(QDataStream::Qt_5_9);
+
+  QStringList table;
+  QVector<quint32> items;
+  stream >> table >> items;
+  if (stream.status() != QDataStream::Ok)
+    return {};
+
+  QStringList result;
+  result.reserve(items.size());
+  for (const auto index : items)
+  {
+    if (index >= static_cast<quint32>(table.size()))
+      return {};
+    result.append(table.at(index));
+  }
+  return result;
+}
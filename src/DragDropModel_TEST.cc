@@ -49,3 +49,39 @@ TEST(DragDropModelTest, Mime)
   EXPECT_EQ(model->mimeData(ids)->data("application/x-item"), "/example/URI");
 }
 
+/////////////////////////////////////////////////
+TEST(DragDropModelTest, BinaryMime)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  auto model = new DragDropModel();
+  ASSERT_TRUE(model != nullptr);
+
+  // duplicate URIs should be interned, not repeated
+  const QStringList uris{"/example/a", "/example/b", "/example/a"};
+  for (int i = 0; i < uris.size(); ++i)
+  {
+    auto it = new QStandardItem();
+    it->setData(uris[i], DataRole::URI_QUERY);
+    model->insertRow(i, it);
+  }
+
+  QList<QModelIndex> ids;
+  for (int i = 0; i < uris.size(); ++i)
+    ids.push_back(model->index(i, 0));
+
+  auto mime = model->mimeData(ids);
+
+  // legacy payload still carries the first item
+  EXPECT_EQ(mime->data("application/x-item"), "/example/a");
+
+  // compact payload round-trips the whole selection in order
+  auto decoded = DragDropModel::DecodeUriQueries(
+      mime->data("application/x-ignition-items"));
+  EXPECT_EQ(decoded, uris);
+
+  // malformed payloads decode to nothing
+  EXPECT_TRUE(DragDropModel::DecodeUriQueries(
+      QByteArray("garbage")).isEmpty());
+}
+
@@ -17,52 +17,321 @@
 
 #include <sys/stat.h>
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <ignition/common/Console.hh>
 #include <ignition/math/Helpers.hh>
 
 #include "ignition/gui/Enums.hh"
 #include "ignition/gui/Helpers.hh"
 
+namespace
+{
+/// \brief One queued console message
+struct LogRecord
+{
+  /// \brief Severity to write with
+  ignition::gui::LogSeverity severity;
+
+  /// \brief Formatted message text
+  std::string message;
+
+  /// \brief Messages from the same site dropped before this one
+  uint64_t dropped{0};
+};
+
+/// \brief Bounded multi-producer, single-consumer ring. Producers
+/// claim slots through an atomic ticket, so enqueueing never takes a
+/// lock; when the ring is full the record is dropped instead.
+class LogRing
+{
+  /// \brief Number of slots. Power of two, so masking wraps tickets.
+  public: static const size_t kCapacity{1024};
+
+  /// \brief Constructor, seeds each slot's sequence number.
+  public: LogRing()
+  {
+    for (size_t i = 0; i < kCapacity; ++i)
+      this->slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  /// \brief Try to enqueue a record.
+  /// \param[in] _record Record to move in.
+  /// \return False when the ring was full.
+  public: bool Push(LogRecord &&_record)
+  {
+    auto pos = this->tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+      auto &slot = this->slots[pos & (kCapacity - 1)];
+      auto seq = slot.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+      if (diff == 0)
+      {
+        if (this->tail.compare_exchange_weak(pos, pos + 1,
+            std::memory_order_relaxed))
+        {
+          slot.record = std::move(_record);
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = this->tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// \brief Dequeue a record. Single consumer.
+  /// \param[out] _record Filled with the dequeued record.
+  /// \return False when the ring was empty.
+  public: bool Pop(LogRecord &_record)
+  {
+    auto &slot = this->slots[this->head & (kCapacity - 1)];
+    auto seq = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(seq) -
+        static_cast<intptr_t>(this->head + 1) < 0)
+    {
+      return false;
+    }
+
+    _record = std::move(slot.record);
+    slot.sequence.store(this->head + kCapacity, std::memory_order_release);
+    ++this->head;
+    return true;
+  }
+
+  /// \brief One slot and its sequence number
+  private: struct Slot
+  {
+    /// \brief Ticket marking the slot's state
+    std::atomic<size_t> sequence;
+
+    /// \brief The record held while the slot is full
+    LogRecord record;
+  };
+
+  /// \brief Slot storage
+  private: Slot slots[kCapacity];
+
+  /// \brief Producer ticket counter
+  private: std::atomic<size_t> tail{0};
+
+  /// \brief Consumer position, only touched by the logger thread
+  private: size_t head{0};
+};
+
+/// \brief Background thread draining the ring into the console
+class AsyncLogger
+{
+  /// \brief Get the process-wide logger, starting it on first use.
+  /// \return Reference to the logger.
+  public: static AsyncLogger &Instance()
+  {
+    static AsyncLogger logger;
+    return logger;
+  }
+
+  /// \brief Hand a record to the logger thread.
+  /// \param[in] _record Record to enqueue.
+  public: void Enqueue(LogRecord &&_record)
+  {
+    this->ring.Push(std::move(_record));
+  }
+
+  /// \brief Constructor, starts the drain thread.
+  private: AsyncLogger()
+  {
+    this->thread = std::thread([this]() { this->Loop(); });
+  }
+
+  /// \brief Destructor, flushes what's queued and joins the thread.
+  private: ~AsyncLogger()
+  {
+    this->done = true;
+    if (this->thread.joinable())
+      this->thread.join();
+  }
+
+  /// \brief Drain loop, sleeps while the ring is empty.
+  private: void Loop()
+  {
+    LogRecord record;
+    while (true)
+    {
+      if (this->ring.Pop(record))
+      {
+        this->Write(record);
+        continue;
+      }
+
+      if (this->done)
+        break;
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+
+  /// \brief Write one record through the console macros.
+  /// \param[in] _record Record to write.
+  private: void Write(const LogRecord &_record) const
+  {
+    std::string suffix;
+    if (_record.dropped > 0)
+    {
+      suffix = " (" + std::to_string(_record.dropped) +
+          " similar suppressed)";
+    }
+
+    switch (_record.severity)
+    {
+      case ignition::gui::LogSeverity::DBG:
+        igndbg << _record.message << suffix << std::endl;
+        break;
+      case ignition::gui::LogSeverity::MSG:
+        ignmsg << _record.message << suffix << std::endl;
+        break;
+      case ignition::gui::LogSeverity::WARN:
+        ignwarn << _record.message << suffix << std::endl;
+        break;
+      case ignition::gui::LogSeverity::ERR:
+      default:
+        ignerr << _record.message << suffix << std::endl;
+        break;
+    }
+  }
+
+  /// \brief Queued records
+  private: LogRing ring;
+
+  /// \brief The drain thread
+  private: std::thread thread;
+
+  /// \brief Set on destruction, tells the drain thread to finish
+  private: std::atomic<bool> done{false};
+};
+}  // namespace
+
 /////////////////////////////////////////////////
 std::string ignition::gui::humanReadable(const std::string &_key)
 {
+  // Property widgets call this on every refresh with the same handful
+  // of keys, so memoize per thread
+  static thread_local std::unordered_map<std::string, std::string> cache;
+
+  auto cached = cache.find(_key);
+  if (cached != cache.end())
+    return cached->second;
+
   std::string humanKey = _key;
-  humanKey[0] = toupper(humanKey[0]);
+  if (!humanKey.empty())
+    humanKey[0] = toupper(humanKey[0]);
   std::replace(humanKey.begin(), humanKey.end(), '_', ' ');
+
+  cache.emplace(_key, humanKey);
   return humanKey;
 }
 
 /////////////////////////////////////////////////
-std::string ignition::gui::unitFromKey(const std::string &_key,
-    const std::string &_type)
+QString ignition::gui::internedQString(const std::string &_str)
 {
-  if (_key == "pos" || _key == "length" || _key == "min_depth")
-  {
-    return "m";
-  }
+  // Identifiers come from a small stable set, so the table stays tiny;
+  // the cap only guards against misuse with unbounded inputs.
+  static const std::size_t kMaxEntries{10000};
+  static thread_local std::unordered_map<std::string, QString> cache;
 
-  if (_key == "rot")
-    return "rad";
+  auto cached = cache.find(_str);
+  if (cached != cache.end())
+    return cached->second;
 
-  if (_key == "kp" || _key == "kd")
-    return "N/m";
+  if (cache.size() >= kMaxEntries)
+    cache.clear();
 
-  if (_key == "max_vel")
-    return "m/s";
+  auto converted = QString::fromStdString(_str);
+  cache.emplace(_str, converted);
+  return converted;
+}
+
+/////////////////////////////////////////////////
+void ignition::gui::logAsync(LogSeverity _severity, const std::string &_site,
+    const std::string &_message, int _rateLimitMs)
+{
+  /// \brief Rate limiting state for one site
+  struct RateState
+  {
+    /// \brief When the last message got through
+    std::chrono::steady_clock::time_point last;
+
+    /// \brief Messages dropped since then
+    uint64_t dropped{0};
+  };
 
-  if (_key == "mass")
-    return "kg";
+  // Rate state is kept per thread so checking it doesn't take a lock;
+  // a given callback fires on a stable thread, so per-thread limiting
+  // is equivalent in practice
+  static thread_local std::unordered_map<std::string, RateState> sites;
 
-  if (_key == "ixx" || _key == "ixy" || _key == "ixz" ||
-      _key == "iyy" || _key == "iyz" || _key == "izz")
+  uint64_t dropped = 0;
+  if (_rateLimitMs > 0)
   {
-    return "kg&middot;m<sup>2</sup>";
+    auto now = std::chrono::steady_clock::now();
+    auto &state = sites[_site];
+    if (state.last.time_since_epoch().count() != 0 &&
+        now - state.last < std::chrono::milliseconds(_rateLimitMs))
+    {
+      ++state.dropped;
+      return;
+    }
+
+    state.last = now;
+    dropped = state.dropped;
+    state.dropped = 0;
   }
 
-  if (_key == "density")
+  AsyncLogger::Instance().Enqueue({_severity, _message, dropped});
+}
+
+/////////////////////////////////////////////////
+std::string ignition::gui::unitFromKey(const std::string &_key,
+    const std::string &_type)
+{
+  // Units which don't depend on the type, precomputed once
+  static const std::unordered_map<std::string, std::string> kFixedUnits =
   {
-    return "kg/m<sup>3</sup>";
-  }
+    {"pos", "m"},
+    {"length", "m"},
+    {"min_depth", "m"},
+    {"rot", "rad"},
+    {"kp", "N/m"},
+    {"kd", "N/m"},
+    {"max_vel", "m/s"},
+    {"mass", "kg"},
+    {"ixx", "kg&middot;m<sup>2</sup>"},
+    {"ixy", "kg&middot;m<sup>2</sup>"},
+    {"ixz", "kg&middot;m<sup>2</sup>"},
+    {"iyy", "kg&middot;m<sup>2</sup>"},
+    {"iyz", "kg&middot;m<sup>2</sup>"},
+    {"izz", "kg&middot;m<sup>2</sup>"},
+    {"density", "kg/m<sup>3</sup>"},
+  };
+
+  auto fixed = kFixedUnits.find(_key);
+  if (fixed != kFixedUnits.end())
+    return fixed->second;
 
   if (_key == "limit_lower" || _key == "limit_upper")
   {
@@ -164,3 +433,42 @@ std::string ignition::gui::uniqueFilePath(const std::string &_pathAndName,
 
   return result;
 }
+
+/////////////////////////////////////////////////
+std::string ignition::gui::formattedTime(const common::Time &_time)
+{
+  // Reused per-thread scratch so repeated refreshes don't allocate
+  static thread_local char buffer[32];
+
+  auto sec = _time.sec;
+
+  auto day = sec / 86400;
+  sec -= day * 86400;
+
+  auto hour = sec / 3600;
+  sec -= hour * 3600;
+
+  auto min = sec / 60;
+  sec -= min * 60;
+
+  auto msec = _time.nsec / 1000000;
+
+  std::snprintf(buffer, sizeof(buffer), "%02d %02d:%02d:%02d.%03d",
+      static_cast<int>(day), static_cast<int>(hour), static_cast<int>(min),
+      static_cast<int>(sec), static_cast<int>(msec));
+
+  return buffer;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> ignition::gui::formattedTimes(
+    const std::vector<common::Time> &_times)
+{
+  std::vector<std::string> result;
+  result.reserve(_times.size());
+
+  for (const auto &time : _times)
+    result.push_back(formattedTime(time));
+
+  return result;
+}
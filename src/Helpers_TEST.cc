@@ -116,6 +116,51 @@ TEST(HelpersTest, stringTypeFromKey)
   EXPECT_EQ(stringTypeFromKey("innerxml"), StringType::PLAIN_TEXT);
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, formattedTime)
+{
+  EXPECT_EQ(formattedTime(common::Time(0, 0)), "00 00:00:00.000");
+  EXPECT_EQ(formattedTime(common::Time(90061, 500000000)), "01 01:01:01.500");
+
+  // Repeated calls reuse the same scratch buffer
+  EXPECT_EQ(formattedTime(common::Time(59, 1000000)), "00 00:00:59.001");
+  EXPECT_EQ(formattedTime(common::Time(3600, 0)), "00 01:00:00.000");
+
+  auto batch = formattedTimes({common::Time(1, 0), common::Time(61, 0)});
+  ASSERT_EQ(batch.size(), 2u);
+  EXPECT_EQ(batch[0], "00 00:00:01.000");
+  EXPECT_EQ(batch[1], "00 00:01:01.000");
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, internedQString)
+{
+  EXPECT_EQ(internedQString("banana"), QString("banana"));
+  EXPECT_EQ(internedQString(""), QString(""));
+
+  // Repeated conversions share the cached string's data
+  auto first = internedQString("/some/topic");
+  auto second = internedQString("/some/topic");
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first.constData(), second.constData());
+
+  // Different inputs don't collide
+  EXPECT_NE(internedQString("banana"), internedQString("grape"));
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, logAsync)
+{
+  // Messages are written by a background thread, so this only checks
+  // that hammering one site and shutting down afterwards are safe
+  for (int i = 0; i < 100; ++i)
+  {
+    logAsync(LogSeverity::DBG, "HelpersTest::logAsync",
+        "repeated message");
+  }
+  logAsync(LogSeverity::MSG, "HelpersTest::other", "one-off message", 0);
+}
+
 /////////////////////////////////////////////////
 TEST(HelpersTest, findFirstByProperty)
 {
@@ -142,3 +187,37 @@ TEST(HelpersTest, findFirstByProperty)
   EXPECT_EQ(findFirstByProperty(list, "acerola", 1.0), nullptr);
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, IndexedMap)
+{
+  IndexedMap<QString, int> map;
+  EXPECT_EQ(map.Size(), 0);
+
+  map.Insert("banana", 1);
+  map.Insert("acerola", 2);
+  EXPECT_EQ(map.Size(), 2);
+
+  // Lookups in both directions
+  EXPECT_EQ(map.Value("banana"), 1);
+  EXPECT_EQ(map.Key(2), QString("acerola"));
+  EXPECT_TRUE(map.ContainsKey("acerola"));
+  EXPECT_TRUE(map.ContainsValue(1));
+
+  // Missing entries return the default
+  EXPECT_EQ(map.Value("grape", -1), -1);
+  EXPECT_EQ(map.Key(99), QString());
+
+  // Updating a key retires its old value from the reverse index
+  map.Insert("banana", 3);
+  EXPECT_EQ(map.Size(), 2);
+  EXPECT_FALSE(map.ContainsValue(1));
+  EXPECT_EQ(map.Key(3), QString("banana"));
+
+  EXPECT_TRUE(map.Remove("banana"));
+  EXPECT_FALSE(map.Remove("banana"));
+  EXPECT_FALSE(map.ContainsValue(3));
+
+  map.Clear();
+  EXPECT_EQ(map.Size(), 0);
+}
+
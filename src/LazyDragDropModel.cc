@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/gui/DragDropModel.hh"
+#include "ignition/gui/Enums.hh"
+#include "ignition/gui/LazyDragDropModel.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+int LazyDragDropModel::AddRow(const QString &_name, const int _parentRow)
+{
+  if (_parentRow >= static_cast<int>(this->names.size()))
+    return -1;
+
+  auto handle = static_cast<int>(this->names.size());
+
+  QModelIndex parentId;
+  if (_parentRow >= 0)
+  {
+    parentId = this->createIndex(this->rowInParent[_parentRow], 0,
+        static_cast<quintptr>(_parentRow));
+  }
+
+  auto pos = _parentRow < 0 ?
+      static_cast<int>(this->topRows.size()) :
+      static_cast<int>(this->childRows[_parentRow].size());
+
+  this->beginInsertRows(parentId, pos, pos);
+
+  this->names.push_back(_name);
+  this->uriQueries.push_back(QString());
+  this->types.push_back(QString());
+  this->toExpand.push_back(false);
+  this->deferred.push_back(false);
+  this->parents.push_back(_parentRow);
+  this->rowInParent.push_back(pos);
+  this->childRows.push_back({});
+
+  if (_parentRow < 0)
+    this->topRows.push_back(handle);
+  else
+    this->childRows[_parentRow].push_back(handle);
+
+  this->endInsertRows();
+
+  return handle;
+}
+
+/////////////////////////////////////////////////
+void LazyDragDropModel::SetUriQuery(const int _row, const QString &_uriQuery)
+{
+  if (_row < 0 || _row >= static_cast<int>(this->names.size()))
+    return;
+
+  this->uriQueries[_row] = _uriQuery;
+}
+
+/////////////////////////////////////////////////
+void LazyDragDropModel::SetType(const int _row, const QString &_type)
+{
+  if (_row < 0 || _row >= static_cast<int>(this->names.size()))
+    return;
+
+  this->types[_row] = _type;
+}
+
+/////////////////////////////////////////////////
+void LazyDragDropModel::SetDeferred(const int _row, const bool _deferred)
+{
+  if (_row < 0 || _row >= static_cast<int>(this->names.size()))
+    return;
+
+  this->deferred[_row] = _deferred;
+}
+
+/////////////////////////////////////////////////
+void LazyDragDropModel::SetChildProvider(const ChildProvider &_provider)
+{
+  this->provider = _provider;
+}
+
+/////////////////////////////////////////////////
+QModelIndex LazyDragDropModel::index(int _row, int _column,
+    const QModelIndex &_parent) const
+{
+  auto parentRow = this->RowFrom(_parent);
+  const auto &list = parentRow < 0 ? this->topRows :
+      this->childRows[parentRow];
+
+  if (_column != 0 || _row < 0 || _row >= static_cast<int>(list.size()))
+    return QModelIndex();
+
+  return this->createIndex(_row, _column,
+      static_cast<quintptr>(list[_row]));
+}
+
+/////////////////////////////////////////////////
+QModelIndex LazyDragDropModel::parent(const QModelIndex &_index) const
+{
+  auto row = this->RowFrom(_index);
+  if (row < 0)
+    return QModelIndex();
+
+  auto parentRow = this->parents[row];
+  if (parentRow < 0)
+    return QModelIndex();
+
+  return this->createIndex(this->rowInParent[parentRow], 0,
+      static_cast<quintptr>(parentRow));
+}
+
+/////////////////////////////////////////////////
+int LazyDragDropModel::rowCount(const QModelIndex &_parent) const
+{
+  auto parentRow = this->RowFrom(_parent);
+  if (parentRow < 0)
+    return static_cast<int>(this->topRows.size());
+
+  return static_cast<int>(this->childRows[parentRow].size());
+}
+
+/////////////////////////////////////////////////
+int LazyDragDropModel::columnCount(const QModelIndex &) const
+{
+  return 1;
+}
+
+/////////////////////////////////////////////////
+QVariant LazyDragDropModel::data(const QModelIndex &_index,
+    int _role) const
+{
+  auto row = this->RowFrom(_index);
+  if (row < 0)
+    return QVariant();
+
+  switch (_role)
+  {
+    case Qt::DisplayRole:
+    case DataRole::DISPLAY_NAME:
+      return this->names[row];
+    case DataRole::URI_QUERY:
+      return this->uriQueries[row];
+    case DataRole::TYPE:
+      return this->types[row];
+    case DataRole::TO_EXPAND:
+      return static_cast<bool>(this->toExpand[row]);
+    default:
+      return QVariant();
+  }
+}
+
+/////////////////////////////////////////////////
+bool LazyDragDropModel::setData(const QModelIndex &_index,
+    const QVariant &_value, int _role)
+{
+  auto row = this->RowFrom(_index);
+  if (row < 0)
+    return false;
+
+  switch (_role)
+  {
+    case Qt::DisplayRole:
+    case DataRole::DISPLAY_NAME:
+      this->names[row] = _value.toString();
+      break;
+    case DataRole::URI_QUERY:
+      this->uriQueries[row] = _value.toString();
+      break;
+    case DataRole::TYPE:
+      this->types[row] = _value.toString();
+      break;
+    case DataRole::TO_EXPAND:
+      this->toExpand[row] = _value.toBool();
+      break;
+    default:
+      return false;
+  }
+
+  this->dataChanged(_index, _index, {_role});
+  return true;
+}
+
+/////////////////////////////////////////////////
+Qt::ItemFlags LazyDragDropModel::flags(const QModelIndex &_index) const
+{
+  if (!_index.isValid())
+    return Qt::NoItemFlags;
+
+  return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
+}
+
+/////////////////////////////////////////////////
+bool LazyDragDropModel::hasChildren(const QModelIndex &_parent) const
+{
+  auto parentRow = this->RowFrom(_parent);
+  if (parentRow < 0)
+    return !this->topRows.empty();
+
+  // Deferred rows report children before fetching them, so views show
+  // the expansion handle
+  return this->deferred[parentRow] ||
+      !this->childRows[parentRow].empty();
+}
+
+/////////////////////////////////////////////////
+bool LazyDragDropModel::canFetchMore(const QModelIndex &_parent) const
+{
+  auto parentRow = this->RowFrom(_parent);
+  return parentRow >= 0 && this->deferred[parentRow];
+}
+
+/////////////////////////////////////////////////
+void LazyDragDropModel::fetchMore(const QModelIndex &_parent)
+{
+  auto parentRow = this->RowFrom(_parent);
+  if (parentRow < 0 || !this->deferred[parentRow])
+    return;
+
+  // Clear first so the provider's AddRow calls see consistent counts
+  this->deferred[parentRow] = false;
+
+  if (this->provider)
+    this->provider(parentRow);
+}
+
+/////////////////////////////////////////////////
+QMimeData *LazyDragDropModel::mimeData(const QModelIndexList &_indexes) const
+{
+  QMimeData *curMimeData = new QMimeData();
+
+  // legacy single-item payload, kept for existing drop sites
+  for (auto const &idx : _indexes)
+  {
+    if (idx.isValid())
+    {
+      QString text = this->data(idx, DataRole::URI_QUERY).toString();
+      curMimeData->setData("application/x-item", text.toLatin1().data());
+
+      break;
+    }
+  }
+
+  // the whole selection in one buffer, same format as DragDropModel
+  QStringList queries;
+  queries.reserve(_indexes.size());
+  for (auto const &idx : _indexes)
+  {
+    if (idx.isValid())
+      queries.append(this->data(idx, DataRole::URI_QUERY).toString());
+  }
+  curMimeData->setData("application/x-ignition-items",
+      DragDropModel::EncodeUriQueries(queries));
+
+  return curMimeData;
+}
+
+/////////////////////////////////////////////////
+int LazyDragDropModel::RowFrom(const QModelIndex &_index) const
+{
+  if (!_index.isValid())
+    return -1;
+
+  return static_cast<int>(_index.internalId());
+}
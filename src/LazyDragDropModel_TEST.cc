@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <ignition/common/Console.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+#include "ignition/gui/Enums.hh"
+#include "ignition/gui/LazyDragDropModel.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(LazyDragDropModelTest, Mime)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  auto model = new LazyDragDropModel();
+  ASSERT_TRUE(model != nullptr);
+
+  auto row = model->AddRow("example");
+  model->SetUriQuery(row, "/example/URI");
+
+  auto id = model->index(0, 0);
+
+  QList<QModelIndex> ids;
+  ids.push_back(id);
+
+  EXPECT_EQ(model->mimeData(ids)->data("application/x-item"), "/example/URI");
+}
+
+/////////////////////////////////////////////////
+TEST(LazyDragDropModelTest, DeferredChildren)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  auto model = new LazyDragDropModel();
+  ASSERT_TRUE(model != nullptr);
+
+  auto branch = model->AddRow("branch");
+  model->SetDeferred(branch, true);
+
+  int providerCalls{0};
+  model->SetChildProvider([&](const int _row)
+      {
+        providerCalls++;
+        auto child = model->AddRow("child", _row);
+        model->SetType(child, "Double");
+      });
+
+  // Children exist for the view, but haven't been materialized
+  auto branchId = model->index(0, 0);
+  EXPECT_TRUE(model->hasChildren(branchId));
+  EXPECT_EQ(model->rowCount(branchId), 0);
+  EXPECT_TRUE(model->canFetchMore(branchId));
+  EXPECT_EQ(providerCalls, 0);
+
+  // Expansion fetches them exactly once
+  model->fetchMore(branchId);
+  EXPECT_EQ(providerCalls, 1);
+  EXPECT_EQ(model->rowCount(branchId), 1);
+  EXPECT_FALSE(model->canFetchMore(branchId));
+
+  model->fetchMore(branchId);
+  EXPECT_EQ(providerCalls, 1);
+
+  // Data and tree navigation
+  auto childId = model->index(0, 0, branchId);
+  EXPECT_EQ(model->data(childId, DataRole::DISPLAY_NAME).toString(), "child");
+  EXPECT_EQ(model->data(childId, DataRole::TYPE).toString(), "Double");
+  EXPECT_EQ(model->parent(childId), branchId);
+}
@@ -16,12 +16,28 @@
  */
 
 #include <tinyxml2.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <regex>
+#include <sstream>
 #include <string>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
+#include <ignition/common/Profiler.hh>
+#include <ignition/msgs/stringmsg.pb.h>
+#include <ignition/transport/Node.hh>
 #include "ignition/gui/Application.hh"
+#include "ignition/gui/GuiEvents.hh"
 #include "ignition/gui/MainWindow.hh"
 #include "ignition/gui/Plugin.hh"
 #include "ignition/gui/qt.h"
@@ -38,15 +54,103 @@ namespace ignition
       /// \brief Pointer to quick window
       public: QQuickWindow *quickWindow{nullptr};
 
+      /// \brief Context the window's QML was created in. Each window has
+      /// its own, so several windows can share one engine.
+      public: QQmlContext *context{nullptr};
+
       /// \brief Configuration for this window.
       public: WindowConfig windowConfig;
 
+      /// \brief Model backing the plugins menu, updated incrementally
+      /// as plugins are shown or hidden by the config.
+      public: QStandardItemModel *pluginListModel{nullptr};
+
       /// \brief Counts the times the window has been painted
       public: unsigned int paintCount{0};
 
       /// \brief Minimum number of paint events to consider the window to be
       /// fully initialized.
       public: const unsigned int paintCountMin{20};
+
+      /// \brief Debounce timer for asynchronous config saves, created on
+      /// first use.
+      public: QTimer *autoSaveTimer{nullptr};
+
+      /// \brief Result of the most recent background save.
+      public: std::future<void> autoSaveResult;
+
+      /// \brief Fingerprint of the last auto-saved config, so settled
+      /// debounce timers that changed nothing don't rewrite the file.
+      public: std::size_t autoSavedFingerprint{0};
+
+      /// \brief True while memory telemetry is being sampled.
+      public: bool telemetryEnabled{false};
+
+      /// \brief Telemetry sampling interval in ms.
+      public: int telemetryInterval{5000};
+
+      /// \brief Timer driving telemetry samples, created on first use.
+      public: QTimer *telemetryTimer{nullptr};
+
+      /// \brief Latest sampled resident set size in kB.
+      public: int telemetryRss{-1};
+
+      /// \brief Latest sampled object count.
+      public: int telemetryObjectCount{0};
+
+      /// \brief Publisher for telemetry samples, advertised when
+      /// telemetry is first enabled.
+      public: transport::Node::Publisher telemetryPub;
+
+      /// \brief True while frame statistics are collected.
+      public: bool frameStatsEnabled{false};
+
+      /// \brief Connections into the quick window's render loop,
+      /// broken when frame stats are disabled.
+      public: std::vector<QMetaObject::Connection> frameStatsConnections;
+
+      /// \brief Timer folding the frame ring into the summary
+      /// properties, created on first use.
+      public: QTimer *frameStatsTimer{nullptr};
+
+      /// \brief Ring of recent frame times in microseconds, written by
+      /// the render thread and read on the GUI thread.
+      public: std::array<std::atomic<int>, 120> frameRing;
+
+      /// \brief Frames recorded since enabling; indexes the ring.
+      public: std::atomic<size_t> frameCount{0};
+
+      /// \brief Start of the current sync phase. Render thread only.
+      public: std::chrono::steady_clock::time_point syncStart;
+
+      /// \brief Start of the current render phase. Render thread only.
+      public: std::chrono::steady_clock::time_point renderStart;
+
+      /// \brief Previous frame swap. Render thread only.
+      public: std::chrono::steady_clock::time_point lastSwap;
+
+      /// \brief Previous frame swap as seen by the GUI thread, for the
+      /// frame-budget event. Distinct from lastSwap, which belongs to
+      /// the render thread.
+      public: std::chrono::steady_clock::time_point lastBudgetSwap;
+
+      /// \brief Last sync phase duration in microseconds.
+      public: std::atomic<int> lastSyncUs{0};
+
+      /// \brief Last render phase duration in microseconds.
+      public: std::atomic<int> lastRenderUs{0};
+
+      /// \brief Frames which took longer than 33 ms since enabling.
+      public: std::atomic<int> longFrames{0};
+
+      /// \brief Frame rate over the last stats window.
+      public: double frameFps{0.0};
+
+      /// \brief Average frame time in ms over the last stats window.
+      public: double frameAvgMs{0.0};
+
+      /// \brief Worst frame time in ms over the last stats window.
+      public: double frameWorstMs{0.0};
     };
   }
 }
@@ -67,15 +171,30 @@ std::string dirName(const std::string &_path)
 MainWindow::MainWindow()
   : dataPtr(new MainWindowPrivate)
 {
-  // Make MainWindow functions available from all QML files (using root)
-  App()->Engine()->rootContext()->setContextProperty("MainWindow", this);
+  // Fill the plugins menu model before the QML that displays it is
+  // created. Parented to the window so QML doesn't take ownership.
+  this->dataPtr->pluginListModel = new QStandardItemModel(this);
+  this->UpdatePluginListModel();
+
+  auto rootContext = App()->Engine()->rootContext();
+
+  // Each window resolves `MainWindow` in QML to itself through its own
+  // context, so several windows can share one engine. The first window
+  // also registers on the root context, where items created without a
+  // window context, such as cards, look the property up.
+  if (!rootContext->contextProperty("MainWindow").isValid())
+    rootContext->setContextProperty("MainWindow", this);
+
+  this->dataPtr->context = new QQmlContext(rootContext);
+  this->dataPtr->context->setContextProperty("MainWindow", this);
 
   // Load QML and keep pointer to generated QQuickWindow
   std::string qmlFile("qrc:qml/Main.qml");
-  App()->Engine()->load(QUrl(QString::fromStdString(qmlFile)));
+  QQmlComponent component(App()->Engine(),
+      QUrl(QString::fromStdString(qmlFile)));
 
   this->dataPtr->quickWindow = qobject_cast<QQuickWindow *>(
-      App()->Engine()->rootObjects().value(0));
+      component.create(this->dataPtr->context));
   if (!this->dataPtr->quickWindow)
   {
     ignerr << "Internal error: Failed to instantiate QML file [" << qmlFile
@@ -83,12 +202,43 @@ MainWindow::MainWindow()
     return;
   }
 
+  // The engine owns the window object, like it owned the root objects
+  // it used to load directly
+  this->dataPtr->quickWindow->setParent(App()->Engine());
+
+  // Route frame-budget feedback after every presented frame, so plugins
+  // can shed optional work while the GUI is behind. frameSwapped is
+  // emitted on the render thread; the context object queues the call
+  // back onto the GUI thread, where the event router runs.
+  this->connect(this->dataPtr->quickWindow, &QQuickWindow::frameSwapped,
+      this, [this]()
+      {
+        const auto now = std::chrono::steady_clock::now();
+        const auto last = this->dataPtr->lastBudgetSwap;
+        this->dataPtr->lastBudgetSwap = now;
+        if (last.time_since_epoch().count() == 0)
+          return;
+
+        const double frameMs = std::chrono::duration<double,
+            std::milli>(now - last).count();
+
+        double periodMs{1000.0 / 60.0};
+        auto screen = this->dataPtr->quickWindow->screen();
+        if (screen && screen->refreshRate() > 0.0)
+          periodMs = 1000.0 / screen->refreshRate();
+
+        events::FrameBudget event(frameMs, periodMs - frameMs);
+        App()->RouteEvent(&event);
+      });
+
   App()->setWindowIcon(QIcon(":/qml/images/ignition_logo_50x50.png"));
 }
 
 /////////////////////////////////////////////////
 MainWindow::~MainWindow()
 {
+  if (this->dataPtr->autoSaveResult.valid())
+    this->dataPtr->autoSaveResult.wait();
 }
 
 /////////////////////////////////////////////////
@@ -133,6 +283,41 @@ QStringList MainWindow::PluginListModel() const
   return pluginNames;
 }
 
+/////////////////////////////////////////////////
+QAbstractItemModel *MainWindow::PluginsModel() const
+{
+  return this->dataPtr->pluginListModel;
+}
+
+/////////////////////////////////////////////////
+void MainWindow::UpdatePluginListModel()
+{
+  auto names = this->PluginListModel();
+  auto model = this->dataPtr->pluginListModel;
+
+  // Both the wanted list and the model rows are sorted, so a single
+  // merge pass inserts and removes exactly the rows that changed
+  int row = 0;
+  for (const auto &name : names)
+  {
+    while (row < model->rowCount() && model->item(row)->text() < name)
+      model->removeRow(row);
+
+    if (row < model->rowCount() && model->item(row)->text() == name)
+    {
+      ++row;
+      continue;
+    }
+
+    model->insertRow(row, new QStandardItem(name));
+    ++row;
+  }
+
+  // Trailing rows aren't in the wanted list anymore
+  while (model->rowCount() > row)
+    model->removeRow(row);
+}
+
 //////////////////////////////////////////////////
 void MainWindow::OnLoadConfig(const QString &_path)
 {
@@ -161,28 +346,124 @@ void MainWindow::OnSaveConfigAs(const QString &_path)
 /////////////////////////////////////////////////
 void MainWindow::SaveConfig(const std::string &_path)
 {
+  IGN_PROFILE("MainWindow::SaveConfig");
+
+  // Snapshot on the GUI thread; serialization and file I/O happen in
+  // the background
   this->dataPtr->windowConfig = this->CurrentWindowConfig();
 
-  // Create the intermediate directories if needed.
-  // We check for errors when we try to open the file.
-  auto dirname = dirName(_path);
-  ignition::common::createDirectories(dirname);
+  // A following autosave of the very same state would be redundant
+  if (_path == App()->DefaultConfigPath())
+  {
+    this->dataPtr->autoSavedFingerprint =
+        this->dataPtr->windowConfig.Fingerprint();
+  }
+
+  // Share the autosave slot so two writes never interleave
+  if (this->dataPtr->autoSaveResult.valid())
+    this->dataPtr->autoSaveResult.wait();
+
+  // The future is a member, so its destructor keeps `this` alive until
+  // the task is done. The notify signal is safe to emit from the
+  // worker, connections to QML are queued.
+  this->dataPtr->autoSaveResult = std::async(std::launch::async,
+      [this, config = this->dataPtr->windowConfig, _path]()
+      {
+        // Create the intermediate directories if needed.
+        // We check for errors when we try to open the file.
+        ignition::common::createDirectories(dirName(_path));
+
+        // Open the file
+        std::ofstream out(_path.c_str(), std::ios::out);
+        if (!out)
+        {
+          std::string str = "Unable to open file: " + _path;
+          str += ".\nCheck file permissions.";
+          this->notify(QString::fromStdString(str));
+          return;
+        }
+        out << config.XMLString();
+
+        std::string msg("Saved configuration to <b>" + _path + "</b>");
+
+        this->notify(QString::fromStdString(msg));
+        ignmsg << msg << std::endl;
+      });
+}
+
+/////////////////////////////////////////////////
+void MainWindow::WaitForSave()
+{
+  if (this->dataPtr->autoSaveResult.valid())
+    this->dataPtr->autoSaveResult.wait();
+}
 
-  // Open the file
-  std::ofstream out(_path.c_str(), std::ios::out);
-  if (!out)
+/////////////////////////////////////////////////
+void MainWindow::AutoSaveConfig()
+{
+  // Debounce: rapid requests collapse into one save once they settle
+  if (!this->dataPtr->autoSaveTimer)
   {
-    std::string str = "Unable to open file: " + _path;
-    str += ".\nCheck file permissions.";
-    this->notify(QString::fromStdString(str));
+    this->dataPtr->autoSaveTimer = new QTimer(this);
+    this->dataPtr->autoSaveTimer->setSingleShot(true);
+    this->dataPtr->autoSaveTimer->setInterval(1000);
+    this->connect(this->dataPtr->autoSaveTimer, SIGNAL(timeout()), this,
+        SLOT(OnAutoSaveTimeout()));
   }
-  else
-    out << this->dataPtr->windowConfig.XMLString();
+  this->dataPtr->autoSaveTimer->start();
+}
+
+/////////////////////////////////////////////////
+void MainWindow::OnAutoSaveTimeout()
+{
+  // Snapshot on the GUI thread; serialization and file I/O happen in
+  // the background
+  auto config = this->CurrentWindowConfig();
+
+  // Settled to the same state as the last write: skip the
+  // serialization and the file I/O altogether
+  const auto fingerprint = config.Fingerprint();
+  if (fingerprint == this->dataPtr->autoSavedFingerprint)
+    return;
+  this->dataPtr->autoSavedFingerprint = fingerprint;
 
-  std::string msg("Saved configuration to <b>" + _path + "</b>");
+  this->dataPtr->windowConfig = config;
+  auto path = App()->DefaultConfigPath();
 
-  this->notify(QString::fromStdString(msg));
-  ignmsg << msg << std::endl;
+  // Let a previous save finish first
+  if (this->dataPtr->autoSaveResult.valid())
+    this->dataPtr->autoSaveResult.wait();
+
+  this->dataPtr->autoSaveResult = std::async(std::launch::async,
+      [config = std::move(config), path]()
+      {
+        // Create the intermediate directories if needed.
+        // We check for errors when we try to open the file.
+        ignition::common::createDirectories(dirName(path));
+
+        // Write to a temporary file and rename it into place, so a
+        // crash mid-write can't truncate the previous config
+        auto tmpPath = path + ".tmp";
+        std::ofstream out(tmpPath.c_str(), std::ios::out);
+        if (!out)
+        {
+          ignerr << "Unable to open file: " << tmpPath
+                 << ".\nCheck file permissions." << std::endl;
+          return;
+        }
+        out << config.XMLString();
+        out.close();
+
+        if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+        {
+          ignerr << "Failed to save configuration to [" << path << "]"
+                 << std::endl;
+        }
+        else
+        {
+          igndbg << "Saved configuration to [" << path << "]" << std::endl;
+        }
+      });
 }
 
 /////////////////////////////////////////////////
@@ -200,10 +481,22 @@ void MainWindow::OnAddPlugin(QString _plugin)
 
 ///////////////////////////////////////////////////
 bool MainWindow::ApplyConfig(const WindowConfig &_config)
+{
+  // Delegate to the move overload on a copy, so the delta logic lives
+  // in one place
+  return this->ApplyConfig(WindowConfig(_config));
+}
+
+/////////////////////////////////////////////////
+bool MainWindow::ApplyConfig(WindowConfig &&_config)
 {
   if (!this->dataPtr->quickWindow)
     return false;
 
+  // Only apply the delta against the current state, so unchanged
+  // properties don't trigger QML re-evaluation
+  const auto current = this->CurrentWindowConfig();
+
   // Window position
   if (!_config.IsIgnoring("position_x") &&
       !_config.IsIgnoring("position_y") &&
@@ -217,7 +510,8 @@ bool MainWindow::ApplyConfig(const WindowConfig &_config)
   if (!_config.IsIgnoring("width") &&
       !_config.IsIgnoring("height") &&
       !_config.IsIgnoring("size") &&
-      _config.width >= 0 && _config.height >= 0)
+      _config.width >= 0 && _config.height >= 0 &&
+      (_config.width != current.width || _config.height != current.height))
   {
     this->QuickWindow()->resize(_config.width, _config.height);
   }
@@ -232,35 +526,78 @@ bool MainWindow::ApplyConfig(const WindowConfig &_config)
   // Style
   if (!_config.IsIgnoring("style"))
   {
-    this->SetMaterialTheme(QString::fromStdString(_config.materialTheme));
-    this->SetMaterialPrimary(QString::fromStdString(_config.materialPrimary));
-    this->SetMaterialAccent(QString::fromStdString(_config.materialAccent));
+    if (_config.materialTheme != current.materialTheme)
+      this->SetMaterialTheme(QString::fromStdString(_config.materialTheme));
+    if (_config.materialPrimary != current.materialPrimary)
+    {
+      this->SetMaterialPrimary(
+          QString::fromStdString(_config.materialPrimary));
+    }
+    if (_config.materialAccent != current.materialAccent)
+      this->SetMaterialAccent(QString::fromStdString(_config.materialAccent));
 
-    this->SetToolBarColorLight(QString::fromStdString(
-        _config.toolBarColorLight));
-    this->SetToolBarTextColorLight(QString::fromStdString(
-        _config.toolBarTextColorLight));
-    this->SetToolBarColorDark(QString::fromStdString(_config.toolBarColorDark));
-    this->SetToolBarTextColorDark(QString::fromStdString(
-        _config.toolBarTextColorDark));
+    if (_config.toolBarColorLight != current.toolBarColorLight)
+    {
+      this->SetToolBarColorLight(QString::fromStdString(
+          _config.toolBarColorLight));
+    }
+    if (_config.toolBarTextColorLight != current.toolBarTextColorLight)
+    {
+      this->SetToolBarTextColorLight(QString::fromStdString(
+          _config.toolBarTextColorLight));
+    }
+    if (_config.toolBarColorDark != current.toolBarColorDark)
+    {
+      this->SetToolBarColorDark(QString::fromStdString(
+          _config.toolBarColorDark));
+    }
+    if (_config.toolBarTextColorDark != current.toolBarTextColorDark)
+    {
+      this->SetToolBarTextColorDark(QString::fromStdString(
+          _config.toolBarTextColorDark));
+    }
 
-    this->SetPluginToolBarColorLight(QString::fromStdString(
-        _config.pluginToolBarColorLight));
-    this->SetPluginToolBarTextColorLight(QString::fromStdString(
-        _config.pluginToolBarTextColorLight));
-    this->SetPluginToolBarColorDark(QString::fromStdString(
-        _config.pluginToolBarColorDark));
-    this->SetPluginToolBarTextColorDark(QString::fromStdString(
-        _config.pluginToolBarTextColorDark));
+    // CurrentWindowConfig doesn't report plugin toolbar colors, so
+    // compare against the last applied config instead
+    const auto &prev = this->dataPtr->windowConfig;
+    if (_config.pluginToolBarColorLight != prev.pluginToolBarColorLight)
+    {
+      this->SetPluginToolBarColorLight(QString::fromStdString(
+          _config.pluginToolBarColorLight));
+    }
+    if (_config.pluginToolBarTextColorLight !=
+        prev.pluginToolBarTextColorLight)
+    {
+      this->SetPluginToolBarTextColorLight(QString::fromStdString(
+          _config.pluginToolBarTextColorLight));
+    }
+    if (_config.pluginToolBarColorDark != prev.pluginToolBarColorDark)
+    {
+      this->SetPluginToolBarColorDark(QString::fromStdString(
+          _config.pluginToolBarColorDark));
+    }
+    if (_config.pluginToolBarTextColorDark !=
+        prev.pluginToolBarTextColorDark)
+    {
+      this->SetPluginToolBarTextColorDark(QString::fromStdString(
+          _config.pluginToolBarTextColorDark));
+    }
   }
 
   // Menus
-  this->SetShowDrawer(_config.showDrawer);
-  this->SetShowDefaultDrawerOpts(_config.showDefaultDrawerOpts);
-  this->SetShowPluginMenu(_config.showPluginMenu);
+  if (_config.showDrawer != current.showDrawer)
+    this->SetShowDrawer(_config.showDrawer);
+  if (_config.showDefaultDrawerOpts != current.showDefaultDrawerOpts)
+    this->SetShowDefaultDrawerOpts(_config.showDefaultDrawerOpts);
+  if (_config.showPluginMenu != current.showPluginMenu)
+    this->SetShowPluginMenu(_config.showPluginMenu);
 
-  // Keep a copy
-  this->dataPtr->windowConfig = _config;
+  // Keep it, stealing the buffers
+  this->dataPtr->windowConfig = std::move(_config);
+
+  // Sync the plugins menu with the new config, touching only the rows
+  // that changed
+  this->UpdatePluginListModel();
 
   // Notify view
   this->configChanged();
@@ -314,10 +651,12 @@ WindowConfig MainWindow::CurrentWindowConfig() const
   config.showPlugins = this->dataPtr->windowConfig.showPlugins;
   config.ignoredProps = this->dataPtr->windowConfig.ignoredProps;
 
-  // Plugins
+  // Plugins: only capture cheap snapshots here; XMLString renders
+  // them to XML, which lets saves keep the tinyxml2 work off the GUI
+  // thread
   auto plugins = this->findChildren<Plugin *>();
   for (const auto plugin : plugins)
-    config.plugins += plugin->ConfigStr();
+    config.pluginSnapshots.push_back(plugin->ConfigSnapshot());
 
   return config;
 }
@@ -482,6 +821,199 @@ bool WindowConfig::MergeFromXML(const std::string &_windowXml)
   return true;
 }
 
+/// \brief Format version of the WindowConfig binary representation.
+/// Bump whenever fields are added, removed or reordered.
+static const qint32 kWindowConfigBinaryVersion{1};
+
+/////////////////////////////////////////////////
+QByteArray WindowConfig::ToBinary() const
+{
+  QByteArray buffer;
+  QDataStream stream(&buffer, QIODevice::WriteOnly);
+  stream.setVersion(QDataStream::Qt_5_9);
+
+  stream << kWindowConfigBinaryVersion
+         << qint32(this->posX)
+         << qint32(this->posY)
+         << qint32(this->width)
+         << qint32(this->height)
+         << this->state
+         << QString::fromStdString(this->materialTheme)
+         << QString::fromStdString(this->materialPrimary)
+         << QString::fromStdString(this->materialAccent)
+         << QString::fromStdString(this->toolBarColorLight)
+         << QString::fromStdString(this->toolBarTextColorLight)
+         << QString::fromStdString(this->toolBarColorDark)
+         << QString::fromStdString(this->toolBarTextColorDark)
+         << QString::fromStdString(this->pluginToolBarColorLight)
+         << QString::fromStdString(this->pluginToolBarTextColorLight)
+         << QString::fromStdString(this->pluginToolBarColorDark)
+         << QString::fromStdString(this->pluginToolBarTextColorDark)
+         << this->showDrawer
+         << this->showDefaultDrawerOpts
+         << this->showPluginMenu
+         << this->pluginsFromPaths;
+
+  stream << qint32(this->showPlugins.size());
+  for (auto const &plugin : this->showPlugins)
+    stream << QString::fromStdString(plugin);
+
+  stream << qint32(this->ignoredProps.size());
+  for (auto const &prop : this->ignoredProps)
+    stream << QString::fromStdString(prop);
+
+  stream << QString::fromStdString(this->plugins);
+
+  return buffer;
+}
+
+/////////////////////////////////////////////////
+bool WindowConfig::FromBinary(const QByteArray &_buffer)
+{
+  QDataStream stream(_buffer);
+  stream.setVersion(QDataStream::Qt_5_9);
+
+  qint32 version;
+  stream >> version;
+  if (version != kWindowConfigBinaryVersion)
+    return false;
+
+  // Read into a temporary so a truncated or corrupt buffer doesn't
+  // leave this config half-applied
+  WindowConfig config;
+
+  qint32 posXIn, posYIn, widthIn, heightIn;
+  QString materialThemeIn, materialPrimaryIn, materialAccentIn,
+      toolBarColorLightIn, toolBarTextColorLightIn, toolBarColorDarkIn,
+      toolBarTextColorDarkIn, pluginToolBarColorLightIn,
+      pluginToolBarTextColorLightIn, pluginToolBarColorDarkIn,
+      pluginToolBarTextColorDarkIn;
+
+  stream >> posXIn
+         >> posYIn
+         >> widthIn
+         >> heightIn
+         >> config.state
+         >> materialThemeIn
+         >> materialPrimaryIn
+         >> materialAccentIn
+         >> toolBarColorLightIn
+         >> toolBarTextColorLightIn
+         >> toolBarColorDarkIn
+         >> toolBarTextColorDarkIn
+         >> pluginToolBarColorLightIn
+         >> pluginToolBarTextColorLightIn
+         >> pluginToolBarColorDarkIn
+         >> pluginToolBarTextColorDarkIn
+         >> config.showDrawer
+         >> config.showDefaultDrawerOpts
+         >> config.showPluginMenu
+         >> config.pluginsFromPaths;
+
+  qint32 showCount;
+  stream >> showCount;
+  for (qint32 i = 0; i < showCount && stream.status() == QDataStream::Ok;
+      ++i)
+  {
+    QString plugin;
+    stream >> plugin;
+    config.showPlugins.push_back(plugin.toStdString());
+  }
+
+  qint32 ignoredCount;
+  stream >> ignoredCount;
+  for (qint32 i = 0; i < ignoredCount && stream.status() == QDataStream::Ok;
+      ++i)
+  {
+    QString prop;
+    stream >> prop;
+    config.ignoredProps.insert(prop.toStdString());
+  }
+
+  QString pluginsIn;
+  stream >> pluginsIn;
+
+  if (stream.status() != QDataStream::Ok)
+    return false;
+
+  config.posX = posXIn;
+  config.posY = posYIn;
+  config.width = widthIn;
+  config.height = heightIn;
+  config.materialTheme = materialThemeIn.toStdString();
+  config.materialPrimary = materialPrimaryIn.toStdString();
+  config.materialAccent = materialAccentIn.toStdString();
+  config.toolBarColorLight = toolBarColorLightIn.toStdString();
+  config.toolBarTextColorLight = toolBarTextColorLightIn.toStdString();
+  config.toolBarColorDark = toolBarColorDarkIn.toStdString();
+  config.toolBarTextColorDark = toolBarTextColorDarkIn.toStdString();
+  config.pluginToolBarColorLight = pluginToolBarColorLightIn.toStdString();
+  config.pluginToolBarTextColorLight =
+      pluginToolBarTextColorLightIn.toStdString();
+  config.pluginToolBarColorDark = pluginToolBarColorDarkIn.toStdString();
+  config.pluginToolBarTextColorDark =
+      pluginToolBarTextColorDarkIn.toStdString();
+  config.plugins = pluginsIn.toStdString();
+
+  *this = config;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t WindowConfig::Fingerprint() const
+{
+  std::size_t seed{0};
+
+  // Standard combiner; the constant is the 64-bit golden ratio
+  auto combine = [&seed](std::size_t _value)
+  {
+    seed ^= _value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+  };
+
+  std::hash<std::string> strHash;
+  std::hash<int> intHash;
+  std::hash<bool> boolHash;
+
+  combine(intHash(this->posX));
+  combine(intHash(this->posY));
+  combine(intHash(this->width));
+  combine(intHash(this->height));
+  combine(qHash(this->state));
+  combine(strHash(this->materialTheme));
+  combine(strHash(this->materialPrimary));
+  combine(strHash(this->materialAccent));
+  combine(strHash(this->toolBarColorLight));
+  combine(strHash(this->toolBarTextColorLight));
+  combine(strHash(this->toolBarColorDark));
+  combine(strHash(this->toolBarTextColorDark));
+  combine(strHash(this->pluginToolBarColorLight));
+  combine(strHash(this->pluginToolBarTextColorLight));
+  combine(strHash(this->pluginToolBarColorDark));
+  combine(strHash(this->pluginToolBarTextColorDark));
+  combine(boolHash(this->showDrawer));
+  combine(boolHash(this->showDefaultDrawerOpts));
+  combine(boolHash(this->showPluginMenu));
+  combine(boolHash(this->pluginsFromPaths));
+  for (const auto &plugin : this->showPlugins)
+    combine(strHash(plugin));
+  for (const auto &prop : this->ignoredProps)
+    combine(strHash(prop));
+  combine(strHash(this->plugins));
+  for (const auto &snapshot : this->pluginSnapshots)
+  {
+    combine(strHash(snapshot.configStr));
+    combine(boolHash(snapshot.anchored));
+    for (const auto &prop : snapshot.properties)
+    {
+      combine(strHash(prop.key));
+      combine(strHash(prop.value));
+    }
+  }
+
+  return seed;
+}
+
 /////////////////////////////////////////////////
 std::string WindowConfig::XMLString() const
 {
@@ -614,6 +1146,8 @@ std::string WindowConfig::XMLString() const
   std::string config = "<?xml version=\"1.0\"?>\n\n";
   config += printer.CStr();
   config += this->plugins;
+  for (const auto &snapshot : this->pluginSnapshots)
+    config += Plugin::ConfigStrFromSnapshot(snapshot);
 
   return config;
 }
@@ -843,3 +1377,306 @@ void MainWindow::SetShowPluginMenu(const bool _showPluginMenu)
   this->dataPtr->windowConfig.showPluginMenu = _showPluginMenu;
   this->ShowPluginMenuChanged();
 }
+
+/////////////////////////////////////////////////
+/// \brief Read this process' resident set size.
+/// \return RSS in kB, or -1 where procfs isn't available.
+static int ReadRssKb()
+{
+#ifdef __linux__
+  // Single small procfs read, cheap enough for periodic sampling
+  std::ifstream statm("/proc/self/statm");
+  long size{0};
+  long resident{0};
+  if (!(statm >> size >> resident))
+    return -1;
+  return static_cast<int>(resident * (sysconf(_SC_PAGESIZE) / 1024));
+#else
+  return -1;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool MainWindow::TelemetryEnabled() const
+{
+  return this->dataPtr->telemetryEnabled;
+}
+
+/////////////////////////////////////////////////
+void MainWindow::SetTelemetryEnabled(const bool _enabled)
+{
+  if (_enabled == this->dataPtr->telemetryEnabled)
+    return;
+
+  this->dataPtr->telemetryEnabled = _enabled;
+
+  if (_enabled)
+  {
+    if (nullptr == this->dataPtr->telemetryTimer)
+    {
+      this->dataPtr->telemetryTimer = new QTimer(this);
+      this->connect(this->dataPtr->telemetryTimer, SIGNAL(timeout()), this,
+          SLOT(OnTelemetryTimeout()));
+    }
+
+    if (!this->dataPtr->telemetryPub.Valid())
+    {
+      this->dataPtr->telemetryPub =
+          App()->TransportNode()->Advertise<msgs::StringMsg>(
+          "/gui/telemetry");
+    }
+
+    this->dataPtr->telemetryTimer->start(this->dataPtr->telemetryInterval);
+  }
+  else if (this->dataPtr->telemetryTimer)
+  {
+    this->dataPtr->telemetryTimer->stop();
+  }
+
+  this->TelemetryEnabledChanged();
+}
+
+/////////////////////////////////////////////////
+int MainWindow::TelemetryInterval() const
+{
+  return this->dataPtr->telemetryInterval;
+}
+
+/////////////////////////////////////////////////
+void MainWindow::SetTelemetryInterval(const int _intervalMs)
+{
+  this->dataPtr->telemetryInterval = _intervalMs;
+
+  if (this->dataPtr->telemetryTimer && this->dataPtr->telemetryEnabled)
+    this->dataPtr->telemetryTimer->start(_intervalMs);
+
+  this->TelemetryIntervalChanged();
+}
+
+/////////////////////////////////////////////////
+int MainWindow::TelemetryRss() const
+{
+  return this->dataPtr->telemetryRss;
+}
+
+/////////////////////////////////////////////////
+int MainWindow::TelemetryObjectCount() const
+{
+  return this->dataPtr->telemetryObjectCount;
+}
+
+/////////////////////////////////////////////////
+void MainWindow::OnTelemetryTimeout()
+{
+  this->dataPtr->telemetryRss = ReadRssKb();
+
+  // Everything hanging off this window plus the QML object tree under
+  // the quick window. Creep in either is what shows up as RSS growth
+  // over long sessions.
+  auto count = this->findChildren<QObject *>().count();
+  if (this->dataPtr->quickWindow)
+    count += this->dataPtr->quickWindow->findChildren<QObject *>().count() + 1;
+  this->dataPtr->telemetryObjectCount = count;
+
+  // One JSON object per sample, with a per-plugin object breakdown so
+  // a leaking plugin can be singled out from fleet data
+  std::ostringstream sample;
+  sample << "{\"rss_kb\": " << this->dataPtr->telemetryRss
+         << ", \"objects\": " << this->dataPtr->telemetryObjectCount;
+
+  // Frame health rides along when the render loop is instrumented
+  if (this->dataPtr->frameStatsEnabled)
+  {
+    sample << ", \"frame\": {\"fps\": " << this->FrameFps()
+           << ", \"avg_ms\": " << this->FrameAvgMs()
+           << ", \"worst_ms\": " << this->FrameWorstMs()
+           << ", \"sync_ms\": " << this->FrameSyncMs()
+           << ", \"render_ms\": " << this->FrameRenderMs()
+           << ", \"long_frames\": " << this->LongFrameCount() << "}";
+  }
+
+  sample << ", \"plugins\": [";
+
+  bool first{true};
+  for (const auto plugin : this->findChildren<Plugin *>())
+  {
+    if (!first)
+      sample << ", ";
+    first = false;
+    sample << "{\"name\": \"" << plugin->objectName().toStdString()
+           << "\", \"objects\": "
+           << plugin->findChildren<QObject *>().count() << "}";
+  }
+  sample << "]}";
+
+  this->TelemetryUpdated();
+
+  if (this->dataPtr->telemetryPub.Valid())
+  {
+    msgs::StringMsg msg;
+    msg.set_data(sample.str());
+    this->dataPtr->telemetryPub.Publish(msg);
+  }
+}
+
+/////////////////////////////////////////////////
+bool MainWindow::FrameStatsEnabled() const
+{
+  return this->dataPtr->frameStatsEnabled;
+}
+
+/////////////////////////////////////////////////
+void MainWindow::SetFrameStatsEnabled(const bool _enabled)
+{
+  if (_enabled == this->dataPtr->frameStatsEnabled ||
+      nullptr == this->dataPtr->quickWindow)
+  {
+    return;
+  }
+
+  this->dataPtr->frameStatsEnabled = _enabled;
+
+  if (_enabled)
+  {
+    auto win = this->dataPtr->quickWindow;
+    auto priv = this->dataPtr.get();
+
+    priv->frameCount = 0;
+    priv->longFrames = 0;
+    priv->lastSwap = std::chrono::steady_clock::time_point();
+
+    // Direct connections run on the render thread; each one is a clock
+    // read and a relaxed store, cheap enough to leave on
+    this->dataPtr->frameStatsConnections.push_back(this->connect(
+        win, &QQuickWindow::beforeSynchronizing, this, [priv]()
+        {
+          priv->syncStart = std::chrono::steady_clock::now();
+        }, Qt::DirectConnection));
+
+    this->dataPtr->frameStatsConnections.push_back(this->connect(
+        win, &QQuickWindow::afterSynchronizing, this, [priv]()
+        {
+          priv->lastSyncUs.store(static_cast<int>(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - priv->syncStart).count()),
+              std::memory_order_relaxed);
+        }, Qt::DirectConnection));
+
+    this->dataPtr->frameStatsConnections.push_back(this->connect(
+        win, &QQuickWindow::beforeRendering, this, [priv]()
+        {
+          priv->renderStart = std::chrono::steady_clock::now();
+        }, Qt::DirectConnection));
+
+    this->dataPtr->frameStatsConnections.push_back(this->connect(
+        win, &QQuickWindow::afterRendering, this, [priv]()
+        {
+          priv->lastRenderUs.store(static_cast<int>(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - priv->renderStart).count()),
+              std::memory_order_relaxed);
+        }, Qt::DirectConnection));
+
+    this->dataPtr->frameStatsConnections.push_back(this->connect(
+        win, &QQuickWindow::frameSwapped, this, [priv]()
+        {
+          auto now = std::chrono::steady_clock::now();
+          if (priv->lastSwap.time_since_epoch().count() != 0)
+          {
+            auto us = static_cast<int>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                now - priv->lastSwap).count());
+
+            auto index = priv->frameCount.fetch_add(1,
+                std::memory_order_relaxed);
+            priv->frameRing[index % priv->frameRing.size()].store(us,
+                std::memory_order_relaxed);
+
+            if (us > 33000)
+              priv->longFrames.fetch_add(1, std::memory_order_relaxed);
+          }
+          priv->lastSwap = now;
+        }, Qt::DirectConnection));
+
+    if (nullptr == this->dataPtr->frameStatsTimer)
+    {
+      this->dataPtr->frameStatsTimer = new QTimer(this);
+      this->connect(this->dataPtr->frameStatsTimer, SIGNAL(timeout()), this,
+          SLOT(OnFrameStatsTimeout()));
+    }
+    this->dataPtr->frameStatsTimer->start(500);
+  }
+  else
+  {
+    for (auto &connection : this->dataPtr->frameStatsConnections)
+      this->disconnect(connection);
+    this->dataPtr->frameStatsConnections.clear();
+
+    if (this->dataPtr->frameStatsTimer)
+      this->dataPtr->frameStatsTimer->stop();
+  }
+
+  this->FrameStatsEnabledChanged();
+}
+
+/////////////////////////////////////////////////
+double MainWindow::FrameFps() const
+{
+  return this->dataPtr->frameFps;
+}
+
+/////////////////////////////////////////////////
+double MainWindow::FrameAvgMs() const
+{
+  return this->dataPtr->frameAvgMs;
+}
+
+/////////////////////////////////////////////////
+double MainWindow::FrameWorstMs() const
+{
+  return this->dataPtr->frameWorstMs;
+}
+
+/////////////////////////////////////////////////
+double MainWindow::FrameSyncMs() const
+{
+  return this->dataPtr->lastSyncUs.load(std::memory_order_relaxed) / 1000.0;
+}
+
+/////////////////////////////////////////////////
+double MainWindow::FrameRenderMs() const
+{
+  return this->dataPtr->lastRenderUs.load(std::memory_order_relaxed) / 1000.0;
+}
+
+/////////////////////////////////////////////////
+int MainWindow::LongFrameCount() const
+{
+  return this->dataPtr->longFrames.load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void MainWindow::OnFrameStatsTimeout()
+{
+  auto total = this->dataPtr->frameCount.load(std::memory_order_relaxed);
+  auto count = std::min(total, this->dataPtr->frameRing.size());
+  if (count == 0)
+    return;
+
+  double sumMs{0.0};
+  double worstMs{0.0};
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto ms = this->dataPtr->frameRing[i].load(
+        std::memory_order_relaxed) / 1000.0;
+    sumMs += ms;
+    worstMs = std::max(worstMs, ms);
+  }
+
+  this->dataPtr->frameAvgMs = sumMs / count;
+  this->dataPtr->frameWorstMs = worstMs;
+  this->dataPtr->frameFps = this->dataPtr->frameAvgMs > 0.0 ?
+      1000.0 / this->dataPtr->frameAvgMs : 0.0;
+
+  this->FrameStatsUpdated();
+}
@@ -60,8 +60,9 @@ TEST(MainWindowTest, OnSaveConfig)
 
   // Save to default location
   {
-    // Trigger save
+    // Trigger save and wait for the background write
     mainWindow->OnSaveConfig();
+    mainWindow->WaitForSave();
 
     // Check saved file
     QFile saved(QString::fromStdString(kTestConfigFile));
@@ -93,8 +94,9 @@ TEST(MainWindowTest, OnSaveConfigAs)
 
   // Save to file
   {
-    // Trigger save
+    // Trigger save and wait for the background write
     mainWindow->OnSaveConfigAs(QString::fromStdString(kTestConfigFile));
+    mainWindow->WaitForSave();
 
     // Check saved file
     QFile saved(QString::fromStdString(kTestConfigFile));
@@ -227,6 +229,40 @@ TEST(WindowConfigTest, defaultValues)
   EXPECT_EQ(xml.find("<ignore>"), std::string::npos);
 }
 
+/////////////////////////////////////////////////
+TEST(WindowConfigTest, FingerprintAndMove)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  WindowConfig a;
+  WindowConfig b;
+
+  // Identical configs fingerprint the same
+  EXPECT_EQ(a.Fingerprint(), b.Fingerprint());
+
+  // Any field change is picked up
+  b.width = 1234;
+  EXPECT_NE(a.Fingerprint(), b.Fingerprint());
+
+  b = a;
+  b.materialTheme = "Dark";
+  EXPECT_NE(a.Fingerprint(), b.Fingerprint());
+
+  b = a;
+  b.plugins = "<plugin filename=\"Publisher\"/>";
+  EXPECT_NE(a.Fingerprint(), b.Fingerprint());
+
+  // Moving transfers the contents
+  const auto fingerprint = b.Fingerprint();
+  WindowConfig c(std::move(b));
+  EXPECT_EQ(c.Fingerprint(), fingerprint);
+  EXPECT_EQ(c.plugins, "<plugin filename=\"Publisher\"/>");
+
+  WindowConfig d;
+  d = std::move(c);
+  EXPECT_EQ(d.Fingerprint(), fingerprint);
+}
+
 /////////////////////////////////////////////////
 TEST(WindowConfigTest, mergeFromXML)
 {
@@ -430,3 +466,39 @@ TEST(MainWindowTest, ApplyConfig)
   delete mainWindow;
 }
 
+/////////////////////////////////////////////////
+TEST(MainWindowTest, Telemetry)
+{
+  ignition::common::Console::SetVerbosity(4);
+  Application app(g_argc, g_argv);
+
+  auto mainWindow = App()->findChild<MainWindow *>();
+  ASSERT_NE(nullptr, mainWindow);
+
+  // Off by default, no sample yet
+  EXPECT_FALSE(mainWindow->TelemetryEnabled());
+  EXPECT_EQ(mainWindow->TelemetryObjectCount(), 0);
+
+  mainWindow->SetTelemetryInterval(50);
+  EXPECT_EQ(mainWindow->TelemetryInterval(), 50);
+
+  mainWindow->SetTelemetryEnabled(true);
+  EXPECT_TRUE(mainWindow->TelemetryEnabled());
+
+  // Wait for a sample
+  for (int sleep = 0; sleep < 100 &&
+      mainWindow->TelemetryObjectCount() == 0; ++sleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    QCoreApplication::processEvents();
+  }
+
+  EXPECT_GT(mainWindow->TelemetryObjectCount(), 0);
+#ifdef __linux__
+  EXPECT_GT(mainWindow->TelemetryRss(), 0);
+#endif
+
+  mainWindow->SetTelemetryEnabled(false);
+  EXPECT_FALSE(mainWindow->TelemetryEnabled());
+}
+
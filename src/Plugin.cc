@@ -15,9 +15,12 @@
  *
  */
 
+#include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
 #include "ignition/gui/Application.hh"
 #include "ignition/gui/Helpers.hh"
 #include "ignition/gui/MainWindow.hh"
@@ -51,6 +54,115 @@ static const std::unordered_set<std::string> kIgnoredProps{
     "pluginName",
     "anchored"};
 
+/// \brief One savable property: its meta-property index, so reads and
+/// writes are indexed instead of going through a name lookup, and its
+/// type as spelled in `<property type="...">`.
+struct PropertyDescriptor
+{
+  /// \brief Qt meta-property index
+  int index;
+
+  /// \brief Property name
+  std::string name;
+
+  /// \brief Config file type name
+  std::string type;
+};
+
+/// \brief Descriptor table for one card or plugin type
+struct PropertyTable
+{
+  /// \brief Savable properties, in meta-object order, excluding the
+  /// ignored ones
+  std::vector<PropertyDescriptor> props;
+
+  /// \brief Property name to meta-property index, for applying config
+  std::unordered_map<std::string, int> indexByName;
+};
+
+/// \brief Get the cached descriptor table for a meta-object, building
+/// it on first sight. All cards share one table; plugin types with
+/// their own properties each get their own.
+/// \param[in] _meta Meta-object to describe.
+/// \return Reference to the table.
+static const PropertyTable &CachedPropertyTable(const QMetaObject *_meta)
+{
+  static std::map<const QMetaObject *, PropertyTable> tables;
+
+  auto cached = tables.find(_meta);
+  if (cached != tables.end())
+    return cached->second;
+
+  PropertyTable table;
+  for (int i = 0; i < _meta->propertyCount(); ++i)
+  {
+    auto prop = _meta->property(i);
+
+    std::string type(prop.typeName());
+    if (type == "QString")
+      type = "string";
+    if (type != "double" && type != "int" && type != "bool" &&
+        type != "string")
+    {
+      continue;
+    }
+
+    table.indexByName[prop.name()] = i;
+
+    if (kIgnoredProps.find(prop.name()) != kIgnoredProps.end())
+      continue;
+
+    table.props.push_back({i, prop.name(), type});
+  }
+
+  return tables.emplace(_meta, std::move(table)).first->second;
+}
+
+/// \brief Set a property through its cached meta-property index,
+/// falling back to a name lookup for dynamic properties.
+/// \param[in] _item Item to write to.
+/// \param[in] _key Property name.
+/// \param[in] _value Value to set.
+static void WriteProperty(QQuickItem *_item, const std::string &_key,
+    const QVariant &_value)
+{
+  const auto &table = CachedPropertyTable(_item->metaObject());
+  auto index = table.indexByName.find(_key);
+  if (index != table.indexByName.end())
+    _item->metaObject()->property(index->second).write(_item, _value);
+  else
+    _item->setProperty(_key.c_str(), _value);
+}
+
+/// \brief Cards recycled from closed plugins. Instantiating the card
+/// chrome is the expensive part of adding a plugin, so recently closed
+/// cards are kept warm and handed to the next plugin instead of being
+/// destroyed.
+struct CardPool
+{
+  /// \brief Cards waiting to be reused
+  std::vector<QQuickItem *> cards;
+
+  /// \brief Property values of a pristine card, restored before a card
+  /// is handed out again so nothing from the previous owner leaks
+  /// through
+  std::vector<std::pair<QByteArray, QVariant>> defaults;
+};
+
+/// \brief Most cards kept warm at a time; beyond this, closed cards are
+/// destroyed as before
+static const size_t kMaxPooledCards{5};
+
+/// \brief Get the process-wide card pool. Cards belong to the running
+/// application's QML engine, so ClearCardPool empties the pool before
+/// that engine is torn down.
+/// \return Reference to the pool
+static CardPool &GlobalCardPool()
+{
+  static CardPool pool;
+  return pool;
+}
+
 class ignition::gui::PluginPrivate
 {
   /// \brief Set this to true if the plugin should be deleted as soon as it has
@@ -78,6 +190,13 @@ class ignition::gui::PluginPrivate
 
   /// \brief Holds all anchor information
   public: Anchors anchors;
+
+  /// \brief Name of the QML file, same as the shared library name
+  public: std::string qmlFilename;
+
+  /// \brief True while the plugin's QML and custom configuration are
+  /// deferred, waiting for the card to first become visible
+  public: bool qmlDeferred{false};
 };
 
 using namespace ignition;
@@ -117,16 +236,50 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
   }
 
   // Qml file
-  std::string filename = _pluginElem->Attribute("filename");
+  this->dataPtr->qmlFilename = _pluginElem->Attribute("filename");
+
+  // Load common configuration first, it only touches XML and tells us
+  // whether the card starts out hidden
+  this->LoadCommonConfig(_pluginElem->FirstChildElement("ignition-gui"));
+
+  // Cards configured to start invisible defer their QML and custom
+  // configuration until they're first shown, so hidden plugins don't
+  // delay startup
+  auto visibleProp = this->dataPtr->cardProperties.find("visible");
+  if (visibleProp != this->dataPtr->cardProperties.end() &&
+      !visibleProp->second.toBool())
+  {
+    this->dataPtr->qmlDeferred = true;
+    return;
+  }
+
+  this->InstantiateQml();
+  if (!this->dataPtr->pluginItem)
+    return;
+
+  // Load custom configuration
+  {
+    IGN_PROFILE("Plugin::LoadConfig");
+    this->LoadConfig(_pluginElem);
+  }
+}
+
+/////////////////////////////////////////////////
+void Plugin::InstantiateQml()
+{
+  if (this->dataPtr->pluginItem)
+    return;
+
+  auto filename = this->dataPtr->qmlFilename;
 
   // This let's <filename>.qml use <pluginclass> functions and properties
   this->dataPtr->context = new QQmlContext(App()->Engine()->rootContext());
-  this->dataPtr->context->setContextProperty(QString::fromStdString(filename),
+  this->dataPtr->context->setContextProperty(internedQString(filename),
       this);
 
   // Instantiate plugin QML file into a component
   std::string qmlFile(":/" + filename + "/" + filename + ".qml");
-  QQmlComponent component(App()->Engine(), QString::fromStdString(qmlFile));
+  QQmlComponent component(App()->Engine(), internedQString(qmlFile));
 
   // Create an item for the plugin
   this->dataPtr->pluginItem =
@@ -139,12 +292,51 @@ void Plugin::Load(const tinyxml2::XMLElement *_pluginElem)
            << "You can check with the `qmlscene` tool" << std::endl;
     return;
   }
+}
+
+/////////////////////////////////////////////////
+void Plugin::OnCardVisible()
+{
+  if (!this->dataPtr->qmlDeferred || !this->dataPtr->cardItem ||
+      !this->dataPtr->cardItem->isVisible())
+  {
+    return;
+  }
+  this->dataPtr->qmlDeferred = false;
 
-  // Load common configuration
-  this->LoadCommonConfig(_pluginElem->FirstChildElement("ignition-gui"));
+  this->InstantiateQml();
+  if (!this->dataPtr->pluginItem)
+    return;
 
-  // Load custom configuration
-  this->LoadConfig(_pluginElem);
+  // Run the custom configuration that was skipped at load time
+  tinyxml2::XMLDocument doc;
+  doc.Parse(this->configStr.c_str());
+  if (auto pluginElem = doc.FirstChildElement("plugin"))
+  {
+    IGN_PROFILE("Plugin::LoadConfig");
+    this->LoadConfig(pluginElem);
+  }
+
+  // Attach to the card created while the plugin was deferred
+  auto cardContentItem =
+      this->dataPtr->cardItem->findChild<QQuickItem *>("content");
+  if (cardContentItem)
+    this->dataPtr->pluginItem->setParentItem(cardContentItem);
+
+  // Adjust size to accomodate plugin if not explicitly set in config
+  if (this->dataPtr->cardProperties.find("width") ==
+      this->dataPtr->cardProperties.end())
+  {
+    this->dataPtr->cardItem->setProperty("width",
+        this->dataPtr->pluginItem->property("width").toInt());
+  }
+
+  if (this->dataPtr->cardProperties.find("height") ==
+      this->dataPtr->cardProperties.end())
+  {
+    this->dataPtr->cardItem->setProperty("height",
+        this->dataPtr->pluginItem->property("height").toInt());
+  }
 }
 
 /////////////////////////////////////////////////
@@ -176,42 +368,60 @@ void Plugin::LoadCommonConfig(const tinyxml2::XMLElement *_ignGuiElem)
       propElem != nullptr;
       propElem = propElem->NextSiblingElement("property"))
   {
+    // Dispatch on the declared type through a static table instead of
+    // comparing type names for every property
+    enum class PropType { BOOL, INT, DOUBLE, STRING };
+    static const std::unordered_map<std::string, PropType> kPropTypes{
+        {"bool", PropType::BOOL},
+        {"int", PropType::INT},
+        {"double", PropType::DOUBLE},
+        {"string", PropType::STRING}};
+
     std::string key = propElem->Attribute("key");
     std::string type = propElem->Attribute("type");
     QVariant variant;
 
-    if (type == "bool")
-    {
-      bool value;
-      propElem->QueryBoolText(&value);
-      variant = QVariant(value);
-    }
-    else if (type == "int")
-    {
-      int value;
-      propElem->QueryIntText(&value);
-      variant = QVariant(value);
-    }
-    else if (type == "double")
+    auto propType = kPropTypes.find(type);
+    if (propType == kPropTypes.end())
     {
-      double value;
-      propElem->QueryDoubleText(&value);
-      variant = QVariant(value);
+      ignwarn << "Property type [" << type << "] not supported." << std::endl;
+      continue;
     }
-    else if (type == "string")
+
+    switch (propType->second)
     {
-      if (nullptr == propElem->GetText())
+      case PropType::BOOL:
       {
-        ignerr << "Invalid string inside [" << key << "]" << std::endl;
-        continue;
+        bool value;
+        propElem->QueryBoolText(&value);
+        variant = QVariant(value);
+        break;
+      }
+      case PropType::INT:
+      {
+        int value;
+        propElem->QueryIntText(&value);
+        variant = QVariant(value);
+        break;
+      }
+      case PropType::DOUBLE:
+      {
+        double value;
+        propElem->QueryDoubleText(&value);
+        variant = QVariant(value);
+        break;
+      }
+      case PropType::STRING:
+      {
+        if (nullptr == propElem->GetText())
+        {
+          ignerr << "Invalid string inside [" << key << "]" << std::endl;
+          continue;
+        }
+        std::string value = propElem->GetText();
+        variant = QVariant(QString::fromStdString(value));
+        break;
       }
-      std::string value = propElem->GetText();
-      variant = QVariant(QString::fromStdString(value));
-    }
-    else
-    {
-      ignwarn << "Property type [" << type << "] not supported." << std::endl;
-      continue;
     }
 
     this->dataPtr->cardProperties[key] = variant;
@@ -255,9 +465,38 @@ std::string Plugin::ConfigStr()
   // TODO(anyone): When plugins override this function they will lose the
   // card updates, must refactor config handling
 
+  this->configStr = ConfigStrFromSnapshot(this->ConfigSnapshot());
+  return this->configStr;
+}
+
+/////////////////////////////////////////////////
+PluginConfigSnapshot Plugin::ConfigSnapshot() const
+{
+  PluginConfigSnapshot snapshot;
+  snapshot.configStr = this->configStr;
+
+  // Read the card properties through the cached descriptor table, so
+  // each snapshot is indexed reads instead of type name comparisons
+  auto cardItem = this->CardItem();
+  auto meta = cardItem->metaObject();
+  for (const auto &desc : CachedPropertyTable(meta).props)
+  {
+    snapshot.properties.push_back({desc.name, desc.type,
+        meta->property(desc.index).read(cardItem).toString().toStdString()});
+  }
+
+  snapshot.anchored = cardItem->property("anchored").toBool();
+
+  return snapshot;
+}
+
+/////////////////////////////////////////////////
+std::string Plugin::ConfigStrFromSnapshot(
+    const PluginConfigSnapshot &_snapshot)
+{
   // Convert string to XML
   tinyxml2::XMLDocument doc;
-  doc.Parse(this->configStr.c_str());
+  doc.Parse(_snapshot.configStr.c_str());
 
   // <plugin>
   auto pluginElem = doc.FirstChildElement("plugin");
@@ -265,7 +504,7 @@ std::string Plugin::ConfigStr()
   {
     ignerr << "Missing <plugin> element, not updating config string."
            << std::endl;
-    return this->configStr;
+    return _snapshot.configStr;
   }
 
   // <ignition-gui>
@@ -286,40 +525,18 @@ std::string Plugin::ConfigStr()
   }
 
   // Add <property>s
-  auto meta = this->CardItem()->metaObject();
-  for (int i = 0; i < meta->propertyCount(); ++i)
+  for (const auto &prop : _snapshot.properties)
   {
-    auto key = meta->property(i).name();
-    auto type = std::string(meta->property(i).typeName());
-
-    // Explicitly skip some keys
-    if (kIgnoredProps.find(key) != kAnchorLineSet.end())
-      continue;
-
-    // When setting, it will need to be string
-    if (type == "QString")
-      type = "string";
-
-    std::string value;
-    if (type != "double" && type != "int" && type != "bool" && type != "string")
-    {
-      continue;
-    }
-
-    value = this->CardItem()->property(meta->property(i).name())
-            .toString().toStdString();
-
     auto elem = doc.NewElement("property");
-    elem->SetAttribute("key", key);
-    elem->SetAttribute("type", type.c_str());
-    elem->SetText(value.c_str());
+    elem->SetAttribute("key", prop.key.c_str());
+    elem->SetAttribute("type", prop.type.c_str());
+    elem->SetText(prop.value.c_str());
     ignGuiElem->InsertEndChild(elem);
   }
 
   // Remove <anchors> if needed
   // TODO(louise) Support setting anchors from UI and then saving it.
-  auto anchored = this->CardItem()->property("anchored").toBool();
-  if (!anchored)
+  if (!_snapshot.anchored)
   {
     for (auto anchorElem = ignGuiElem->FirstChildElement("anchors");
         anchorElem != nullptr;)
@@ -334,15 +551,12 @@ std::string Plugin::ConfigStr()
   tinyxml2::XMLPrinter printer;
   if (!pluginElem->Accept(&printer))
   {
-    ignwarn << "There was an error parsing the plugin element for " <<
-        "[" << this->title << "]." << std::endl;
-  }
-  else
-  {
-    this->configStr = std::string(printer.CStr());
+    ignwarn << "There was an error printing the plugin element."
+            << std::endl;
+    return _snapshot.configStr;
   }
 
-  return this->configStr;
+  return std::string(printer.CStr());
 }
 
 /////////////////////////////////////////////////
@@ -374,23 +588,52 @@ QQuickItem *Plugin::PluginItem() const
 /////////////////////////////////////////////////
 QQuickItem *Plugin::CardItem() const
 {
-  if (!this->dataPtr->pluginItem)
+  if (!this->dataPtr->pluginItem && !this->dataPtr->qmlDeferred)
     return nullptr;
 
   // If already created, just return it
   if (this->dataPtr->cardItem)
     return this->dataPtr->cardItem;
 
-  // Instantiate a card
-  std::string qmlFile(":qml/IgnCard.qml");
-  QQmlComponent cardComp(App()->Engine(),
-      QString(QString::fromStdString(qmlFile)));
-  auto cardItem = qobject_cast<QQuickItem *>(cardComp.create());
-  if (!cardItem)
+  // Take a recycled card when one is available
+  auto &pool = GlobalCardPool();
+  QQuickItem *cardItem = nullptr;
+  if (!pool.cards.empty())
   {
-    ignerr << "Internal error: Failed to instantiate QML file [" << qmlFile
-           << "]" << std::endl;
-    return nullptr;
+    cardItem = pool.cards.back();
+    pool.cards.pop_back();
+
+    for (const auto &prop : pool.defaults)
+      cardItem->setProperty(prop.first, prop.second);
+  }
+  else
+  {
+    // Instantiate a card
+    std::string qmlFile(":qml/IgnCard.qml");
+    QQmlComponent cardComp(App()->Engine(),
+        internedQString(qmlFile));
+    cardItem = qobject_cast<QQuickItem *>(cardComp.create());
+    if (!cardItem)
+    {
+      ignerr << "Internal error: Failed to instantiate QML file [" << qmlFile
+             << "]" << std::endl;
+      return nullptr;
+    }
+
+    // Snapshot a pristine card's simple properties once, to reset
+    // recycled cards with. The generated unique object name is kept.
+    if (pool.defaults.empty())
+    {
+      auto meta = cardItem->metaObject();
+      for (const auto &entry : CachedPropertyTable(meta).indexByName)
+      {
+        if (entry.first == "objectName")
+          continue;
+
+        auto prop = meta->property(entry.second);
+        pool.defaults.push_back({prop.name(), prop.read(cardItem)});
+      }
+    }
   }
 
   // C++ ownership
@@ -411,35 +654,47 @@ QQuickItem *Plugin::CardItem() const
     return nullptr;
   }
 
-  // Add plugin to card content
-  this->dataPtr->pluginItem->setParentItem(cardContentItem);
+  // Add plugin to card content. Deferred plugins attach when their QML
+  // is instantiated on first show instead.
+  if (this->dataPtr->pluginItem)
+  {
+    this->dataPtr->pluginItem->setParentItem(cardContentItem);
+  }
+  else
+  {
+    this->connect(cardItem, SIGNAL(visibleChanged()), this,
+        SLOT(OnCardVisible()));
+  }
 
   // Configure card
   cardItem->setProperty("pluginName",
-      QString::fromStdString(this->Title()));
+      internedQString(this->Title()));
 
-  for (auto prop : this->dataPtr->cardProperties)
+  for (const auto &prop : this->dataPtr->cardProperties)
   {
     // Skip and only apply once it's reparented
     if (prop.first == "state")
       continue;
 
-    cardItem->setProperty(prop.first.c_str(), prop.second);
+    WriteProperty(cardItem, prop.first, prop.second);
   }
 
   // Adjust size to accomodate plugin if not explicitly set in config
-  if (this->dataPtr->cardProperties.find("width") ==
-      this->dataPtr->cardProperties.end())
+  if (this->dataPtr->pluginItem)
   {
-    cardItem->setProperty("width",
-        this->dataPtr->pluginItem->property("width").toInt());
-  }
+    if (this->dataPtr->cardProperties.find("width") ==
+        this->dataPtr->cardProperties.end())
+    {
+      cardItem->setProperty("width",
+          this->dataPtr->pluginItem->property("width").toInt());
+    }
 
-  if (this->dataPtr->cardProperties.find("height") ==
-      this->dataPtr->cardProperties.end())
-  {
-    cardItem->setProperty("height",
-        this->dataPtr->pluginItem->property("height").toInt());
+    if (this->dataPtr->cardProperties.find("height") ==
+        this->dataPtr->cardProperties.end())
+    {
+      cardItem->setProperty("height",
+          this->dataPtr->pluginItem->property("height").toInt());
+    }
   }
 
   this->dataPtr->cardItem = cardItem;
@@ -447,6 +702,43 @@ QQuickItem *Plugin::CardItem() const
   return cardItem;
 }
 
+/////////////////////////////////////////////////
+bool Plugin::ReleaseCard()
+{
+  auto cardItem = this->dataPtr->cardItem;
+  if (!cardItem)
+    return false;
+
+  auto &pool = GlobalCardPool();
+  if (pool.cards.size() >= kMaxPooledCards || pool.defaults.empty())
+    return false;
+
+  // Sever everything tying the card to this plugin: the plugin item,
+  // signal connections, anchors and the scene parent. Detaching from
+  // the scene also keeps the card alive when its split is removed.
+  if (this->dataPtr->pluginItem)
+    this->dataPtr->pluginItem->setParentItem(nullptr);
+
+  cardItem->disconnect();
+  QMetaObject::invokeMethod(cardItem, "clearAnchors");
+  cardItem->setParentItem(nullptr);
+
+  pool.cards.push_back(cardItem);
+  this->dataPtr->cardItem = nullptr;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void Plugin::ClearCardPool()
+{
+  auto &pool = GlobalCardPool();
+  for (auto card : pool.cards)
+    card->deleteLater();
+  pool.cards.clear();
+  pool.defaults.clear();
+}
+
 /////////////////////////////////////////////////
 QQmlContext *Plugin::Context() const
 {
@@ -459,26 +751,40 @@ void Plugin::PostParentChanges()
   // TODO(louise) Test more configuration combinations, the order of operations
   // may be messing up some use cases.
 
+  auto cardItem = this->CardItem();
+
+  // Hide the card while the batch of state, anchor and geometry writes
+  // lands, so the layout settles once when the card reappears instead
+  // of re-evaluating after every write
+  bool wasVisible = cardItem->isVisible();
+  if (wasVisible)
+    cardItem->setVisible(false);
+
   // State
   // Change state now that we have a parent
   if (this->dataPtr->cardProperties.find("state") !=
       this->dataPtr->cardProperties.end())
   {
-    this->CardItem()->setProperty("state",
-        this->dataPtr->cardProperties["state"]);
+    WriteProperty(cardItem, "state", this->dataPtr->cardProperties["state"]);
   }
 
   // Anchor
   this->ApplyAnchors();
 
   // Re-apply other properties like size and position if present
-  for (auto prop : this->dataPtr->cardProperties)
+  for (const auto &prop : this->dataPtr->cardProperties)
   {
-    if (prop.first == "state")
+    // Visibility is restored once, at the end of the batch
+    if (prop.first == "state" || prop.first == "visible")
       continue;
 
-    this->CardItem()->setProperty(prop.first.c_str(), prop.second);
+    WriteProperty(cardItem, prop.first, prop.second);
   }
+
+  // End of the batch: a single visibility change, a single relayout
+  auto visibleProp = this->dataPtr->cardProperties.find("visible");
+  cardItem->setVisible(visibleProp != this->dataPtr->cardProperties.end() ?
+      visibleProp->second.toBool() : wasVisible);
 }
 
 /////////////////////////////////////////////////
@@ -523,7 +829,7 @@ void Plugin::ApplyAnchors()
     // See if there's a plugin with that name
     target =
         findFirstByProperty(App()->Engine()->findChildren<QQuickItem *>(),
-        "pluginName", QString::fromStdString(this->dataPtr->anchors.target));
+        "pluginName", internedQString(this->dataPtr->anchors.target));
   }
 
   if (!target)
@@ -533,19 +839,29 @@ void Plugin::ApplyAnchors()
     return;
   }
 
+  // Read all target lines up front, then write, so lines set early in
+  // the batch can't feed back into lines read later
+  std::vector<std::pair<std::string, QVariant>> lineValues;
+  lineValues.reserve(this->dataPtr->anchors.lines.size());
+  for (const auto &line : this->dataPtr->anchors.lines)
+  {
+    lineValues.push_back(std::make_pair(line.first,
+        target->property(line.second.c_str())));
+  }
+
   // Reparent so it can be anchored
   this->CardItem()->setParentItem(target);
 
-  // Clear previous anchors
-  QMetaObject::invokeMethod(this->CardItem(), "clearAnchors");
+  // Clear previous anchors, when there are any to clear
+  if (this->CardItem()->property("anchored").toBool())
+    QMetaObject::invokeMethod(this->CardItem(), "clearAnchors");
 
   // Set anchors
   auto cardAnchors = qvariant_cast<QObject *>(
       this->CardItem()->property("anchors"));
-  for (auto line : this->dataPtr->anchors.lines)
+  for (const auto &line : lineValues)
   {
-    cardAnchors->setProperty(line.first.c_str(),
-        target->property(line.second.c_str()));
+    cardAnchors->setProperty(line.first.c_str(), line.second);
   }
   this->CardItem()->setProperty("anchored", true);
 }
@@ -15,6 +15,9 @@
  *
 */
 
+#include <functional>
+#include <utility>
+
 #include <ignition/common/Console.hh>
 
 #include "ignition/gui/Enums.hh"
@@ -23,6 +26,92 @@
 using namespace ignition;
 using namespace gui;
 
+/// \brief Biggest model which is still filtered inline. Bigger models
+/// go through the debounced background pass.
+static const int kInlineFilterMax{500};
+
+/// \brief How long typing must pause before a background pass starts.
+static const int kSearchDebounceMs{100};
+
+/// \brief Fold a string's characters into 64 bits.
+/// \param[in] _text Text to fold.
+/// \return One bit set per distinct character bucket.
+static quint64 CharMask(const QString &_text)
+{
+  quint64 mask = 0u;
+  for (const auto &ch : _text)
+    mask |= 1ull << (ch.unicode() % 64u);
+  return mask;
+}
+
+/////////////////////////////////////////////////
+std::vector<SearchModel::CompiledWord> SearchModel::Compile(
+    const QString &_search)
+{
+  std::vector<CompiledWord> compiled;
+  auto words = _search.toLower().split(" ", QString::SkipEmptyParts);
+  compiled.reserve(words.size());
+  for (const auto &word : words)
+    compiled.push_back({word, CharMask(word)});
+  return compiled;
+}
+
+/////////////////////////////////////////////////
+double SearchModel::WordScore(const CompiledWord &_word,
+    const QString &_text, const quint64 _mask)
+{
+  // quick reject: the row is missing one of the word's characters
+  if ((_mask & _word.mask) != _word.mask)
+    return -1.0;
+
+  if (_text.startsWith(_word.word))
+    return 3.0;
+
+  // substring; a match starting at a word boundary ranks close to a
+  // prefix
+  const auto pos = _text.indexOf(_word.word);
+  if (pos > 0)
+  {
+    const QChar before = _text.at(pos - 1);
+    return (before == ' ' || before == '/' || before == '_' ||
+        before == '.') ? 2.5 : 2.0;
+  }
+
+  // fuzzy subsequence: every word character in order, scored by how
+  // tight the match is. Contiguous runs were caught above, so this is
+  // always below the substring scores.
+  int ti = 0;
+  int first = -1;
+  int last = -1;
+  for (int wi = 0; wi < _word.word.size(); ++wi)
+  {
+    while (ti < _text.size() && _text.at(ti) != _word.word.at(wi))
+      ++ti;
+    if (ti == _text.size())
+      return -1.0;
+    if (first < 0)
+      first = ti;
+    last = ti;
+    ++ti;
+  }
+  return static_cast<double>(_word.word.size()) / (last - first + 1);
+}
+
+/////////////////////////////////////////////////
+double SearchModel::MatchScore(const CompiledWord &_word,
+    const QModelIndex &_id) const
+{
+  const auto &entry = this->IndexedText(_id);
+  return WordScore(_word, entry.text, entry.mask);
+}
+
+/////////////////////////////////////////////////
+SearchModel::~SearchModel()
+{
+  if (this->filterResult.valid())
+    this->filterResult.wait();
+}
+
 /////////////////////////////////////////////////
 bool SearchModel::filterAcceptsRow(const int _srcRow,
       const QModelIndex &_srcParent) const
@@ -37,21 +126,47 @@ bool SearchModel::filterAcceptsRow(const int _srcRow,
     return false;
   }
 
+  // Empty search matches everything.
+  if (this->search.isEmpty())
+  {
+    // Collapsed by default.
+    this->sourceModel()->blockSignals(true);
+    this->sourceModel()->setData(id, false, DataRole::TO_EXPAND);
+    this->sourceModel()->blockSignals(false);
+
+    return true;
+  }
+
+  // Memoized verdict for the current search. Besides serving Qt's own
+  // repeat queries, this collapses the recursion through
+  // HasAcceptedChildren, and a search which extends the previous one
+  // starts out with all of its rejections.
+  QPersistentModelIndex persistentId(id);
+  auto cachedIt = this->matchCache.constFind(persistentId);
+  if (cachedIt != this->matchCache.constEnd())
+    return cachedIt.value();
+
   // Collapsed by default.
   this->sourceModel()->blockSignals(true);
   this->sourceModel()->setData(id, false, DataRole::TO_EXPAND);
   this->sourceModel()->blockSignals(false);
 
-  // Empty search matches everything.
-  if (this->search.isEmpty())
-    return true;
+  bool accepted = true;
+  double score = 0.0;
+
+  // SetSearch compiles the pattern; this only fires when search was
+  // assigned directly
+  if (this->compiledWords.empty())
+    this->compiledWords = Compile(this->search);
 
   // Each word must match at least once, either self, parent or child.
-  auto words = this->search.split(" ");
-  for (auto word : words)
+  for (const auto &word : this->compiledWords)
   {
-    if (word.isEmpty())
-      continue;
+    // Row's own match quality feeds the ranking no matter which rule
+    // accepts it.
+    const double wordScore = this->MatchScore(word, id);
+    if (wordScore > 0.0)
+      score += wordScore;
 
     // Expand this if at least one child contains the word.
     // Note that this is not enough for this to be accepted, we need to match
@@ -67,17 +182,17 @@ bool SearchModel::filterAcceptsRow(const int _srcRow,
     if (this->HasAcceptedChildren(_srcRow, _srcParent))
       continue;
 
-    // Row itself contains this word.
-    if (this->FilterAcceptsRowItself(_srcRow, _srcParent, word))
+    // Row itself matches this word.
+    if (wordScore >= 0.0)
       continue;
 
-    // One of the ancestors contains this word.
+    // One of the ancestors matches this word.
     QModelIndex parentIndex = _srcParent;
     bool parentAccepted = false;
     while (parentIndex.isValid())
     {
-      if (this->FilterAcceptsRowItself(parentIndex.row(),
-          parentIndex.parent(), word))
+      if (this->MatchScore(word, this->sourceModel()->index(
+          parentIndex.row(), 0, parentIndex.parent())) >= 0.0)
       {
         parentAccepted = true;
         break;
@@ -90,10 +205,15 @@ bool SearchModel::filterAcceptsRow(const int _srcRow,
 
     // This word can't be found on the row or a parent, and no child is fully
     // accepted.
-    return false;
+    accepted = false;
+    break;
   }
 
-  return true;
+  this->matchCache.insert(persistentId, accepted);
+  if (accepted)
+    this->matchScores.insert(persistentId, score);
+
+  return accepted;
 }
 
 /////////////////////////////////////////////////
@@ -102,8 +222,7 @@ bool SearchModel::FilterAcceptsRowItself(const int _srcRow,
 {
   auto id = this->sourceModel()->index(_srcRow, 0, _srcParent);
 
-  return (this->sourceModel()->data(id,
-      this->filterRole()).toString().contains(_word, Qt::CaseInsensitive));
+  return this->MatchScore({_word, CharMask(_word)}, id) >= 0.0;
 }
 
 /////////////////////////////////////////////////
@@ -127,15 +246,23 @@ bool SearchModel::HasAcceptedChildren(const int _srcRow,
 /////////////////////////////////////////////////
 bool SearchModel::HasChildAcceptsItself(const QModelIndex &_srcParent,
       const QString &_word) const
+{
+  return this->HasChildAcceptsItself(_srcParent,
+      CompiledWord{_word, CharMask(_word)});
+}
+
+/////////////////////////////////////////////////
+bool SearchModel::HasChildAcceptsItself(const QModelIndex &_srcParent,
+      const CompiledWord &_word) const
 {
   for (int i = 0; i < this->sourceModel()->rowCount(_srcParent); ++i)
   {
     // Check immediate children.
-    if (this->FilterAcceptsRowItself(i, _srcParent, _word))
+    auto item = this->sourceModel()->index(i, 0, _srcParent);
+    if (this->MatchScore(_word, item) >= 0.0)
       return true;
 
     // Check grandchildren.
-    auto item = this->sourceModel()->index(i, 0, _srcParent);
     if (this->HasChildAcceptsItself(item, _word))
       return true;
   }
@@ -143,10 +270,328 @@ bool SearchModel::HasChildAcceptsItself(const QModelIndex &_srcParent,
   return false;
 }
 
+/////////////////////////////////////////////////
+const SearchModel::IndexedEntry &SearchModel::IndexedText(
+    const QModelIndex &_id) const
+{
+  auto it = this->textIndex.constFind(QPersistentModelIndex(_id));
+  if (it == this->textIndex.constEnd())
+  {
+    IndexedEntry entry;
+    entry.text = this->sourceModel()->data(_id, this->filterRole())
+        .toString().toLower();
+    entry.mask = CharMask(entry.text);
+    it = this->textIndex.insert(QPersistentModelIndex(_id),
+        std::move(entry));
+  }
+  return it.value();
+}
+
+/////////////////////////////////////////////////
+const QString &SearchModel::CollationKey(const QModelIndex &_id) const
+{
+  auto it = this->collationKeys.constFind(QPersistentModelIndex(_id));
+  if (it == this->collationKeys.constEnd())
+  {
+    it = this->collationKeys.insert(QPersistentModelIndex(_id),
+        this->sourceModel()->data(_id, this->sortRole())
+            .toString().toLower());
+  }
+  return it.value();
+}
+
+/////////////////////////////////////////////////
+bool SearchModel::lessThan(const QModelIndex &_left,
+    const QModelIndex &_right) const
+{
+  // While a search is active, better matches sort first
+  if (!this->search.isEmpty())
+  {
+    const auto leftScore =
+        this->matchScores.value(QPersistentModelIndex(_left), 0.0);
+    const auto rightScore =
+        this->matchScores.value(QPersistentModelIndex(_right), 0.0);
+    if (leftScore != rightScore)
+      return leftScore > rightScore;
+  }
+
+  return this->CollationKey(_left) < this->CollationKey(_right);
+}
+
+/////////////////////////////////////////////////
+void SearchModel::setSourceModel(QAbstractItemModel *_sourceModel)
+{
+  QSortFilterProxyModel::setSourceModel(_sourceModel);
+
+  if (nullptr == _sourceModel)
+    return;
+
+  // Any change to the source drops the caches; they're rebuilt lazily
+  // as rows are filtered again. Our own TO_EXPAND updates don't land
+  // here because their signals are blocked.
+  auto clearCaches = [this]()
+  {
+    this->textIndex.clear();
+    this->matchCache.clear();
+    this->matchScores.clear();
+    this->collationKeys.clear();
+    this->snapshot.reset();
+    this->snapshotIds.clear();
+    ++this->snapshotGeneration;
+  };
+  this->connect(_sourceModel, &QAbstractItemModel::dataChanged, this,
+      clearCaches);
+  this->connect(_sourceModel, &QAbstractItemModel::rowsInserted, this,
+      clearCaches);
+  this->connect(_sourceModel, &QAbstractItemModel::rowsRemoved, this,
+      clearCaches);
+  this->connect(_sourceModel, &QAbstractItemModel::modelReset, this,
+      clearCaches);
+  this->connect(_sourceModel, &QAbstractItemModel::layoutChanged, this,
+      clearCaches);
+}
+
+/////////////////////////////////////////////////
+int SearchModel::EnsureSnapshot()
+{
+  if (this->snapshot)
+    return static_cast<int>(this->snapshot->size());
+
+  auto rows = std::make_shared<std::vector<RowSnapshot>>();
+  this->snapshotIds.clear();
+
+  // Depth-first, so every row's ancestors are snapshotted before it
+  std::function<void(const QModelIndex &, int)> walk =
+      [&](const QModelIndex &_parent, const int _parentPos)
+  {
+    for (int i = 0; i < this->sourceModel()->rowCount(_parent); ++i)
+    {
+      auto id = this->sourceModel()->index(i, 0, _parent);
+
+      RowSnapshot row;
+      const auto &entry = this->IndexedText(id);
+      row.text = entry.text;
+      row.mask = entry.mask;
+      row.parent = _parentPos;
+      row.title = this->sourceModel()->data(id, DataRole::TYPE)
+          .toString() == "title";
+
+      auto pos = static_cast<int>(rows->size());
+      rows->push_back(std::move(row));
+      this->snapshotIds.push_back(QPersistentModelIndex(id));
+
+      if (_parentPos >= 0)
+        (*rows)[_parentPos].children.push_back(pos);
+
+      walk(id, pos);
+    }
+  };
+  walk(QModelIndex(), -1);
+
+  this->snapshot = rows;
+  return static_cast<int>(rows->size());
+}
+
+/////////////////////////////////////////////////
+void SearchModel::OnSearchTimeout()
+{
+  this->EnsureSnapshot();
+
+  auto rows = this->snapshot;
+  auto search = this->pendingSearch;
+  auto generation = this->snapshotGeneration;
+
+  // At most one pass runs at a time; with the debounce window this
+  // wait is only ever hit by a pathologically slow pass
+  if (this->filterResult.valid())
+    this->filterResult.wait();
+
+  this->filterResult = std::async(std::launch::async,
+      [this, rows, search, generation]()
+      {
+        const auto count = rows->size();
+
+        // True while every word so far matched the row or an ancestor
+        std::vector<bool> acceptSelf(count, true);
+        std::vector<bool> accepted(count, false);
+        std::vector<bool> expand(count, false);
+        std::vector<double> scores(count, 0.0);
+
+        // the pattern is compiled once for the whole pass
+        const auto words = Compile(search);
+        for (const auto &word : words)
+        {
+          // Word found in the row's own text
+          std::vector<bool> self(count, false);
+
+          // Word found in the row's own text or an ancestor's
+          std::vector<bool> chain(count, false);
+
+          // Word found in a descendant's own text, which expands the row
+          std::vector<bool> desc(count, false);
+
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            const double score =
+                WordScore(word, (*rows)[i].text, (*rows)[i].mask);
+            self[i] = score >= 0.0;
+            if (score > 0.0)
+              scores[i] += score;
+
+            auto parent = (*rows)[i].parent;
+            chain[i] = self[i] || (parent >= 0 && chain[parent]);
+          }
+
+          for (auto i = count; i-- > 0;)
+          {
+            auto parent = (*rows)[i].parent;
+            if (parent >= 0 && (self[i] || desc[i]))
+              desc[parent] = true;
+          }
+
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            if (!chain[i])
+              acceptSelf[i] = false;
+            if (desc[i])
+              expand[i] = true;
+          }
+        }
+
+        // A row is accepted when every word matched it or an ancestor,
+        // or when any descendant is accepted. Children come after their
+        // parents, so walking backwards sees them first.
+        for (auto i = count; i-- > 0;)
+        {
+          if ((*rows)[i].title)
+            continue;
+
+          bool childAccepted = false;
+          for (auto child : (*rows)[i].children)
+          {
+            if (accepted[child])
+            {
+              childAccepted = true;
+              break;
+            }
+          }
+
+          accepted[i] = acceptSelf[i] || childAccepted;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(this->resultMutex);
+          this->resultSearch = search;
+          this->resultGeneration = generation;
+          this->resultAccepted = std::move(accepted);
+          this->resultExpand = std::move(expand);
+          this->resultScores = std::move(scores);
+        }
+
+        emit this->FilterReady();
+      });
+}
+
+/////////////////////////////////////////////////
+void SearchModel::OnFilterReady()
+{
+  QString search;
+  int generation;
+  std::vector<bool> accepted;
+  std::vector<bool> expand;
+  std::vector<double> scores;
+  {
+    std::lock_guard<std::mutex> lock(this->resultMutex);
+    search = this->resultSearch;
+    generation = this->resultGeneration;
+    accepted = std::move(this->resultAccepted);
+    expand = std::move(this->resultExpand);
+    scores = std::move(this->resultScores);
+  }
+
+  // Stale pass: the model changed, or the user kept typing and the
+  // debounce timer will start a fresh pass
+  if (generation != this->snapshotGeneration ||
+      search != this->pendingSearch ||
+      static_cast<int>(accepted.size()) != this->snapshotIds.count())
+  {
+    return;
+  }
+
+  this->search = search;
+  this->compiledWords = Compile(search);
+  this->matchCache.clear();
+  this->matchScores.clear();
+
+  this->sourceModel()->blockSignals(true);
+  for (int i = 0; i < this->snapshotIds.count(); ++i)
+  {
+    const auto &id = this->snapshotIds[i];
+    if (!id.isValid())
+      continue;
+
+    this->matchCache.insert(id, accepted[i]);
+    if (accepted[i])
+      this->matchScores.insert(id, scores[i]);
+    this->sourceModel()->setData(id, expand[i], DataRole::TO_EXPAND);
+  }
+  this->sourceModel()->blockSignals(false);
+
+  // Trigger repaint on whole model
+  this->invalidateFilter();
+  this->layoutChanged();
+}
+
 /////////////////////////////////////////////////
 void SearchModel::SetSearch(const QString &_search)
 {
+  // Models small enough to filter well within a frame keep the
+  // synchronous path; big trees go through the debounced background
+  // pass so typing never blocks on a full re-filter.
+  if (nullptr != this->sourceModel() &&
+      this->EnsureSnapshot() > kInlineFilterMax)
+  {
+    this->pendingSearch = _search;
+
+    if (nullptr == this->searchTimer)
+    {
+      this->searchTimer = new QTimer(this);
+      this->searchTimer->setSingleShot(true);
+      this->searchTimer->setInterval(kSearchDebounceMs);
+      this->connect(this->searchTimer, &QTimer::timeout, this,
+          &SearchModel::OnSearchTimeout);
+
+      // The pass finishes on its worker thread; queue the swap onto
+      // the GUI thread
+      this->connect(this, &SearchModel::FilterReady, this,
+          &SearchModel::OnFilterReady, Qt::QueuedConnection);
+    }
+    this->searchTimer->start();
+    return;
+  }
+
+  // A search which extends the previous one can only narrow its
+  // results (per word, a longer prefix, substring or subsequence
+  // matches fewer rows), so rows it rejected stay rejected and only
+  // the previous matches are checked again.
+  if (!this->search.isEmpty() && _search.startsWith(this->search))
+  {
+    for (auto it = this->matchCache.begin(); it != this->matchCache.end();)
+    {
+      if (it.value())
+        it = this->matchCache.erase(it);
+      else
+        ++it;
+    }
+  }
+  else
+  {
+    this->matchCache.clear();
+  }
+  this->matchScores.clear();
+
   this->search = _search;
+  this->compiledWords = Compile(_search);
 
   // Trigger repaint on whole model
   this->invalidateFilter();
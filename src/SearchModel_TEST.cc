@@ -96,6 +96,52 @@ TEST(SearchModelTest, FlatStructure)
   EXPECT_EQ(searchModel->rowCount(), 1);
 }
 
+/////////////////////////////////////////////////
+TEST(SearchModelTest, FuzzyMatchAndRanking)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  // A source model
+  auto sourceModel = new QStandardItemModel();
+  ASSERT_NE(nullptr, sourceModel);
+
+  std::vector<std::string> items = {"compose", "set_pose", "pose",
+      "camera_info"};
+  for (size_t i = 0; i < items.size(); ++i)
+  {
+    auto it = new QStandardItem();
+    ASSERT_NE(nullptr, it);
+    it->setData(items[i].c_str(), DataRole::DISPLAY_NAME);
+    sourceModel->insertRow(i, it);
+  }
+
+  // A search model
+  auto searchModel = new SearchModel();
+  ASSERT_NE(nullptr, searchModel);
+
+  searchModel->setFilterRole(DataRole::DISPLAY_NAME);
+  searchModel->setSortRole(DataRole::DISPLAY_NAME);
+  searchModel->setSourceModel(sourceModel);
+
+  // Fuzzy subsequence matching: characters in order, gaps allowed
+  searchModel->SetSearch("cminfo");
+  EXPECT_EQ(searchModel->rowCount(), 1);
+  EXPECT_EQ(searchModel->data(searchModel->index(0, 0),
+      DataRole::DISPLAY_NAME).toString(), "camera_info");
+
+  // Prefix matches rank above boundary matches, which rank above plain
+  // substring matches
+  searchModel->SetSearch("pose");
+  searchModel->sort(0);
+  EXPECT_EQ(searchModel->rowCount(), 3);
+  EXPECT_EQ(searchModel->data(searchModel->index(0, 0),
+      DataRole::DISPLAY_NAME).toString(), "pose");
+  EXPECT_EQ(searchModel->data(searchModel->index(1, 0),
+      DataRole::DISPLAY_NAME).toString(), "set_pose");
+  EXPECT_EQ(searchModel->data(searchModel->index(2, 0),
+      DataRole::DISPLAY_NAME).toString(), "compose");
+}
+
 /////////////////////////////////////////////////
 TEST(SearchModelTest, NestedStructure)
 {
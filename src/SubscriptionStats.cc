@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+
+#include "ignition/gui/SubscriptionStats.hh"
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+void LatencyHistogram::Record(const std::chrono::nanoseconds _duration)
+{
+  auto us = _duration.count() / 1000;
+  if (us < 1)
+    us = 1;
+
+  // bucket index is the position of the highest set bit, clamping
+  // durations beyond the last bucket into it
+  unsigned int bucket = 0u;
+  while (us > 1 && bucket < kBuckets - 1)
+  {
+    us >>= 1;
+    ++bucket;
+  }
+  this->counts[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+uint64_t LatencyHistogram::Count() const
+{
+  uint64_t total{0};
+  for (const auto &count : this->counts)
+    total += count.load(std::memory_order_relaxed);
+  return total;
+}
+
+/////////////////////////////////////////////////
+double LatencyHistogram::PercentileMs(const double _percentile) const
+{
+  const auto total = this->Count();
+  if (0u == total)
+    return 0.0;
+
+  const auto rank = static_cast<uint64_t>(
+      std::ceil(_percentile / 100.0 * total));
+  uint64_t seen{0};
+  for (unsigned int i = 0; i < kBuckets; ++i)
+  {
+    seen += this->counts[i].load(std::memory_order_relaxed);
+    if (seen >= rank)
+      return std::ldexp(1.0, i + 1) / 1000.0;
+  }
+  return std::ldexp(1.0, kBuckets) / 1000.0;
+}
+
+/////////////////////////////////////////////////
+double LatencyHistogram::MaxMs() const
+{
+  for (unsigned int i = kBuckets; i > 0; --i)
+  {
+    if (this->counts[i - 1].load(std::memory_order_relaxed) > 0)
+      return std::ldexp(1.0, i) / 1000.0;
+  }
+  return 0.0;
+}
+
+/////////////////////////////////////////////////
+void LatencyHistogram::Reset()
+{
+  for (auto &count : this->counts)
+    count.store(0, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<SubscriptionStats::Metrics> SubscriptionStats::Register(
+    const std::string &_topic, const std::string &_label)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (const auto &existing : this->metrics)
+  {
+    if (existing->topic == _topic && existing->label == _label)
+      return existing;
+  }
+
+  auto created = std::make_shared<Metrics>();
+  created->topic = _topic;
+  created->label = _label;
+  this->metrics.push_back(created);
+  return created;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::shared_ptr<SubscriptionStats::Metrics>>
+    SubscriptionStats::AllMetrics() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->metrics;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include <ignition/common/Console.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/SubscriptionStats.hh"
+
+using namespace ignition;
+using namespace gui;
+using namespace std::chrono;
+
+/////////////////////////////////////////////////
+TEST(SubscriptionStatsTest, Histogram)
+{
+  common::Console::SetVerbosity(4);
+
+  LatencyHistogram histogram;
+
+  // Empty
+  EXPECT_EQ(0u, histogram.Count());
+  EXPECT_DOUBLE_EQ(0.0, histogram.PercentileMs(50.0));
+  EXPECT_DOUBLE_EQ(0.0, histogram.MaxMs());
+
+  // 99 fast samples and one slow one
+  for (int i = 0; i < 99; ++i)
+    histogram.Record(microseconds(100));
+  histogram.Record(milliseconds(50));
+
+  EXPECT_EQ(100u, histogram.Count());
+
+  // The median bucket covers the fast samples; queries return bucket
+  // upper bounds, so they overestimate by at most 2x
+  EXPECT_LE(histogram.PercentileMs(50.0), 0.256);
+  EXPECT_GE(histogram.PercentileMs(99.0), 50.0 / 1000.0);
+  EXPECT_GE(histogram.MaxMs(), 50.0);
+  EXPECT_LE(histogram.MaxMs(), 100.0);
+
+  // Sub-microsecond and absurdly long samples clamp into the first and
+  // last buckets instead of going out of range
+  histogram.Record(nanoseconds(1));
+  histogram.Record(hours(10));
+  EXPECT_EQ(102u, histogram.Count());
+
+  // A reset restarts the window
+  histogram.Reset();
+  EXPECT_EQ(0u, histogram.Count());
+  EXPECT_DOUBLE_EQ(0.0, histogram.MaxMs());
+}
+
+/////////////////////////////////////////////////
+TEST(SubscriptionStatsTest, Registry)
+{
+  common::Console::SetVerbosity(4);
+
+  SubscriptionStats stats;
+  EXPECT_TRUE(stats.AllMetrics().empty());
+
+  auto metrics = stats.Register("/topic", "My plugin");
+  ASSERT_NE(nullptr, metrics);
+  EXPECT_EQ("/topic", metrics->topic);
+  EXPECT_EQ("My plugin", metrics->label);
+
+  // Re-registering the same subscription continues its history
+  metrics->execution.Record(milliseconds(1));
+  auto again = stats.Register("/topic", "My plugin");
+  EXPECT_EQ(metrics, again);
+  EXPECT_EQ(1u, again->execution.Count());
+
+  // A different label on the same topic is its own subscription
+  auto other = stats.Register("/topic", "Other plugin");
+  EXPECT_NE(metrics, other);
+  EXPECT_EQ(2u, stats.AllMetrics().size());
+}
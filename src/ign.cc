@@ -39,9 +39,9 @@ extern "C" IGNITION_GUI_VISIBLE char *ignitionVersion()
 //////////////////////////////////////////////////
 extern "C" IGNITION_GUI_VISIBLE void cmdPluginList()
 {
-  ignition::gui::Application app(g_argc, g_argv);
-
-  auto pluginsList = app.PluginList();
+  // Listing plugins only walks the file system, so skip bringing up Qt
+  // and the QML engine. This also keeps -l usable on headless shells.
+  auto pluginsList = ignition::gui::Application::ListPlugins();
   for (auto const &path : pluginsList)
   {
     std::cout << path.first << std::endl;
@@ -76,18 +76,28 @@ extern "C" IGNITION_GUI_VISIBLE void cmdStandalone(const char *_filename)
 //////////////////////////////////////////////////
 extern "C" IGNITION_GUI_VISIBLE void cmdConfig(const char *_config)
 {
-  ignition::gui::Application app(g_argc, g_argv);
-
-  if (!app.findChild<ignition::gui::MainWindow *>())
+  // A resident daemon already has Qt, the QML engine and transport warm;
+  // attaching to it maps a window in tens of milliseconds. Fall through
+  // to a cold start when none answers.
+  if (ignition::gui::Application::RequestDaemonAttach(
+      std::string(_config)))
   {
+    ignmsg << "Attached to a running gui daemon." << std::endl;
     return;
   }
 
-  if (!app.LoadConfig(std::string(_config)))
+  ignition::gui::Application app(g_argc, g_argv);
+
+  if (!app.findChild<ignition::gui::MainWindow *>())
   {
     return;
   }
 
+  // Staged startup: present the empty window first, then load plugins
+  // once the first frame is on screen, so window paint isn't competing
+  // with plugin transport discovery.
+  app.LoadConfigAfterFirstFrame(std::string(_config));
+
   app.exec();
 }
 
@@ -97,6 +107,12 @@ extern "C" IGNITION_GUI_VISIBLE void cmdVerbose(const char *_verbosity)
   ignition::common::Console::SetVerbosity(std::atoi(_verbosity));
 }
 
+//////////////////////////////////////////////////
+extern "C" IGNITION_GUI_VISIBLE void cmdStartupTiming()
+{
+  ignition::gui::Application::SetStartupTimingEnabled(true);
+}
+
 //////////////////////////////////////////////////
 extern "C" IGNITION_GUI_VISIBLE void cmdEmptyWindow()
 {
@@ -112,6 +128,24 @@ extern "C" IGNITION_GUI_VISIBLE void cmdEmptyWindow()
   app.exec();
 }
 
+//////////////////////////////////////////////////
+extern "C" IGNITION_GUI_VISIBLE void cmdDaemon()
+{
+  ignition::gui::Application app(g_argc, g_argv);
+
+  if (!app.findChild<ignition::gui::MainWindow *>())
+  {
+    return;
+  }
+
+  if (!app.StartDaemon())
+  {
+    return;
+  }
+
+  app.exec();
+}
+
 //////////////////////////////////////////////////
 extern "C" IGNITION_GUI_VISIBLE void cmdSetStyleFromFile(
     const char */*_filename*/)
@@ -16,13 +16,20 @@
 */
 
 #include <algorithm>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Util.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/math/Color.hh>
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/rendering.hh>
 
@@ -49,6 +56,54 @@ static const ignition::math::Pose3d kDefaultPose{ignition::math::Pose3d::Zero};
 static const ignition::math::Color kDefaultColor{
     ignition::math::Color(0.7, 0.7, 0.7, 1.0)};
 
+// Default fade distance for infinite grids
+static const double kDefaultFadeDistance{100.0};
+
+// Vertex shader for the infinite grid: a unit ground plane stretched to
+// cover the fade radius, handing grid-space coordinates to the fragment
+// stage.
+static const char kInfiniteGridVert[] = R"(#version 120
+
+uniform float extent;
+
+varying vec2 gridXY;
+
+void main()
+{
+  vec4 pos = gl_Vertex;
+  pos.xy *= extent;
+  gridXY = pos.xy;
+  gl_Position = gl_ModelViewProjectionMatrix * pos;
+}
+)";
+
+// Fragment shader for the infinite grid: evaluates anti-aliased cell
+// lines analytically, so cost is per covered pixel no matter how far
+// the grid extends, and no line geometry exists at all.
+static const char kInfiniteGridFrag[] = R"(#version 120
+
+uniform float cellLength;
+uniform float fadeDistance;
+uniform float colorR;
+uniform float colorG;
+uniform float colorB;
+uniform float colorA;
+
+varying vec2 gridXY;
+
+void main()
+{
+  vec2 coord = gridXY / cellLength;
+  vec2 dist = abs(fract(coord - 0.5) - 0.5) / fwidth(coord);
+  float line = 1.0 - min(min(dist.x, dist.y), 1.0);
+  float fade = clamp(1.0 - length(gridXY) / fadeDistance, 0.0, 1.0);
+  float alpha = line * fade * colorA;
+  if (alpha < 0.004)
+    discard;
+  gl_FragColor = vec4(colorR, colorG, colorB, alpha);
+}
+)";
+
 namespace ignition
 {
 namespace gui
@@ -72,6 +127,39 @@ namespace plugins
 
     /// \brief Grid ambient color
     math::Color color{kDefaultColor};
+
+    /// \brief True for a shader-based infinite grid instead of line
+    /// geometry
+    bool infinite{false};
+
+    /// \brief Distance at which an infinite grid fades out
+    double fadeDistance{kDefaultFadeDistance};
+  };
+
+  /// \brief Staged edits for one grid. Fields below zero / unset are
+  /// left alone, so only what the user actually touched is applied.
+  struct GridChange
+  {
+    /// \brief New horizontal cell count, or -1.
+    int cellCount{-1};
+
+    /// \brief New vertical cell count, or -1.
+    int vertCellCount{-1};
+
+    /// \brief New cell length, or -1.
+    double cellLength{-1};
+
+    /// \brief True when pose holds a staged value.
+    bool hasPose{false};
+
+    /// \brief Staged pose.
+    math::Pose3d pose;
+
+    /// \brief True when color holds a staged value.
+    bool hasColor{false};
+
+    /// \brief Staged ambient color.
+    math::Color color;
   };
 
   class Grid3DPrivate
@@ -95,6 +183,23 @@ namespace plugins
 
     /// \brief Keep track of grids we currently found on the scene
     public: std::vector<rendering::GridPtr> grids;
+
+    /// \brief Edits staged from the GUI thread, keyed by grid name.
+    /// Drained on the render thread in one pass.
+    public: std::map<std::string, GridChange> pendingChanges;
+
+    /// \brief Protects pendingChanges.
+    public: std::mutex changeMutex;
+
+    /// \brief Stage an edit for a grid.
+    /// \param[in] _grid Grid name.
+    /// \param[in] _apply Applied to the grid's staged entry.
+    public: void StageChange(const QString &_grid,
+        const std::function<void(GridChange &)> &_apply)
+    {
+      std::lock_guard<std::mutex> lock(this->changeMutex);
+      _apply(this->pendingChanges[_grid.toStdString()]);
+    }
   };
 }
 }
@@ -104,6 +209,73 @@ using namespace ignition;
 using namespace gui;
 using namespace plugins;
 
+/////////////////////////////////////////////////
+/// \brief Write an embedded shader source under the ign-gui cache
+/// directory, where the render engine can load it from.
+/// \param[in] _name File name, including extension.
+/// \param[in] _source Shader source.
+/// \return Full path to the written file, or empty on failure.
+static std::string WriteShaderFile(const std::string &_name,
+    const char *_source)
+{
+  std::string home;
+  common::env(IGN_HOMEDIR, home);
+  auto dir = common::joinPaths(home, ".ignition", "gui");
+  common::createDirectories(dir);
+
+  auto path = common::joinPaths(dir, _name);
+  std::ofstream file(path);
+  if (!file)
+  {
+    ignerr << "Failed to write shader file [" << path << "]" << std::endl;
+    return "";
+  }
+  file << _source;
+  return path;
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a shader-based infinite grid: one ground plane whose
+/// fragment shader evaluates the cell lines, so cost and memory are
+/// constant no matter the extent.
+/// \param[in] _scene Scene to add the grid to.
+/// \param[in] _g Grid parameters; cell counts are ignored since the
+/// grid has no cells to count.
+static void CreateInfiniteGrid(const rendering::ScenePtr &_scene,
+    const GridInfo &_g)
+{
+  auto vertPath = WriteShaderFile("infinite_grid.vert", kInfiniteGridVert);
+  auto fragPath = WriteShaderFile("infinite_grid.frag", kInfiniteGridFrag);
+  if (vertPath.empty() || fragPath.empty())
+    return;
+
+  auto vis = _scene->CreateVisual();
+  _scene->RootVisual()->AddChild(vis);
+  vis->SetLocalPose(_g.pose);
+  vis->AddGeometry(_scene->CreatePlane());
+
+  auto mat = _scene->CreateMaterial();
+  mat->SetLightingEnabled(false);
+  mat->SetTransparency(0.5);
+  mat->SetCastShadows(false);
+  mat->SetVertexShader(vertPath);
+  mat->SetFragmentShader(fragPath);
+
+  // The plane only needs to reach as far as the fade does
+  auto vertParams = mat->VertexShaderParams();
+  (*vertParams)["extent"] = static_cast<float>(2.0 * _g.fadeDistance);
+
+  auto fragParams = mat->FragmentShaderParams();
+  (*fragParams)["cellLength"] = static_cast<float>(_g.cellLength);
+  (*fragParams)["fadeDistance"] = static_cast<float>(_g.fadeDistance);
+  (*fragParams)["colorR"] = _g.color.R();
+  (*fragParams)["colorG"] = _g.color.G();
+  (*fragParams)["colorB"] = _g.color.B();
+  (*fragParams)["colorA"] = _g.color.A();
+
+  vis->SetMaterial(mat);
+}
+
 /////////////////////////////////////////////////
 Grid3D::Grid3D()
   : Plugin(), dataPtr(new Grid3DPrivate)
@@ -149,6 +321,12 @@ void Grid3D::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
       if (auto lengthElem = insertElem->FirstChildElement("cell_length"))
         lengthElem->QueryDoubleText(&gridInfo.cellLength);
 
+      if (auto infElem = insertElem->FirstChildElement("infinite"))
+        infElem->QueryBoolText(&gridInfo.infinite);
+
+      if (auto fadeElem = insertElem->FirstChildElement("fade_distance"))
+        fadeElem->QueryDoubleText(&gridInfo.fadeDistance);
+
       elem = insertElem->FirstChildElement("pose");
       if (nullptr != elem && nullptr != elem->GetText())
       {
@@ -224,6 +402,12 @@ void Grid3D::Initialize()
       // Initial grids
       for (const auto &g : this->dataPtr->startupGrids)
       {
+        if (g.infinite)
+        {
+          CreateInfiniteGrid(scene, g);
+          continue;
+        }
+
         auto grid = scene->CreateGrid();
         grid->SetCellCount(g.cellCount);
         grid->SetVerticalCellCount(g.vertCellCount);
@@ -237,7 +421,15 @@ void Grid3D::Initialize()
         auto mat = scene->CreateMaterial();
         mat->SetAmbient(g.color);
         gridVis->SetMaterial(mat);
+
+        this->dataPtr->grids.push_back(grid);
       }
+
+      // Stays connected: drains staged edits right before each render
+      // pass, so they're applied in batch on the render thread
+      this->connect(this->dataPtr->quickWindow,
+          &QQuickWindow::beforeRendering, this,
+          &Grid3D::ApplyPendingChanges, Qt::DirectConnection);
     }
   }
 
@@ -411,6 +603,106 @@ void Grid3D::Refresh()
 //  mainLayout->addWidget(spacer);
 }
 
+/////////////////////////////////////////////////
+void Grid3D::SetGridCellCount(const QString &_grid, const int _cellCount)
+{
+  this->dataPtr->StageChange(_grid, [_cellCount](GridChange &_change)
+  {
+    _change.cellCount = _cellCount;
+  });
+}
+
+/////////////////////////////////////////////////
+void Grid3D::SetGridVerticalCellCount(const QString &_grid,
+    const int _vertCellCount)
+{
+  this->dataPtr->StageChange(_grid, [_vertCellCount](GridChange &_change)
+  {
+    _change.vertCellCount = _vertCellCount;
+  });
+}
+
+/////////////////////////////////////////////////
+void Grid3D::SetGridCellLength(const QString &_grid, const double _cellLength)
+{
+  this->dataPtr->StageChange(_grid, [_cellLength](GridChange &_change)
+  {
+    _change.cellLength = _cellLength;
+  });
+}
+
+/////////////////////////////////////////////////
+void Grid3D::SetGridPose(const QString &_grid,
+    const double _x, const double _y, const double _z,
+    const double _roll, const double _pitch, const double _yaw)
+{
+  math::Pose3d pose(_x, _y, _z, _roll, _pitch, _yaw);
+  this->dataPtr->StageChange(_grid, [&pose](GridChange &_change)
+  {
+    _change.hasPose = true;
+    _change.pose = pose;
+  });
+}
+
+/////////////////////////////////////////////////
+void Grid3D::SetGridColor(const QString &_grid,
+    const double _r, const double _g, const double _b, const double _a)
+{
+  math::Color color(_r, _g, _b, _a);
+  this->dataPtr->StageChange(_grid, [&color](GridChange &_change)
+  {
+    _change.hasColor = true;
+    _change.color = color;
+  });
+}
+
+/////////////////////////////////////////////////
+void Grid3D::ApplyPendingChanges()
+{
+  // Cheap per-frame check; edits are rare
+  std::map<std::string, GridChange> changes;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->changeMutex);
+    if (this->dataPtr->pendingChanges.empty())
+      return;
+    changes.swap(this->dataPtr->pendingChanges);
+  }
+
+  for (const auto &grid : this->dataPtr->grids)
+  {
+    auto change = changes.find(grid->Name());
+    if (change == changes.end())
+      continue;
+
+    // Set parameters on the existing grid: geometry is only rebuilt
+    // when the topology values actually differ
+    if (change->second.cellCount >= 0 &&
+        change->second.cellCount != static_cast<int>(grid->CellCount()))
+    {
+      grid->SetCellCount(change->second.cellCount);
+    }
+
+    if (change->second.vertCellCount >= 0 && change->second.vertCellCount !=
+        static_cast<int>(grid->VerticalCellCount()))
+    {
+      grid->SetVerticalCellCount(change->second.vertCellCount);
+    }
+
+    if (change->second.cellLength >= 0 &&
+        !math::equal(change->second.cellLength, grid->CellLength()))
+    {
+      grid->SetCellLength(change->second.cellLength);
+    }
+
+    // Transform and material changes never touch geometry
+    if (change->second.hasPose && grid->Parent())
+      grid->Parent()->SetLocalPose(change->second.pose);
+
+    if (change->second.hasColor && grid->Material())
+      grid->Material()->SetAmbient(change->second.color);
+  }
+}
+
 /////////////////////////////////////////////////
 void Grid3D::OnChange(const QVariant & /*_value*/)
 {
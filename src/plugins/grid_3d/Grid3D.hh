@@ -54,6 +54,12 @@ namespace plugins
   ///   * \<cell_length\> : Length of each cell, defaults to 1.
   ///   * \<pose\> : Grid pose, defaults to the origin.
   ///   * \<color\> : Grid color, defaults to (0.7, 0.7, 0.7, 1.0)
+  ///   * \<infinite\> : Set to true for a shader-based grid: the cell
+  ///                    lines are evaluated per pixel on a single
+  ///                    ground plane, so cost and memory don't grow
+  ///                    with extent. Cell counts are ignored.
+  ///   * \<fade_distance\> : Distance at which an infinite grid fades
+  ///                         out, defaults to 100.
   class Grid3D : public Plugin
   {
     Q_OBJECT
@@ -70,6 +76,54 @@ namespace plugins
 
     private slots: void Initialize();
 
+    /// \brief Stage a new horizontal cell count for a grid. Edits are
+    /// applied in place on the next render pass; several staged edits
+    /// to one grid become a single scene update.
+    /// \param[in] _grid Grid name.
+    /// \param[in] _cellCount New horizontal cell count.
+    public: Q_INVOKABLE void SetGridCellCount(const QString &_grid,
+        const int _cellCount);
+
+    /// \brief Stage a new vertical cell count for a grid.
+    /// \param[in] _grid Grid name.
+    /// \param[in] _vertCellCount New vertical cell count.
+    public: Q_INVOKABLE void SetGridVerticalCellCount(const QString &_grid,
+        const int _vertCellCount);
+
+    /// \brief Stage a new cell length for a grid.
+    /// \param[in] _grid Grid name.
+    /// \param[in] _cellLength New cell length.
+    public: Q_INVOKABLE void SetGridCellLength(const QString &_grid,
+        const double _cellLength);
+
+    /// \brief Stage a new pose for a grid. Pose changes only move the
+    /// visual, no geometry is touched.
+    /// \param[in] _grid Grid name.
+    /// \param[in] _x X position.
+    /// \param[in] _y Y position.
+    /// \param[in] _z Z position.
+    /// \param[in] _roll Roll angle.
+    /// \param[in] _pitch Pitch angle.
+    /// \param[in] _yaw Yaw angle.
+    public: Q_INVOKABLE void SetGridPose(const QString &_grid,
+        const double _x, const double _y, const double _z,
+        const double _roll, const double _pitch, const double _yaw);
+
+    /// \brief Stage a new ambient color for a grid.
+    /// \param[in] _grid Grid name.
+    /// \param[in] _r Red.
+    /// \param[in] _g Green.
+    /// \param[in] _b Blue.
+    /// \param[in] _a Alpha.
+    public: Q_INVOKABLE void SetGridColor(const QString &_grid,
+        const double _r, const double _g, const double _b, const double _a);
+
+    /// \brief Apply all staged edits to the scene. Runs on the render
+    /// thread right before rendering, so a burst of UI edits costs one
+    /// update, and parameters are set on the existing grid instead of
+    /// recreating it.
+    private slots: void ApplyPendingChanges();
+
     /// \brief Called when a value changes on a widget
     /// \param[in] _value New value
     private slots: void OnChange(const QVariant &_value);
@@ -15,15 +15,35 @@
  *
 */
 
+#include <QPainter>
 #include <QQuickImageProvider>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
 #include <ignition/common/Image.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
 
 #include "ignition/gui/Application.hh"
+#include "ignition/gui/GuiEvents.hh"
+#include "ignition/gui/Helpers.hh"
+#include "ignition/gui/SubscriptionStats.hh"
 #include "ImageDisplay.hh"
 
 namespace ignition
@@ -32,6 +52,12 @@ namespace gui
 {
 namespace plugins
 {
+  /// \brief Provides the displayed frame to QML through a front/back
+  /// QImage pair. Conversions write into the back buffer and publish it
+  /// with SwapBuffers; requestImage hands the scene graph the front
+  /// buffer, whose pixels are never written again while it's out, so
+  /// the only per-frame pixel copy downstream of the conversion is the
+  /// GPU upload.
   class ImageProvider : public QQuickImageProvider
   {
     public: ImageProvider()
@@ -39,14 +65,15 @@ namespace plugins
     {
     }
 
+    // Documentation inherited
     public: QImage requestImage(const QString &, QSize *,
         const QSize &) override
     {
-      if (!this->img.isNull())
+      std::lock_guard<std::mutex> lock(this->imgMutex);
+      if (!this->front.isNull())
       {
-        // Must return a copy
-        QImage copy(this->img);
-        return copy;
+        // Implicitly shared: a refcount bump, not a pixel copy
+        return this->front;
       }
 
       // Placeholder in case we have no image yet
@@ -55,12 +82,195 @@ namespace plugins
       return i;
     }
 
-    public: void SetImage(const QImage &_image)
+    /// \brief Get a writable back buffer with the given shape.
+    /// Reallocates only when the shape changed or the scene graph still
+    /// holds a reference to this allocation: a detach on write would
+    /// copy the stale pixels before they are overwritten, so a fresh
+    /// allocation is cheaper.
+    /// \param[in] _width Target width.
+    /// \param[in] _height Target height.
+    /// \param[in] _format Target format.
+    /// \return Buffer to convert the next frame into.
+    public: QImage &BackBuffer(const int _width, const int _height,
+        const QImage::Format _format)
     {
-      this->img = _image;
+      std::lock_guard<std::mutex> lock(this->imgMutex);
+      if (this->back.width() != _width || this->back.height() != _height ||
+          this->back.format() != _format || !this->back.isDetached())
+      {
+        this->back = QImage(_width, _height, _format);
+      }
+      return this->back;
+    }
+
+    /// \brief Publish the back buffer as the next displayed frame.
+    public: void SwapBuffers()
+    {
+      std::lock_guard<std::mutex> lock(this->imgMutex);
+      this->front.swap(this->back);
+    }
+
+    /// \brief Publish a frame which already owns its own stable
+    /// buffer, such as a decoded JPEG.
+    /// \param[in] _image Frame to display.
+    public: void SetFrame(QImage &&_image)
+    {
+      std::lock_guard<std::mutex> lock(this->imgMutex);
+      this->front = std::move(_image);
     }
 
-    private: QImage img;
+    /// \brief Stable frame handed out to the scene graph.
+    private: QImage front;
+
+    /// \brief Frame currently being converted into.
+    private: QImage back;
+
+    /// \brief Protects the pair: with a threaded render loop,
+    /// requestImage runs on the render thread while the GUI thread
+    /// converts.
+    private: std::mutex imgMutex;
+  };
+
+  /// \brief Per-stream state in tiled mode
+  struct TileStream
+  {
+    /// \brief Topic this stream subscribes to
+    std::string topic;
+
+    /// \brief Latest raw payload from the transport callback
+    std::string pendingData;
+
+    /// \brief Worker-side buffer the payload is swapped into, so in
+    /// steady state neither side allocates
+    std::string parseData;
+
+    /// \brief Message parsed from parseData; only the stream's active
+    /// job touches it
+    msgs::Image msg;
+
+    /// \brief True when pendingData holds an unprocessed frame
+    bool dirty = false;
+
+    /// \brief True while a conversion job for this stream is queued or
+    /// running, so at most one job per stream sits in the pool
+    bool queued = false;
+  };
+
+  /// \brief State shared between a tiled ImageDisplay and the
+  /// conversion pool workers. Held by shared_ptr so a job that outlives
+  /// the plugin finds stopped set instead of freed memory.
+  struct TiledState
+  {
+    /// \brief Protects everything here
+    std::mutex mutex;
+
+    /// \brief Set by the plugin destructor; jobs bail out when they
+    /// see it
+    bool stopped = false;
+
+    /// \brief One entry per subscribed topic
+    std::vector<TileStream> streams;
+
+    /// \brief Atlas all tiles are composited into. Published to the
+    /// provider as an implicitly shared copy, so the one pixel copy per
+    /// updated frame is the detach on the next tile write.
+    QImage atlas;
+
+    /// \brief Width of one tile in the atlas
+    int tileWidth = 320;
+
+    /// \brief Height of one tile in the atlas
+    int tileHeight = 240;
+
+    /// \brief Number of tile columns
+    int columns = 1;
+
+    /// \brief Provider the atlas is published through, owned by the
+    /// engine
+    ImageProvider *provider{nullptr};
+
+    /// \brief Plugin to notify about new frames
+    ImageDisplay *plugin{nullptr};
+  };
+
+  /// \brief Process-wide pool of conversion workers shared by every
+  /// tiled ImageDisplay instance, so a quad view costs one set of
+  /// decode threads instead of four.
+  class ConversionPool
+  {
+    /// \brief Get the pool, starting its workers on first use
+    /// \return The pool
+    public: static ConversionPool &Instance()
+    {
+      static ConversionPool pool;
+      return pool;
+    }
+
+    /// \brief Queue a conversion job
+    /// \param[in] _job Job to run on a worker thread
+    public: void Enqueue(std::function<void()> _job)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->jobs.push_back(std::move(_job));
+      }
+      this->cv.notify_one();
+    }
+
+    /// \brief Constructor, starts the workers
+    private: ConversionPool()
+    {
+      const unsigned int count =
+          std::max(2u, std::thread::hardware_concurrency() / 4);
+      for (unsigned int i = 0; i < count; ++i)
+        this->workers.emplace_back([this]() { this->Loop(); });
+    }
+
+    /// \brief Destructor, drains and joins the workers
+    private: ~ConversionPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->done = true;
+      }
+      this->cv.notify_all();
+      for (auto &worker : this->workers)
+        worker.join();
+    }
+
+    /// \brief Worker body: run jobs until told to stop
+    private: void Loop()
+    {
+      while (true)
+      {
+        std::function<void()> job;
+        {
+          std::unique_lock<std::mutex> lock(this->mutex);
+          this->cv.wait(lock, [this]()
+              { return this->done || !this->jobs.empty(); });
+          if (this->done && this->jobs.empty())
+            return;
+          job = std::move(this->jobs.front());
+          this->jobs.pop_front();
+        }
+        job();
+      }
+    }
+
+    /// \brief Protects the job queue
+    private: std::mutex mutex;
+
+    /// \brief Wakes idle workers
+    private: std::condition_variable cv;
+
+    /// \brief Queued jobs
+    private: std::deque<std::function<void()>> jobs;
+
+    /// \brief Worker threads
+    private: std::vector<std::thread> workers;
+
+    /// \brief True once the pool is shutting down
+    private: bool done = false;
   };
 
   class ImageDisplayPrivate
@@ -68,17 +278,109 @@ namespace plugins
     /// \brief List of topics publishing image messages.
     public: QStringList topicList;
 
-    /// \brief Holds data to set as the next image
+    /// \brief Holds data to set as the next image. Only touched from the
+    /// GUI thread.
     public: msgs::Image imageMsg;
 
+    /// \brief Serialized payload of the latest frame, written by the raw
+    /// transport callback. Swapped with parseData when the GUI thread is
+    /// ready to process, so the two threads never copy pixel data while
+    /// the other waits.
+    public: std::string pendingData;
+
+    /// \brief GUI-side buffer the pending payload is swapped into before
+    /// parsing. Keeping it as a member means the swap hands its previous
+    /// allocation back to pendingData, so in steady state neither side
+    /// allocates.
+    public: std::string parseData;
+
+    /// \brief True when pendingData holds a frame that hasn't been
+    /// processed yet
+    public: bool msgDirty = false;
+
+    /// \brief True while the last GUI frame overran its budget,
+    /// according to the frame-budget event
+    public: bool guiBehind = false;
+
+    /// \brief Toggles while guiBehind is set, so only every other
+    /// conversion is skipped and the display can't freeze
+    public: bool skipConversion = false;
+
+    /// \brief True while a ProcessImage call is queued on the GUI thread.
+    /// Lets the subscriber coalesce dispatches: however fast the camera
+    /// publishes, at most one conversion is pending, and it always picks
+    /// up the latest frame.
+    public: bool processQueued = false;
+
     /// \brief Node for communication.
     public: transport::Node node;
 
-    /// \brief Mutex for accessing image data
-    public: std::recursive_mutex imageMutex;
+    /// \brief Mutex protecting pendingData and msgDirty. Held only for
+    /// the buffer swap on the GUI side.
+    public: std::mutex msgMutex;
+
+    /// \brief Compressed payload awaiting decode. Latest frame wins.
+    public: std::string compressedData;
+
+    /// \brief True when compressedData holds an undecoded frame.
+    public: bool compressedDirty = false;
+
+    /// \brief True while the decode worker is running.
+    public: bool decodeRunning = false;
+
+    /// \brief Keeps the decode worker alive; waited on at destruction.
+    public: std::future<void> decodeResult;
+
+    /// \brief Protects the compressed payload hand-off.
+    public: std::mutex decodeMutex;
 
     /// \brief To provide images for QML.
     public: ImageProvider *provider{nullptr};
+
+    /// \brief True to convert formats in a fragment shader instead of on
+    /// the CPU, for formats the shader supports
+    public: bool gpuConversion = false;
+
+    /// \brief Keep every Nth pixel in each direction during conversion,
+    /// so small tiles don't pay for full-resolution conversion and
+    /// upload. 1 keeps the full frame.
+    public: int decimation = 1;
+
+    /// \brief Conversion the shader should apply to the current texture.
+    /// 0: none (texture is displayable RGB), 1: normalize a 16-bit value
+    /// packed into the R/G channels, 2-5: demosaic a Bayer mosaic with
+    /// the red site at (0,0), (1,0), (0,1) or (1,1) of each 2x2 tile.
+    public: int gpuMode = 0;
+
+    /// \brief Lower bound of the normalization range, in texture units
+    public: double normMin = 0.0;
+
+    /// \brief Upper bound of the normalization range, in texture units
+    public: double normMax = 1.0;
+
+    /// \brief Shared state for tiled mode, null in single-stream mode
+    public: std::shared_ptr<TiledState> tiled;
+
+    /// \brief End-to-end frame latencies, header stamp to provider
+    /// hand-off. Reset each telemetry period, so the readout follows a
+    /// rolling window instead of averaging over the whole run.
+    public: LatencyHistogram latency;
+
+    /// \brief Header stamp of the staged compressed payload in ns since
+    /// epoch, -1 when unset. Travels with compressedData under
+    /// decodeMutex, so the decode worker charges the latency to the
+    /// frame it actually decoded.
+    public: int64_t compressedStampNs{-1};
+
+    /// \brief Latency readout shown in the UI, empty while there is
+    /// nothing to report
+    public: QString latencyText;
+
+    /// \brief Readout refreshes since the last telemetry report
+    public: int latencyTicks{0};
+
+    /// \brief Publisher for the latency telemetry
+    public: transport::Node::Publisher latencyPub;
   };
 }
 }
@@ -97,10 +399,30 @@ ImageDisplay::ImageDisplay()
 /////////////////////////////////////////////////
 ImageDisplay::~ImageDisplay()
 {
+  // in-flight pool jobs check this flag under the same mutex before
+  // touching the provider or this plugin
+  if (this->dataPtr->tiled)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->tiled->mutex);
+    this->dataPtr->tiled->stopped = true;
+  }
+
+  if (this->dataPtr->decodeResult.valid())
+    this->dataPtr->decodeResult.wait();
+
   App()->Engine()->removeImageProvider(
       this->CardItem()->objectName() + "imagedisplay");
 }
 
+/////////////////////////////////////////////////
+void ImageDisplay::Shutdown()
+{
+  // Transport-only cleanup, this runs on a teardown worker thread
+  // while the object is destroyed later on the GUI thread
+  for (auto const &sub : this->dataPtr->node.SubscribedTopics())
+    this->dataPtr->node.Unsubscribe(sub);
+}
+
 /////////////////////////////////////////////////
 void ImageDisplay::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 {
@@ -109,16 +431,47 @@ void ImageDisplay::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     this->title = "Image display";
 
   std::string topic;
+  std::vector<std::string> topics;
   bool topicPicker = true;
+  int tileWidth = 320;
+  int tileHeight = 240;
 
   // Read configuration
   if (_pluginElem)
   {
-    if (auto topicElem = _pluginElem->FirstChildElement("topic"))
-      topic = topicElem->GetText();
+    // more than one <topic> switches to tiled multi-stream mode
+    for (auto topicElem = _pluginElem->FirstChildElement("topic");
+        topicElem != nullptr;
+        topicElem = topicElem->NextSiblingElement("topic"))
+    {
+      if (nullptr != topicElem->GetText())
+        topics.push_back(topicElem->GetText());
+    }
+    if (!topics.empty())
+      topic = topics.front();
+
+    if (auto widthElem = _pluginElem->FirstChildElement("tile_width"))
+      widthElem->QueryIntText(&tileWidth);
+
+    if (auto heightElem = _pluginElem->FirstChildElement("tile_height"))
+      heightElem->QueryIntText(&tileHeight);
 
     if (auto pickerElem = _pluginElem->FirstChildElement("topic_picker"))
       pickerElem->QueryBoolText(&topicPicker);
+
+    if (auto gpuElem = _pluginElem->FirstChildElement("gpu_conversion"))
+      gpuElem->QueryBoolText(&this->dataPtr->gpuConversion);
+
+    if (auto decimationElem = _pluginElem->FirstChildElement("decimation"))
+    {
+      decimationElem->QueryIntText(&this->dataPtr->decimation);
+      if (this->dataPtr->decimation < 1)
+      {
+        ignwarn << "Ignoring decimation [" << this->dataPtr->decimation
+                << "], must be positive." << std::endl;
+        this->dataPtr->decimation = 1;
+      }
+    }
   }
 
   if (topic.empty() && !topicPicker)
@@ -127,22 +480,269 @@ void ImageDisplay::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     topicPicker = true;
   }
 
+  // the picker switches a single stream; it doesn't fit tiled mode
+  if (topics.size() > 1)
+    topicPicker = false;
+
   this->PluginItem()->setProperty("showPicker", topicPicker);
 
+  this->dataPtr->provider = new ImageProvider();
+  App()->Engine()->addImageProvider(
+      this->CardItem()->objectName() + "imagedisplay", this->dataPtr->provider);
+
+  if (topics.size() > 1)
+  {
+    this->SetupTiled(topics, tileWidth, tileHeight);
+    return;
+  }
+
+  // camera-to-screen latency readout, refreshed once a second on the
+  // wakeup shared with the other plugins' periodic updates
+  App()->AddUpdateCallback(this, 1000, [this]()
+  {
+    this->UpdateLatency();
+  });
+
+  // Shed load while the GUI is behind on its frame budget: conversions
+  // are optional work, and latest-wins dropping means skipped frames
+  // just make the next one catch the display up
+  App()->SubscribeToEvent(events::FrameBudget::kType, this,
+      [this](QEvent *_event)
+      {
+        auto budget = static_cast<events::FrameBudget *>(_event);
+        this->dataPtr->guiBehind = budget->RemainingBudget() < 0.0;
+      });
+
+  // Merge topics found by the application's topic index as its scans
+  // complete, so the picker fills in without this plugin paying for
+  // discovery round trips of its own
+  App()->SubscribeToEvent(events::TopicIndexUpdated::kType, this,
+      [this](QEvent *)
+      {
+        for (const auto &t : App()->TopicsOfType("ignition.msgs.Image"))
+          this->AddTopic(internedQString(t));
+      });
+
   if (!topic.empty())
-    this->OnTopic(QString::fromStdString(topic));
+    this->OnTopic(internedQString(topic));
   else
     this->OnRefresh();
+}
 
-  this->dataPtr->provider = new ImageProvider();
-  App()->Engine()->addImageProvider(
-      this->CardItem()->objectName() + "imagedisplay", this->dataPtr->provider);
+/////////////////////////////////////////////////
+/// \brief Convert one stream's frames into its atlas tile and publish
+/// the atlas. Runs on a conversion pool worker; loops until the stream
+/// has no unprocessed frame so no frame is left behind when one
+/// arrives mid-conversion.
+/// \param[in] _state Shared tiled state.
+/// \param[in] _index Stream index.
+static void ConvertTile(const std::shared_ptr<TiledState> &_state,
+    const std::size_t _index)
+{
+  while (true)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_state->mutex);
+      auto &stream = _state->streams[_index];
+      if (_state->stopped || !stream.dirty)
+      {
+        stream.queued = false;
+        return;
+      }
+      stream.parseData.swap(stream.pendingData);
+      stream.dirty = false;
+    }
+
+    // only this job touches the stream's parse buffer and msg, so no
+    // lock is needed while converting
+    auto &stream = _state->streams[_index];
+    if (!stream.msg.ParseFromString(stream.parseData))
+    {
+      logAsync(LogSeverity::WARN, "ImageDisplay::ConvertTile::parse",
+          "Failed to parse image message on [" + stream.topic + "]");
+      continue;
+    }
+
+    QImage source;
+    const auto &data = stream.msg.data();
+    if (stream.msg.pixel_format_type() == msgs::PixelFormatType::RGB_INT8)
+    {
+      // zero-copy wrapper; drawImage reads it before the next parse
+      source = QImage(reinterpret_cast<const uchar *>(data.data()),
+          stream.msg.width(), stream.msg.height(),
+          stream.msg.width() * 3, QImage::Format_RGB888);
+    }
+    else if (data.size() >= 4 &&
+        ((static_cast<uchar>(data[0]) == 0xffu &&
+          static_cast<uchar>(data[1]) == 0xd8u) ||
+         (static_cast<uchar>(data[0]) == 0x89u && data[1] == 'P')))
+    {
+      source = QImage::fromData(
+          reinterpret_cast<const uchar *>(data.data()),
+          static_cast<int>(data.size()));
+    }
+    else
+    {
+      logAsync(LogSeverity::WARN, "ImageDisplay::ConvertTile::format",
+          "Unsupported image type on [" + stream.topic + "]: " +
+          std::to_string(static_cast<int>(
+          stream.msg.pixel_format_type())));
+      continue;
+    }
+
+    if (source.isNull())
+    {
+      logAsync(LogSeverity::WARN, "ImageDisplay::ConvertTile::decode",
+          "Failed to decode image on [" + stream.topic + "]");
+      continue;
+    }
+
+    const int col = static_cast<int>(_index) % _state->columns;
+    const int row = static_cast<int>(_index) / _state->columns;
+    const QRect target(col * _state->tileWidth, row * _state->tileHeight,
+        _state->tileWidth, _state->tileHeight);
+
+    {
+      std::lock_guard<std::mutex> lock(_state->mutex);
+      if (_state->stopped)
+        return;
+
+      QPainter painter(&_state->atlas);
+      painter.setRenderHint(QPainter::SmoothPixmapTransform);
+      painter.drawImage(target, source);
+      painter.end();
+
+      // implicitly shared: a refcount bump, not a pixel copy
+      _state->provider->SetFrame(QImage(_state->atlas));
+      QMetaObject::invokeMethod(_state->plugin, "OnDecoded",
+          Qt::QueuedConnection);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::SetupTiled(const std::vector<std::string> &_topics,
+    const int _tileWidth, const int _tileHeight)
+{
+  auto state = std::make_shared<TiledState>();
+  state->provider = this->dataPtr->provider;
+  state->plugin = this;
+  state->tileWidth = std::max(_tileWidth, 32);
+  state->tileHeight = std::max(_tileHeight, 32);
+  state->columns = static_cast<int>(
+      std::ceil(std::sqrt(static_cast<double>(_topics.size()))));
+  const int rows = (static_cast<int>(_topics.size()) + state->columns - 1) /
+      state->columns;
+  state->atlas = QImage(state->columns * state->tileWidth,
+      rows * state->tileHeight, QImage::Format_RGB888);
+  state->atlas.fill(QColor(40, 40, 40));
+  state->streams.resize(_topics.size());
+  this->dataPtr->tiled = state;
+
+  for (std::size_t i = 0; i < _topics.size(); ++i)
+  {
+    state->streams[i].topic = _topics[i];
+    if (!this->dataPtr->node.SubscribeRaw(_topics[i],
+        [state, i](const char *_msgData, const size_t _size,
+            const transport::MessageInfo &)
+        {
+          bool enqueue = false;
+          {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->stopped)
+              return;
+            auto &stream = state->streams[i];
+            stream.pendingData.assign(_msgData, _size);
+            stream.dirty = true;
+            // latest frame wins: at most one job per stream in the pool
+            if (!stream.queued)
+            {
+              stream.queued = true;
+              enqueue = true;
+            }
+          }
+          if (enqueue)
+          {
+            ConversionPool::Instance().Enqueue(
+                [state, i]() { ConvertTile(state, i); });
+          }
+        },
+        msgs::Image().GetTypeName()))
+    {
+      ignerr << "Unable to subscribe to topic [" << _topics[i] << "]"
+             << std::endl;
+    }
+  }
+
+  igndbg << "Tiled mode with " << _topics.size() << " streams"
+         << std::endl;
 }
 
 /////////////////////////////////////////////////
 void ImageDisplay::ProcessImage()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
+  IGN_PROFILE("ImageDisplay::ProcessImage");
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->msgMutex);
+    this->dataPtr->processQueued = false;
+    if (!this->dataPtr->msgDirty)
+      return;
+
+    // While the GUI is behind on its frame budget, skip every other
+    // conversion. The frame stays dirty, so the next message (or call)
+    // shows it or a newer one — the display can't freeze.
+    if (this->dataPtr->guiBehind)
+    {
+      this->dataPtr->skipConversion = !this->dataPtr->skipConversion;
+      if (this->dataPtr->skipConversion)
+        return;
+    }
+    this->dataPtr->parseData.swap(this->dataPtr->pendingData);
+    this->dataPtr->msgDirty = false;
+  }
+
+  // Single deserialization of the frame, on the thread which consumes it
+  if (!this->dataPtr->imageMsg.ParseFromString(this->dataPtr->parseData))
+  {
+    logAsync(LogSeverity::WARN, "ImageDisplay::ProcessImage::parse",
+        "Failed to parse image message.");
+    return;
+  }
+
+  const auto &stamp = this->dataPtr->imageMsg.header().stamp();
+  const int64_t stampNs = (0 == stamp.sec() && 0 == stamp.nsec()) ? -1 :
+      stamp.sec() * 1000000000LL + stamp.nsec();
+
+  if (this->dataPtr->gpuConversion)
+  {
+    // Formats the shader can convert only get packed into a texture
+    // here; anything else falls through to the CPU paths below.
+    switch (this->dataPtr->imageMsg.pixel_format_type())
+    {
+      case msgs::PixelFormatType::L_INT16:
+        this->UploadLInt16();
+        this->RecordLatency(stampNs);
+        return;
+      case msgs::PixelFormatType::BAYER_RGGB8:
+      case msgs::PixelFormatType::BAYER_BGGR8:
+      case msgs::PixelFormatType::BAYER_GBRG8:
+      case msgs::PixelFormatType::BAYER_GRBG8:
+        this->UploadBayer8();
+        this->RecordLatency(stampNs);
+        return;
+      default:
+        break;
+    }
+  }
+
+  if (this->dataPtr->gpuMode != 0)
+  {
+    this->dataPtr->gpuMode = 0;
+    this->GpuModeChanged();
+  }
+
+  bool handedOver = true;
   switch (this->dataPtr->imageMsg.pixel_format_type())
   {
     case msgs::PixelFormatType::RGB_INT8:
@@ -154,19 +754,60 @@ void ImageDisplay::ProcessImage()
     case msgs::PixelFormatType::L_INT16:
       this->UpdateFromLInt16();
       break;
+    case msgs::PixelFormatType::BAYER_RGGB8:
+    case msgs::PixelFormatType::BAYER_BGGR8:
+    case msgs::PixelFormatType::BAYER_GBRG8:
+    case msgs::PixelFormatType::BAYER_GRBG8:
+      this->UpdateFromBayer8();
+      break;
     default:
     {
-      ignwarn << "Unsupported image type: "
-              << this->dataPtr->imageMsg.pixel_format_type() << std::endl;
+      // compressed frames reach the provider via the decode worker,
+      // which records their latency at its own hand-off
+      handedOver = false;
+
+      // The format enum has no compressed entries and republishers
+      // leave it unset, so recognize JPEG and PNG payloads by their
+      // magic bytes
+      const auto &data = this->dataPtr->imageMsg.data();
+      if (data.size() >= 4 &&
+          ((static_cast<uchar>(data[0]) == 0xffu &&
+            static_cast<uchar>(data[1]) == 0xd8u) ||
+           (static_cast<uchar>(data[0]) == 0x89u && data[1] == 'P')))
+      {
+        this->UpdateFromCompressed();
+        break;
+      }
+
+      // This fires once per frame on an unsupported stream, so it goes
+      // through the rate-limited background logger
+      logAsync(LogSeverity::WARN, "ImageDisplay::ProcessImage::format",
+          "Unsupported image type: " + std::to_string(static_cast<int>(
+          this->dataPtr->imageMsg.pixel_format_type())));
     }
   }
+
+  if (handedOver)
+    this->RecordLatency(stampNs);
 }
 
 /////////////////////////////////////////////////
-void ImageDisplay::OnImageMsg(const msgs::Image &_msg)
+void ImageDisplay::OnImageMsg(const char *_msgData, const size_t _size)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->imageMutex);
-  this->dataPtr->imageMsg = _msg;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->msgMutex);
+    // assign reuses the buffer handed back by the last swap, so in
+    // steady state this is one memcpy of the payload and no allocation
+    this->dataPtr->pendingData.assign(_msgData, _size);
+    this->dataPtr->msgDirty = true;
+
+    // Latest frame wins: if a ProcessImage call is already queued it will
+    // pick up this frame, so don't pile more dispatches onto the GUI
+    // thread than it can drain.
+    if (this->dataPtr->processQueued)
+      return;
+    this->dataPtr->processQueued = true;
+  }
 
   // Signal to main thread that the image changed
   QMetaObject::invokeMethod(this, "ProcessImage");
@@ -184,9 +825,16 @@ void ImageDisplay::OnTopic(const QString _topic)
   for (auto sub : subs)
     this->dataPtr->node.Unsubscribe(sub);
 
-  // Subscribe to new topic
-  if (!this->dataPtr->node.Subscribe(topic, &ImageDisplay::OnImageMsg,
-      this))
+  // Subscribe to new topic. The raw subscription hands us the serialized
+  // payload as published, skipping the deserialize-into-temporary /
+  // copy-into-back-buffer pair the typed callback would cost per frame.
+  if (!this->dataPtr->node.SubscribeRaw(topic,
+      [this](const char *_msgData, const size_t _size,
+             const transport::MessageInfo &)
+      {
+        this->OnImageMsg(_msgData, _size);
+      },
+      msgs::Image().GetTypeName()))
   {
     ignerr << "Unable to subscribe to topic [" << topic << "]" << std::endl;
   }
@@ -197,39 +845,86 @@ void ImageDisplay::OnRefresh()
 {
   // Clear
   this->dataPtr->topicList.clear();
+  this->TopicListChanged();
 
-  // Get updated list
-  std::vector<std::string> allTopics;
-  this->dataPtr->node.TopicList(allTopics);
-  for (auto topic : allTopics)
-  {
-    std::vector<transport::MessagePublisher> publishers;
-    this->dataPtr->node.TopicInfo(topic, publishers);
-    for (auto pub : publishers)
-    {
-      if (pub.MsgTypeName() == "ignition.msgs.Image")
-      {
-        this->dataPtr->topicList.push_back(QString::fromStdString(topic));
-        break;
-      }
-    }
-  }
+  // Query the application's topic index: this is served from memory in
+  // microseconds, however many topics are advertised
+  for (const auto &topic : App()->TopicsOfType("ignition.msgs.Image"))
+    this->dataPtr->topicList.push_back(internedQString(topic));
 
-  // Select first one
+  // Select the first discovered topic
   if (this->dataPtr->topicList.count() > 0)
     this->OnTopic(this->dataPtr->topicList.at(0));
   this->TopicListChanged();
+
+  // Kick off a background rescan; the TopicIndexUpdated subscription
+  // merges in topics advertised since the index was last filled
+  App()->RefreshTopicIndex();
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::AddTopic(const QString &_topic)
+{
+  if (this->dataPtr->topicList.contains(_topic))
+    return;
+
+  this->dataPtr->topicList.push_back(_topic);
+
+  // Select the first discovered topic
+  if (this->dataPtr->topicList.count() == 1)
+    this->OnTopic(_topic);
+  this->TopicListChanged();
 }
 
 /////////////////////////////////////////////////
 void ImageDisplay::UpdateFromRgbInt8()
 {
-  QImage image(
-    reinterpret_cast<const uchar *>(this->dataPtr->imageMsg.data().c_str()),
-    this->dataPtr->imageMsg.width(), this->dataPtr->imageMsg.height(),
-    QImage::Format_RGB888);
+  const unsigned int width = this->dataPtr->imageMsg.width();
+  const unsigned int height = this->dataPtr->imageMsg.height();
+  const unsigned int dec = this->dataPtr->decimation;
+
+  if (dec <= 1)
+  {
+    // One row-wise copy into the stable back buffer. Uploading straight
+    // out of the message buffer would be free here, but its pixels are
+    // overwritten by the next parse while the scene graph may still be
+    // reading them.
+    QImage &image = this->dataPtr->provider->BackBuffer(width, height,
+        QImage::Format_RGB888);
+    const uchar *data = reinterpret_cast<const uchar *>(
+        this->dataPtr->imageMsg.data().c_str());
+    for (unsigned int j = 0; j < height; ++j)
+    {
+      // row by row: QImage scanlines are 32-bit aligned
+      memcpy(image.scanLine(j), data + j * width * 3, width * 3);
+    }
+
+    this->dataPtr->provider->SwapBuffers();
+    this->newImage();
+    return;
+  }
+
+  const unsigned int outWidth = width / dec;
+  const unsigned int outHeight = height / dec;
+  QImage &image = this->dataPtr->provider->BackBuffer(outWidth, outHeight,
+      QImage::Format_RGB888);
+
+  const uchar *data = reinterpret_cast<const uchar *>(
+      this->dataPtr->imageMsg.data().data());
+  for (unsigned int j = 0; j < outHeight; ++j)
+  {
+    uchar *scanLine = image.scanLine(j);
+    const uchar *row = data + j * dec * width * 3;
+    for (unsigned int i = 0; i < outWidth; ++i)
+    {
+      const uchar *px = row + i * dec * 3;
+      scanLine[3 * i] = px[0];
+      scanLine[3 * i + 1] = px[1];
+      scanLine[3 * i + 2] = px[2];
+    }
+  }
 
-  this->dataPtr->provider->SetImage(image);
+  this->dataPtr->provider->SwapBuffers();
   this->newImage();
 }
 
@@ -238,45 +933,50 @@ void ImageDisplay::UpdateFromFloat32()
 {
   unsigned int height = this->dataPtr->imageMsg.height();
   unsigned int width = this->dataPtr->imageMsg.width();
-  QImage::Format qFormat = QImage::Format_RGB888;
-
-  QImage image = QImage(width, height, qFormat);
+  const unsigned int dec = this->dataPtr->decimation;
+  const unsigned int outWidth = width / dec;
+  const unsigned int outHeight = height / dec;
+  QImage &image = this->dataPtr->provider->BackBuffer(outWidth, outHeight,
+      QImage::Format_RGB888);
 
-  unsigned int depthSamples = width * height;
-  float f;
-  // cppchecker recommends using sizeof(varname)
-  unsigned int depthBufferSize = depthSamples * sizeof(f);
-
-  float * depthBuffer = new float[depthSamples];
-
-  memcpy(depthBuffer, this->dataPtr->imageMsg.data().c_str(),
-      depthBufferSize);
+  // read the depth samples in place; no scratch copy needed
+  const float *depthBuffer = reinterpret_cast<const float *>(
+      this->dataPtr->imageMsg.data().data());
 
+  // single-pass max reduction over the samples that will be displayed;
+  // for the common dec == 1 case this is contiguous and vectorizable
   float maxDepth = 0;
-  for (unsigned int i = 0; i < depthSamples; ++i)
+  for (unsigned int j = 0; j < outHeight; ++j)
   {
-    if (depthBuffer[i] > maxDepth && !std::isinf(depthBuffer[i]))
+    const float *row = depthBuffer + j * dec * width;
+    for (unsigned int i = 0; i < outWidth; ++i)
     {
-      maxDepth = depthBuffer[i];
+      const float d = row[i * dec];
+      if (d > maxDepth && !std::isinf(d))
+        maxDepth = d;
     }
   }
-  unsigned int idx = 0;
-  double factor = 255 / maxDepth;
-  for (unsigned int j = 0; j < height; ++j)
+
+  // normalize straight into the QImage scanlines instead of per-pixel
+  // setPixel calls
+  const float factor = maxDepth > 0.0f ? 255.0f / maxDepth : 0.0f;
+  for (unsigned int j = 0; j < outHeight; ++j)
   {
-    for (unsigned int i = 0; i < width; ++i)
+    uchar *scanLine = image.scanLine(j);
+    const float *row = depthBuffer + j * dec * width;
+    for (unsigned int i = 0; i < outWidth; ++i)
     {
-      float d = depthBuffer[idx++];
-      d = 255 - (d * factor);
-      QRgb value = qRgb(d, d, d);
-      image.setPixel(i, j, value);
+      const float d = 255.0f - row[i * dec] * factor;
+      const uchar v = d <= 0.0f ? 0u :
+          (d >= 255.0f ? 255u : static_cast<uchar>(d));
+      scanLine[3 * i] = v;
+      scanLine[3 * i + 1] = v;
+      scanLine[3 * i + 2] = v;
     }
   }
 
-  this->dataPtr->provider->SetImage(image);
+  this->dataPtr->provider->SwapBuffers();
   this->newImage();
-
-  delete[] depthBuffer;
 }
 
 /////////////////////////////////////////////////
@@ -284,53 +984,444 @@ void ImageDisplay::UpdateFromLInt16()
 {
   unsigned int height = this->dataPtr->imageMsg.height();
   unsigned int width = this->dataPtr->imageMsg.width();
-  QImage::Format qFormat = QImage::Format_RGB888;
-
-  QImage image = QImage(width, height, qFormat);
+  const unsigned int dec = this->dataPtr->decimation;
+  const unsigned int outWidth = width / dec;
+  const unsigned int outHeight = height / dec;
 
-  unsigned int samples = width * height;
-  uint16_t type;
-  // cppchecker recommends using sizeof(varname)
-  unsigned int bufferSize = samples * sizeof(type);
+  QImage &image = this->dataPtr->provider->BackBuffer(outWidth, outHeight,
+      QImage::Format_RGB888);
 
-  uint16_t *buffer = new uint16_t[samples];
-  memcpy(buffer, this->dataPtr->imageMsg.data().c_str(),
-      bufferSize);
+  // read the samples in place; no scratch copy needed
+  const uint16_t *buffer = reinterpret_cast<const uint16_t *>(
+      this->dataPtr->imageMsg.data().data());
 
-  // get min and max of temperature values
+  // get min and max of the temperature values that will be displayed
   uint16_t min = std::numeric_limits<uint16_t>::max();
   uint16_t max = 0;
-  for (unsigned int i = 0; i < samples; ++i)
+  for (unsigned int j = 0; j < outHeight; ++j)
   {
-    uint16_t temp = buffer[i];
-    if (temp > max)
-      max = temp;
-    if (temp < min)
-      min = temp;
+    const uint16_t *row = buffer + j * dec * width;
+    for (unsigned int i = 0; i < outWidth; ++i)
+    {
+      uint16_t temp = row[i * dec];
+      if (temp > max)
+        max = temp;
+      if (temp < min)
+        min = temp;
+    }
   }
 
-  // convert temperature to grayscale image
+  // convert temperature to grayscale image, writing scanlines directly
   double range = static_cast<double>(max - min);
   if (ignition::math::equal(range, 0.0))
     range = 1.0;
-  unsigned int idx = 0;
-  for (unsigned int j = 0; j < height; ++j)
+  for (unsigned int j = 0; j < outHeight; ++j)
   {
-    for (unsigned int i = 0; i < width; ++i)
+    uchar *scanLine = image.scanLine(j);
+    const uint16_t *row = buffer + j * dec * width;
+    for (unsigned int i = 0; i < outWidth; ++i)
     {
-      uint16_t temp = buffer[idx++];
-      double t = static_cast<double>(temp-min) / range;
-      int r = 255*t;
-      int g = r;
-      int b = r;
-      QRgb value = qRgb(r, g, b);
-      image.setPixel(i, j, value);
+      double t = static_cast<double>(row[i * dec] - min) / range;
+      const uchar v = static_cast<uchar>(255 * t);
+      scanLine[3 * i] = v;
+      scanLine[3 * i + 1] = v;
+      scanLine[3 * i + 2] = v;
     }
   }
-  this->dataPtr->provider->SetImage(image);
+  this->dataPtr->provider->SwapBuffers();
   this->newImage();
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::UpdateFromBayer8()
+{
+  unsigned int height = this->dataPtr->imageMsg.height();
+  unsigned int width = this->dataPtr->imageMsg.width();
+
+  // Bayer streams are mosaiced in 2x2 tiles, so dimensions are even on
+  // every camera we've seen; bail out rather than read past the payload.
+  if (width < 2 || height < 2 || (width % 2) || (height % 2))
+  {
+    ignerr << "Bayer image with invalid dimensions [" << width << " x "
+           << height << "]" << std::endl;
+    return;
+  }
 
-  delete[] buffer;
+  // Offset of the red site within each 2x2 tile; blue sits on the
+  // opposite diagonal and the other two sites are green.
+  unsigned int rx = 0;
+  unsigned int ry = 0;
+  switch (this->dataPtr->imageMsg.pixel_format_type())
+  {
+    case msgs::PixelFormatType::BAYER_RGGB8:
+      rx = 0; ry = 0;
+      break;
+    case msgs::PixelFormatType::BAYER_GRBG8:
+      rx = 1; ry = 0;
+      break;
+    case msgs::PixelFormatType::BAYER_GBRG8:
+      rx = 0; ry = 1;
+      break;
+    case msgs::PixelFormatType::BAYER_BGGR8:
+      rx = 1; ry = 1;
+      break;
+    default:
+      return;
+  }
+  const unsigned int bx = 1 - rx;
+  const unsigned int by = 1 - ry;
+
+  // decimation steps whole 2x2 tiles so the mosaic pattern is preserved
+  const unsigned int dec = this->dataPtr->decimation;
+  const unsigned int tileStep = 2 * dec;
+  const unsigned int outWidth = 2 * (width / tileStep);
+  const unsigned int outHeight = 2 * (height / tileStep);
+
+  QImage &image = this->dataPtr->provider->BackBuffer(outWidth, outHeight,
+      QImage::Format_RGB888);
+
+  const uchar *data = reinterpret_cast<const uchar *>(
+      this->dataPtr->imageMsg.data().data());
+
+  // Tile-based demosaic: each 2x2 tile yields one red and one blue
+  // sample shared by its four output pixels, while the two green sites
+  // keep their own samples so luma resolution is preserved. All offsets
+  // are resolved before the loop, leaving a branch-free inner body.
+  for (unsigned int j = 0; j < outHeight; j += 2)
+  {
+    const unsigned int inJ = (j / 2) * tileStep;
+    const uchar *rowR = data + (inJ + ry) * width;
+    const uchar *rowB = data + (inJ + by) * width;
+    uchar *outTop = image.scanLine(j);
+    uchar *outBot = image.scanLine(j + 1);
+    for (unsigned int i = 0; i < outWidth; i += 2)
+    {
+      const unsigned int inI = (i / 2) * tileStep;
+      const uchar r = rowR[inI + rx];
+      const uchar b = rowB[inI + bx];
+      const uchar g0 = rowR[inI + bx];
+      const uchar g1 = rowB[inI + rx];
+      const uchar gAvg = static_cast<uchar>((g0 + g1 + 1) >> 1);
+
+      uchar *rows[2] = {outTop, outBot};
+      // green per pixel: the two green sites keep their sample, the
+      // red/blue sites take the tile average
+      uchar greens[2][2];
+      greens[ry][rx] = gAvg;
+      greens[ry][bx] = g0;
+      greens[by][rx] = g1;
+      greens[by][bx] = gAvg;
+      for (unsigned int dj = 0; dj < 2; ++dj)
+      {
+        uchar *out = rows[dj] + 3 * i;
+        for (unsigned int di = 0; di < 2; ++di)
+        {
+          out[0] = r;
+          out[1] = greens[dj][di];
+          out[2] = b;
+          out += 3;
+        }
+      }
+    }
+  }
+
+  this->dataPtr->provider->SwapBuffers();
+  this->newImage();
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::UpdateFromCompressed()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->decodeMutex);
+    // Stage the payload for the worker; if one is already running it
+    // picks this frame up when it finishes the current one
+    this->dataPtr->compressedData = this->dataPtr->imageMsg.data();
+    const auto &stamp = this->dataPtr->imageMsg.header().stamp();
+    this->dataPtr->compressedStampNs =
+        (0 == stamp.sec() && 0 == stamp.nsec()) ? -1 :
+        stamp.sec() * 1000000000LL + stamp.nsec();
+    this->dataPtr->compressedDirty = true;
+    if (this->dataPtr->decodeRunning)
+      return;
+    this->dataPtr->decodeRunning = true;
+  }
+
+  // The previous worker has exited, this only collects it
+  if (this->dataPtr->decodeResult.valid())
+    this->dataPtr->decodeResult.wait();
+
+  this->dataPtr->decodeResult = std::async(std::launch::async, [this]()
+  {
+    while (true)
+    {
+      std::string payload;
+      int64_t stampNs{-1};
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->decodeMutex);
+        if (!this->dataPtr->compressedDirty)
+        {
+          this->dataPtr->decodeRunning = false;
+          return;
+        }
+        payload.swap(this->dataPtr->compressedData);
+        stampNs = this->dataPtr->compressedStampNs;
+        this->dataPtr->compressedDirty = false;
+      }
+
+      // Qt dispatches to its image plugins; JPEG decode lands in
+      // libjpeg-turbo's SIMD paths, off the GUI thread
+      auto decoded = QImage::fromData(
+          reinterpret_cast<const uchar *>(payload.data()),
+          static_cast<int>(payload.size()));
+      if (decoded.isNull())
+      {
+        logAsync(LogSeverity::WARN, "ImageDisplay::UpdateFromCompressed",
+            "Failed to decode compressed image [" +
+            std::to_string(payload.size()) + " bytes]");
+        continue;
+      }
+      if (decoded.format() != QImage::Format_RGB888)
+        decoded = decoded.convertToFormat(QImage::Format_RGB888);
+
+      // The decoded image owns its buffer, so it goes straight to the
+      // provider without touching the back buffer
+      this->dataPtr->provider->SetFrame(std::move(decoded));
+      this->RecordLatency(stampNs);
+      QMetaObject::invokeMethod(this, "OnDecoded", Qt::QueuedConnection);
+    }
+  });
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::OnDecoded()
+{
+  this->newImage();
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::RecordLatency(const int64_t _stampNs)
+{
+  if (_stampNs < 0)
+    return;
+
+  const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+  const auto deltaNs = nowNs - _stampNs;
+
+  // Stamps are only comparable to our wall clock when the publisher
+  // stamps wall time and the clocks are synced; sim time or clock skew
+  // produces negative or absurd deltas, which are dropped
+  if (deltaNs < 0 || deltaNs > 60LL * 1000000000LL)
+    return;
+
+  this->dataPtr->latency.Record(std::chrono::nanoseconds(deltaNs));
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::UpdateLatency()
+{
+  const auto count = this->dataPtr->latency.Count();
+
+  QString text;
+  if (count > 0u)
+  {
+    text = QString("Latency p50 %1 ms / p99 %2 ms")
+        .arg(this->dataPtr->latency.PercentileMs(50.0), 0, 'f', 1)
+        .arg(this->dataPtr->latency.PercentileMs(99.0), 0, 'f', 1);
+  }
+  if (text != this->dataPtr->latencyText)
+  {
+    this->dataPtr->latencyText = text;
+    this->LatencyChanged();
+  }
+
+  // every tenth refresh, publish the summary so deployed consoles can
+  // be monitored, and restart the window
+  if (++this->dataPtr->latencyTicks < 10)
+    return;
+  this->dataPtr->latencyTicks = 0;
+
+  if (count > 0u)
+  {
+    if (!this->dataPtr->latencyPub.Valid())
+    {
+      this->dataPtr->latencyPub =
+          this->dataPtr->node.Advertise<msgs::Param>(
+          "/gui/image_display/latency");
+    }
+    if (this->dataPtr->latencyPub.Valid())
+    {
+      msgs::Param msg;
+      auto addParam = [&msg](const std::string &_key, const double _value)
+      {
+        msgs::Any value;
+        value.set_type(msgs::Any::DOUBLE);
+        value.set_double_value(_value);
+        (*msg.mutable_params())[_key] = value;
+      };
+      addParam("p50_ms", this->dataPtr->latency.PercentileMs(50.0));
+      addParam("p99_ms", this->dataPtr->latency.PercentileMs(99.0));
+      addParam("max_ms", this->dataPtr->latency.MaxMs());
+      addParam("count", static_cast<double>(count));
+      this->dataPtr->latencyPub.Publish(msg);
+    }
+  }
+  this->dataPtr->latency.Reset();
+}
+
+/////////////////////////////////////////////////
+QString ImageDisplay::LatencyText() const
+{
+  return this->dataPtr->latencyText;
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::UploadLInt16()
+{
+  unsigned int height = this->dataPtr->imageMsg.height();
+  unsigned int width = this->dataPtr->imageMsg.width();
+
+  const uint16_t *buffer = reinterpret_cast<const uint16_t *>(
+      this->dataPtr->imageMsg.data().data());
+  const unsigned int dec = this->dataPtr->decimation;
+  const unsigned int outWidth = width / dec;
+  const unsigned int outHeight = height / dec;
+
+  // the reduction stays on the CPU; only the per-pixel normalization
+  // moves to the shader
+  uint16_t min = std::numeric_limits<uint16_t>::max();
+  uint16_t max = 0;
+  for (unsigned int j = 0; j < outHeight; ++j)
+  {
+    const uint16_t *row = buffer + j * dec * width;
+    for (unsigned int i = 0; i < outWidth; ++i)
+    {
+      uint16_t temp = row[i * dec];
+      if (temp > max)
+        max = temp;
+      if (temp < min)
+        min = temp;
+    }
+  }
+
+  // pack each 16-bit sample into the R (high byte) and G (low byte)
+  // channels; the shader reassembles and normalizes them
+  QImage &image = this->dataPtr->provider->BackBuffer(outWidth, outHeight,
+      QImage::Format_RGB888);
+  for (unsigned int j = 0; j < outHeight; ++j)
+  {
+    uchar *scanLine = image.scanLine(j);
+    const uint16_t *row = buffer + j * dec * width;
+    for (unsigned int i = 0; i < outWidth; ++i)
+    {
+      scanLine[3 * i] = static_cast<uchar>(row[i * dec] >> 8);
+      scanLine[3 * i + 1] = static_cast<uchar>(row[i * dec] & 0xff);
+      scanLine[3 * i + 2] = 0;
+    }
+  }
+
+  this->dataPtr->normMin = min / 65535.0;
+  this->dataPtr->normMax = max / 65535.0;
+  this->NormRangeChanged();
+  if (this->dataPtr->gpuMode != 1)
+  {
+    this->dataPtr->gpuMode = 1;
+    this->GpuModeChanged();
+  }
+
+  this->dataPtr->provider->SwapBuffers();
+  this->newImage();
+}
+
+/////////////////////////////////////////////////
+void ImageDisplay::UploadBayer8()
+{
+  unsigned int height = this->dataPtr->imageMsg.height();
+  unsigned int width = this->dataPtr->imageMsg.width();
+
+  if (width < 2 || height < 2 || (width % 2) || (height % 2))
+  {
+    ignerr << "Bayer image with invalid dimensions [" << width << " x "
+           << height << "]" << std::endl;
+    return;
+  }
+
+  int mode = 0;
+  switch (this->dataPtr->imageMsg.pixel_format_type())
+  {
+    case msgs::PixelFormatType::BAYER_RGGB8:
+      mode = 2;
+      break;
+    case msgs::PixelFormatType::BAYER_GRBG8:
+      mode = 3;
+      break;
+    case msgs::PixelFormatType::BAYER_GBRG8:
+      mode = 4;
+      break;
+    case msgs::PixelFormatType::BAYER_BGGR8:
+      mode = 5;
+      break;
+    default:
+      return;
+  }
+
+  // the raw mosaic goes up as a single-channel texture, a third of the
+  // upload of demosaiced RGB; the shader reconstructs color per fragment
+  const unsigned int dec = this->dataPtr->decimation;
+  const unsigned int tileStep = 2 * dec;
+  const unsigned int outWidth = 2 * (width / tileStep);
+  const unsigned int outHeight = 2 * (height / tileStep);
+  QImage &image = this->dataPtr->provider->BackBuffer(outWidth, outHeight,
+      QImage::Format_Grayscale8);
+  const uchar *data = reinterpret_cast<const uchar *>(
+      this->dataPtr->imageMsg.data().data());
+  if (dec <= 1)
+  {
+    for (unsigned int j = 0; j < height; ++j)
+    {
+      // row by row: QImage scanlines are 32-bit aligned
+      memcpy(image.scanLine(j), data + j * width, width);
+    }
+  }
+  else
+  {
+    // gather whole 2x2 tiles so the decimated mosaic keeps its pattern
+    for (unsigned int j = 0; j < outHeight; ++j)
+    {
+      uchar *scanLine = image.scanLine(j);
+      const uchar *row = data + ((j / 2) * tileStep + (j % 2)) * width;
+      for (unsigned int i = 0; i < outWidth; ++i)
+        scanLine[i] = row[(i / 2) * tileStep + (i % 2)];
+    }
+  }
+
+  if (this->dataPtr->gpuMode != mode)
+  {
+    this->dataPtr->gpuMode = mode;
+    this->GpuModeChanged();
+  }
+
+  this->dataPtr->provider->SwapBuffers();
+  this->newImage();
+}
+
+/////////////////////////////////////////////////
+int ImageDisplay::GpuMode() const
+{
+  return this->dataPtr->gpuMode;
+}
+
+/////////////////////////////////////////////////
+double ImageDisplay::NormMin() const
+{
+  return this->dataPtr->normMin;
+}
+
+/////////////////////////////////////////////////
+double ImageDisplay::NormMax() const
+{
+  return this->dataPtr->normMax;
 }
 
 /////////////////////////////////////////////////
@@ -18,7 +18,11 @@
 #ifndef IGNITION_GUI_PLUGINS_IMAGEDISPLAY_HH_
 #define IGNITION_GUI_PLUGINS_IMAGEDISPLAY_HH_
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
+
 #include <ignition/msgs.hh>
 
 #include "ignition/gui/Plugin.hh"
@@ -35,9 +39,24 @@ namespace plugins
   ///
   /// ## Configuration
   ///
-  /// \<topic\> : Set the topic to receive image messages.
+  /// \<topic\> : Set the topic to receive image messages. Repeating the
+  ///             element switches to tiled mode: every listed topic is
+  ///             shown as one tile of a shared atlas, with decoding and
+  ///             conversion done by a worker pool shared across all
+  ///             tiled displays in the process.
   /// \<topic_picker\> : Whether to show the topic picker, true by default. If
   ///                    this is false, a \<topic\> must be specified.
+  ///                    Always hidden in tiled mode.
+  /// \<tile_width\> : Width in pixels of one atlas tile in tiled mode,
+  ///                  320 by default.
+  /// \<tile_height\> : Height in pixels of one atlas tile in tiled
+  ///                   mode, 240 by default.
+  /// \<gpu_conversion\> : Convert supported pixel formats in a fragment
+  ///                      shader instead of on the CPU, false by default.
+  /// \<decimation\> : Keep every Nth pixel in each direction during
+  ///                  conversion, useful when the display tile is much
+  ///                  smaller than the stream. 1 (full resolution) by
+  ///                  default.
   class ImageDisplay : public Plugin
   {
     Q_OBJECT
@@ -50,6 +69,36 @@ namespace plugins
       NOTIFY TopicListChanged
     )
 
+    /// \brief Conversion the shader should apply to the current texture.
+    /// See ImageDisplayPrivate::gpuMode for the encoding.
+    Q_PROPERTY(
+      int gpuMode
+      READ GpuMode
+      NOTIFY GpuModeChanged
+    )
+
+    /// \brief Lower bound of the shader normalization range
+    Q_PROPERTY(
+      double normMin
+      READ NormMin
+      NOTIFY NormRangeChanged
+    )
+
+    /// \brief Upper bound of the shader normalization range
+    Q_PROPERTY(
+      double normMax
+      READ NormMax
+      NOTIFY NormRangeChanged
+    )
+
+    /// \brief End-to-end latency readout, empty while there is nothing
+    /// to report
+    Q_PROPERTY(
+      QString latencyText
+      READ LatencyText
+      NOTIFY LatencyChanged
+    )
+
     /// \brief Constructor
     public: ImageDisplay();
 
@@ -59,6 +108,9 @@ namespace plugins
     // Documentation inherited
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem);
 
+    // Documentation inherited
+    public: virtual void Shutdown();
+
     /// \brief Callback when refresh button is pressed.
     public slots: void OnRefresh();
 
@@ -75,15 +127,46 @@ namespace plugins
     /// \param[in] _topicList Message type
     public: Q_INVOKABLE void SetTopicList(const QStringList &_topicList);
 
+    /// \brief Get the conversion mode for the shader
+    /// \return Mode, see ImageDisplayPrivate::gpuMode
+    public: Q_INVOKABLE int GpuMode() const;
+
+    /// \brief Get the lower bound of the shader normalization range
+    /// \return Lower bound in texture units
+    public: Q_INVOKABLE double NormMin() const;
+
+    /// \brief Get the upper bound of the shader normalization range
+    /// \return Upper bound in texture units
+    public: Q_INVOKABLE double NormMax() const;
+
+    /// \brief Get the end-to-end latency readout.
+    /// \return p50/p99 summary, or an empty string while there is
+    /// nothing to report.
+    public: Q_INVOKABLE QString LatencyText() const;
+
     /// \brief Notify that topic list has changed
     signals: void TopicListChanged();
 
+    /// \brief Notify that the shader conversion mode has changed
+    signals: void GpuModeChanged();
+
+    /// \brief Notify that the shader normalization range has changed
+    signals: void NormRangeChanged();
+
+    /// \brief Notify that the latency readout has changed
+    signals: void LatencyChanged();
+
     /// \brief Notify that a new image has been received.
     signals: void newImage();
 
     /// \brief Callback in main thread when image changes
     private slots: void ProcessImage();
 
+    /// \brief Add a discovered topic to the list. Queued from the
+    /// discovery worker so results stream in as they arrive.
+    /// \param[in] _topic Topic name
+    private slots: void AddTopic(const QString &_topic);
+
     /// \brief Update from rx'd RGB_INT8
     private: void UpdateFromRgbInt8();
 
@@ -93,9 +176,50 @@ namespace plugins
     /// \brief Update from L_INT16
     private: void UpdateFromLInt16();
 
-    /// \brief Subscriber callback when new image is received
-    /// \param[in] _msg New image
-    private: void OnImageMsg(const ignition::msgs::Image &_msg);
+    /// \brief Update from any of the 8-bit Bayer mosaic formats
+    private: void UpdateFromBayer8();
+
+    /// \brief Hand a compressed (JPEG or PNG) payload to the decode
+    /// worker, which feeds the provider when done. The latest payload
+    /// wins, so a slow decode never builds a queue.
+    private: void UpdateFromCompressed();
+
+    /// \brief Called on the GUI thread whenever the decode worker
+    /// finished a frame.
+    private slots: void OnDecoded();
+
+    /// \brief Refresh the latency readout and, every few ticks, publish
+    /// the telemetry summary and reset the window.
+    private slots: void UpdateLatency();
+
+    /// \brief Record one frame's end-to-end latency: the delta between
+    /// the msg's header stamp and now, the time the converted frame was
+    /// handed to the provider. Deltas from unstamped msgs, sim time or
+    /// unsynced clocks are dropped instead of charted.
+    /// \param[in] _stampNs Header stamp in ns since epoch, -1 when
+    /// unset.
+    private: void RecordLatency(const int64_t _stampNs);
+
+    /// \brief Pack L_INT16 data into a texture for shader normalization
+    private: void UploadLInt16();
+
+    /// \brief Pack an 8-bit Bayer mosaic into a single-channel texture
+    /// for shader demosaicing
+    private: void UploadBayer8();
+
+    /// \brief Subscriber callback when new image is received. Takes the
+    /// serialized payload, which is parsed once on the GUI thread.
+    /// \param[in] _msgData Serialized image message
+    /// \param[in] _size Size of the serialized message in bytes
+    private: void OnImageMsg(const char *_msgData, const size_t _size);
+
+    /// \brief Subscribe to several topics and show them as tiles of one
+    /// atlas, converted by the process-wide worker pool.
+    /// \param[in] _topics Topics to subscribe to, one tile each
+    /// \param[in] _tileWidth Width in pixels of one tile
+    /// \param[in] _tileHeight Height in pixels of one tile
+    private: void SetupTiled(const std::vector<std::string> &_topics,
+        const int _tileWidth, const int _tileHeight);
 
     /// \internal
     /// \brief Pointer to private data.
@@ -86,15 +86,116 @@ Rectangle {
         ToolTip.text: qsTr("Ignition transport topics publishing Image messages")
       }
     }
-    Image {
-      id: image
-      fillMode: Image.PreserveAspectFit
+    Item {
       Layout.fillHeight: true
       Layout.fillWidth: true
-      verticalAlignment: Image.AlignTop
-      function reload() {
-        // Force image request to C++
-        source = "image://" + uniqueName + "/" + Math.random().toString(36).substr(2, 5);
+
+      Image {
+        id: image
+        anchors.fill: parent
+        fillMode: Image.PreserveAspectFit
+        verticalAlignment: Image.AlignTop
+        // When a GPU conversion mode is active, the image holds raw
+        // packed data that only the shader below knows how to display
+        visible: ImageDisplay.gpuMode === 0
+        function reload() {
+          // Force image request to C++
+          source = "image://" + uniqueName + "/" + Math.random().toString(36).substr(2, 5);
+        }
+      }
+      ShaderEffect {
+        id: convertEffect
+        visible: ImageDisplay.gpuMode !== 0
+        anchors.top: parent.top
+        anchors.horizontalCenter: parent.horizontalCenter
+        // preserve the texture's aspect ratio, like the Image above
+        property real fitScale: texSize.width > 0 && texSize.height > 0 ?
+            Math.min(parent.width / texSize.width,
+                     parent.height / texSize.height) : 0
+        width: texSize.width * fitScale
+        height: texSize.height * fitScale
+        property variant src: image
+        property int mode: ImageDisplay.gpuMode
+        property real normMin: ImageDisplay.normMin
+        property real normMax: ImageDisplay.normMax
+        property size texSize: Qt.size(image.sourceSize.width,
+                                       image.sourceSize.height)
+        fragmentShader: "
+          varying highp vec2 qt_TexCoord0;
+          uniform lowp float qt_Opacity;
+          uniform sampler2D src;
+          uniform int mode;
+          uniform highp float normMin;
+          uniform highp float normMax;
+          uniform highp vec2 texSize;
+
+          highp float sample1(highp vec2 _px)
+          {
+            return texture2D(src, (_px + 0.5) / texSize).r;
+          }
+
+          void main()
+          {
+            if (mode == 1)
+            {
+              // 16-bit value packed into R (high byte) and G (low byte),
+              // normalized to the [normMin, normMax] range
+              highp vec4 t = texture2D(src, qt_TexCoord0);
+              highp float v = (t.r * 65280.0 + t.g * 255.0) / 65535.0;
+              v = (v - normMin) / max(normMax - normMin, 0.00001);
+              gl_FragColor = vec4(v, v, v, 1.0) * qt_Opacity;
+              return;
+            }
+
+            // modes 2-5: Bayer mosaic, red site at (0,0), (1,0), (0,1) or
+            // (1,1) of each 2x2 tile
+            highp vec2 rOff = vec2(0.0, 0.0);
+            if (mode == 3)
+              rOff = vec2(1.0, 0.0);
+            else if (mode == 4)
+              rOff = vec2(0.0, 1.0);
+            else if (mode == 5)
+              rOff = vec2(1.0, 1.0);
+
+            highp vec2 px = floor(qt_TexCoord0 * texSize);
+            highp vec2 parity = mod(px - rOff + 2.0, 2.0);
+
+            highp float c = sample1(px);
+            highp float h = 0.5 * (sample1(px + vec2(-1.0, 0.0)) +
+                                   sample1(px + vec2(1.0, 0.0)));
+            highp float v = 0.5 * (sample1(px + vec2(0.0, -1.0)) +
+                                   sample1(px + vec2(0.0, 1.0)));
+            highp float d = 0.25 * (sample1(px + vec2(-1.0, -1.0)) +
+                                    sample1(px + vec2(1.0, -1.0)) +
+                                    sample1(px + vec2(-1.0, 1.0)) +
+                                    sample1(px + vec2(1.0, 1.0)));
+
+            highp vec3 rgb;
+            if (parity.x < 0.5 && parity.y < 0.5)
+              rgb = vec3(c, 0.5 * (h + v), d);          // red site
+            else if (parity.x >= 0.5 && parity.y < 0.5)
+              rgb = vec3(h, c, v);                      // green, red row
+            else if (parity.x < 0.5 && parity.y >= 0.5)
+              rgb = vec3(v, c, h);                      // green, blue row
+            else
+              rgb = vec3(d, 0.5 * (h + v), c);          // blue site
+            gl_FragColor = vec4(rgb, 1.0) * qt_Opacity;
+          }"
+      }
+    }
+    Label {
+      visible: ImageDisplay.latencyText.length > 0
+      text: ImageDisplay.latencyText
+      font.pixelSize: 10
+      ToolTip.visible: latencyMouse.containsMouse
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text: qsTr("End-to-end latency from the image header stamp " +
+          "to the frame reaching the display, over the last few seconds")
+      MouseArea {
+        id: latencyMouse
+        anchors.fill: parent
+        hoverEnabled: true
       }
     }
   }
@@ -0,0 +1,645 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <QSGFlatColorMaterial>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+
+#include <ignition/common/Console.hh>
+#include <ignition/plugin/Register.hh>
+
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/Helpers.hh"
+
+#include "Plotting.hh"
+
+/// \brief Samples kept per series. At 1 kHz this holds 20 s of raw
+/// data; the display window is usually shorter, and older samples fall
+/// off the ring instead of growing memory.
+static const size_t kRingCapacity{20000};
+
+/// \brief Colors handed to series in creation order
+static const std::vector<QString> kSeriesPalette{
+    "#2196f3",
+    "#f44336",
+    "#4caf50",
+    "#ff9800",
+    "#9c27b0",
+    "#00bcd4"};
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  /// \brief Fixed-capacity ring of samples for one series
+  struct PlotSeries
+  {
+    /// \brief Name shown in the legend
+    std::string name;
+
+    /// \brief Sample storage, preallocated to kRingCapacity
+    std::vector<QPointF> ring;
+
+    /// \brief Next write position
+    size_t head{0};
+
+    /// \brief Number of valid samples, up to the ring size
+    size_t count{0};
+
+    /// \brief Append a sample, overwriting the oldest when full.
+    /// \param[in] _x Sample time in seconds.
+    /// \param[in] _y Sample value.
+    void Push(double _x, double _y)
+    {
+      this->ring[this->head] = QPointF(_x, _y);
+      this->head = (this->head + 1) % this->ring.size();
+      this->count = std::min(this->count + 1, this->ring.size());
+    }
+  };
+
+  class PlottingPrivate
+  {
+    /// \brief Communication node. Points at the node shared by all
+    /// plugins when there is an application, otherwise at fallbackNode.
+    public: ignition::transport::Node *node{nullptr};
+
+    /// \brief Node owned by this plugin, only created when there is no
+    /// application to share one with.
+    public: std::unique_ptr<ignition::transport::Node> fallbackNode;
+
+    /// \brief Topics subscribed to, so the destructor can remove this
+    /// plugin's handlers from the shared node.
+    public: std::vector<std::string> topics;
+
+    /// \brief Protects the series; samples arrive on transport threads
+    /// and are read from the render thread.
+    public: mutable std::mutex mutex;
+
+    /// \brief All plotted series
+    public: std::vector<PlotSeries> series;
+
+    /// \brief When plotting started; sample times are relative to it
+    public: std::chrono::steady_clock::time_point start;
+
+    /// \brief Index of the real time factor series, -1 when absent
+    public: int rtfSeries{-1};
+
+    /// \brief Index of the iteration rate series, -1 when absent
+    public: int iterationSeries{-1};
+
+    /// \brief Iteration count of the previous stats message
+    public: uint64_t prevIterations{0};
+
+    /// \brief Sample time of the previous stats message
+    public: double prevIterationStamp{-1.0};
+
+    /// \brief Messages parsed from raw subscriptions, keyed by series;
+    /// created from the advertised type on first use
+    public: std::vector<std::unique_ptr<google::protobuf::Message>>
+        prototypes;
+
+    /// \brief Seconds of history shown, from <window>
+    public: double window{60.0};
+
+    /// \brief Get the sample time for now.
+    /// \return Seconds since plotting started.
+    public: double Now() const
+    {
+      return std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - this->start).count();
+    }
+  };
+
+  class PlotViewPrivate
+  {
+    /// \brief Plugin holding the series data, not owned
+    public: Plotting *source{nullptr};
+
+    /// \brief Seconds of history shown
+    public: double windowSeconds{60.0};
+  };
+}
+}
+}
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+/// \brief Resolve a dot path to a numeric field through reflection.
+/// \param[in] _msg Message to read from.
+/// \param[in] _path Dot-separated field path, e.g. "linear_velocity.x".
+/// \param[out] _ok Set to false when the path doesn't name a numeric
+/// singular field.
+/// \return The field's value as a double.
+static double NumericField(const google::protobuf::Message &_msg,
+    const std::string &_path, bool &_ok)
+{
+  _ok = false;
+
+  const google::protobuf::Message *msg = &_msg;
+  std::string path = _path;
+
+  while (true)
+  {
+    auto dot = path.find('.');
+    auto name = path.substr(0, dot);
+
+    auto descriptor = msg->GetDescriptor()->FindFieldByName(name);
+    if (!descriptor || descriptor->is_repeated())
+      return 0.0;
+
+    auto reflection = msg->GetReflection();
+
+    if (dot != std::string::npos)
+    {
+      if (descriptor->cpp_type() !=
+          google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE)
+      {
+        return 0.0;
+      }
+      msg = &reflection->GetMessage(*msg, descriptor);
+      path = path.substr(dot + 1);
+      continue;
+    }
+
+    switch (descriptor->cpp_type())
+    {
+      case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+        _ok = true;
+        return reflection->GetDouble(*msg, descriptor);
+      case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+        _ok = true;
+        return reflection->GetFloat(*msg, descriptor);
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+        _ok = true;
+        return reflection->GetInt32(*msg, descriptor);
+      case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+        _ok = true;
+        return static_cast<double>(reflection->GetInt64(*msg, descriptor));
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+        _ok = true;
+        return reflection->GetUInt32(*msg, descriptor);
+      case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+        _ok = true;
+        return static_cast<double>(reflection->GetUInt64(*msg, descriptor));
+      case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+        _ok = true;
+        return reflection->GetBool(*msg, descriptor) ? 1.0 : 0.0;
+      default:
+        return 0.0;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+PlotView::PlotView()
+  : dataPtr(new PlotViewPrivate)
+{
+  this->setFlag(QQuickItem::ItemHasContents);
+
+  // Repaint at display rate; decimation keeps each pass cheap. Piggyback
+  // on the application's shared scheduler so the repaint doesn't add its
+  // own wakeup, keeping a fallback timer for views created standalone.
+  if (auto app = App())
+  {
+    app->AddUpdateCallback(this, 33, [this]() { this->update(); });
+  }
+  else
+  {
+    auto timer = new QTimer(this);
+    this->connect(timer, &QTimer::timeout, this, [this]() { this->update(); });
+    timer->start(33);
+  }
+}
+
+/////////////////////////////////////////////////
+PlotView::~PlotView() = default;
+
+/////////////////////////////////////////////////
+void PlotView::SetSource(Plotting *_plugin)
+{
+  this->dataPtr->source = _plugin;
+}
+
+/////////////////////////////////////////////////
+double PlotView::WindowSeconds() const
+{
+  return this->dataPtr->windowSeconds;
+}
+
+/////////////////////////////////////////////////
+void PlotView::SetWindowSeconds(const double _seconds)
+{
+  this->dataPtr->windowSeconds = std::max(1.0, _seconds);
+  this->WindowSecondsChanged();
+}
+
+/////////////////////////////////////////////////
+QSGNode *PlotView::updatePaintNode(QSGNode *_node,
+    QQuickItem::UpdatePaintNodeData *)
+{
+  auto root = _node ? _node : new QSGNode;
+
+  if (!this->dataPtr->source || this->width() < 2 || this->height() < 2)
+    return root;
+
+  std::vector<std::vector<QPointF>> series;
+  QRectF bounds;
+  this->dataPtr->source->DecimatedCopy(
+      static_cast<int>(this->width() / 2),
+      this->dataPtr->windowSeconds, series, bounds);
+
+  auto colors = this->dataPtr->source->SeriesColors();
+
+  // One geometry node per series, reused across frames
+  while (root->childCount() < static_cast<int>(series.size()))
+  {
+    auto node = new QSGGeometryNode;
+
+    auto geometry = new QSGGeometry(
+        QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+    geometry->setLineWidth(2);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+
+    auto material = new QSGFlatColorMaterial;
+    material->setColor(QColor(colors.value(root->childCount(), "#2196f3")));
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+
+    root->appendChildNode(node);
+  }
+  while (root->childCount() > static_cast<int>(series.size()))
+  {
+    auto last = root->childAtIndex(root->childCount() - 1);
+    root->removeChildNode(last);
+    delete last;
+  }
+
+  // Map data space to item space; y grows downwards on screen
+  auto xSpan = std::max(bounds.width(), 1e-9);
+  auto ySpan = std::max(bounds.height(), 1e-9);
+  auto margin = ySpan * 0.05;
+  auto yMin = bounds.top() - margin;
+  ySpan += 2 * margin;
+
+  for (size_t i = 0; i < series.size(); ++i)
+  {
+    auto node = static_cast<QSGGeometryNode *>(
+        root->childAtIndex(static_cast<int>(i)));
+    auto geometry = node->geometry();
+    geometry->allocate(static_cast<int>(series[i].size()));
+
+    auto vertices = geometry->vertexDataAsPoint2D();
+    for (size_t j = 0; j < series[i].size(); ++j)
+    {
+      auto px = (series[i][j].x() - bounds.left()) / xSpan * this->width();
+      auto py = this->height() -
+          (series[i][j].y() - yMin) / ySpan * this->height();
+      vertices[j].set(static_cast<float>(px), static_cast<float>(py));
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+  }
+
+  return root;
+}
+
+/////////////////////////////////////////////////
+Plotting::Plotting()
+  : Plugin(), dataPtr(new PlottingPrivate)
+{
+  qmlRegisterType<PlotView>("PlotView", 1, 0, "PlotView");
+  this->dataPtr->start = std::chrono::steady_clock::now();
+}
+
+/////////////////////////////////////////////////
+Plotting::~Plotting()
+{
+  // The shared node outlives this plugin, so remove our handlers
+  if (nullptr != this->dataPtr->node)
+  {
+    for (const auto &topic : this->dataPtr->topics)
+      this->dataPtr->node->Unsubscribe(topic);
+  }
+}
+
+/////////////////////////////////////////////////
+void Plotting::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  if (this->title.empty())
+    this->title = "Plotting";
+
+  if (!_pluginElem)
+  {
+    ignerr << "Null plugin element." << std::endl;
+    return;
+  }
+
+  // Subscribe on the node shared by all plugins, so this plugin adds no
+  // transport threads of its own
+  if (auto app = App())
+    this->dataPtr->node = app->TransportNode();
+  if (nullptr == this->dataPtr->node)
+  {
+    this->dataPtr->fallbackNode.reset(new ignition::transport::Node());
+    this->dataPtr->node = this->dataPtr->fallbackNode.get();
+  }
+
+  if (auto windowElem = _pluginElem->FirstChildElement("window"))
+  {
+    windowElem->QueryDoubleText(&this->dataPtr->window);
+    if (this->dataPtr->window <= 0.0)
+    {
+      ignwarn << "Ignoring <window> [" << this->dataPtr->window
+              << "], must be positive." << std::endl;
+      this->dataPtr->window = 60.0;
+    }
+  }
+
+  // World statistics series
+  if (auto statsElem = _pluginElem->FirstChildElement("stats_topic"))
+  {
+    std::string topic;
+    if (nullptr != statsElem->GetText())
+      topic = statsElem->GetText();
+
+    if (!topic.empty() && this->dataPtr->node->Subscribe(topic,
+        &Plotting::OnWorldStatsMsg, this))
+    {
+      this->dataPtr->topics.push_back(topic);
+
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+      PlotSeries rtf;
+      rtf.name = "Real time factor";
+      rtf.ring.resize(kRingCapacity);
+      this->dataPtr->rtfSeries =
+          static_cast<int>(this->dataPtr->series.size());
+      this->dataPtr->series.push_back(std::move(rtf));
+
+      PlotSeries iterations;
+      iterations.name = "Iterations / s";
+      iterations.ring.resize(kRingCapacity);
+      this->dataPtr->iterationSeries =
+          static_cast<int>(this->dataPtr->series.size());
+      this->dataPtr->series.push_back(std::move(iterations));
+    }
+    else if (!topic.empty())
+    {
+      ignerr << "Failed to subscribe to [" << topic << "]" << std::endl;
+    }
+  }
+
+  // Arbitrary numeric fields
+  for (auto seriesElem = _pluginElem->FirstChildElement("series");
+      seriesElem != nullptr;
+      seriesElem = seriesElem->NextSiblingElement("series"))
+  {
+    std::string topic = seriesElem->Attribute("topic") ?
+        seriesElem->Attribute("topic") : "";
+    std::string field = seriesElem->Attribute("field") ?
+        seriesElem->Attribute("field") : "";
+    if (topic.empty() || field.empty())
+    {
+      ignwarn << "<series> needs `topic` and `field` attributes."
+              << std::endl;
+      continue;
+    }
+
+    size_t index;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      index = this->dataPtr->series.size();
+
+      PlotSeries series;
+      series.name = topic + " " + field;
+      series.ring.resize(kRingCapacity);
+      this->dataPtr->series.push_back(std::move(series));
+      this->dataPtr->prototypes.resize(index + 1);
+    }
+
+    // Raw subscription: the message type isn't known at compile time,
+    // so parse into a prototype created from the advertised type name
+    // and pull the field out through reflection
+    auto cb = [this, index, field](const char *_msgData, const size_t _size,
+        const ignition::transport::MessageInfo &_info)
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+      auto &prototype = this->dataPtr->prototypes[index];
+      if (!prototype)
+      {
+        prototype = ignition::msgs::Factory::New(_info.Type());
+        if (!prototype)
+        {
+          return;
+        }
+      }
+
+      if (!prototype->ParseFromArray(_msgData, static_cast<int>(_size)))
+        return;
+
+      bool ok{false};
+      auto value = NumericField(*prototype, field, ok);
+      if (ok)
+        this->dataPtr->series[index].Push(this->dataPtr->Now(), value);
+    };
+
+    if (!this->dataPtr->node->SubscribeRaw(topic, cb))
+    {
+      ignerr << "Failed to subscribe to [" << topic << "]" << std::endl;
+      continue;
+    }
+    this->dataPtr->topics.push_back(topic);
+  }
+
+  // Wire the view to this plugin's data
+  if (auto view = this->PluginItem()->findChild<PlotView *>())
+  {
+    view->SetSource(this);
+    view->SetWindowSeconds(this->dataPtr->window);
+  }
+  else
+  {
+    ignerr << "Unable to find PlotView item." << std::endl;
+  }
+
+  this->SeriesChanged();
+}
+
+/////////////////////////////////////////////////
+QStringList Plotting::SeriesNames() const
+{
+  QStringList names;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (const auto &series : this->dataPtr->series)
+    names.append(QString::fromStdString(series.name));
+  return names;
+}
+
+/////////////////////////////////////////////////
+QStringList Plotting::SeriesColors() const
+{
+  QStringList colors;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (size_t i = 0; i < this->dataPtr->series.size(); ++i)
+    colors.append(kSeriesPalette[i % kSeriesPalette.size()]);
+  return colors;
+}
+
+/////////////////////////////////////////////////
+void Plotting::DecimatedCopy(int _buckets, double _windowSeconds,
+    std::vector<std::vector<QPointF>> &_series, QRectF &_bounds) const
+{
+  _series.clear();
+
+  auto buckets = std::max(_buckets, 10);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto xMax = this->dataPtr->Now();
+  auto xMin = xMax - _windowSeconds;
+  auto bucketSpan = (xMax - xMin) / buckets;
+
+  double yMin{std::numeric_limits<double>::max()};
+  double yMax{-std::numeric_limits<double>::max()};
+
+  for (const auto &series : this->dataPtr->series)
+  {
+    std::vector<QPointF> run;
+    run.reserve(2 * buckets);
+
+    // Walk the ring oldest to newest, folding each bucket to its min
+    // and max so spikes survive decimation
+    int bucket{-1};
+    double bucketMin{0.0};
+    double bucketMax{0.0};
+    double bucketMinX{0.0};
+    double bucketMaxX{0.0};
+
+    auto flush = [&]()
+    {
+      if (bucket < 0)
+        return;
+
+      // Emit min and max in time order so the strip doesn't zigzag
+      if (bucketMinX <= bucketMaxX)
+      {
+        run.push_back(QPointF(bucketMinX, bucketMin));
+        if (bucketMaxX > bucketMinX || bucketMax != bucketMin)
+          run.push_back(QPointF(bucketMaxX, bucketMax));
+      }
+      else
+      {
+        run.push_back(QPointF(bucketMaxX, bucketMax));
+        run.push_back(QPointF(bucketMinX, bucketMin));
+      }
+    };
+
+    auto start = (series.head + series.ring.size() - series.count) %
+        series.ring.size();
+    for (size_t i = 0; i < series.count; ++i)
+    {
+      const auto &point = series.ring[(start + i) % series.ring.size()];
+      if (point.x() < xMin)
+        continue;
+
+      auto pointBucket = static_cast<int>((point.x() - xMin) / bucketSpan);
+      if (pointBucket != bucket)
+      {
+        flush();
+        bucket = pointBucket;
+        bucketMin = bucketMax = point.y();
+        bucketMinX = bucketMaxX = point.x();
+      }
+      else
+      {
+        if (point.y() < bucketMin)
+        {
+          bucketMin = point.y();
+          bucketMinX = point.x();
+        }
+        if (point.y() > bucketMax)
+        {
+          bucketMax = point.y();
+          bucketMaxX = point.x();
+        }
+      }
+
+      yMin = std::min(yMin, point.y());
+      yMax = std::max(yMax, point.y());
+    }
+    flush();
+
+    _series.push_back(std::move(run));
+  }
+
+  if (yMin > yMax)
+  {
+    yMin = 0.0;
+    yMax = 1.0;
+  }
+
+  _bounds = QRectF(QPointF(xMin, yMin), QPointF(xMax, yMax));
+}
+
+/////////////////////////////////////////////////
+void Plotting::OnWorldStatsMsg(const ignition::msgs::WorldStatistics &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto now = this->dataPtr->Now();
+
+  if (this->dataPtr->rtfSeries >= 0)
+  {
+    this->dataPtr->series[this->dataPtr->rtfSeries].Push(now,
+        _msg.real_time_factor());
+  }
+
+  if (this->dataPtr->iterationSeries >= 0)
+  {
+    if (this->dataPtr->prevIterationStamp >= 0.0 &&
+        now > this->dataPtr->prevIterationStamp)
+    {
+      auto rate = (_msg.iterations() - this->dataPtr->prevIterations) /
+          (now - this->dataPtr->prevIterationStamp);
+      this->dataPtr->series[this->dataPtr->iterationSeries].Push(now, rate);
+    }
+    this->dataPtr->prevIterations = _msg.iterations();
+    this->dataPtr->prevIterationStamp = now;
+  }
+}
+
+// Register this plugin
+IGNITION_ADD_PLUGIN(ignition::gui::plugins::Plotting,
+                    ignition::gui::Plugin)
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_PLUGINS_PLOTTING_HH_
+#define IGNITION_GUI_PLUGINS_PLOTTING_HH_
+
+#include <memory>
+#include <vector>
+
+#include <ignition/msgs.hh>
+#include <ignition/transport.hh>
+
+#include "ignition/gui/Export.hh"
+#include "ignition/gui/Plugin.hh"
+
+#ifndef _WIN32
+#  define Plotting_EXPORTS_API
+#else
+#  if (defined(Plotting_EXPORTS))
+#    define Plotting_EXPORTS_API __declspec(dllexport)
+#  else
+#    define Plotting_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class Plotting;
+  class PlottingPrivate;
+  class PlotViewPrivate;
+
+  /// \brief Scene graph item which renders the series of a Plotting
+  /// plugin as one GPU line strip per series. Series are decimated to
+  /// roughly one min/max pair per pixel column before upload, so the
+  /// vertex count stays in the hundreds regardless of the sample rate.
+  class Plotting_EXPORTS_API PlotView : public QQuickItem
+  {
+    Q_OBJECT
+
+    /// \brief Seconds of history shown
+    Q_PROPERTY(
+      double windowSeconds
+      READ WindowSeconds
+      WRITE SetWindowSeconds
+      NOTIFY WindowSecondsChanged
+    )
+
+    /// \brief Constructor
+    public: PlotView();
+
+    /// \brief Destructor
+    public: ~PlotView() override;
+
+    /// \brief Point the view at the plugin holding the series data.
+    /// \param[in] _plugin Source plugin. Not owned; the plugin outlives
+    /// its QML items.
+    public: void SetSource(Plotting *_plugin);
+
+    /// \brief Get the seconds of history shown.
+    /// \return Window length in seconds.
+    public: Q_INVOKABLE double WindowSeconds() const;
+
+    /// \brief Set the seconds of history shown.
+    /// \param[in] _seconds Window length in seconds.
+    public: Q_INVOKABLE void SetWindowSeconds(const double _seconds);
+
+    /// \brief Notify that the window length has changed
+    signals: void WindowSecondsChanged();
+
+    // Documentation inherited
+    protected: QSGNode *updatePaintNode(QSGNode *_node,
+        UpdatePaintNodeData *_data) override;
+
+    /// \internal
+    /// \brief Private data pointer
+    private: std::unique_ptr<PlotViewPrivate> dataPtr;
+  };
+
+  /// \brief Plot numeric values live, without a serialization round
+  /// trip through an external tool. Each series is held in a
+  /// fixed-size ring buffer, so memory doesn't grow over long
+  /// sessions, and rendering decimates to min/max pairs per pixel
+  /// column so high-rate signals stay a few hundred vertices.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<stats_topic\> : WorldStatistics topic; adds series for the
+  ///                     real time factor and the iteration rate.
+  /// * \<series\> : Any number of these, each with a `topic` attribute
+  ///                and a `field` attribute holding a dot path to a
+  ///                numeric field, such as "linear_velocity.x".
+  /// * \<window\> : Seconds of history shown, 60 by default.
+  class Plotting_EXPORTS_API Plotting : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Constructor
+    public: Plotting();
+
+    /// \brief Destructor
+    public: virtual ~Plotting();
+
+    // Documentation inherited
+    public: void LoadConfig(const tinyxml2::XMLElement *_pluginElem);
+
+    /// \brief Get the names of the plotted series, for the legend.
+    /// \return One name per series.
+    public: Q_INVOKABLE QStringList SeriesNames() const;
+
+    /// \brief Get the legend color of each series.
+    /// \return One #rrggbb string per series.
+    public: Q_INVOKABLE QStringList SeriesColors() const;
+
+    /// \brief Copy every series out, decimated to at most two vertices
+    /// (bucket min and max) per x bucket so spikes survive. Called by
+    /// PlotView from the render thread during the sync phase.
+    /// \param[in] _buckets Number of x buckets, usually the view width.
+    /// \param[in] _windowSeconds Seconds of history to include.
+    /// \param[out] _series One vertex run per series, in data space.
+    /// \param[out] _bounds Data-space bounds of the output.
+    public: void DecimatedCopy(int _buckets, double _windowSeconds,
+        std::vector<std::vector<QPointF>> &_series, QRectF &_bounds) const;
+
+    /// \brief Notify that series have been added
+    signals: void SeriesChanged();
+
+    /// \brief Subscriber callback when new world statistics are received
+    private: void OnWorldStatsMsg(const ignition::msgs::WorldStatistics &_msg);
+
+    /// \internal
+    /// \brief Private data pointer
+    private: std::unique_ptr<PlottingPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
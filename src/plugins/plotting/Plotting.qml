@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+import QtQuick.Layouts 1.3
+import PlotView 1.0
+
+Rectangle {
+  id: plotting
+  color: "transparent"
+  Layout.minimumWidth: 290
+  Layout.minimumHeight: 200
+
+  ColumnLayout {
+    anchors.fill: parent
+    anchors.margins: 5
+    spacing: 5
+
+    /**
+     * Legend
+     */
+    Flow {
+      Layout.fillWidth: true
+      spacing: 10
+
+      Repeater {
+        id: legend
+        model: Plotting.SeriesNames()
+
+        Row {
+          spacing: 4
+
+          Rectangle {
+            width: 10
+            height: 10
+            radius: 2
+            anchors.verticalCenter: parent.verticalCenter
+            color: Plotting.SeriesColors()[index]
+          }
+
+          Label {
+            text: modelData
+            font.pixelSize: 11
+          }
+        }
+      }
+    }
+
+    PlotView {
+      objectName: "plotView"
+      Layout.fillWidth: true
+      Layout.fillHeight: true
+    }
+  }
+
+  Connections {
+    target: Plotting
+    onSeriesChanged: {
+      legend.model = Plotting.SeriesNames()
+    }
+  }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <ignition/common/Console.hh>
+#include <ignition/transport/Node.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/Plugin.hh"
+#include "ignition/gui/MainWindow.hh"
+#include "Plotting.hh"
+
+int g_argc = 1;
+char **g_argv = new char *[g_argc];
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(PlottingTest, Load)
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  EXPECT_TRUE(app.LoadPlugin("Plotting"));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Get plugin
+  auto plugins = win->findChildren<Plugin *>();
+  EXPECT_EQ(plugins.size(), 1);
+
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->Title(), "Plotting");
+
+  // Cleanup
+  plugins.clear();
+}
+
+/////////////////////////////////////////////////
+TEST(PlottingTest, WorldStatsSeries)
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Load plugin
+  const char *pluginStr =
+    "<plugin filename=\"Plotting\">"
+      "<stats_topic>/plotting_test_stats</stats_topic>"
+      "<window>30</window>"
+    "</plugin>";
+
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr);
+  EXPECT_TRUE(app.LoadPlugin("Plotting",
+      pluginDoc.FirstChildElement("plugin")));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Show, but don't exec, so we don't block
+  win->QuickWindow()->show();
+
+  // Get plugin
+  auto plugin = win->findChild<plugins::Plotting *>();
+  ASSERT_NE(nullptr, plugin);
+
+  // The stats topic adds an RTF series and an iteration rate series
+  auto names = plugin->SeriesNames();
+  ASSERT_EQ(names.size(), 2);
+  EXPECT_EQ(names[0].toStdString(), "Real time factor");
+  EXPECT_EQ(names[1].toStdString(), "Iterations / s");
+  EXPECT_EQ(plugin->SeriesColors().size(), 2);
+
+  // Publish stats
+  transport::Node node;
+  auto pub = node.Advertise<msgs::WorldStatistics>("/plotting_test_stats");
+
+  {
+    msgs::WorldStatistics msg;
+    msg.set_real_time_factor(0.5);
+    msg.set_iterations(100);
+    pub.Publish(msg);
+  }
+
+  // Give it time to be processed, then check the decimated copy has a
+  // sample in the RTF series
+  std::vector<std::vector<QPointF>> series;
+  QRectF bounds;
+  int sleep = 0;
+  int maxSleep = 10;
+  while (sleep < maxSleep)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    QCoreApplication::processEvents();
+
+    plugin->DecimatedCopy(100, 30.0, series, bounds);
+    if (!series[0].empty())
+      break;
+    sleep++;
+  }
+
+  ASSERT_EQ(series.size(), 2u);
+  ASSERT_FALSE(series[0].empty());
+  EXPECT_DOUBLE_EQ(series[0].back().y(), 0.5);
+
+  // Decimation caps the vertex count at two per bucket
+  EXPECT_LE(series[0].size(), 200u);
+}
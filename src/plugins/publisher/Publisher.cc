@@ -15,7 +15,13 @@
  *
 */
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <ignition/common/Console.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/msgs.hh>
@@ -29,6 +35,24 @@ namespace gui
 {
 namespace plugins
 {
+  /// \brief Rates above this are driven by a dedicated thread; QTimer
+  /// resolution and GUI-thread contention make it jitter well before
+  /// this point.
+  static const double kHighRateThreshold = 100.0;
+
+  /// \brief One step of a publishing sequence, as configured
+  struct SequenceEntry
+  {
+    /// \brief Message contents in protobuf text format
+    public: std::string msgData;
+
+    /// \brief How many times to publish this message
+    public: int count{1};
+
+    /// \brief Seconds between publications, 0 for back-to-back
+    public: double interval{0.0};
+  };
+
   class PublisherPrivate
   {
     /// \brief Message type
@@ -43,9 +67,34 @@ namespace plugins
     /// \brief Frequency
     public: double frequency = 1.0;
 
-    /// \brief Timer to keep publishing
+    /// \brief Timer to keep publishing, for rates up to
+    /// kHighRateThreshold
     public: QTimer *timer;
 
+    /// \brief Drives publishing above kHighRateThreshold, where QTimer
+    /// can't keep up
+    public: std::thread publishThread;
+
+    /// \brief True while the publish thread should keep running
+    public: std::atomic<bool> publishing{false};
+
+    /// \brief Configured burst sequence, run by OnSequence
+    public: std::vector<SequenceEntry> sequence;
+
+    /// \brief Throughput of the last finished sequence run, in msgs/s
+    public: double throughput{0.0};
+
+    /// \brief Stop whichever publish driver is active and wait for the
+    /// thread to finish
+    public: void StopPublishing()
+    {
+      if (this->timer != nullptr)
+        this->timer->stop();
+      this->publishing = false;
+      if (this->publishThread.joinable())
+        this->publishThread.join();
+    }
+
     /// \brief Node for communication
     public: ignition::transport::Node node;
 
@@ -69,6 +118,7 @@ Publisher::Publisher()
 /////////////////////////////////////////////////
 Publisher::~Publisher()
 {
+  this->dataPtr->StopPublishing();
 }
 
 /////////////////////////////////////////////////
@@ -94,6 +144,28 @@ void Publisher::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 
     if (auto frequencyElem = _pluginElem->FirstChildElement("frequency"))
       frequencyElem->QueryDoubleText(&this->dataPtr->frequency);
+
+    if (auto sequenceElem = _pluginElem->FirstChildElement("sequence"))
+    {
+      for (auto entryElem = sequenceElem->FirstChildElement("entry");
+          entryElem != nullptr;
+          entryElem = entryElem->NextSiblingElement("entry"))
+      {
+        SequenceEntry entry;
+        auto entryMsgElem = entryElem->FirstChildElement("message");
+        if (nullptr != entryMsgElem && nullptr != entryMsgElem->GetText())
+          entry.msgData = entryMsgElem->GetText();
+
+        if (auto countElem = entryElem->FirstChildElement("count"))
+          countElem->QueryIntText(&entry.count);
+
+        if (auto intervalElem = entryElem->FirstChildElement("interval"))
+          intervalElem->QueryDoubleText(&entry.interval);
+
+        if (entry.count > 0)
+          this->dataPtr->sequence.push_back(entry);
+      }
+    }
   }
 
   this->dataPtr->timer = new QTimer(this);
@@ -104,11 +176,9 @@ void Publisher::OnPublish(const bool _checked)
 {
   if (!_checked)
   {
+    this->dataPtr->StopPublishing();
     if (this->dataPtr->timer != nullptr)
-    {
-      this->dataPtr->timer->stop();
       this->disconnect(this->dataPtr->timer, 0, 0, 0);
-    }
     this->dataPtr->pub = ignition::transport::Node::Publisher();
     return;
   }
@@ -146,15 +216,188 @@ void Publisher::OnPublish(const bool _checked)
     return;
   }
 
+  // The payload is fixed for the whole run, so parse and serialize it
+  // once here; every tick below just hands the cached bytes to the
+  // publisher. Text parsing dominates the publish cost otherwise.
+  std::string payload;
+  if (!msg->SerializeToString(&payload))
+  {
+    ignerr << "Failed to serialize message of type[" << msgType << "].\n";
+    return;
+  }
+
+  // High rates get a dedicated thread with absolute monotonic deadlines;
+  // QTimer tops out around 100 Hz and jitters whenever the UI is busy
+  if (this->dataPtr->frequency > kHighRateThreshold)
+  {
+    // make sure a finished sequence thread is joined before reusing it
+    this->dataPtr->StopPublishing();
+
+    const double frequency = this->dataPtr->frequency;
+    this->dataPtr->publishing = true;
+    this->dataPtr->publishThread = std::thread([this, msgType, payload,
+        frequency]()
+    {
+      const auto period = std::chrono::duration_cast<
+          std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / frequency));
+
+      // absolute deadlines keep the long-run rate exact: oversleeping one
+      // period shortens the next wait instead of accumulating drift
+      auto deadline = std::chrono::steady_clock::now() + period;
+      while (this->dataPtr->publishing)
+      {
+        this->dataPtr->pub.PublishRaw(payload, msgType);
+
+        // coarse sleep to just short of the deadline, then yield-spin
+        // the last stretch for microsecond-level accuracy
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining > std::chrono::milliseconds(1))
+        {
+          std::this_thread::sleep_for(
+              remaining - std::chrono::milliseconds(1));
+        }
+        while (std::chrono::steady_clock::now() < deadline &&
+            this->dataPtr->publishing)
+        {
+          std::this_thread::yield();
+        }
+
+        deadline += period;
+        // if publishing itself overran, skip the missed slots
+        const auto now = std::chrono::steady_clock::now();
+        if (deadline < now)
+          deadline = now + period;
+      }
+    });
+    return;
+  }
+
   this->dataPtr->timer->setInterval(1000/this->dataPtr->frequency);
-  this->connect(this->dataPtr->timer, &QTimer::timeout, [=]()
+  this->connect(this->dataPtr->timer, &QTimer::timeout, [this, msgType,
+      payload]()
   {
-    auto newMsg = ignition::msgs::Factory::New(msgType, msgData);
-    this->dataPtr->pub.Publish(*newMsg);
+    this->dataPtr->pub.PublishRaw(payload, msgType);
   });
   this->dataPtr->timer->start();
 }
 
+/////////////////////////////////////////////////
+void Publisher::OnSequence()
+{
+  if (this->dataPtr->sequence.empty())
+  {
+    ignwarn << "No <sequence> configured for the Publisher plugin.\n";
+    return;
+  }
+
+  if (this->dataPtr->publishing)
+  {
+    ignwarn << "Already publishing, not starting sequence.\n";
+    return;
+  }
+
+  // make sure a finished sequence thread is joined before reusing it
+  this->dataPtr->StopPublishing();
+
+  auto topic = this->dataPtr->topic.toStdString();
+  auto msgType = this->dataPtr->msgType.toStdString();
+
+  // pre-serialize every entry so the burst loop only moves bytes
+  struct CompiledEntry
+  {
+    std::string payload;
+    int count;
+    std::chrono::steady_clock::duration interval;
+  };
+  std::vector<CompiledEntry> entries;
+  for (const auto &entry : this->dataPtr->sequence)
+  {
+    auto msg = ignition::msgs::Factory::New(msgType, entry.msgData);
+    if (!msg || (msg->DebugString() == "" && entry.msgData != ""))
+    {
+      ignerr << "Unable to create message of type[" << msgType << "] "
+        << "with data[" << entry.msgData << "].\n";
+      return;
+    }
+
+    CompiledEntry compiled;
+    if (!msg->SerializeToString(&compiled.payload))
+    {
+      ignerr << "Failed to serialize message of type[" << msgType << "].\n";
+      return;
+    }
+    compiled.count = entry.count;
+    compiled.interval = std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(entry.interval));
+    entries.push_back(compiled);
+  }
+
+  this->dataPtr->pub = this->dataPtr->node.Advertise(topic, msgType);
+  if (!this->dataPtr->pub)
+  {
+    ignerr << "Unable to publish on topic[" << topic << "] "
+      << "with message type[" << msgType << "].\n";
+    return;
+  }
+
+  this->dataPtr->publishing = true;
+  this->dataPtr->publishThread = std::thread([this, msgType, entries]()
+  {
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t total = 0;
+
+    auto deadline = start;
+    for (const auto &entry : entries)
+    {
+      for (int i = 0; i < entry.count && this->dataPtr->publishing; ++i)
+      {
+        this->dataPtr->pub.PublishRaw(entry.payload, msgType);
+        ++total;
+
+        if (entry.interval.count() == 0)
+          continue;
+
+        deadline += entry.interval;
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining > std::chrono::milliseconds(1))
+        {
+          std::this_thread::sleep_for(
+              remaining - std::chrono::milliseconds(1));
+        }
+        while (std::chrono::steady_clock::now() < deadline &&
+            this->dataPtr->publishing)
+        {
+          std::this_thread::yield();
+        }
+      }
+      // intervals are per entry; restart spacing from now
+      deadline = std::chrono::steady_clock::now();
+    }
+
+    const double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    QMetaObject::invokeMethod(this, "SetThroughput", Qt::QueuedConnection,
+        Q_ARG(double, elapsed > 0.0 ? total / elapsed : 0.0));
+
+    this->dataPtr->publishing = false;
+  });
+}
+
+/////////////////////////////////////////////////
+double Publisher::Throughput() const
+{
+  return this->dataPtr->throughput;
+}
+
+/////////////////////////////////////////////////
+void Publisher::SetThroughput(const double _throughput)
+{
+  this->dataPtr->throughput = _throughput;
+  this->ThroughputChanged();
+}
+
 /////////////////////////////////////////////////
 QString Publisher::MsgType() const
 {
@@ -43,7 +43,16 @@ namespace plugins
   /// \brief Widget which publishes a custom Ignition transport message.
   ///
   /// ## Configuration
-  /// This plugin doesn't accept any custom configuration.
+  ///
+  /// \<message_type\> : Message type, e.g. 'ignition.msgs.StringMsg'.
+  /// \<message\> : Message contents in protobuf text format.
+  /// \<topic\> : Topic to publish on.
+  /// \<frequency\> : Publish frequency in Hz, 0 to publish once.
+  /// \<sequence\> : Optional burst sequence run by the Burst button. Holds
+  ///                \<entry\> elements, each with a \<message\>, a
+  ///                \<count\> (number of publications, 1 by default) and
+  ///                an \<interval\> (seconds between publications, 0 for
+  ///                back-to-back by default).
   class Publisher_EXPORTS_API Publisher : public Plugin
   {
     Q_OBJECT
@@ -89,10 +98,34 @@ namespace plugins
     // Documentation inherited
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem);
 
+    /// \brief Throughput of the last finished sequence run, in msgs/s
+    Q_PROPERTY(
+      double throughput
+      READ Throughput
+      NOTIFY ThroughputChanged
+    )
+
     /// \brief Callback when publish button is checked or unchecked.
     /// \param[in] _checked True if button is checked.
     public slots: void OnPublish(const bool _checked);
 
+    /// \brief Callback when the burst button is pressed. Runs the
+    /// configured sequence from the publish thread with pre-serialized
+    /// payloads.
+    public slots: void OnSequence();
+
+    /// \brief Get the throughput of the last finished sequence run
+    /// \return Throughput in msgs/s
+    public: Q_INVOKABLE double Throughput() const;
+
+    /// \brief Notify that the throughput has been updated
+    signals: void ThroughputChanged();
+
+    /// \brief Record the throughput of a finished sequence run. Queued
+    /// from the publish thread.
+    /// \param[in] _throughput Throughput in msgs/s
+    private slots: void SetThroughput(const double _throughput);
+
     /// \brief Get the message type as a string, for example
     /// 'ignition.msgs.StringMsg'
     /// \return Message type
@@ -101,5 +101,25 @@ Rectangle {
       ToolTip.timeout: tooltipTimeout
       ToolTip.text: checked ? qsTr("Stop publising") : qsTr("Start publishing")
     }
+
+    Button {
+      text: qsTr("Burst")
+      onClicked: {
+        Publisher.msgType = msgTypeField.text
+        Publisher.topic = topicField.text
+
+        Publisher.OnSequence();
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text: qsTr("Run the configured burst sequence")
+    }
+
+    Label {
+      id: throughputLabel
+      visible: Publisher.throughput > 0
+      text: Publisher.throughput.toFixed(0) + " msgs/s"
+    }
   }
 }
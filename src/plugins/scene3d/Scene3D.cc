@@ -15,17 +15,46 @@
  *
 */
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <limits>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <google/protobuf/arena.h>
+
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Image.hh>
+#include <ignition/common/ImageHeightmap.hh>
+#include <ignition/common/Mesh.hh>
 #include <ignition/common/MouseEvent.hh>
+#include <ignition/common/SubMesh.hh>
+#include <ignition/common/Profiler.hh>
+#include <ignition/common/Util.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/common/MeshManager.hh>
 
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Vector2.hh>
 #include <ignition/math/Vector3.hh>
 
@@ -48,12 +77,284 @@ namespace gui
 {
 namespace plugins
 {
+  /// \brief Visibility layer bits assigned to visuals when they are
+  /// loaded. Toggling a whole category of visuals is then a single mask
+  /// write on the camera instead of a node visibility update per visual.
+  static const uint32_t kDefaultLayer{0x00000001u};
+  static const uint32_t kCollisionLayer{0x00000002u};
+  static const uint32_t kDebugLayer{0x00000004u};
+
+  /// \brief Vertices per side of a terrain's internal elevation grid.
+  /// Must be a power of two plus one.
+  static const unsigned int kTerrainGridSize{1025u};
+
+  /// \brief Tiles per side a heightmap terrain is split into
+  static const unsigned int kTerrainTilesPerSide{4u};
+
+  /// \brief Grid cells skipped per vertex in a coarse tile mesh
+  static const unsigned int kTerrainCoarseStep{32u};
+
+  /// \brief Tiles closer than this many tile spans to the camera are
+  /// refined to full resolution
+  static const double kTerrainRefineFactor{1.5};
+
+  /// \brief Budget for refined tile meshes, in approximate bytes across
+  /// CPU and GPU copies. The farthest refined tiles are demoted back to
+  /// their coarse meshes when the budget is exceeded.
+  static const std::size_t kTerrainMemoryBudget{64u * 1024u * 1024u};
+
+  /// \brief Record for a single entity in the scene manager's dense entity
+  /// table. Pose, local pose and object pointers live side by side so that
+  /// per-frame pose application is a linear scan over contiguous memory.
+  struct EntityRecord
+  {
+    /// \brief Entity id
+    unsigned int id = 0u;
+
+    /// \brief Latest pose received for this entity
+    math::Pose3d pose;
+
+    /// \brief Previous pose received for this entity, used as the
+    /// interpolation start point when sampling at render time
+    math::Pose3d prevPose;
+
+    /// \brief Time the latest pose was received
+    std::chrono::steady_clock::time_point poseTime;
+
+    /// \brief Time the previous pose was received
+    std::chrono::steady_clock::time_point prevPoseTime;
+
+    /// \brief Initial local pose. This is currently used to handle the
+    /// normal vector in plane visuals. In general, this can be used to store
+    /// any local transforms between the parent Visual and geometry.
+    math::Pose3d localPose;
+
+    /// \brief True if pose holds an update that still needs to be applied
+    bool poseDirty = false;
+
+    /// \brief True once at least one pose has been received
+    bool hasPose = false;
+
+    /// \brief True if this is a top-level model visual, which makes it a
+    /// candidate for view culling
+    bool topLevel = false;
+
+    /// \brief True if the entity is currently hidden by view culling
+    bool culled = false;
+
+    /// \brief Visual associated with this entity, if any
+    rendering::VisualPtr::weak_type visual;
+
+    /// \brief Light associated with this entity, if any
+    rendering::LightPtr::weak_type light;
+  };
+
+  /// \brief A mesh that is being loaded in the background. While the load is
+  /// in flight the entity's visual shows a placeholder box; once the future
+  /// is ready the real geometry is swapped in by SceneManager::Update.
+  struct PendingMesh
+  {
+    /// \brief Id of the entity waiting for this mesh
+    unsigned int entityId = 0u;
+
+    /// \brief Mesh name (file path) being loaded
+    std::string meshName;
+
+    /// \brief Scale to apply to the mesh once it is attached
+    math::Vector3d scale = math::Vector3d::One;
+
+    /// \brief True if the visual msg carried its own material, which then
+    /// also overrides the mesh's material
+    bool overrideMaterial = false;
+
+    /// \brief Future holding the result of the background load. Shared so
+    /// that any number of entities using the same mesh wait on one load.
+    std::shared_future<const common::Mesh *> future;
+  };
+
+  /// \brief One tile of a streamed heightmap terrain. Every tile always
+  /// has a coarse mesh; tiles near the camera are refined to full
+  /// resolution in the background and demoted again when the refined
+  /// memory budget runs out.
+  struct TerrainTile
+  {
+    /// \brief Tile row in the terrain's tile grid
+    unsigned int row = 0u;
+
+    /// \brief Tile column in the terrain's tile grid
+    unsigned int col = 0u;
+
+    /// \brief Visual holding the tile's current mesh
+    rendering::VisualPtr visual;
+
+    /// \brief World-space center of the tile, for LOD distance tests
+    math::Vector3d center;
+
+    /// \brief Name of the coarse tile mesh, kept registered for the
+    /// tile's whole lifetime so demotion is a cheap geometry swap
+    std::string coarseMeshName;
+
+    /// \brief Name of the refined tile mesh, empty until first refined
+    std::string fineMeshName;
+
+    /// \brief True while the refined mesh is attached
+    bool fine = false;
+
+    /// \brief In-flight background build of the refined mesh
+    std::shared_future<const common::Mesh *> pendingFine;
+  };
+
+  /// \brief Shared elevation grid and tile state for one heightmap
+  /// terrain
+  struct Terrain
+  {
+    /// \brief Terrain counter value, used to make mesh names unique
+    unsigned int id = 0u;
+
+    /// \brief Elevation grid, grid x grid values in row-major order.
+    /// Shared with the background tile builders, so it stays valid even
+    /// if the terrain list reallocates.
+    std::shared_ptr<std::vector<float>> heights;
+
+    /// \brief Vertices per side of the elevation grid
+    unsigned int grid = 0u;
+
+    /// \brief Terrain size in meters (x, y) and elevation range (z)
+    math::Vector3d size;
+
+    /// \brief Terrain origin offset
+    math::Vector3d origin;
+
+    /// \brief Visual of the heightmap's entity; the tiles are its
+    /// children
+    rendering::VisualPtr root;
+
+    /// \brief All tiles of this terrain
+    std::vector<TerrainTile> tiles;
+  };
+
+  /// \brief One queued scene mutation. Model loads and deletions go
+  /// through this buffer and execute in arrival order, so a deletion
+  /// received after a model's load command can never run before it.
+  struct SceneCommand
+  {
+    /// \brief Mutation kind
+    enum CommandType
+    {
+      /// \brief Load the model in `model` under the root visual
+      LOAD_MODEL = 0,
+
+      /// \brief Delete the entities in `entities`
+      DELETE_ENTITIES = 1
+    };
+
+    /// \brief Kind of this command
+    CommandType type = LOAD_MODEL;
+
+    /// \brief Model to load, for LOAD_MODEL
+    msgs::Model model;
+
+    /// \brief Entities to delete, for DELETE_ENTITIES
+    std::vector<unsigned int> entities;
+  };
+
+  /// \brief Result of probing a texture image in the background: its
+  /// dimensions, to price the texture against the residency budget, and
+  /// its average color, which stands in for the texture (a 1x1 mip)
+  /// until the real thing is streamed in.
+  struct TextureProbe
+  {
+    /// \brief True if the image could be loaded
+    bool valid = false;
+
+    /// \brief Image width in pixels
+    unsigned int width = 0u;
+
+    /// \brief Image height in pixels
+    unsigned int height = 0u;
+
+    /// \brief Average color of the image
+    math::Color average;
+  };
+
+  /// \brief One geometry rendering a managed texture: the visual for
+  /// proximity tests and lifetime, the material the geometry actually
+  /// renders, and the diffuse color restored when the texture is
+  /// applied.
+  struct TextureUser
+  {
+    /// \brief Visual the geometry belongs to
+    rendering::VisualPtr::weak_type visual;
+
+    /// \brief The material the geometry renders. Geometry::SetMaterial
+    /// assigns a per-geometry clone of the material it's given, so this
+    /// is that clone, not the shared original: mutations only reach the
+    /// screen through this object.
+    rendering::MaterialPtr material;
+
+    /// \brief Diffuse color the material's msg specified
+    math::Color diffuse;
+  };
+
+  /// \brief One texture referenced by scene materials. Textures are not
+  /// uploaded when their material loads; UpdateTextures streams them in
+  /// by camera proximity under the residency budget and evicts the
+  /// farthest ones when over it. While a texture is not resident its
+  /// materials show the image's average color instead.
+  struct TextureRecord
+  {
+    /// \brief Texture image URI
+    std::string uri;
+
+    /// \brief Shared original materials registered for this texture,
+    /// kept for material-to-record lookups. These are never rendered
+    /// directly, see TextureUser::material.
+    std::vector<rendering::MaterialPtr> sources;
+
+    /// \brief Geometries the texture appears on, for proximity tests
+    /// and for reaching the materials they render
+    std::vector<TextureUser> users;
+
+    /// \brief True while the full texture is applied to the materials
+    bool resident = false;
+
+    /// \brief True if the image failed to load or can never fit the
+    /// budget; only the average color is shown then
+    bool failed = false;
+
+    /// \brief Estimated GPU cost of the texture with its mip chain, in
+    /// bytes. Zero until the background probe finishes.
+    std::size_t bytes = 0u;
+
+    /// \brief Average color of the image, valid once the probe finished
+    math::Color average;
+
+    /// \brief True once the probe delivered an average color
+    bool hasAverage = false;
+
+    /// \brief In-flight background probe of the image
+    std::shared_future<TextureProbe> probe;
+
+    /// \brief Distance from the camera to the nearest user visual,
+    /// recomputed each UpdateTextures pass
+    double distance = 0.0;
+  };
+
   /// \brief Scene manager class for loading and managing objects in the scene
   class SceneManager
   {
     /// \brief Constructor
     public: SceneManager();
 
+    /// \brief Get the scene manager shared by every viewport attached
+    /// to a scene, so entity state is ingested and stored once no
+    /// matter how many views are open. Created on first use and
+    /// destroyed when the last viewport lets go.
+    /// \param[in] _sceneName Rendering scene name.
+    /// \return The shared manager.
+    public: static std::shared_ptr<SceneManager> Shared(
+        const std::string &_sceneName);
+
     /// \brief Constructor
     /// \param[in] _service Ign transport scene service name
     /// \param[in] _poseTopic Ign transport pose topic name
@@ -81,16 +382,69 @@ namespace plugins
     /// \brief Make the scene service request and populate the scene
     public: void Request();
 
+    /// \brief Check whether Load has already been called with a scene,
+    /// so viewports joining a shared manager don't load it twice.
+    /// \return True once loaded.
+    public: bool Loaded() const;
+
+    /// \brief Path of the binary snapshot cache file for this scene
+    /// service
+    /// \return Cache file path
+    private: std::string SnapshotPath() const;
+
     /// \brief Update the scene based on pose msgs received
     public: void Update();
 
+    /// \brief Check whether there are buffered msgs or pending mesh loads
+    /// that the next Update() would process
+    /// \return True if there is work pending
+    public: bool HasUpdates();
+
+    /// \brief Set the camera used for view culling
+    /// \param[in] _camera User camera
+    public: void SetCamera(const rendering::CameraPtr &_camera);
+
+    /// \brief Enable or disable view culling of off-screen models
+    /// \param[in] _enabled True to enable culling
+    public: void SetViewCulling(const bool _enabled);
+
+    /// \brief Set the distance beyond which models are culled
+    /// \param[in] _distance Max draw distance in meters
+    public: void SetMaxDrawDistance(const double _distance);
+
+    /// \brief Hide top-level models that are behind the camera or beyond
+    /// the max draw distance, and restore them (with their latest pose)
+    /// when they come back into view. Called from Update().
+    private: void CullEntities();
+
+    /// \brief Broad-phase test of a ray against bounding spheres of all
+    /// visuals in the dense entity table. Used to skip the engine's exact
+    /// (and much more expensive) scene query when a ray cannot hit
+    /// anything.
+    /// \param[in] _origin Ray origin in world coordinates
+    /// \param[in] _dir Normalized ray direction
+    /// \return True if the ray hits at least one bounding sphere
+    public: bool RayHitsAnyBound(const math::Vector3d &_origin,
+        const math::Vector3d &_dir) const;
+
     /// \brief Callback function for the pose topic
     /// \param[in] _msg Pose vector msg
     private: void OnPoseVMsg(const msgs::Pose_V &_msg);
 
-    /// \brief Load the scene from a scene msg
+    /// \brief Load the scene from a scene msg. Only entities not already in
+    /// the scene are created, and if the msg is a full snapshot, entities
+    /// that are no longer in the msg are destroyed, so repeated snapshots of
+    /// a mostly-unchanged world only touch the delta.
     /// \param[in] _msg Scene msg
-    private: void LoadScene(const msgs::Scene &_msg);
+    /// \param[in] _fullScene True if the msg describes the complete scene,
+    /// false if it only contains newly added entities
+    private: void LoadScene(const msgs::Scene &_msg, const bool _fullScene);
+
+    /// \brief Recursively collect the ids of all entities in a model msg
+    /// \param[in] _msg Model msg
+    /// \param[out] _ids Set to collect the ids into
+    private: void CollectEntityIds(const msgs::Model &_msg,
+        std::unordered_set<unsigned int> &_ids) const;
 
     /// \brief Callback function for the request topic
     /// \param[in] _msg Deletion message
@@ -128,7 +482,54 @@ namespace plugins
     private: rendering::GeometryPtr LoadGeometry(const msgs::Geometry &_msg,
         math::Vector3d &_scale, math::Pose3d &_localPose);
 
-    /// \brief Load a material from a material msg
+    /// \brief Load a heightmap as a grid of streamed terrain tiles under
+    /// the visual. Coarse tiles are built immediately; refinement near
+    /// the camera happens asynchronously from UpdateTerrains.
+    /// \param[in] _msg Visual msg whose geometry holds the heightmap
+    /// \param[in] _parent Visual of the heightmap's entity
+    private: void LoadTerrain(const msgs::Visual &_msg,
+        const rendering::VisualPtr &_parent);
+
+    /// \brief Drive terrain LOD: swap in finished refined tiles, kick
+    /// off refinement of coarse tiles near the camera, and demote the
+    /// farthest refined tiles when over the memory budget. Called from
+    /// Update().
+    private: void UpdateTerrains();
+
+    /// \brief Set the texture residency budget
+    /// \param[in] _mb Budget in megabytes of estimated texture memory
+    public: void SetTextureBudget(const double _mb);
+
+    /// \brief Put a texture under residency management and start the
+    /// background probe of its image. The texture is not applied here;
+    /// UpdateTextures streams it in by camera proximity.
+    /// \param[in] _uri Texture image URI
+    /// \param[in] _material Material the texture belongs to
+    private: void RegisterTexture(const std::string &_uri,
+        const rendering::MaterialPtr &_material);
+
+    /// \brief Record that a geometry renders with a texture-managed
+    /// material. Tracks the per-geometry material clone SetMaterial
+    /// installed, since that clone is what streaming must mutate for
+    /// changes to appear on screen. Call after SetMaterial. No-op for
+    /// materials without a managed texture.
+    /// \param[in] _material Material handed to SetMaterial
+    /// \param[in] _geometry Geometry the material was applied to
+    /// \param[in] _visual Visual the geometry belongs to
+    private: void AddTextureUser(const rendering::MaterialPtr &_material,
+        const rendering::GeometryPtr &_geometry,
+        const rendering::VisualPtr &_visual);
+
+    /// \brief Drive texture residency: consume finished probes, stream
+    /// in the non-resident texture nearest the camera (at most one per
+    /// call, so a texture-heavy world costs extra frames instead of one
+    /// long one) and evict the farthest resident textures when over the
+    /// budget. Called from Update().
+    private: void UpdateTextures();
+
+    /// \brief Load a material from a material msg. Identical msgs resolve
+    /// to one shared material object instead of creating a new one per
+    /// visual.
     /// \param[in] _msg Material msg
     /// \return Material object created from the msg
     private: rendering::MaterialPtr LoadMaterial(const msgs::Material &_msg);
@@ -142,6 +543,31 @@ namespace plugins
     /// \param[in] _entity Entity to delete
     private: void DeleteEntity(const unsigned int _entity);
 
+    /// \brief Delete a batch of entities in one scene-graph pass, erasing
+    /// their records from the dense table in bulk
+    /// \param[in] _entities Entities to delete
+    private: void DeleteEntities(const std::vector<unsigned int> &_entities);
+
+    /// \brief Get the record for an entity, creating it if needed
+    /// \param[in] _id Entity id
+    /// \return Reference to the entity's record in the dense table. The
+    /// reference is invalidated by the next call to Entity or RemoveEntity.
+    private: EntityRecord &Entity(const unsigned int _id);
+
+    /// \brief Find the record for an entity
+    /// \param[in] _id Entity id
+    /// \return Pointer to the entity's record, or nullptr if not found. The
+    /// pointer is invalidated by the next call to Entity or RemoveEntity.
+    private: EntityRecord *EntityById(const unsigned int _id);
+
+    /// \brief Remove an entity's record from the dense table
+    /// \param[in] _id Entity id
+    private: void RemoveEntity(const unsigned int _id);
+
+    /// \brief Swap finished background mesh loads into their visuals,
+    /// replacing the placeholder geometry. Called from Update().
+    private: void ProcessPendingMeshes();
+
     //// \brief Ign-transport scene service name
     private: std::string service;
 
@@ -157,33 +583,153 @@ namespace plugins
     //// \brief Pointer to the rendering scene
     private: rendering::ScenePtr scene;
 
-    //// \brief Mutex to protect the pose msgs
+    //// \brief Mutex to protect the scene and deletion msgs
     private: std::mutex mutex;
 
-    /// \brief Map of entity id to pose
-    private: std::map<unsigned int, math::Pose3d> poses;
+    //// \brief Mutex to protect the pose msg buffer. Held only long enough
+    //// to swap buffers so the transport callback never blocks rendering.
+    private: std::mutex poseMutex;
 
-    /// \brief Map of entity id to initial local poses
-    /// This is currently used to handle the normal vector in plane visuals. In
-    /// general, this can be used to store any local transforms between the
-    /// parent Visual and geometry.
-    private: std::map<unsigned int, math::Pose3d> localPoses;
+    /// \brief Ping-pong protobuf arenas backing the staged pose msgs.
+    /// Staging a msg costs an arena bump allocation plus a copy, and a
+    /// consumed batch is dropped with one bulk Reset instead of a free
+    /// per message, keeping the allocator out of the transport threads.
+    private: google::protobuf::Arena poseArenas[2];
 
-    /// \brief Map of visual id to visual pointers.
-    private: std::map<unsigned int, rendering::VisualPtr::weak_type> visuals;
+    /// \brief Index of the arena currently accepting new msgs.
+    private: int activePoseArena{0};
 
-    /// \brief Map of light id to light pointers.
-    private: std::map<unsigned int, rendering::LightPtr::weak_type> lights;
-
-    /// Entities to be deleted
-    private: std::vector<unsigned int> toDeleteEntities;
-
-    /// \brief Keeps the a list of unprocessed scene messages
-    private: std::vector<msgs::Scene> sceneMsgs;
+    /// \brief Unprocessed pose msgs, allocated on the active arena. The
+    /// transport callback appends and Update() swaps the batch out in
+    /// one operation.
+    private: std::vector<msgs::Pose_V *> poseMsgs;
+
+    /// \brief Structure-of-arrays scratch for pose ingestion, reused
+    /// every frame so its buffers are only allocated once
+    private: BatchedPoses poseBatch;
+
+    /// \brief Dense table of all entities in the scene. Per-frame pose
+    /// application iterates this vector linearly instead of chasing map
+    /// nodes.
+    private: std::vector<EntityRecord> entities;
+
+    /// \brief Map of entity id to index into the dense entity table
+    private: std::unordered_map<unsigned int, std::size_t> entityIndices;
+
+    /// \brief Cache of materials keyed by their serialized msg, so visuals
+    /// sharing the same material msg share one material object
+    private: std::unordered_map<std::string, rendering::MaterialPtr>
+        materialCache;
+
+    /// \brief Meshes currently being loaded in the background
+    private: std::vector<PendingMesh> pendingMeshes;
+
+    /// \brief In-flight background mesh loads keyed by mesh name. Worlds
+    /// with many copies of the same mesh trigger a single load that all
+    /// the waiting entities share.
+    private: std::unordered_map<std::string,
+        std::shared_future<const common::Mesh *>> meshLoads;
+
+    /// \brief Name of the mesh deferred by the last LoadGeometry call, so
+    /// LoadVisual can register the pending load with the entity id. Empty
+    /// if the last geometry was loaded synchronously.
+    private: std::string pendingMeshName;
+
+    /// \brief All streamed heightmap terrains in the scene
+    private: std::vector<Terrain> terrains;
+
+    /// \brief Approximate bytes currently spent on refined tile meshes
+    private: std::size_t refinedTerrainBytes = 0u;
+
+    /// \brief All textures under residency management
+    private: std::vector<TextureRecord> textures;
+
+    /// \brief Map of texture URI to index into the texture table
+    private: std::unordered_map<std::string, std::size_t> textureIndices;
+
+    /// \brief Map of raw material pointer to index into the texture
+    /// table, for AddTextureUser lookups
+    private: std::unordered_map<rendering::Material *, std::size_t>
+        materialTextures;
+
+    /// \brief Estimated bytes of currently resident textures
+    private: std::size_t residentTextureBytes = 0u;
+
+    /// \brief Texture residency budget in estimated bytes
+    private: std::size_t textureBudgetBytes = 256u * 1024u * 1024u;
+
+    /// \brief True while texture streaming still has work that doesn't
+    /// need a camera move to make progress, so render-on-demand keeps
+    /// frames coming
+    private: bool texturesStreaming = false;
+
+    /// \brief Number of terrains created so far, for unique mesh names
+    private: unsigned int terrainCounter = 0u;
+
+    /// \brief True while at least one entity is still interpolating
+    /// towards its latest pose, so render-on-demand keeps drawing
+    private: bool interpolating = false;
+
+    /// \brief Scene mutations waiting to be executed. Scene responses
+    /// are split into model-sized commands and deletions queue behind
+    /// them; Update() drains the buffer against a per-frame time budget
+    /// and carries the remainder, so a spawn storm costs extra frames
+    /// instead of one long one.
+    private: std::deque<SceneCommand> commands;
+
+    /// \brief Time budget for draining the command buffer per Update()
+    /// call, in milliseconds. At least one command always executes so
+    /// the buffer can't stall.
+    private: double mutationBudgetMs = 4.0;
+
+    /// \brief Camera used for view culling
+    private: rendering::CameraPtr camera;
+
+    /// \brief True to hide models that are off screen
+    private: bool viewCulling = false;
+
+    /// \brief True once more than one viewport camera is attached.
+    /// Per-camera view culling is disabled in that case, since
+    /// off-screen for one camera isn't off-screen for the others.
+    private: bool multiViewport = false;
+
+    /// \brief Distance beyond which models are culled when view culling
+    /// is enabled
+    private: double maxDrawDistance =
+        std::numeric_limits<double>::infinity();
+
+    /// \brief Keeps the a list of unprocessed scene messages, paired with
+    /// whether each msg is a full scene snapshot or just newly added
+    /// entities. Bounded: a new snapshot drops everything queued before it
+    /// and consecutive deltas are merged, so it holds at most one snapshot
+    /// plus one accumulated delta.
+    private: std::vector<std::pair<msgs::Scene, bool>> sceneMsgs;
 
     /// \brief Transport node for making service request and subscribing to
     /// pose topic
     private: ignition::transport::Node node;
+
+    /// \brief Pending background write of the scene snapshot cache
+    private: std::future<void> snapshotWrite;
+  };
+
+  /// \brief Per-stage durations of a single rendered frame, in milliseconds
+  struct FrameTimings
+  {
+    /// \brief Time spent in SceneManager::Update
+    double sceneUpdateMs = 0.0;
+
+    /// \brief Time spent handling mouse events for view control
+    double mouseMs = 0.0;
+
+    /// \brief Time spent in the camera render
+    double renderMs = 0.0;
+
+    /// \brief Time spent copying the frame into the texture ring
+    double copyMs = 0.0;
+
+    /// \brief Total frame time
+    double totalMs = 0.0;
   };
 
   /// \brief Private data class for IgnRenderer
@@ -198,6 +744,39 @@ namespace plugins
     /// \brief Mouse move distance since last event.
     public: math::Vector2d drag;
 
+    /// \brief True while a drag gesture with cached view math is in
+    /// progress.
+    public: bool gestureActive = false;
+
+    /// \brief Zoom amount per dragged pixel, precomputed from the
+    /// camera frustum when a drag gesture starts.
+    public: double zoomPerPixel = 0.0;
+
+    /// \brief True while the cached scroll target matches
+    /// scrollTargetPos.
+    public: bool scrollTargetValid = false;
+
+    /// \brief Screen position the cached scroll target was resolved
+    /// at.
+    public: math::Vector2i scrollTargetPos;
+
+    /// \brief Visibility mask waiting to be applied to the camera
+    public: uint32_t pendingVisibilityMask = 0xffffffffu;
+
+    /// \brief True while pendingVisibilityMask hasn't been applied yet
+    public: bool visibilityMaskDirty = false;
+
+    /// \brief Current dynamic resolution scale applied to textureSize.
+    /// Only the render thread touches it.
+    public: double renderScale = 1.0;
+
+    /// \brief Exponential moving average of the total frame time, in ms
+    public: double frameTimeAvgMs = 0.0;
+
+    /// \brief Frames remaining before the resolution scale may change
+    /// again, so one adjustment settles before the next is considered
+    public: int scaleCooldown = 0;
+
     /// \brief Mutex to protect mouse events
     public: std::mutex mutex;
 
@@ -210,11 +789,88 @@ namespace plugins
     /// \brief Ray query for mouse clicks
     public: rendering::RayQueryPtr rayQuery;
 
-    /// \brief Scene requester to get scene info
-    public: SceneManager sceneManager;
+    /// \brief Scene requester to get scene info. Shared by every
+    /// viewport attached to the same scene.
+    public: std::shared_ptr<SceneManager> sceneManager;
 
     /// \brief View control focus target
     public: math::Vector3d target;
+
+    /// \brief Time of the last rendered frame, used to enforce the idle
+    /// FPS floor in render-on-demand mode
+    public: std::chrono::steady_clock::time_point lastRenderTime;
+
+    /// \brief Ring of textures that rendered frames are copied into, so
+    /// the render thread never writes to a texture the scene graph may
+    /// still be sampling
+    public: GLuint ringTextures[3] = {0u, 0u, 0u};
+
+    /// \brief Index of the next ring texture to copy into
+    public: unsigned int ringIndex = 0u;
+
+    /// \brief Size the ring textures were allocated with
+    public: QSize ringSize;
+
+    /// \brief Framebuffer used to read from the camera's render texture
+    public: GLuint readFbo = 0u;
+
+    /// \brief Framebuffer used to draw into the ring textures
+    public: GLuint drawFbo = 0u;
+
+    /// \brief Ring buffer of per-frame timings. Only the render thread
+    /// writes to it; aggregates are published once per window.
+    public: std::array<FrameTimings, 128> timings;
+
+    /// \brief Number of frames recorded into the current timing window
+    public: std::size_t timingCount = 0u;
+
+    /// \brief Latest aggregated frame statistics
+    public: QVariantMap frameStats;
+
+    /// \brief True if frameStats holds an aggregate that hasn't been
+    /// emitted to the GUI thread yet
+    public: bool frameStatsDirty = false;
+
+    /// \brief Mutex protecting frameStats and frameStatsDirty
+    public: std::mutex statsMutex;
+
+    /// \brief Transport node for publishing frame statistics
+    public: transport::Node statsNode;
+
+    /// \brief Publisher for frame statistics
+    public: transport::Node::Publisher statsPub;
+
+    /// \brief Pixel buffer objects used for double-buffered asynchronous
+    /// frame readback
+    public: GLuint capturePbos[2] = {0u, 0u};
+
+    /// \brief Index of the PBO the current frame is being read into
+    public: unsigned int captureIndex = 0u;
+
+    /// \brief True once the other PBO holds a frame ready to be mapped
+    public: bool capturePrimed = false;
+
+    /// \brief Size the capture PBOs were allocated with
+    public: QSize captureSize;
+
+    /// \brief Number of frames handed to the capture writer so far
+    public: unsigned int captureCount = 0u;
+
+    /// \brief Thread that encodes and writes captured frames to disk
+    public: std::thread captureThread;
+
+    /// \brief Queue of frames waiting to be written, paired with their
+    /// destination paths
+    public: std::deque<std::pair<QImage, QString>> captureQueue;
+
+    /// \brief Mutex protecting the capture queue
+    public: std::mutex captureMutex;
+
+    /// \brief Condition variable the writer thread waits on
+    public: std::condition_variable captureCv;
+
+    /// \brief True when the writer thread should drain and exit
+    public: bool captureDone = false;
   };
 
   /// \brief Private data class for RenderWindowItem
@@ -226,6 +882,9 @@ namespace plugins
     /// \brief Render thread
     public : RenderThread *renderThread = nullptr;
 
+    /// \brief Latest aggregated frame timing statistics
+    public: QVariantMap frameStats;
+
     //// \brief List of threads
     public: static QList<QThread *> threads;
   };
@@ -244,154 +903,1178 @@ using namespace plugins;
 
 QList<QThread *> RenderWindowItemPrivate::threads;
 
-/////////////////////////////////////////////////
-SceneManager::SceneManager()
-{
+/////////////////////////////////////////////////
+SceneManager::SceneManager()
+{
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<SceneManager> SceneManager::Shared(
+    const std::string &_sceneName)
+{
+  static std::mutex managersMutex;
+  static std::map<std::string, std::weak_ptr<SceneManager>> managers;
+
+  std::lock_guard<std::mutex> lock(managersMutex);
+  auto manager = managers[_sceneName].lock();
+  if (!manager)
+  {
+    manager = std::make_shared<SceneManager>();
+    managers[_sceneName] = manager;
+  }
+  return manager;
+}
+
+/////////////////////////////////////////////////
+bool SceneManager::Loaded() const
+{
+  return nullptr != this->scene;
+}
+
+/////////////////////////////////////////////////
+SceneManager::SceneManager(const std::string &_service,
+                           const std::string &_poseTopic,
+                           const std::string &_deletionTopic,
+                           const std::string &_sceneTopic,
+                           rendering::ScenePtr _scene)
+{
+  this->Load(_service, _poseTopic, _deletionTopic, _sceneTopic, _scene);
+}
+
+/////////////////////////////////////////////////
+void SceneManager::Load(const std::string &_service,
+                        const std::string &_poseTopic,
+                        const std::string &_deletionTopic,
+                        const std::string &_sceneTopic,
+                        rendering::ScenePtr _scene)
+{
+  this->service = _service;
+  this->poseTopic = _poseTopic;
+  this->deletionTopic = _deletionTopic;
+  this->sceneTopic = _sceneTopic;
+  this->scene = _scene;
+}
+
+/////////////////////////////////////////////////
+std::string SceneManager::SnapshotPath() const
+{
+  std::string home;
+  common::env(IGN_HOMEDIR, home);
+
+  // key the snapshot by the scene service name
+  std::string key = this->service;
+  std::replace(key.begin(), key.end(), '/', '_');
+
+  return common::joinPaths(home, ".ignition", "gui", "scene_cache",
+      key + ".scene");
+}
+
+/////////////////////////////////////////////////
+void SceneManager::Request()
+{
+  // Populate the scene right away from the snapshot cached by the last
+  // session, if any. When the live response arrives it is diffed against
+  // the loaded entities, so an unchanged world costs only the delta and
+  // the operator isn't staring at an empty scene while the full world
+  // downloads.
+  const auto snapshotPath = this->SnapshotPath();
+  if (common::exists(snapshotPath))
+  {
+    std::ifstream in(snapshotPath, std::ios::binary);
+    msgs::Scene snapshot;
+    if (in && snapshot.ParseFromIstream(&in))
+    {
+      igndbg << "Loading scene snapshot from [" << snapshotPath << "]"
+             << std::endl;
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->sceneMsgs.push_back({snapshot, false});
+    }
+    else
+    {
+      ignwarn << "Failed to parse scene snapshot [" << snapshotPath << "]"
+              << std::endl;
+    }
+  }
+
+  // wait for the service to be advertized
+  std::vector<transport::ServicePublisher> publishers;
+  const std::chrono::duration<double> sleepDuration{1.0};
+  const std::size_t tries = 30;
+  for (std::size_t i = 0; i < tries; ++i)
+  {
+    this->node.ServiceInfo(this->service, publishers);
+    if (publishers.size() > 0)
+      break;
+    std::this_thread::sleep_for(sleepDuration);
+    igndbg << "Waiting for service " << this->service << "\n";
+  }
+
+  if (publishers.empty() ||
+      !this->node.Request(this->service, &SceneManager::OnSceneSrvMsg, this))
+  {
+    ignerr << "Error making service request to " << this->service << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+void SceneManager::OnPoseVMsg(const msgs::Pose_V &_msg)
+{
+  // Only buffer the msg here. The render thread converts and applies the
+  // poses in Update(), so this callback holds the lock just long enough
+  // to stage a copy and never contends with pose application.
+  std::lock_guard<std::mutex> lock(this->poseMutex);
+  auto staged = google::protobuf::Arena::CreateMessage<msgs::Pose_V>(
+      &this->poseArenas[this->activePoseArena]);
+  staged->CopyFrom(_msg);
+  this->poseMsgs.push_back(staged);
+}
+
+/////////////////////////////////////////////////
+void SceneManager::OnDeletionMsg(const msgs::UInt32_V &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // Queued behind any earlier load commands rather than applied right
+  // away, so deleting a model whose load is still buffered works.
+  SceneCommand command;
+  command.type = SceneCommand::DELETE_ENTITIES;
+  command.entities.assign(_msg.data().begin(), _msg.data().end());
+  this->commands.push_back(std::move(command));
+}
+
+/////////////////////////////////////////////////
+void SceneManager::Update()
+{
+  IGN_PROFILE("SceneManager::Update");
+
+  // Swap the pose msg buffer out in one operation so the transport callback
+  // can keep filling a fresh buffer, on the other arena, while we process
+  // this one.
+  std::vector<msgs::Pose_V *> poseMsgBuffer;
+  google::protobuf::Arena *consumedArena{nullptr};
+  {
+    std::lock_guard<std::mutex> lock(this->poseMutex);
+    poseMsgBuffer.swap(this->poseMsgs);
+    consumedArena = &this->poseArenas[this->activePoseArena];
+    this->activePoseArena = 1 - this->activePoseArena;
+  }
+
+  // process msgs
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  const auto now = std::chrono::steady_clock::now();
+  for (const auto *msg : poseMsgBuffer)
+  {
+    // One pass through the protobuf into contiguous arrays, so the
+    // per-entity loop below touches plain memory only
+    convert(*msg, this->poseBatch);
+
+    for (std::size_t i = 0; i < this->poseBatch.ids.size(); ++i)
+    {
+      auto &record = this->Entity(this->poseBatch.ids[i]);
+
+      // apply additional local poses if available
+      const auto pose = math::Pose3d(this->poseBatch.positions[i],
+          this->poseBatch.rotations[i]) * record.localPose;
+
+      // keep the previous snapshot so render-time sampling can
+      // interpolate between the last two received poses
+      record.prevPose = record.hasPose ? record.pose : pose;
+      record.prevPoseTime = record.poseTime;
+      record.pose = pose;
+      record.poseTime = now;
+      record.poseDirty = true;
+      record.hasPose = true;
+    }
+  }
+
+  // The whole consumed batch goes away in one bulk reset. The callback
+  // has been filling the other arena since the swap above, so nothing
+  // still points into this one.
+  poseMsgBuffer.clear();
+  if (consumedArena)
+    consumedArena->Reset();
+
+  for (const auto &msg : this->sceneMsgs)
+  {
+    this->LoadScene(msg.first, msg.second);
+  }
+  this->sceneMsgs.clear();
+
+  // Drain the mutation command buffer until the frame's time budget is
+  // spent. At least one command always executes so the buffer can't
+  // stall, and the remainder carries over — HasUpdates keeps frames
+  // coming until the buffer empties.
+  if (!this->commands.empty())
+  {
+    rendering::VisualPtr rootVis = this->scene->RootVisual();
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(this->mutationBudgetMs));
+    do
+    {
+      const auto &command = this->commands.front();
+      if (command.type == SceneCommand::LOAD_MODEL)
+      {
+        const auto &modelMsg = command.model;
+        auto record = this->EntityById(modelMsg.id());
+        if (!record || record->visual.expired())
+        {
+          rendering::VisualPtr modelVis = this->LoadModel(modelMsg);
+          if (modelVis)
+          {
+            rootVis->AddChild(modelVis);
+            this->Entity(modelMsg.id()).topLevel = true;
+          }
+          else
+            ignerr << "Failed to load model: " << modelMsg.name() << std::endl;
+        }
+      }
+      else
+      {
+        this->DeleteEntities(command.entities);
+      }
+      this->commands.pop_front();
+    } while (!this->commands.empty() &&
+        std::chrono::steady_clock::now() < deadline);
+  }
+
+  this->ProcessPendingMeshes();
+
+  this->UpdateTerrains();
+
+  this->UpdateTextures();
+
+  // Apply buffered poses in one linear scan over the dense entity table,
+  // sampling between the last two received poses so the render rate is
+  // decoupled from the pose topic rate.
+  // Note we are clearing the pose dirty flags here but later on we may need
+  // to consider the case where pose msgs arrive before scene/visual msgs
+  this->interpolating = false;
+  for (auto &record : this->entities)
+  {
+    if (!record.poseDirty)
+      continue;
+
+    // culled entities get their latest pose applied when they come back
+    // into view
+    if (record.culled)
+    {
+      record.poseDirty = false;
+      continue;
+    }
+
+    // fraction of the pose update interval that has elapsed; once the
+    // latest pose is fully applied the entity goes clean
+    double t = 1.0;
+    const auto interval = std::chrono::duration<double>(
+        record.poseTime - record.prevPoseTime).count();
+    if (interval > 0.0)
+    {
+      t = std::chrono::duration<double>(now - record.poseTime).count() /
+          interval;
+    }
+
+    math::Pose3d pose = record.pose;
+    if (t < 1.0)
+    {
+      t = std::max(t, 0.0);
+      pose.Pos() = record.prevPose.Pos() +
+          (record.pose.Pos() - record.prevPose.Pos()) * t;
+      pose.Rot() = math::Quaterniond::Slerp(
+          t, record.prevPose.Rot(), record.pose.Rot(), true);
+      this->interpolating = true;
+    }
+    else
+    {
+      record.poseDirty = false;
+    }
+
+    if (auto visual = record.visual.lock())
+    {
+      visual->SetLocalPose(pose);
+    }
+    else if (auto light = record.light.lock())
+    {
+      light->SetLocalPose(pose);
+    }
+  }
+
+  if (this->viewCulling && this->camera)
+    this->CullEntities();
+}
+
+/////////////////////////////////////////////////
+void SceneManager::CullEntities()
+{
+  const auto camPose = this->camera->WorldPose();
+  const auto forward = camPose.Rot().RotateVector(math::Vector3d::UnitX);
+
+  // A generous angular margin keeps large models at the screen edge and
+  // the vertical fov covered; models well behind the camera still cull.
+  const double cullAngle =
+      std::min(this->camera->HFOV().Radian() * 1.25, IGN_PI);
+  const double cosCull = std::cos(cullAngle);
+
+  for (auto &record : this->entities)
+  {
+    if (!record.topLevel)
+      continue;
+
+    auto visual = record.visual.lock();
+    if (!visual)
+      continue;
+
+    const auto offset = visual->WorldPosition() - camPose.Pos();
+    const double distance = offset.Length();
+
+    bool cull = distance > this->maxDrawDistance;
+    // never direction-cull close by, where object extents dominate
+    if (!cull && distance > 5.0)
+      cull = offset.Dot(forward) < cosCull * distance;
+
+    if (cull == record.culled)
+      continue;
+
+    if (!cull && record.hasPose)
+      visual->SetLocalPose(record.pose);
+    visual->SetVisible(!cull);
+    record.culled = cull;
+  }
+}
+
+/////////////////////////////////////////////////
+bool SceneManager::RayHitsAnyBound(const math::Vector3d &_origin,
+    const math::Vector3d &_dir) const
+{
+  for (const auto &record : this->entities)
+  {
+    auto visual = record.visual.lock();
+    if (!visual || record.culled)
+      continue;
+
+    // conservative bounding sphere around the visual
+    const auto center = visual->WorldPosition();
+    const double radius = 0.5 * visual->LocalScale().Length() + 0.5;
+
+    // distance from the sphere center to the ray
+    const auto toCenter = center - _origin;
+    const double along = toCenter.Dot(_dir);
+    if (along < 0.0 && toCenter.Length() > radius)
+      continue;
+    const double distSq = toCenter.SquaredLength() - along * along;
+    if (distSq <= radius * radius)
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::SetCamera(const rendering::CameraPtr &_camera)
+{
+  // The first viewport's camera drives view culling
+  if (!this->camera || this->camera == _camera)
+  {
+    this->camera = _camera;
+    return;
+  }
+
+  // Another viewport attached to the shared scene: turn culling off
+  // and restore anything the first camera already hid
+  this->multiViewport = true;
+  if (this->viewCulling)
+  {
+    ignmsg << "Multiple viewports share this scene, disabling view culling"
+           << std::endl;
+    this->viewCulling = false;
+    for (auto &record : this->entities)
+    {
+      if (!record.culled)
+        continue;
+      if (auto visual = record.visual.lock())
+      {
+        if (record.hasPose)
+          visual->SetLocalPose(record.pose);
+        visual->SetVisible(true);
+      }
+      record.culled = false;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void SceneManager::SetViewCulling(const bool _enabled)
+{
+  this->viewCulling = _enabled && !this->multiViewport;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::SetMaxDrawDistance(const double _distance)
+{
+  this->maxDrawDistance = _distance;
+}
+
+/////////////////////////////////////////////////
+bool SceneManager::HasUpdates()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->poseMutex);
+    if (!this->poseMsgs.empty())
+      return true;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (!this->sceneMsgs.empty() || !this->commands.empty() ||
+      !this->pendingMeshes.empty() || this->interpolating ||
+      this->texturesStreaming)
+  {
+    return true;
+  }
+
+  // terrain tiles being refined in the background still need frames
+  for (const auto &terrain : this->terrains)
+  {
+    for (const auto &tile : terrain.tiles)
+    {
+      if (tile.pendingFine.valid())
+        return true;
+    }
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+EntityRecord &SceneManager::Entity(const unsigned int _id)
+{
+  auto it = this->entityIndices.find(_id);
+  if (it == this->entityIndices.end())
+  {
+    it = this->entityIndices.insert({_id, this->entities.size()}).first;
+    this->entities.push_back(EntityRecord());
+    this->entities.back().id = _id;
+  }
+  return this->entities[it->second];
+}
+
+/////////////////////////////////////////////////
+EntityRecord *SceneManager::EntityById(const unsigned int _id)
+{
+  auto it = this->entityIndices.find(_id);
+  if (it == this->entityIndices.end())
+    return nullptr;
+  return &this->entities[it->second];
+}
+
+/////////////////////////////////////////////////
+void SceneManager::RemoveEntity(const unsigned int _id)
+{
+  auto it = this->entityIndices.find(_id);
+  if (it == this->entityIndices.end())
+    return;
+
+  // Swap the record with the last one to keep the table dense, then pop.
+  const auto index = it->second;
+  if (index + 1 != this->entities.size())
+  {
+    this->entities[index] = std::move(this->entities.back());
+    this->entityIndices[this->entities[index].id] = index;
+  }
+  this->entities.pop_back();
+  this->entityIndices.erase(it);
+}
+
+/////////////////////////////////////////////////
+void SceneManager::ProcessPendingMeshes()
+{
+  for (auto it = this->pendingMeshes.begin();
+       it != this->pendingMeshes.end();)
+  {
+    if (it->future.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready)
+    {
+      ++it;
+      continue;
+    }
+
+    const common::Mesh *mesh = it->future.get();
+    auto record = this->EntityById(it->entityId);
+    auto visual = record ? record->visual.lock() : nullptr;
+    if (mesh && visual)
+    {
+      rendering::MeshDescriptor descriptor;
+      descriptor.meshName = it->meshName;
+      descriptor.mesh = mesh;
+      auto geom = this->scene->CreateMesh(descriptor);
+      if (geom)
+      {
+        // Keep the material set from the visual msg, otherwise let the
+        // mesh bring its own.
+        rendering::MaterialPtr material;
+        if (it->overrideMaterial && visual->GeometryCount() > 0u)
+          material = visual->GeometryByIndex(0u)->Material();
+
+        visual->RemoveGeometries();
+        visual->AddGeometry(geom);
+        visual->SetLocalScale(it->scale);
+
+        // material is the old geometry's own instance, so reattach it
+        // as-is: cloning here would orphan texture streaming's record
+        // of it
+        if (material)
+          geom->SetMaterial(material, false);
+      }
+      else
+      {
+        ignerr << "Failed to create geometry for mesh: " << it->meshName
+               << std::endl;
+      }
+    }
+    else if (!mesh)
+    {
+      ignerr << "Failed to load mesh: " << it->meshName << std::endl;
+    }
+    it = this->pendingMeshes.erase(it);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Build and register a mesh for one terrain tile.
+/// \param[in] _name Name to register the mesh under.
+/// \param[in] _heights Full elevation grid, row-major.
+/// \param[in] _grid Vertices per side of the elevation grid.
+/// \param[in] _size Terrain size in meters.
+/// \param[in] _origin Terrain origin offset.
+/// \param[in] _x0 First grid column of the tile.
+/// \param[in] _y0 First grid row of the tile.
+/// \param[in] _cells Grid cells per tile side.
+/// \param[in] _step Grid cells per mesh cell; 1 builds full resolution.
+/// \return The registered mesh.
+static const common::Mesh *BuildTerrainTileMesh(const std::string &_name,
+    const std::vector<float> &_heights, const unsigned int _grid,
+    const math::Vector3d &_size, const math::Vector3d &_origin,
+    const unsigned int _x0, const unsigned int _y0,
+    const unsigned int _cells, const unsigned int _step)
+{
+  const unsigned int side = _cells / _step + 1;
+  const double cellX = _size.X() / (_grid - 1);
+  const double cellY = _size.Y() / (_grid - 1);
+
+  auto heightAt = [&](const unsigned int _x, const unsigned int _y)
+  {
+    return static_cast<double>(_heights[_y * _grid + _x]);
+  };
+
+  common::SubMesh subMesh;
+  for (unsigned int y = 0; y < side; ++y)
+  {
+    const unsigned int gy = _y0 + y * _step;
+    for (unsigned int x = 0; x < side; ++x)
+    {
+      const unsigned int gx = _x0 + x * _step;
+
+      subMesh.AddVertex(
+          _origin.X() - _size.X() / 2.0 + gx * cellX,
+          _origin.Y() - _size.Y() / 2.0 + gy * cellY,
+          _origin.Z() + heightAt(gx, gy));
+
+      // central differences over the full-resolution grid, so coarse
+      // tiles shade like the refined ones
+      const unsigned int xl = gx > 0 ? gx - 1 : gx;
+      const unsigned int xr = gx + 1 < _grid ? gx + 1 : gx;
+      const unsigned int yl = gy > 0 ? gy - 1 : gy;
+      const unsigned int yr = gy + 1 < _grid ? gy + 1 : gy;
+      math::Vector3d normal(
+          -(heightAt(xr, gy) - heightAt(xl, gy)) / ((xr - xl) * cellX),
+          -(heightAt(gx, yr) - heightAt(gx, yl)) / ((yr - yl) * cellY),
+          1.0);
+      normal.Normalize();
+      subMesh.AddNormal(normal);
+
+      subMesh.AddTexCoord(static_cast<double>(gx) / (_grid - 1),
+                          static_cast<double>(gy) / (_grid - 1));
+    }
+  }
+
+  for (unsigned int y = 0; y + 1 < side; ++y)
+  {
+    for (unsigned int x = 0; x + 1 < side; ++x)
+    {
+      const unsigned int v = y * side + x;
+      subMesh.AddIndex(v);
+      subMesh.AddIndex(v + 1);
+      subMesh.AddIndex(v + side);
+      subMesh.AddIndex(v + 1);
+      subMesh.AddIndex(v + side + 1);
+      subMesh.AddIndex(v + side);
+    }
+  }
+
+  auto mesh = new common::Mesh();
+  mesh->SetName(_name);
+  mesh->AddSubMesh(subMesh);
+  common::MeshManager::Instance()->AddMesh(mesh);
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+/// \brief Approximate memory cost of a tile mesh, counting CPU and GPU
+/// copies of vertex and index data.
+/// \param[in] _cells Mesh cells per tile side.
+/// \return Cost in bytes.
+static std::size_t TerrainTileBytes(const unsigned int _cells)
+{
+  const std::size_t verts = (_cells + 1) * (_cells + 1);
+  // position + normal + texcoord per vertex, six indices per cell
+  return 2u * (verts * 8u * sizeof(float) +
+      static_cast<std::size_t>(_cells) * _cells * 6u * sizeof(uint32_t));
+}
+
+/////////////////////////////////////////////////
+void SceneManager::LoadTerrain(const msgs::Visual &_msg,
+    const rendering::VisualPtr &_parent)
+{
+  const auto &heightmapMsg = _msg.geometry().heightmap();
+
+  Terrain terrain;
+  terrain.id = this->terrainCounter++;
+  terrain.grid = kTerrainGridSize;
+  terrain.size = msgs::Convert(heightmapMsg.size());
+  terrain.origin = msgs::Convert(heightmapMsg.origin());
+  if (terrain.size == math::Vector3d::Zero)
+    terrain.size.Set(terrain.grid - 1, terrain.grid - 1, 10.0);
+
+  terrain.heights = std::make_shared<std::vector<float>>();
+  auto &heights = *terrain.heights;
+
+  if (heightmapMsg.heights_size() > 0 && heightmapMsg.width() > 1 &&
+      heightmapMsg.height() > 1)
+  {
+    // resample the msg's grid onto the internal grid bilinearly
+    const int msgW = heightmapMsg.width();
+    const int msgH = heightmapMsg.height();
+    heights.resize(terrain.grid * terrain.grid);
+    for (unsigned int y = 0; y < terrain.grid; ++y)
+    {
+      const double fy =
+          static_cast<double>(y) / (terrain.grid - 1) * (msgH - 1);
+      const int y0 = std::min(static_cast<int>(fy), msgH - 2);
+      const double ty = fy - y0;
+      for (unsigned int x = 0; x < terrain.grid; ++x)
+      {
+        const double fx =
+            static_cast<double>(x) / (terrain.grid - 1) * (msgW - 1);
+        const int x0 = std::min(static_cast<int>(fx), msgW - 2);
+        const double tx = fx - x0;
+
+        const double h00 = heightmapMsg.heights(y0 * msgW + x0);
+        const double h10 = heightmapMsg.heights(y0 * msgW + x0 + 1);
+        const double h01 = heightmapMsg.heights((y0 + 1) * msgW + x0);
+        const double h11 = heightmapMsg.heights((y0 + 1) * msgW + x0 + 1);
+        heights[y * terrain.grid + x] = static_cast<float>(
+            (h00 * (1 - tx) + h10 * tx) * (1 - ty) +
+            (h01 * (1 - tx) + h11 * tx) * ty);
+      }
+    }
+  }
+  else if (!heightmapMsg.filename().empty())
+  {
+    common::ImageHeightmap image;
+    if (image.Load(heightmapMsg.filename()) < 0)
+    {
+      ignerr << "Failed to load heightmap image ["
+             << heightmapMsg.filename() << "]" << std::endl;
+      return;
+    }
+    image.FillHeightMap(1, terrain.grid, terrain.size,
+        math::Vector3d::One, false, heights);
+  }
+  else
+  {
+    ignerr << "Heightmap msg has neither heights nor a filename."
+           << std::endl;
+    return;
+  }
+
+  if (heights.size() != terrain.grid * terrain.grid)
+  {
+    ignerr << "Unexpected heightmap grid size [" << heights.size()
+           << "]" << std::endl;
+    return;
+  }
+
+  // material shared by all tiles of this terrain
+  rendering::MaterialPtr material;
+  if (_msg.has_material())
+    material = this->LoadMaterial(_msg.material());
+
+  // Coarse tiles first: small meshes built synchronously, so the whole
+  // terrain shows up right away. Refinement happens from
+  // UpdateTerrains as the camera gets close.
+  const unsigned int cells = (terrain.grid - 1) / kTerrainTilesPerSide;
+  for (unsigned int row = 0; row < kTerrainTilesPerSide; ++row)
+  {
+    for (unsigned int col = 0; col < kTerrainTilesPerSide; ++col)
+    {
+      TerrainTile tile;
+      tile.row = row;
+      tile.col = col;
+      tile.coarseMeshName = "terrain_" + std::to_string(terrain.id) +
+          "_" + std::to_string(row) + "_" + std::to_string(col) +
+          "_coarse";
+
+      auto mesh = BuildTerrainTileMesh(tile.coarseMeshName, heights,
+          terrain.grid, terrain.size, terrain.origin, col * cells,
+          row * cells, cells, kTerrainCoarseStep);
+
+      rendering::MeshDescriptor descriptor;
+      descriptor.meshName = tile.coarseMeshName;
+      descriptor.mesh = mesh;
+      auto geom = this->scene->CreateMesh(descriptor);
+      if (!geom)
+      {
+        ignerr << "Failed to create terrain tile ["
+               << tile.coarseMeshName << "]" << std::endl;
+        continue;
+      }
+
+      tile.visual = this->scene->CreateVisual();
+      tile.visual->SetVisibilityFlags(_parent->VisibilityFlags());
+      tile.visual->AddGeometry(geom);
+      if (material)
+      {
+        geom->SetMaterial(material);
+        this->AddTextureUser(material, geom, tile.visual);
+      }
+      _parent->AddChild(tile.visual);
+
+      tile.center.Set(
+          terrain.origin.X() - terrain.size.X() / 2.0 +
+          (col + 0.5) * terrain.size.X() / kTerrainTilesPerSide,
+          terrain.origin.Y() - terrain.size.Y() / 2.0 +
+          (row + 0.5) * terrain.size.Y() / kTerrainTilesPerSide,
+          terrain.origin.Z());
+
+      terrain.tiles.push_back(std::move(tile));
+    }
+  }
+
+  igndbg << "Loaded terrain [" << _msg.name() << "] as "
+         << terrain.tiles.size() << " streamed tiles" << std::endl;
+
+  terrain.root = _parent;
+  this->terrains.push_back(std::move(terrain));
+}
+
+/////////////////////////////////////////////////
+void SceneManager::UpdateTerrains()
+{
+  if (this->terrains.empty())
+    return;
+
+  math::Vector3d camPos;
+  if (this->camera)
+    camPos = this->camera->WorldPosition();
+
+  for (auto terrainIt = this->terrains.begin();
+       terrainIt != this->terrains.end();)
+  {
+    auto &terrain = *terrainIt;
+    const unsigned int cells = (terrain.grid - 1) / kTerrainTilesPerSide;
+
+    // the terrain's entity was deleted; drop its tiles and meshes once
+    // no refinement is still in flight
+    if (!terrain.root->HasParent())
+    {
+      bool busy = false;
+      for (const auto &tile : terrain.tiles)
+        busy = busy || tile.pendingFine.valid();
+      if (!busy)
+      {
+        for (auto &tile : terrain.tiles)
+        {
+          common::MeshManager::Instance()->RemoveMesh(
+              tile.coarseMeshName);
+          if (tile.fine)
+          {
+            common::MeshManager::Instance()->RemoveMesh(
+                tile.fineMeshName);
+            this->refinedTerrainBytes -= TerrainTileBytes(cells);
+          }
+        }
+        terrainIt = this->terrains.erase(terrainIt);
+        continue;
+      }
+    }
+
+    const double refineDistance = kTerrainRefineFactor *
+        std::max(terrain.size.X(), terrain.size.Y()) /
+        kTerrainTilesPerSide;
+
+    for (auto &tile : terrain.tiles)
+    {
+      // attach a finished refinement
+      if (tile.pendingFine.valid() &&
+          tile.pendingFine.wait_for(std::chrono::seconds(0)) ==
+          std::future_status::ready)
+      {
+        const common::Mesh *mesh = tile.pendingFine.get();
+        tile.pendingFine = std::shared_future<const common::Mesh *>();
+        if (mesh)
+        {
+          rendering::MeshDescriptor descriptor;
+          descriptor.meshName = tile.fineMeshName;
+          descriptor.mesh = mesh;
+          auto geom = this->scene->CreateMesh(descriptor);
+          if (geom)
+          {
+            rendering::MaterialPtr material;
+            if (tile.visual->GeometryCount() > 0u)
+              material = tile.visual->GeometryByIndex(0u)->Material();
+            tile.visual->RemoveGeometries();
+            tile.visual->AddGeometry(geom);
+
+            // reattach the tile's own material instance, so texture
+            // streaming keeps reaching what the tile renders
+            if (material)
+              geom->SetMaterial(material, false);
+            tile.fine = true;
+            this->refinedTerrainBytes += TerrainTileBytes(cells);
+          }
+        }
+      }
+
+      // refine a coarse tile the camera is close to
+      if (this->camera && !tile.fine && !tile.pendingFine.valid() &&
+          tile.center.Distance(camPos) < refineDistance)
+      {
+        tile.fineMeshName = "terrain_" + std::to_string(terrain.id) +
+            "_" + std::to_string(tile.row) + "_" +
+            std::to_string(tile.col) + "_fine";
+        tile.pendingFine = std::async(std::launch::async,
+            [name = tile.fineMeshName, heights = terrain.heights,
+             grid = terrain.grid, size = terrain.size,
+             origin = terrain.origin, x0 = tile.col * cells,
+             y0 = tile.row * cells, cells]()
+            {
+              return BuildTerrainTileMesh(name, *heights, grid, size,
+                  origin, x0, y0, cells, 1u);
+            }).share();
+      }
+    }
+    ++terrainIt;
+  }
+
+  // Demote the farthest refined tiles until back under budget. Tiles
+  // still within refine distance are left alone to avoid thrashing.
+  while (this->camera && this->refinedTerrainBytes > kTerrainMemoryBudget)
+  {
+    TerrainTile *victim = nullptr;
+    const Terrain *victimTerrain = nullptr;
+    double victimDistance = 0.0;
+    for (auto &terrain : this->terrains)
+    {
+      const double refineDistance = kTerrainRefineFactor *
+          std::max(terrain.size.X(), terrain.size.Y()) /
+          kTerrainTilesPerSide;
+      for (auto &tile : terrain.tiles)
+      {
+        if (!tile.fine)
+          continue;
+        const double distance = tile.center.Distance(camPos);
+        if (distance > refineDistance && distance > victimDistance)
+        {
+          victim = &tile;
+          victimTerrain = &terrain;
+          victimDistance = distance;
+        }
+      }
+    }
+    if (!victim)
+      break;
+
+    auto manager = common::MeshManager::Instance();
+    rendering::MeshDescriptor descriptor;
+    descriptor.meshName = victim->coarseMeshName;
+    descriptor.mesh = manager->MeshByName(victim->coarseMeshName);
+    auto geom = this->scene->CreateMesh(descriptor);
+    if (geom)
+    {
+      rendering::MaterialPtr material;
+      if (victim->visual->GeometryCount() > 0u)
+        material = victim->visual->GeometryByIndex(0u)->Material();
+      victim->visual->RemoveGeometries();
+      victim->visual->AddGeometry(geom);
+
+      // reattach the tile's own material instance, so texture
+      // streaming keeps reaching what the tile renders
+      if (material)
+        geom->SetMaterial(material, false);
+    }
+    manager->RemoveMesh(victim->fineMeshName);
+    victim->fine = false;
+    this->refinedTerrainBytes -= TerrainTileBytes(
+        (victimTerrain->grid - 1) / kTerrainTilesPerSide);
+  }
 }
 
 /////////////////////////////////////////////////
-SceneManager::SceneManager(const std::string &_service,
-                           const std::string &_poseTopic,
-                           const std::string &_deletionTopic,
-                           const std::string &_sceneTopic,
-                           rendering::ScenePtr _scene)
+void SceneManager::SetTextureBudget(const double _mb)
 {
-  this->Load(_service, _poseTopic, _deletionTopic, _sceneTopic, _scene);
+  if (_mb <= 0.0)
+    return;
+  this->textureBudgetBytes =
+      static_cast<std::size_t>(_mb * 1024.0 * 1024.0);
 }
 
 /////////////////////////////////////////////////
-void SceneManager::Load(const std::string &_service,
-                        const std::string &_poseTopic,
-                        const std::string &_deletionTopic,
-                        const std::string &_sceneTopic,
-                        rendering::ScenePtr _scene)
+void SceneManager::RegisterTexture(const std::string &_uri,
+    const rendering::MaterialPtr &_material)
 {
-  this->service = _service;
-  this->poseTopic = _poseTopic;
-  this->deletionTopic = _deletionTopic;
-  this->sceneTopic = _sceneTopic;
-  this->scene = _scene;
-}
+  if (_uri.empty() || !_material)
+    return;
 
-/////////////////////////////////////////////////
-void SceneManager::Request()
-{
-  // wait for the service to be advertized
-  std::vector<transport::ServicePublisher> publishers;
-  const std::chrono::duration<double> sleepDuration{1.0};
-  const std::size_t tries = 30;
-  for (std::size_t i = 0; i < tries; ++i)
+  auto indexIt = this->textureIndices.find(_uri);
+  if (indexIt == this->textureIndices.end())
   {
-    this->node.ServiceInfo(this->service, publishers);
-    if (publishers.size() > 0)
-      break;
-    std::this_thread::sleep_for(sleepDuration);
-    igndbg << "Waiting for service " << this->service << "\n";
+    TextureRecord record;
+    record.uri = _uri;
+    record.probe = std::async(std::launch::async, [uri = _uri]()
+        {
+          TextureProbe probe;
+          common::Image image(uri);
+          if (!image.Valid())
+            return probe;
+          probe.valid = true;
+          probe.width = image.Width();
+          probe.height = image.Height();
+          probe.average = image.AvgColor();
+          return probe;
+        }).share();
+    indexIt = this->textureIndices.insert(
+        {_uri, this->textures.size()}).first;
+    this->textures.push_back(std::move(record));
   }
 
-  if (publishers.empty() ||
-      !this->node.Request(this->service, &SceneManager::OnSceneSrvMsg, this))
-  {
-    ignerr << "Error making service request to " << this->service << std::endl;
-  }
+  auto &record = this->textures[indexIt->second];
+  record.sources.push_back(_material);
+  this->materialTextures[_material.get()] = indexIt->second;
+  this->texturesStreaming = true;
 }
 
 /////////////////////////////////////////////////
-void SceneManager::OnPoseVMsg(const msgs::Pose_V &_msg)
+void SceneManager::AddTextureUser(const rendering::MaterialPtr &_material,
+    const rendering::GeometryPtr &_geometry,
+    const rendering::VisualPtr &_visual)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  for (int i = 0; i < _msg.pose_size(); ++i)
-  {
-    math::Pose3d pose = msgs::Convert(_msg.pose(i));
+  if (!_material || !_geometry || !_visual)
+    return;
 
-    // apply additional local poses if available
-    const auto it = this->localPoses.find(_msg.pose(i).id());
-    if (it != this->localPoses.end())
-    {
-      pose = pose * it->second;
-    }
+  auto indexIt = this->materialTextures.find(_material.get());
+  if (indexIt == this->materialTextures.end())
+    return;
 
-    this->poses[_msg.pose(i).id()] = pose;
-  }
-}
+  // SetMaterial installed a per-geometry clone of _material; record
+  // that clone, since mutating the shared original never reaches the
+  // screen
+  auto applied = _geometry->Material();
+  if (!applied)
+    return;
 
-/////////////////////////////////////////////////
-void SceneManager::OnDeletionMsg(const msgs::UInt32_V &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->mutex);
-  std::copy(_msg.data().begin(), _msg.data().end(),
-            std::back_inserter(this->toDeleteEntities));
+  auto &record = this->textures[indexIt->second];
+
+  TextureUser user;
+  user.visual = _visual;
+  user.material = applied;
+  user.diffuse = applied->Diffuse();
+
+  // Users arriving after the record settled catch up with its state
+  if (record.resident)
+    applied->SetTexture(record.uri);
+  else if (record.hasAverage)
+    applied->SetDiffuse(record.average);
+
+  record.users.push_back(std::move(user));
 }
 
 /////////////////////////////////////////////////
-void SceneManager::Update()
+void SceneManager::UpdateTextures()
 {
-  // process msgs
-  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->textures.empty())
+  {
+    this->texturesStreaming = false;
+    return;
+  }
 
-  for (const auto &msg : this->sceneMsgs)
+  math::Vector3d camPos;
+  if (this->camera)
+    camPos = this->camera->WorldPosition();
+
+  // Drop textures whose visuals are all gone, releasing their share of
+  // the budget
+  bool erasedRecords = false;
+  for (auto recordIt = this->textures.begin();
+       recordIt != this->textures.end();)
   {
-    this->LoadScene(msg);
+    auto &record = *recordIt;
+    record.users.erase(std::remove_if(record.users.begin(),
+        record.users.end(),
+        [](const TextureUser &_user)
+        {
+          return _user.visual.expired();
+        }), record.users.end());
+
+    if (record.users.empty())
+    {
+      if (record.resident)
+        this->residentTextureBytes -= record.bytes;
+      recordIt = this->textures.erase(recordIt);
+      erasedRecords = true;
+      continue;
+    }
+    ++recordIt;
   }
-  this->sceneMsgs.clear();
 
-  for (const auto &entity : this->toDeleteEntities)
+  // erasing shifted the table, so rebuild the index maps
+  if (erasedRecords)
   {
-    this->DeleteEntity(entity);
+    this->textureIndices.clear();
+    this->materialTextures.clear();
+    for (std::size_t i = 0; i < this->textures.size(); ++i)
+    {
+      this->textureIndices[this->textures[i].uri] = i;
+      for (const auto &source : this->textures[i].sources)
+        this->materialTextures[source.get()] = i;
+    }
   }
-  this->toDeleteEntities.clear();
 
+  bool probing = false;
+  bool changed = false;
 
-  for (auto pIt = this->poses.begin(); pIt != this->poses.end();)
+  for (auto &record : this->textures)
   {
-    auto vIt = this->visuals.find(pIt->first);
-    if (vIt != this->visuals.end())
+    // Consume a finished probe: the image size prices the texture
+    // against the budget, and the average color stands in for it (a
+    // 1x1 mip) until the texture itself is streamed in
+    if (record.probe.valid() &&
+        record.probe.wait_for(std::chrono::seconds(0)) ==
+        std::future_status::ready)
     {
-      auto visual = vIt->second.lock();
-      if (visual)
+      const auto probe = record.probe.get();
+      record.probe = std::shared_future<TextureProbe>();
+      if (probe.valid)
       {
-        visual->SetLocalPose(pIt->second);
+        // RGBA plus a full mip chain is about 4/3 of the base level
+        record.bytes = static_cast<std::size_t>(probe.width) *
+            probe.height * 4u * 4u / 3u;
+        record.average = probe.average;
+        record.hasAverage = true;
+        for (const auto &user : record.users)
+          user.material->SetDiffuse(record.average);
+        changed = true;
+
+        if (record.bytes > this->textureBudgetBytes)
+        {
+          ignwarn << "Texture [" << record.uri << "] exceeds the "
+                  << "texture budget, showing its average color only."
+                  << std::endl;
+          record.failed = true;
+        }
       }
       else
       {
-        this->visuals.erase(vIt);
+        ignerr << "Failed to load texture [" << record.uri << "]"
+               << std::endl;
+        record.failed = true;
       }
-      this->poses.erase(pIt++);
     }
-    else
+    probing = probing || record.probe.valid();
+
+    // distance from the camera to the nearest visual using the texture
+    record.distance = std::numeric_limits<double>::infinity();
+    for (const auto &user : record.users)
     {
-      auto lIt = this->lights.find(pIt->first);
-      if (lIt != this->lights.end())
+      if (auto visual = user.visual.lock())
       {
-        auto light = lIt->second.lock();
-        if (light)
-        {
-          light->SetLocalPose(pIt->second);
-        }
-        else
-        {
-          this->lights.erase(lIt);
-        }
-        this->poses.erase(pIt++);
+        record.distance = std::min(record.distance,
+            visual->WorldPosition().Distance(camPos));
       }
-      else
+    }
+  }
+
+  // Stream in the texture nearest the camera, at most one per call so
+  // a texture-heavy world costs extra frames instead of one long one
+  TextureRecord *candidate = nullptr;
+  for (auto &record : this->textures)
+  {
+    if (record.resident || record.failed || record.probe.valid() ||
+        0u == record.bytes)
+    {
+      continue;
+    }
+    if (!candidate || record.distance < candidate->distance)
+      candidate = &record;
+  }
+
+  if (candidate)
+  {
+    // make room by evicting resident textures farther away than the
+    // candidate; anything nearer is left alone to avoid thrashing
+    while (this->residentTextureBytes + candidate->bytes >
+        this->textureBudgetBytes)
+    {
+      TextureRecord *victim = nullptr;
+      for (auto &record : this->textures)
+      {
+        if (!record.resident || record.distance <= candidate->distance)
+          continue;
+        if (!victim || record.distance > victim->distance)
+          victim = &record;
+      }
+      if (!victim)
+        break;
+
+      for (const auto &user : victim->users)
+      {
+        user.material->ClearTexture();
+        if (victim->hasAverage)
+          user.material->SetDiffuse(victim->average);
+      }
+      victim->resident = false;
+      this->residentTextureBytes -= victim->bytes;
+      changed = true;
+    }
+
+    if (this->residentTextureBytes + candidate->bytes <=
+        this->textureBudgetBytes)
+    {
+      for (const auto &user : candidate->users)
       {
-        ++pIt;
+        user.material->SetTexture(candidate->uri);
+        user.material->SetDiffuse(user.diffuse);
       }
+      candidate->resident = true;
+      this->residentTextureBytes += candidate->bytes;
+      changed = true;
     }
   }
 
-  // Note we are clearing the pose msgs here but later on we may need to
-  // consider the case where pose msgs arrive before scene/visual msgs
-  this->poses.clear();
+  // Residency that can only improve with a camera move waits for the
+  // renders that move triggers anyway; keep frames coming only while
+  // progress doesn't depend on one
+  this->texturesStreaming = probing || changed;
 }
 
-
 /////////////////////////////////////////////////
 void SceneManager::OnSceneMsg(const msgs::Scene &_msg)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
-  this->sceneMsgs.push_back(_msg);
+
+  // Coalesce consecutive delta msgs into one accumulated delta so a
+  // chatty server can't grow the queue without bound.
+  if (!this->sceneMsgs.empty() && !this->sceneMsgs.back().second)
+    this->sceneMsgs.back().first.MergeFrom(_msg);
+  else
+    this->sceneMsgs.push_back({_msg, false});
 }
 
 /////////////////////////////////////////////////
@@ -405,10 +2088,33 @@ void SceneManager::OnSceneSrvMsg(const msgs::Scene &_msg, const bool result)
   }
 
   {
+    // A full snapshot supersedes everything still queued: earlier
+    // snapshots and the deltas folded into them.
     std::lock_guard<std::mutex> lock(this->mutex);
-    this->sceneMsgs.push_back(_msg);
+    this->sceneMsgs.clear();
+    this->sceneMsgs.push_back({_msg, true});
   }
 
+  // Cache the snapshot in the background so the next session can populate
+  // the scene before the service responds.
+  this->snapshotWrite = std::async(std::launch::async,
+      [msg = _msg, path = this->SnapshotPath()]()
+      {
+        const auto dir = common::parentPath(path);
+        if (!common::exists(dir) && !common::createDirectories(dir))
+        {
+          ignwarn << "Failed to create snapshot directory [" << dir << "]"
+                  << std::endl;
+          return;
+        }
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out || !msg.SerializeToOstream(&out))
+        {
+          ignwarn << "Failed to write scene snapshot [" << path << "]"
+                  << std::endl;
+        }
+      });
+
   if (!this->poseTopic.empty())
   {
     if (!this->node.Subscribe(this->poseTopic, &SceneManager::OnPoseVMsg, this))
@@ -457,28 +2163,66 @@ void SceneManager::OnSceneSrvMsg(const msgs::Scene &_msg, const bool result)
   }
 }
 
-void SceneManager::LoadScene(const msgs::Scene &_msg)
+void SceneManager::CollectEntityIds(const msgs::Model &_msg,
+    std::unordered_set<unsigned int> &_ids) const
+{
+  _ids.insert(_msg.id());
+  for (int i = 0; i < _msg.link_size(); ++i)
+  {
+    _ids.insert(_msg.link(i).id());
+    for (int j = 0; j < _msg.link(i).visual_size(); ++j)
+      _ids.insert(_msg.link(i).visual(j).id());
+    for (int j = 0; j < _msg.link(i).light_size(); ++j)
+      _ids.insert(_msg.link(i).light(j).id());
+  }
+  for (int i = 0; i < _msg.model_size(); ++i)
+    this->CollectEntityIds(_msg.model(i), _ids);
+}
+
+void SceneManager::LoadScene(const msgs::Scene &_msg, const bool _fullScene)
 {
   rendering::VisualPtr rootVis = this->scene->RootVisual();
 
-  // load models
+  // A full snapshot tells us the complete set of entities that should
+  // exist, so destroy the ones that are no longer in the msg before
+  // creating the new ones. Entities already in the scene are untouched.
+  if (_fullScene)
+  {
+    std::unordered_set<unsigned int> msgIds;
+    for (int i = 0; i < _msg.model_size(); ++i)
+      this->CollectEntityIds(_msg.model(i), msgIds);
+    for (int i = 0; i < _msg.light_size(); ++i)
+      msgIds.insert(_msg.light(i).id());
+
+    std::vector<unsigned int> removedIds;
+    for (const auto &record : this->entities)
+    {
+      if (msgIds.find(record.id) == msgIds.end())
+        removedIds.push_back(record.id);
+    }
+    if (!removedIds.empty())
+      this->DeleteEntities(removedIds);
+  }
+
+  // queue models as load commands to be executed across frames
   for (int i = 0; i < _msg.model_size(); ++i)
   {
     // Only add if it's not already loaded
-    if (this->visuals.find(_msg.model(i).id()) == this->visuals.end())
+    auto record = this->EntityById(_msg.model(i).id());
+    if (!record || record->visual.expired())
     {
-      rendering::VisualPtr modelVis = this->LoadModel(_msg.model(i));
-      if (modelVis)
-        rootVis->AddChild(modelVis);
-      else
-        ignerr << "Failed to load model: " << _msg.model(i).name() << std::endl;
+      SceneCommand command;
+      command.type = SceneCommand::LOAD_MODEL;
+      command.model = _msg.model(i);
+      this->commands.push_back(std::move(command));
     }
   }
 
   // load lights
   for (int i = 0; i < _msg.light_size(); ++i)
   {
-    if (this->lights.find(_msg.light(i).id()) == this->lights.end())
+    auto record = this->EntityById(_msg.light(i).id());
+    if (!record || record->light.expired())
     {
       rendering::LightPtr light = this->LoadLight(_msg.light(i));
       if (light)
@@ -495,7 +2239,7 @@ rendering::VisualPtr SceneManager::LoadModel(const msgs::Model &_msg)
   rendering::VisualPtr modelVis = this->scene->CreateVisual();
   if (_msg.has_pose())
     modelVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = modelVis;
+  this->Entity(_msg.id()).visual = modelVis;
 
   // load links
   for (int i = 0; i < _msg.link_size(); ++i)
@@ -527,7 +2271,7 @@ rendering::VisualPtr SceneManager::LoadLink(const msgs::Link &_msg)
   rendering::VisualPtr linkVis = this->scene->CreateVisual();
   if (_msg.has_pose())
     linkVis->SetLocalPose(msgs::Convert(_msg.pose()));
-  this->visuals[_msg.id()] = linkVis;
+  this->Entity(_msg.id()).visual = linkVis;
 
   // load visuals
   for (int i = 0; i < _msg.visual_size(); ++i)
@@ -552,6 +2296,28 @@ rendering::VisualPtr SceneManager::LoadLink(const msgs::Link &_msg)
   return linkVis;
 }
 
+/////////////////////////////////////////////////
+/// \brief Pick the visibility layer for a visual, from its declared type
+/// when there is one and from its name otherwise.
+/// \param[in] _msg Visual msg
+/// \return One of the layer bits
+static uint32_t VisualLayer(const msgs::Visual &_msg)
+{
+  if (_msg.type() == msgs::Visual::COLLISION ||
+      _msg.name().find("collision") != std::string::npos)
+  {
+    return kCollisionLayer;
+  }
+
+  if (_msg.name().find("debug") != std::string::npos ||
+      _msg.name().find("marker") != std::string::npos)
+  {
+    return kDebugLayer;
+  }
+
+  return kDefaultLayer;
+}
+
 /////////////////////////////////////////////////
 rendering::VisualPtr SceneManager::LoadVisual(const msgs::Visual &_msg)
 {
@@ -559,7 +2325,18 @@ rendering::VisualPtr SceneManager::LoadVisual(const msgs::Visual &_msg)
     return rendering::VisualPtr();
 
   rendering::VisualPtr visualVis = this->scene->CreateVisual();
-  this->visuals[_msg.id()] = visualVis;
+  visualVis->SetVisibilityFlags(VisualLayer(_msg));
+  this->Entity(_msg.id()).visual = visualVis;
+
+  // Heightmaps become a grid of streamed tiles under the visual instead
+  // of one monolithic geometry.
+  if (_msg.geometry().has_heightmap())
+  {
+    if (_msg.has_pose())
+      visualVis->SetLocalPose(msgs::Convert(_msg.pose()));
+    this->LoadTerrain(_msg, visualVis);
+    return visualVis;
+  }
 
   math::Vector3d scale = math::Vector3d::One;
   math::Pose3d localPose;
@@ -574,7 +2351,33 @@ rendering::VisualPtr SceneManager::LoadVisual(const msgs::Visual &_msg)
   if (geom)
   {
     // store the local pose
-    this->localPoses[_msg.id()] = localPose;
+    this->Entity(_msg.id()).localPose = localPose;
+
+    // register deferred mesh loads kicked off by LoadGeometry
+    if (!this->pendingMeshName.empty())
+    {
+      PendingMesh pending;
+      pending.entityId = _msg.id();
+      pending.meshName = this->pendingMeshName;
+      pending.scale = scale;
+      pending.overrideMaterial = _msg.has_material();
+
+      // repeated geometry shares a single background load
+      auto loadIt = this->meshLoads.find(pending.meshName);
+      if (loadIt == this->meshLoads.end())
+      {
+        loadIt = this->meshLoads.insert({pending.meshName,
+            std::async(std::launch::async,
+            [meshName = pending.meshName]()
+            {
+              return
+                  ignition::common::MeshManager::Instance()->Load(meshName);
+            }).share()}).first;
+      }
+      pending.future = loadIt->second;
+      this->pendingMeshes.push_back(std::move(pending));
+      this->pendingMeshName.clear();
+    }
 
     visualVis->AddGeometry(geom);
     visualVis->SetLocalScale(scale);
@@ -607,14 +2410,18 @@ rendering::VisualPtr SceneManager::LoadVisual(const msgs::Visual &_msg)
       }
     }
 
-    material->SetTransparency(_msg.transparency());
+    if (material)
+    {
+      material->SetTransparency(_msg.transparency());
 
-    // TODO(anyone) Get roughness and metalness from message instead
-    // of giving a default value.
-    material->SetRoughness(0.3);
-    material->SetMetalness(0.3);
+      // TODO(anyone) Get roughness and metalness from message instead
+      // of giving a default value.
+      material->SetRoughness(0.3);
+      material->SetMetalness(0.3);
 
-    geom->SetMaterial(material);
+      geom->SetMaterial(material);
+      this->AddTextureUser(material, geom, visualVis);
+    }
   }
   else
   {
@@ -685,8 +2492,19 @@ rendering::GeometryPtr SceneManager::LoadGeometry(const msgs::Geometry &_msg,
 
     ignition::common::MeshManager* meshManager =
         ignition::common::MeshManager::Instance();
-    descriptor.mesh = meshManager->Load(descriptor.meshName);
-    geom = this->scene->CreateMesh(descriptor);
+    if (meshManager->HasMesh(descriptor.meshName))
+    {
+      descriptor.mesh = meshManager->MeshByName(descriptor.meshName);
+      geom = this->scene->CreateMesh(descriptor);
+    }
+    else
+    {
+      // Load the mesh in the background so scene processing doesn't
+      // serialize on disk I/O and parsing. A placeholder box is shown
+      // until ProcessPendingMeshes swaps the real geometry in.
+      this->pendingMeshName = descriptor.meshName;
+      geom = this->scene->CreateBox();
+    }
 
     scale = msgs::Convert(_msg.mesh().scale());
   }
@@ -702,6 +2520,16 @@ rendering::GeometryPtr SceneManager::LoadGeometry(const msgs::Geometry &_msg,
 /////////////////////////////////////////////////
 rendering::MaterialPtr SceneManager::LoadMaterial(const msgs::Material &_msg)
 {
+  // Worlds commonly reuse a handful of materials across hundreds of
+  // visuals, so share one material object per distinct msg. Per-visual
+  // properties like transparency are applied by the caller, the same way
+  // they already are for the shared default material.
+  std::string key;
+  _msg.SerializeToString(&key);
+  auto cacheIt = this->materialCache.find(key);
+  if (cacheIt != this->materialCache.end())
+    return cacheIt->second;
+
   rendering::MaterialPtr material = this->scene->CreateMaterial();
   if (_msg.has_ambient())
   {
@@ -720,6 +2548,13 @@ rendering::MaterialPtr SceneManager::LoadMaterial(const msgs::Material &_msg)
     material->SetEmissive(msgs::Convert(_msg.emissive()));
   }
 
+  // Textures go through the residency manager instead of being applied
+  // at full resolution right here, so scene load isn't serialized on
+  // texture decodes and VRAM stays under the budget
+  if (_msg.has_pbr() && !_msg.pbr().albedo_map().empty())
+    this->RegisterTexture(_msg.pbr().albedo_map(), material);
+
+  this->materialCache[key] = material;
   return material;
 }
 
@@ -761,88 +2596,489 @@ rendering::LightPtr SceneManager::LoadLight(const msgs::Light &_msg)
   if (_msg.has_pose())
     light->SetLocalPose(msgs::Convert(_msg.pose()));
 
-  if (_msg.has_diffuse())
-    light->SetDiffuseColor(msgs::Convert(_msg.diffuse()));
+  if (_msg.has_diffuse())
+    light->SetDiffuseColor(msgs::Convert(_msg.diffuse()));
+
+  if (_msg.has_specular())
+    light->SetSpecularColor(msgs::Convert(_msg.specular()));
+
+  light->SetAttenuationConstant(_msg.attenuation_constant());
+  light->SetAttenuationLinear(_msg.attenuation_linear());
+  light->SetAttenuationQuadratic(_msg.attenuation_quadratic());
+  light->SetAttenuationRange(_msg.range());
+
+  light->SetCastShadows(_msg.cast_shadows());
+
+  this->Entity(_msg.id()).light = light;
+  return light;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::DeleteEntity(const unsigned int _entity)
+{
+  auto record = this->EntityById(_entity);
+  if (!record)
+    return;
+
+  if (auto visual = record->visual.lock())
+  {
+    this->scene->DestroyVisual(visual, true);
+  }
+  else if (auto light = record->light.lock())
+  {
+    this->scene->DestroyLight(light, true);
+  }
+  this->RemoveEntity(_entity);
+}
+
+/////////////////////////////////////////////////
+void SceneManager::DeleteEntities(const std::vector<unsigned int> &_entities)
+{
+  const std::unordered_set<unsigned int> ids(
+      _entities.begin(), _entities.end());
+
+  // One pass over the scene graph. Destroying a parent visual recursively
+  // destroys its children, so records deleted that way just hold expired
+  // pointers by the time they are visited.
+  for (const auto &id : ids)
+  {
+    auto record = this->EntityById(id);
+    if (!record)
+      continue;
+
+    if (auto visual = record->visual.lock())
+    {
+      this->scene->DestroyVisual(visual, true);
+    }
+    else if (auto light = record->light.lock())
+    {
+      this->scene->DestroyLight(light, true);
+    }
+  }
+
+  // Compact the dense table in one pass and reindex the survivors, instead
+  // of a swap-and-pop per entity.
+  std::size_t write = 0u;
+  for (std::size_t read = 0u; read < this->entities.size(); ++read)
+  {
+    if (ids.find(this->entities[read].id) != ids.end())
+      continue;
+    if (write != read)
+      this->entities[write] = std::move(this->entities[read]);
+    ++write;
+  }
+  this->entities.resize(write);
+
+  this->entityIndices.clear();
+  for (std::size_t i = 0u; i < this->entities.size(); ++i)
+    this->entityIndices[this->entities[i].id] = i;
+}
+
+/////////////////////////////////////////////////
+IgnRenderer::IgnRenderer()
+  : dataPtr(new IgnRendererPrivate)
+{
+}
+
+
+/////////////////////////////////////////////////
+IgnRenderer::~IgnRenderer()
+{
+}
+
+/////////////////////////////////////////////////
+void IgnRenderer::SetVisibilityMask(const uint32_t _mask)
+{
+  this->visibilityMask = _mask;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->pendingVisibilityMask = _mask;
+  this->dataPtr->visibilityMaskDirty = true;
+}
+
+/////////////////////////////////////////////////
+bool IgnRenderer::UpdatePending() const
+{
+  if (this->textureDirty)
+    return true;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->mouseDirty || this->dataPtr->visibilityMaskDirty)
+      return true;
+  }
+
+  if (this->dataPtr->sceneManager && this->dataPtr->sceneManager->HasUpdates())
+    return true;
+
+  // idle FPS floor
+  const auto idlePeriod = std::chrono::duration<double>(
+      1.0 / std::max(this->idleFps, 1e-3));
+  return std::chrono::steady_clock::now() -
+      this->dataPtr->lastRenderTime >= idlePeriod;
+}
+
+/////////////////////////////////////////////////
+void IgnRenderer::Render()
+{
+  IGN_PROFILE("IgnRenderer::Render");
+
+  this->dataPtr->lastRenderTime = std::chrono::steady_clock::now();
+
+  if (this->textureDirty)
+  {
+    // the render target is the item size scaled by the dynamic
+    // resolution; the scene graph upsamples it back for display
+    this->renderSize = QSize(
+        std::max(1, static_cast<int>(
+            this->textureSize.width() * this->dataPtr->renderScale)),
+        std::max(1, static_cast<int>(
+            this->textureSize.height() * this->dataPtr->renderScale)));
+    this->dataPtr->camera->SetImageWidth(this->renderSize.width());
+    this->dataPtr->camera->SetImageHeight(this->renderSize.height());
+    this->dataPtr->camera->SetAspectRatio(
+        static_cast<double>(this->textureSize.width()) /
+        this->textureSize.height());
+    // setting the size should cause the render texture to be rebuilt
+    this->dataPtr->camera->PreRender();
+    this->textureId = this->dataPtr->camera->RenderTextureGLId();
+    this->textureDirty = false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->visibilityMaskDirty)
+    {
+      this->dataPtr->camera->SetVisibilityMask(
+          this->dataPtr->pendingVisibilityMask);
+      this->dataPtr->visibilityMaskDirty = false;
+    }
+  }
+
+  const auto frameStart = std::chrono::steady_clock::now();
+  auto stageMs = [](const std::chrono::steady_clock::time_point &_from,
+                    const std::chrono::steady_clock::time_point &_to)
+  {
+    return std::chrono::duration<double, std::milli>(_to - _from).count();
+  };
+
+  // update the scene
+  this->dataPtr->sceneManager->Update();
+  const auto sceneDone = std::chrono::steady_clock::now();
+
+  // view control
+  this->HandleMouseEvent();
+  const auto mouseDone = std::chrono::steady_clock::now();
+
+  // update and render to texture
+  this->dataPtr->camera->Update();
+  const auto renderDone = std::chrono::steady_clock::now();
+
+  // hand a stable copy of the frame to the scene graph
+  this->CopyFrameToRing();
 
-  if (_msg.has_specular())
-    light->SetSpecularColor(msgs::Convert(_msg.specular()));
+  if (!this->capturePath.empty())
+    this->CaptureFrame();
+  const auto copyDone = std::chrono::steady_clock::now();
 
-  light->SetAttenuationConstant(_msg.attenuation_constant());
-  light->SetAttenuationLinear(_msg.attenuation_linear());
-  light->SetAttenuationQuadratic(_msg.attenuation_quadratic());
-  light->SetAttenuationRange(_msg.range());
+  this->RecordFrameTimings(
+      stageMs(frameStart, sceneDone),
+      stageMs(sceneDone, mouseDone),
+      stageMs(mouseDone, renderDone),
+      stageMs(renderDone, copyDone),
+      stageMs(frameStart, copyDone));
 
-  light->SetCastShadows(_msg.cast_shadows());
+  if (this->dynamicResolution)
+    this->UpdateRenderScale(stageMs(frameStart, copyDone));
 
-  this->lights[_msg.id()] = light;
-  return light;
+  if (ignition::gui::App())
+  {
+    // Routed directly to registered consumers; falls back to the main
+    // window broadcast when there are none
+    gui::events::Render renderEvent;
+    ignition::gui::App()->RouteEvent(&renderEvent);
+  }
 }
 
 /////////////////////////////////////////////////
-void SceneManager::DeleteEntity(const unsigned int _entity)
+void IgnRenderer::CaptureFrame()
 {
-  if (this->visuals.find(_entity) != this->visuals.end())
+  auto context = QOpenGLContext::currentContext();
+  if (!context)
+    return;
+  auto gl = context->extraFunctions();
+
+  const int width = this->renderSize.width();
+  const int height = this->renderSize.height();
+  const int byteCount = width * height * 4;
+
+  // (re)allocate the PBOs on first use or after a resize
+  if (0u == this->dataPtr->capturePbos[0] ||
+      this->dataPtr->captureSize != this->renderSize)
   {
-    auto visual = this->visuals[_entity].lock();
-    if (visual)
+    if (this->dataPtr->capturePbos[0] != 0u)
+      gl->glDeleteBuffers(2, this->dataPtr->capturePbos);
+    gl->glGenBuffers(2, this->dataPtr->capturePbos);
+    for (const auto pbo : this->dataPtr->capturePbos)
     {
-      this->scene->DestroyVisual(visual, true);
+      gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo);
+      gl->glBufferData(GL_PIXEL_PACK_BUFFER, byteCount, nullptr,
+          GL_STREAM_READ);
     }
-    this->visuals.erase(_entity);
+    this->dataPtr->captureSize = this->renderSize;
+    this->dataPtr->capturePrimed = false;
+    this->dataPtr->captureIndex = 0u;
   }
-  else if (this->lights.find(_entity) != this->lights.end())
+
+  // lazily start the writer thread
+  if (!this->dataPtr->captureThread.joinable())
   {
-    auto light = this->lights[_entity].lock();
-    if (light)
+    this->dataPtr->captureThread = std::thread([this]()
     {
-      this->scene->DestroyLight(light, true);
+      while (true)
+      {
+        std::pair<QImage, QString> frame;
+        {
+          std::unique_lock<std::mutex> lock(this->dataPtr->captureMutex);
+          this->dataPtr->captureCv.wait(lock, [this]()
+          {
+            return this->dataPtr->captureDone ||
+                !this->dataPtr->captureQueue.empty();
+          });
+          if (this->dataPtr->captureQueue.empty())
+            return;
+          frame = std::move(this->dataPtr->captureQueue.front());
+          this->dataPtr->captureQueue.pop_front();
+        }
+        if (!frame.first.save(frame.second))
+        {
+          ignwarn << "Failed to save captured frame ["
+                  << frame.second.toStdString() << "]" << std::endl;
+        }
+      }
+    });
+  }
+
+  // kick off the asynchronous readback of this frame
+  gl->glBindFramebuffer(GL_READ_FRAMEBUFFER, this->dataPtr->readFbo);
+  gl->glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+      GL_TEXTURE_2D, this->textureId, 0);
+  gl->glBindBuffer(GL_PIXEL_PACK_BUFFER,
+      this->dataPtr->capturePbos[this->dataPtr->captureIndex]);
+  gl->glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+  // map the PBO filled one frame ago; its transfer has had a full frame
+  // to complete, so the map doesn't stall the pipeline
+  const auto prevIndex = 1u - this->dataPtr->captureIndex;
+  if (this->dataPtr->capturePrimed)
+  {
+    gl->glBindBuffer(GL_PIXEL_PACK_BUFFER,
+        this->dataPtr->capturePbos[prevIndex]);
+    const auto data = gl->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+        byteCount, GL_MAP_READ_BIT);
+    if (data)
+    {
+      QImage frame(reinterpret_cast<const uchar *>(data), width, height,
+          QImage::Format_RGBA8888);
+      const auto path = QString("%1/frame_%2.png")
+          .arg(QString::fromStdString(this->capturePath))
+          .arg(this->dataPtr->captureCount++, 5, 10, QChar('0'));
+      {
+        // mirrored() also deep-copies out of the mapped buffer; GL frames
+        // are bottom-up
+        std::lock_guard<std::mutex> lock(this->dataPtr->captureMutex);
+        this->dataPtr->captureQueue.push_back(
+            {frame.mirrored(), path});
+      }
+      this->dataPtr->captureCv.notify_one();
+      gl->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
     }
-    this->lights.erase(_entity);
   }
+
+  gl->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  gl->glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+  this->dataPtr->captureIndex = prevIndex;
+  this->dataPtr->capturePrimed = true;
 }
 
 /////////////////////////////////////////////////
-IgnRenderer::IgnRenderer()
-  : dataPtr(new IgnRendererPrivate)
+void IgnRenderer::RecordFrameTimings(const double _sceneUpdateMs,
+    const double _mouseMs, const double _renderMs, const double _copyMs,
+    const double _totalMs)
 {
+  auto &timing = this->dataPtr->timings[this->dataPtr->timingCount++];
+  timing.sceneUpdateMs = _sceneUpdateMs;
+  timing.mouseMs = _mouseMs;
+  timing.renderMs = _renderMs;
+  timing.copyMs = _copyMs;
+  timing.totalMs = _totalMs;
+
+  if (this->dataPtr->timingCount < this->dataPtr->timings.size())
+    return;
+  this->dataPtr->timingCount = 0u;
+
+  // aggregate the full window
+  FrameTimings avg, max;
+  for (const auto &t : this->dataPtr->timings)
+  {
+    avg.sceneUpdateMs += t.sceneUpdateMs;
+    avg.mouseMs += t.mouseMs;
+    avg.renderMs += t.renderMs;
+    avg.copyMs += t.copyMs;
+    avg.totalMs += t.totalMs;
+    max.totalMs = std::max(max.totalMs, t.totalMs);
+  }
+  const auto count = static_cast<double>(this->dataPtr->timings.size());
+  avg.sceneUpdateMs /= count;
+  avg.mouseMs /= count;
+  avg.renderMs /= count;
+  avg.copyMs /= count;
+  avg.totalMs /= count;
+
+  QVariantMap stats;
+  stats["sceneUpdateAvgMs"] = avg.sceneUpdateMs;
+  stats["mouseAvgMs"] = avg.mouseMs;
+  stats["renderAvgMs"] = avg.renderMs;
+  stats["copyAvgMs"] = avg.copyMs;
+  stats["totalAvgMs"] = avg.totalMs;
+  stats["totalMaxMs"] = max.totalMs;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->statsMutex);
+    this->dataPtr->frameStats = stats;
+    this->dataPtr->frameStatsDirty = true;
+  }
+
+  // publish the aggregate so deployed consoles can be monitored without
+  // attaching a profiler
+  if (!this->dataPtr->statsPub.Valid())
+  {
+    this->dataPtr->statsPub =
+        this->dataPtr->statsNode.Advertise<msgs::Param>(
+        "/gui/scene3d/frame_stats");
+  }
+  if (this->dataPtr->statsPub.Valid())
+  {
+    msgs::Param msg;
+    auto addParam = [&msg](const std::string &_key, const double _value)
+    {
+      msgs::Any value;
+      value.set_type(msgs::Any::DOUBLE);
+      value.set_double_value(_value);
+      (*msg.mutable_params())[_key] = value;
+    };
+    addParam("scene_update_avg_ms", avg.sceneUpdateMs);
+    addParam("mouse_avg_ms", avg.mouseMs);
+    addParam("render_avg_ms", avg.renderMs);
+    addParam("copy_avg_ms", avg.copyMs);
+    addParam("total_avg_ms", avg.totalMs);
+    addParam("total_max_ms", max.totalMs);
+    this->dataPtr->statsPub.Publish(msg);
+  }
 }
 
+/////////////////////////////////////////////////
+void IgnRenderer::UpdateRenderScale(const double _frameMs)
+{
+  // smooth over recent frames so a single hitch doesn't change the scale
+  if (this->dataPtr->frameTimeAvgMs <= 0.0)
+    this->dataPtr->frameTimeAvgMs = _frameMs;
+  else
+  {
+    this->dataPtr->frameTimeAvgMs =
+        0.9 * this->dataPtr->frameTimeAvgMs + 0.1 * _frameMs;
+  }
+
+  if (this->dataPtr->scaleCooldown > 0)
+  {
+    --this->dataPtr->scaleCooldown;
+    return;
+  }
+
+  // hysteresis band around the target, so the scale settles instead of
+  // bouncing between two steps
+  auto scale = this->dataPtr->renderScale;
+  if (this->dataPtr->frameTimeAvgMs > this->dynResTargetMs * 1.1)
+    scale = std::max(0.5, scale - 0.1);
+  else if (this->dataPtr->frameTimeAvgMs < this->dynResTargetMs * 0.7)
+    scale = std::min(1.0, scale + 0.1);
+
+  if (math::equal(scale, this->dataPtr->renderScale))
+    return;
+
+  this->dataPtr->renderScale = scale;
+  // rebuild the render target at the new size before the next frame
+  this->textureDirty = true;
+  this->dataPtr->scaleCooldown = 30;
+}
 
 /////////////////////////////////////////////////
-IgnRenderer::~IgnRenderer()
+bool IgnRenderer::NewFrameStats(QVariantMap &_stats)
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->statsMutex);
+  if (!this->dataPtr->frameStatsDirty)
+    return false;
+  this->dataPtr->frameStatsDirty = false;
+  _stats = this->dataPtr->frameStats;
+  return true;
 }
 
 /////////////////////////////////////////////////
-void IgnRenderer::Render()
+void IgnRenderer::CopyFrameToRing()
 {
-  if (this->textureDirty)
+  auto context = QOpenGLContext::currentContext();
+  if (!context)
+    return;
+  auto gl = context->extraFunctions();
+
+  // (re)allocate the ring textures on first use or after a resize
+  if (0u == this->dataPtr->ringTextures[0] ||
+      this->dataPtr->ringSize != this->renderSize)
   {
-    this->dataPtr->camera->SetImageWidth(this->textureSize.width());
-    this->dataPtr->camera->SetImageHeight(this->textureSize.height());
-    this->dataPtr->camera->SetAspectRatio(this->textureSize.width() /
-        this->textureSize.height());
-    // setting the size should cause the render texture to be rebuilt
-    this->dataPtr->camera->PreRender();
-    this->textureId = this->dataPtr->camera->RenderTextureGLId();
-    this->textureDirty = false;
+    if (this->dataPtr->ringTextures[0] != 0u)
+      gl->glDeleteTextures(3, this->dataPtr->ringTextures);
+    gl->glGenTextures(3, this->dataPtr->ringTextures);
+    for (const auto tex : this->dataPtr->ringTextures)
+    {
+      gl->glBindTexture(GL_TEXTURE_2D, tex);
+      gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8,
+          this->renderSize.width(), this->renderSize.height(), 0,
+          GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+      gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+      gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+    gl->glBindTexture(GL_TEXTURE_2D, 0);
+    this->dataPtr->ringSize = this->renderSize;
   }
 
-  // update the scene
-  this->dataPtr->sceneManager.Update();
+  if (0u == this->dataPtr->readFbo)
+  {
+    gl->glGenFramebuffers(1, &this->dataPtr->readFbo);
+    gl->glGenFramebuffers(1, &this->dataPtr->drawFbo);
+  }
 
-  // view control
-  this->HandleMouseEvent();
+  const auto cameraTexture = this->dataPtr->camera->RenderTextureGLId();
+  const auto ringTexture =
+      this->dataPtr->ringTextures[this->dataPtr->ringIndex];
 
-  // update and render to texture
-  this->dataPtr->camera->Update();
+  gl->glBindFramebuffer(GL_READ_FRAMEBUFFER, this->dataPtr->readFbo);
+  gl->glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+      GL_TEXTURE_2D, cameraTexture, 0);
+  gl->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->dataPtr->drawFbo);
+  gl->glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+      GL_TEXTURE_2D, ringTexture, 0);
 
-  if (ignition::gui::App())
-  {
-    ignition::gui::App()->sendEvent(
-        ignition::gui::App()->findChild<ignition::gui::MainWindow *>(),
-        new gui::events::Render());
-  }
+  gl->glBlitFramebuffer(
+      0, 0, this->renderSize.width(), this->renderSize.height(),
+      0, 0, this->renderSize.width(), this->renderSize.height(),
+      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+  gl->glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+  gl->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+
+  this->textureId = ringTexture;
+  this->dataPtr->ringIndex = (this->dataPtr->ringIndex + 1u) % 3u;
 }
 
 /////////////////////////////////////////////////
@@ -856,8 +3092,18 @@ void IgnRenderer::HandleMouseEvent()
 
   if (this->dataPtr->mouseEvent.Type() == common::MouseEvent::SCROLL)
   {
-    this->dataPtr->target =
-        this->ScreenToScene(this->dataPtr->mouseEvent.Pos());
+    // Consecutive wheel ticks over the same pixel keep zooming toward
+    // the same world point, so the ray query only runs when the cursor
+    // moved since the last tick. The accumulated drag already folds a
+    // burst of ticks into one zoom.
+    if (!this->dataPtr->scrollTargetValid ||
+        this->dataPtr->mouseEvent.Pos() != this->dataPtr->scrollTargetPos)
+    {
+      this->dataPtr->target =
+          this->ScreenToScene(this->dataPtr->mouseEvent.Pos());
+      this->dataPtr->scrollTargetPos = this->dataPtr->mouseEvent.Pos();
+      this->dataPtr->scrollTargetValid = true;
+    }
     this->dataPtr->viewControl.SetTarget(this->dataPtr->target);
     double distance = this->dataPtr->camera->WorldPosition().Distance(
         this->dataPtr->target);
@@ -866,11 +3112,30 @@ void IgnRenderer::HandleMouseEvent()
   }
   else
   {
-    if (this->dataPtr->drag == math::Vector2d::Zero)
+    this->dataPtr->scrollTargetValid = false;
+
+    if (this->dataPtr->mouseEvent.Type() == common::MouseEvent::RELEASE)
     {
+      this->dataPtr->gestureActive = false;
+    }
+    else if (!this->dataPtr->gestureActive ||
+        this->dataPtr->drag == math::Vector2d::Zero)
+    {
+      // Gesture start: resolve the orbit target with one ray query and
+      // precompute the zoom scale, so the per-frame handling below is
+      // plain arithmetic no matter how many move events were coalesced
+      // into this frame's drag vector
       this->dataPtr->target = this->ScreenToScene(
           this->dataPtr->mouseEvent.PressPos());
       this->dataPtr->viewControl.SetTarget(this->dataPtr->target);
+
+      double hfov = this->dataPtr->camera->HFOV().Radian();
+      double vfov = 2.0f * atan(tan(hfov / 2.0f) /
+          this->dataPtr->camera->AspectRatio());
+      // drags are measured in item pixels, not camera image pixels
+      this->dataPtr->zoomPerPixel = tan(vfov / 2.0) * 6.0 /
+          static_cast<double>(this->textureSize.height());
+      this->dataPtr->gestureActive = true;
     }
 
     // Pan with left button
@@ -885,14 +3150,12 @@ void IgnRenderer::HandleMouseEvent()
     }
     else if (this->dataPtr->mouseEvent.Buttons() & common::MouseEvent::RIGHT)
     {
-      double hfov = this->dataPtr->camera->HFOV().Radian();
-      double vfov = 2.0f * atan(tan(hfov / 2.0f) /
-          this->dataPtr->camera->AspectRatio());
+      // Distance to the target changes as the camera zooms, but the
+      // frustum factor was fixed at gesture start
       double distance = this->dataPtr->camera->WorldPosition().Distance(
           this->dataPtr->target);
-      double amount = ((-this->dataPtr->drag.Y() /
-          static_cast<double>(this->dataPtr->camera->ImageHeight()))
-          * distance * tan(vfov/2.0) * 6.0);
+      double amount = -this->dataPtr->drag.Y() * distance *
+          this->dataPtr->zoomPerPixel;
       this->dataPtr->viewControl.Zoom(amount);
     }
   }
@@ -911,9 +3174,20 @@ void IgnRenderer::Initialize()
   auto engine = rendering::engine(this->engineName, params);
   if (!engine)
   {
-    ignerr << "Engine [" << this->engineName << "] is not supported"
-           << std::endl;
-    return;
+    // both GL engines share the context-sharing setup here, so fall back
+    // to whichever one is available
+    const std::string fallback = this->engineName == "ogre2" ?
+        "ogre" : "ogre2";
+    ignwarn << "Engine [" << this->engineName << "] is not supported, "
+            << "trying [" << fallback << "]" << std::endl;
+    engine = rendering::engine(fallback, params);
+    if (!engine)
+    {
+      ignerr << "Engine [" << this->engineName << "] is not supported"
+             << std::endl;
+      return;
+    }
+    this->engineName = fallback;
   }
 
   // Scene
@@ -932,22 +3206,39 @@ void IgnRenderer::Initialize()
   this->dataPtr->camera = scene->CreateCamera();
   root->AddChild(this->dataPtr->camera);
   this->dataPtr->camera->SetLocalPose(this->cameraPose);
-  this->dataPtr->camera->SetImageWidth(this->textureSize.width());
-  this->dataPtr->camera->SetImageHeight(this->textureSize.height());
+  this->renderSize = this->textureSize;
+  this->dataPtr->camera->SetImageWidth(this->renderSize.width());
+  this->dataPtr->camera->SetImageHeight(this->renderSize.height());
   this->dataPtr->camera->SetAntiAliasing(8);
   this->dataPtr->camera->SetHFOV(M_PI * 0.5);
+  this->dataPtr->camera->SetVisibilityMask(this->visibilityMask);
   // setting the size and calling PreRender should cause the render texture to
   //  be rebuilt
   this->dataPtr->camera->PreRender();
   this->textureId = this->dataPtr->camera->RenderTextureGLId();
 
-  // Make service call to populate scene
-  if (!this->sceneService.empty())
+  // One manager per scene, shared across viewports, so entity state is
+  // ingested and stored once no matter how many views are open
+  this->dataPtr->sceneManager = SceneManager::Shared(this->sceneName);
+
+  // View culling
+  this->dataPtr->sceneManager->SetCamera(this->dataPtr->camera);
+  this->dataPtr->sceneManager->SetViewCulling(this->viewCulling);
+  if (this->maxDrawDistance > 0.0)
+    this->dataPtr->sceneManager->SetMaxDrawDistance(this->maxDrawDistance);
+
+  // Texture residency
+  if (this->textureBudget > 0.0)
+    this->dataPtr->sceneManager->SetTextureBudget(this->textureBudget);
+
+  // Make service call to populate scene. Viewports joining an already
+  // loaded manager reuse the subscriptions and entities it has.
+  if (!this->sceneService.empty() && !this->dataPtr->sceneManager->Loaded())
   {
-    this->dataPtr->sceneManager.Load(this->sceneService, this->poseTopic,
-                                     this->deletionTopic, this->sceneTopic,
-                                     scene);
-    this->dataPtr->sceneManager.Request();
+    this->dataPtr->sceneManager->Load(this->sceneService, this->poseTopic,
+                                      this->deletionTopic, this->sceneTopic,
+                                      scene);
+    this->dataPtr->sceneManager->Request();
   }
 
   // Ray Query
@@ -959,6 +3250,29 @@ void IgnRenderer::Initialize()
 /////////////////////////////////////////////////
 void IgnRenderer::Destroy()
 {
+  // let the capture writer drain and exit
+  if (this->dataPtr->captureThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->captureMutex);
+      this->dataPtr->captureDone = true;
+    }
+    this->dataPtr->captureCv.notify_one();
+    this->dataPtr->captureThread.join();
+  }
+
+  // release the texture ring; the GL context is current during shutdown
+  auto context = QOpenGLContext::currentContext();
+  if (context && this->dataPtr->ringTextures[0] != 0u)
+  {
+    auto gl = context->extraFunctions();
+    gl->glDeleteTextures(3, this->dataPtr->ringTextures);
+    gl->glDeleteFramebuffers(1, &this->dataPtr->readFbo);
+    gl->glDeleteFramebuffers(1, &this->dataPtr->drawFbo);
+    if (this->dataPtr->capturePbos[0] != 0u)
+      gl->glDeleteBuffers(2, this->dataPtr->capturePbos);
+  }
+
   auto engine = rendering::engine(this->engineName);
   if (!engine)
     return;
@@ -991,9 +3305,11 @@ void IgnRenderer::NewMouseEvent(const common::MouseEvent &_e,
 math::Vector3d IgnRenderer::ScreenToScene(
     const math::Vector2i &_screenPos) const
 {
-  // Normalize point on the image
-  double width = this->dataPtr->camera->ImageWidth();
-  double height = this->dataPtr->camera->ImageHeight();
+  // Normalize point on the image. Mouse positions are in item pixels,
+  // so normalize by the item size rather than the camera image, which
+  // may be smaller under dynamic resolution.
+  double width = this->textureSize.width();
+  double height = this->textureSize.height();
 
   double nx = 2.0 * _screenPos.X() / width - 1.0;
   double ny = 1.0 - 2.0 * _screenPos.Y() / height;
@@ -1002,6 +3318,17 @@ math::Vector3d IgnRenderer::ScreenToScene(
   this->dataPtr->rayQuery->SetFromCamera(
       this->dataPtr->camera, math::Vector2d(nx, ny));
 
+  // Broad-phase against entity bounding spheres first; only run the
+  // engine's exact scene query when the ray can actually hit something.
+  if (this->dataPtr->sceneManager &&
+      !this->dataPtr->sceneManager->RayHitsAnyBound(
+      this->dataPtr->rayQuery->Origin(),
+      this->dataPtr->rayQuery->Direction()))
+  {
+    return this->dataPtr->rayQuery->Origin() +
+        this->dataPtr->rayQuery->Direction() * 10;
+  }
+
   auto result = this->dataPtr->rayQuery->ClosestPoint();
   if (result)
     return result.point;
@@ -1020,6 +3347,31 @@ RenderThread::RenderThread()
 /////////////////////////////////////////////////
 void RenderThread::RenderNext()
 {
+  // Pin to the configured core from inside the thread, once, and give
+  // the thread a name in the profiler timeline while we're at it
+  if (!this->affinityApplied)
+  {
+    this->affinityApplied = true;
+    IGN_PROFILE_THREAD_NAME("RenderThread");
+    if (this->threadAffinity >= 0)
+    {
+#ifdef __linux__
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      CPU_SET(this->threadAffinity, &cpuSet);
+      if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet)
+          != 0)
+      {
+        ignwarn << "Failed to pin render thread to core ["
+                << this->threadAffinity << "]" << std::endl;
+      }
+#else
+      ignwarn << "Render thread affinity is only supported on Linux"
+              << std::endl;
+#endif
+    }
+  }
+
   this->context->makeCurrent(this->surface);
 
   if (!this->ignRenderer.initialized)
@@ -1035,9 +3387,29 @@ void RenderThread::RenderNext()
     return;
   }
 
+  // In render-on-demand mode skip the frame if nothing changed and poll
+  // again shortly, instead of spinning on the render loop.
+  if (this->ignRenderer.renderOnDemand && !this->ignRenderer.UpdatePending())
+  {
+    QTimer::singleShot(5, this, &RenderThread::RenderNext);
+    return;
+  }
+
   this->ignRenderer.Render();
 
-  emit TextureReady(this->ignRenderer.textureId, this->ignRenderer.textureSize);
+  // the texture is renderSize, possibly smaller than the item when
+  // dynamic resolution kicked in; the scene graph scales it back up
+  emit TextureReady(this->ignRenderer.textureId, this->ignRenderer.renderSize);
+
+  QVariantMap stats;
+  if (this->ignRenderer.NewFrameStats(stats))
+    emit FrameStats(stats);
+
+  // With the triple-buffered texture ring the renderer doesn't need to wait
+  // for the scene graph to consume the frame, so schedule the next one
+  // right away. Going through the event loop keeps ShutDown and
+  // SizeChanged responsive.
+  QTimer::singleShot(0, this, &RenderThread::RenderNext);
 }
 
 /////////////////////////////////////////////////
@@ -1082,6 +3454,10 @@ TextureNode::TextureNode(QQuickWindow *_window)
   // Our texture node must have a texture, so use the default 0 texture.
   this->texture = this->window->createTextureFromId(0, QSize(1, 1));
   this->setTexture(this->texture);
+
+  // smooth upsampling when the texture is smaller than the item, as
+  // happens under dynamic resolution scaling
+  this->setFiltering(QSGTexture::Linear);
 }
 
 /////////////////////////////////////////////////
@@ -1135,6 +3511,22 @@ RenderWindowItem::RenderWindowItem(QQuickItem *_parent)
   this->setAcceptedMouseButtons(Qt::AllButtons);
   this->setFlag(ItemHasContents);
   this->dataPtr->renderThread = new RenderThread();
+
+  this->connect(this->dataPtr->renderThread, &RenderThread::FrameStats,
+      this, &RenderWindowItem::OnFrameStats, Qt::QueuedConnection);
+}
+
+/////////////////////////////////////////////////
+QVariantMap RenderWindowItem::FrameStats() const
+{
+  return this->dataPtr->frameStats;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::OnFrameStats(const QVariantMap &_stats)
+{
+  this->dataPtr->frameStats = _stats;
+  emit this->FrameStatsChanged();
 }
 
 /////////////////////////////////////////////////
@@ -1164,7 +3556,8 @@ void RenderWindowItem::Ready()
   this->connect(this, &QQuickItem::heightChanged,
       this->dataPtr->renderThread, &RenderThread::SizeChanged);
 
-  this->dataPtr->renderThread->start();
+  this->dataPtr->renderThread->start(
+      this->dataPtr->renderThread->threadPriority);
   this->update();
 }
 
@@ -1199,8 +3592,7 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
   {
     node = new TextureNode(this->window());
 
-    // Set up connections to get the production of render texture in sync with
-    // vsync on the rendering thread.
+    // Set up connections to hand finished frames to the scene graph.
     //
     // When a new texture is ready on the rendering thread, we use a direct
     // connection to the texture node to let it know a new texture can be used.
@@ -1208,13 +3600,11 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
     // QQuickWindow::update to schedule a redraw.
     //
     // When the scene graph starts rendering the next frame, the PrepareNode()
-    // function is used to update the node with the new texture. Once it
-    // completes, it emits TextureInUse() which we connect to the rendering
-    // thread's RenderNext() to have it start producing content into its render
-    // texture.
+    // function is used to update the node with the new texture.
     //
-    // This rendering pipeline is throttled by vsync on the scene graph
-    // rendering thread.
+    // The rendering thread copies each frame into a triple-buffered texture
+    // ring and schedules its own next frame, so it is never throttled by
+    // the scene graph consuming textures.
 
     this->connect(this->dataPtr->renderThread, &RenderThread::TextureReady,
         node, &TextureNode::NewTexture, Qt::DirectConnection);
@@ -1222,8 +3612,6 @@ QSGNode *RenderWindowItem::updatePaintNode(QSGNode *_node,
         &QQuickWindow::update, Qt::QueuedConnection);
     this->connect(this->window(), &QQuickWindow::beforeRendering, node,
         &TextureNode::PrepareNode, Qt::DirectConnection);
-    this->connect(node, &TextureNode::TextureInUse, this->dataPtr->renderThread,
-        &RenderThread::RenderNext, Qt::QueuedConnection);
 
     // Get the production of FBO textures started..
     QMetaObject::invokeMethod(this->dataPtr->renderThread, "RenderNext",
@@ -1265,6 +3653,97 @@ void RenderWindowItem::SetCameraPose(const math::Pose3d &_pose)
   this->dataPtr->renderThread->ignRenderer.cameraPose = _pose;
 }
 
+/////////////////////////////////////////////////
+void RenderWindowItem::SetRenderOnDemand(const bool _onDemand)
+{
+  this->dataPtr->renderThread->ignRenderer.renderOnDemand = _onDemand;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetIdleFps(const double _fps)
+{
+  this->dataPtr->renderThread->ignRenderer.idleFps = _fps;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetDynamicResolution(const bool _enabled)
+{
+  this->dataPtr->renderThread->ignRenderer.dynamicResolution = _enabled;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetTargetFrameTime(const double _ms)
+{
+  this->dataPtr->renderThread->ignRenderer.dynResTargetMs = _ms;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetCapturePath(const std::string &_path)
+{
+  if (!_path.empty() && !common::exists(_path) &&
+      !common::createDirectories(_path))
+  {
+    ignerr << "Failed to create capture directory [" << _path << "]"
+           << std::endl;
+    return;
+  }
+  this->dataPtr->renderThread->ignRenderer.capturePath = _path;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetThreadPriority(const QThread::Priority _priority)
+{
+  this->dataPtr->renderThread->threadPriority = _priority;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetThreadAffinity(const int _core)
+{
+  this->dataPtr->renderThread->threadAffinity = _core;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetViewCulling(const bool _enabled)
+{
+  this->dataPtr->renderThread->ignRenderer.viewCulling = _enabled;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetMaxDrawDistance(const double _distance)
+{
+  this->dataPtr->renderThread->ignRenderer.maxDrawDistance = _distance;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetTextureBudget(const double _mb)
+{
+  this->dataPtr->renderThread->ignRenderer.textureBudget = _mb;
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetVisibilityMask(const uint32_t _mask)
+{
+  this->dataPtr->renderThread->ignRenderer.SetVisibilityMask(_mask);
+}
+
+/////////////////////////////////////////////////
+void RenderWindowItem::SetLayerVisible(const int _layer, const bool _visible)
+{
+  if (_layer < 0 || _layer > 31)
+  {
+    ignwarn << "Ignoring visibility layer [" << _layer
+            << "], expected [0-31]." << std::endl;
+    return;
+  }
+
+  auto mask = this->dataPtr->renderThread->ignRenderer.visibilityMask;
+  if (_visible)
+    mask |= 1u << _layer;
+  else
+    mask &= ~(1u << _layer);
+  this->dataPtr->renderThread->ignRenderer.SetVisibilityMask(mask);
+}
+
 /////////////////////////////////////////////////
 void RenderWindowItem::SetSceneService(const std::string &_service)
 {
@@ -1365,6 +3844,122 @@ void Scene3D::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
       renderWindow->SetCameraPose(pose);
     }
 
+    elem = _pluginElem->FirstChildElement("render_on_demand");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      bool onDemand = false;
+      elem->QueryBoolText(&onDemand);
+      renderWindow->SetRenderOnDemand(onDemand);
+    }
+
+    elem = _pluginElem->FirstChildElement("idle_fps");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double fps = 5.0;
+      elem->QueryDoubleText(&fps);
+      renderWindow->SetIdleFps(fps);
+    }
+
+    elem = _pluginElem->FirstChildElement("dynamic_resolution");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      bool enabled = false;
+      elem->QueryBoolText(&enabled);
+      renderWindow->SetDynamicResolution(enabled);
+    }
+
+    elem = _pluginElem->FirstChildElement("target_frame_time");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double ms = 16.0;
+      elem->QueryDoubleText(&ms);
+      if (ms > 0.0)
+      {
+        renderWindow->SetTargetFrameTime(ms);
+      }
+      else
+      {
+        ignwarn << "Ignoring <target_frame_time> [" << ms
+                << "], must be positive." << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("capture_path");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      renderWindow->SetCapturePath(elem->GetText());
+    }
+
+    elem = _pluginElem->FirstChildElement("thread_priority");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      const std::string priority = elem->GetText();
+      if (priority == "low")
+        renderWindow->SetThreadPriority(QThread::LowPriority);
+      else if (priority == "normal")
+        renderWindow->SetThreadPriority(QThread::NormalPriority);
+      else if (priority == "high")
+        renderWindow->SetThreadPriority(QThread::HighPriority);
+      else if (priority == "highest")
+        renderWindow->SetThreadPriority(QThread::HighestPriority);
+      else if (priority == "time_critical")
+        renderWindow->SetThreadPriority(QThread::TimeCriticalPriority);
+      else
+      {
+        ignwarn << "Unknown <thread_priority> [" << priority
+                << "], expected one of: low, normal, high, highest, "
+                << "time_critical" << std::endl;
+      }
+    }
+
+    elem = _pluginElem->FirstChildElement("thread_affinity");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      int core = -1;
+      elem->QueryIntText(&core);
+      renderWindow->SetThreadAffinity(core);
+    }
+
+    elem = _pluginElem->FirstChildElement("view_culling");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      bool culling = false;
+      elem->QueryBoolText(&culling);
+      renderWindow->SetViewCulling(culling);
+    }
+
+    elem = _pluginElem->FirstChildElement("max_draw_distance");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double distance = -1.0;
+      elem->QueryDoubleText(&distance);
+      renderWindow->SetMaxDrawDistance(distance);
+    }
+
+    elem = _pluginElem->FirstChildElement("texture_budget");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      double budget = -1.0;
+      elem->QueryDoubleText(&budget);
+      renderWindow->SetTextureBudget(budget);
+    }
+
+    elem = _pluginElem->FirstChildElement("visibility_mask");
+    if (nullptr != elem && nullptr != elem->GetText())
+    {
+      // base 0 so hex masks like 0x5 work too
+      try
+      {
+        renderWindow->SetVisibilityMask(static_cast<uint32_t>(
+            std::stoul(elem->GetText(), nullptr, 0)));
+      }
+      catch (const std::exception &)
+      {
+        ignwarn << "Ignoring <visibility_mask> [" << elem->GetText()
+                << "], expected a number." << std::endl;
+      }
+    }
+
     elem = _pluginElem->FirstChildElement("service");
     if (nullptr != elem && nullptr != elem->GetText())
     {
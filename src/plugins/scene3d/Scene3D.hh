@@ -18,6 +18,7 @@
 #ifndef IGNITION_GUI_PLUGINS_SCENE3D_HH_
 #define IGNITION_GUI_PLUGINS_SCENE3D_HH_
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <mutex>
@@ -51,7 +52,11 @@ namespace plugins
   ///
   /// ## Configuration
   ///
-  /// * \<engine\> : Optional render engine name, defaults to 'ogre'.
+  /// * \<engine\> : Optional render engine name, 'ogre' or 'ogre2',
+  ///                defaults to 'ogre'. If the requested engine can't be
+  ///                loaded, the other one is tried. The ogre2 backend
+  ///                batches draw calls and materials much better on large
+  ///                scenes.
   /// * \<scene\> : Optional scene name, defaults to 'scene'. The plugin will
   ///               create a scene with this name if there isn't one yet. If
   ///               there is already one, a new camera is added to it.
@@ -61,6 +66,44 @@ namespace plugins
   ///                          (0.3, 0.3, 0.3, 1.0)
   /// * \<camera_pose\> : Optional starting pose for the camera, defaults to
   ///                     (0, 0, 5, 0, 0, 0)
+  /// * \<render_on_demand\> : Optional, set to true to only render frames
+  ///                          when the scene changed or the camera moved,
+  ///                          defaults to false.
+  /// * \<idle_fps\> : Optional frame rate floor used while the scene is
+  ///                  idle in render-on-demand mode, defaults to 5.
+  /// * \<view_culling\> : Optional, set to true to hide models that are
+  ///                      behind the camera or beyond the max draw
+  ///                      distance, defaults to false.
+  /// * \<max_draw_distance\> : Optional distance in meters beyond which
+  ///                           models are culled when view culling is
+  ///                           enabled, unlimited by default.
+  /// * \<texture_budget\> : Optional budget in megabytes of estimated
+  ///                        texture memory kept resident. Textures are
+  ///                        streamed in by camera proximity and the
+  ///                        farthest ones are evicted when over budget.
+  ///                        Defaults to 256.
+  /// * \<visibility_mask\> : Optional initial camera visibility mask,
+  ///                         decimal or hex. Visuals are assigned layer
+  ///                         bits when loaded: 0x1 regular, 0x2 collision,
+  ///                         0x4 debug / marker. All layers visible by
+  ///                         default.
+  /// * \<dynamic_resolution\> : Optional, set to true to scale the render
+  ///                            target down (to at most half size) when
+  ///                            the frame time exceeds the target, and
+  ///                            back up when it recovers. The scaled
+  ///                            frame is upsampled for display. Defaults
+  ///                            to false.
+  /// * \<target_frame_time\> : Optional frame time in milliseconds that
+  ///                           dynamic resolution steers toward,
+  ///                           defaults to 16.
+  /// * \<thread_priority\> : Optional scheduling priority for the render
+  ///                         thread: low, normal, high, highest or
+  ///                         time_critical. Inherited by default.
+  /// * \<thread_affinity\> : Optional CPU core index to pin the render
+  ///                         thread to (Linux only). Unpinned by default.
+  /// * \<capture_path\> : Optional directory to continuously capture
+  ///                      rendered frames into as numbered PNG files.
+  ///                      Disabled by default.
   class Scene3D : public Plugin
   {
     Q_OBJECT
@@ -97,6 +140,19 @@ namespace plugins
     ///  \brief Main render function
     public: void Render();
 
+    /// \brief Check whether anything requires a new frame: buffered scene
+    /// or pose updates, pending mouse interaction, a texture resize, or
+    /// the idle FPS floor having elapsed since the last render.
+    /// \return True if a new frame should be rendered.
+    public: bool UpdatePending() const;
+
+    /// \brief Get the latest aggregated frame statistics, if a new
+    /// aggregate is available since the last call.
+    /// \param[out] _stats Per-stage timing averages and maxima in ms, plus
+    /// the achieved frame rate.
+    /// \return True if _stats was filled with a new aggregate.
+    public: bool NewFrameStats(QVariantMap &_stats);
+
     /// \brief Initialize the render engine
     public: void Initialize();
 
@@ -109,9 +165,45 @@ namespace plugins
     public: void NewMouseEvent(const common::MouseEvent &_e,
         const math::Vector2d &_drag = math::Vector2d::Zero);
 
+    /// \brief Set the camera's visibility mask. Visuals whose layer bits
+    /// aren't in the mask are skipped by the camera, so hiding a whole
+    /// category of visuals costs one mask write. Applied on the render
+    /// thread before the next frame.
+    /// \param[in] _mask Bitmask of visible layers
+    public: void SetVisibilityMask(const uint32_t _mask);
+
     /// \brief Handle mouse event for view control
     private: void HandleMouseEvent();
 
+    /// \brief Copy the camera's render texture into the next texture of a
+    /// three-deep ring and publish that copy as textureId. The camera can
+    /// then start the next frame while the Qt scene graph is still
+    /// sampling the previous copies.
+    private: void CopyFrameToRing();
+
+    /// \brief Kick off the asynchronous readback of the current frame and
+    /// hand the frame read back last time to the capture writer thread.
+    /// Only called while capturePath is set.
+    private: void CaptureFrame();
+
+    /// \brief Record one frame's per-stage timings into the timing ring
+    /// buffer, aggregating and publishing statistics when the window fills.
+    /// \param[in] _sceneUpdateMs Time spent updating the scene manager
+    /// \param[in] _mouseMs Time spent handling mouse events
+    /// \param[in] _renderMs Time spent in the camera render
+    /// \param[in] _copyMs Time spent copying the frame to the texture ring
+    /// \param[in] _totalMs Total frame time
+    private: void RecordFrameTimings(const double _sceneUpdateMs,
+        const double _mouseMs, const double _renderMs, const double _copyMs,
+        const double _totalMs);
+
+    /// \brief Steer the dynamic resolution scale toward dynResTargetMs,
+    /// shrinking the render target when frames run long and growing it
+    /// back when there is headroom. Only called while dynamicResolution
+    /// is enabled.
+    /// \param[in] _frameMs Total time of the frame just rendered
+    private: void UpdateRenderScale(const double _frameMs);
+
     /// \brief Retrieve the first point on a surface in the 3D scene hit by a
     /// ray cast from the given 2D screen coordinates.
     /// \param[in] _screenPos 2D coordinates on the screen, in pixels.
@@ -146,6 +238,49 @@ namespace plugins
     /// \brief Flag to indicate texture size has changed.
     public: bool textureDirty = false;
 
+    /// \brief True to only render frames when there is something to show:
+    /// a scene update, camera interaction or resize. A static scene then
+    /// renders at idleFps instead of a full core's worth of frames.
+    public: bool renderOnDemand = false;
+
+    /// \brief Frame rate floor used while the scene is idle, when
+    /// renderOnDemand is enabled.
+    public: double idleFps = 5.0;
+
+    /// \brief True to hide models that are behind the camera or beyond
+    /// maxDrawDistance.
+    public: bool viewCulling = false;
+
+    /// \brief Distance beyond which models are culled when viewCulling
+    /// is enabled. Unlimited by default.
+    public: double maxDrawDistance = -1.0;
+
+    /// \brief Texture residency budget in megabytes. Non-positive keeps
+    /// the scene manager's default.
+    public: double textureBudget = -1.0;
+
+    /// \brief Bitmask of visibility layers the camera renders. All
+    /// layers by default.
+    public: uint32_t visibilityMask = 0xffffffffu;
+
+    /// \brief True to adapt the render target size to hold the frame
+    /// time near dynResTargetMs, between half and full item size.
+    public: bool dynamicResolution = false;
+
+    /// \brief Frame time dynamic resolution steers toward, in ms
+    public: double dynResTargetMs = 16.0;
+
+    /// \brief Actual render target size: textureSize scaled by the
+    /// current dynamic resolution. Only the render thread touches it.
+    public: QSize renderSize = QSize(1024, 1024);
+
+    /// \brief Directory to continuously capture rendered frames into as
+    /// numbered PNG files. Capture is disabled while empty. Readback is
+    /// asynchronous (double-buffered pixel buffer objects, one frame
+    /// behind) and encoding happens on a separate writer thread, so the
+    /// render thread only pays for the GL transfer kickoff.
+    public: std::string capturePath;
+
     /// \brief Scene service. If not empty, a request will be made to get the
     /// scene information using this service and the renderer will populate the
     /// scene based on the response data
@@ -191,6 +326,21 @@ namespace plugins
     /// \param[in] _size Size of the texture
     signals: void TextureReady(int _id, const QSize &_size);
 
+    /// \brief Signal emitted when a new aggregate of frame timing
+    /// statistics is available
+    /// \param[in] _stats Per-stage timing averages and maxima in ms
+    signals: void FrameStats(const QVariantMap &_stats);
+
+    /// \brief Priority the thread is started with
+    public: QThread::Priority threadPriority = QThread::InheritPriority;
+
+    /// \brief CPU core to pin the thread to, or -1 to leave scheduling to
+    /// the OS. Applied from inside the thread on its first frame.
+    public: int threadAffinity = -1;
+
+    /// \brief True once the affinity setting has been applied
+    public: bool affinityApplied = false;
+
     /// \brief Offscreen surface to render to
     public: QOffscreenSurface *surface = nullptr;
 
@@ -207,6 +357,11 @@ namespace plugins
   {
     Q_OBJECT
 
+    /// \brief Latest aggregated frame timing statistics, for display in a
+    /// QML overlay
+    Q_PROPERTY(QVariantMap frameStats READ FrameStats
+        NOTIFY FrameStatsChanged)
+
     /// \brief Constructor
     /// \param[in] _parent Parent item
     public: explicit RenderWindowItem(QQuickItem *_parent = nullptr);
@@ -234,6 +389,62 @@ namespace plugins
     /// \param[in] _pose Initical camera pose
     public: void SetCameraPose(const math::Pose3d &_pose);
 
+    /// \brief Enable or disable render-on-demand mode
+    /// \param[in] _onDemand True to only render when the scene changed
+    public: void SetRenderOnDemand(const bool _onDemand);
+
+    /// \brief Set the frame rate used while the scene is idle in
+    /// render-on-demand mode
+    /// \param[in] _fps Idle frames per second
+    public: void SetIdleFps(const double _fps);
+
+    /// \brief Enable or disable view culling of off-screen models
+    /// \param[in] _enabled True to enable culling
+    public: void SetViewCulling(const bool _enabled);
+
+    /// \brief Set the distance beyond which models are culled when view
+    /// culling is enabled
+    /// \param[in] _distance Max draw distance in meters
+    public: void SetMaxDrawDistance(const double _distance);
+
+    /// \brief Set the texture residency budget
+    /// \param[in] _mb Budget in megabytes of estimated texture memory
+    public: void SetTextureBudget(const double _mb);
+
+    /// \brief Set the camera's visibility mask
+    /// \param[in] _mask Bitmask of visible layers
+    public: void SetVisibilityMask(const uint32_t _mask);
+
+    /// \brief Show or hide one visibility layer, keeping the others as
+    /// they are. Layer 1 holds collision visuals and layer 2 debug
+    /// markers.
+    /// \param[in] _layer Layer bit index, 0 to 31
+    /// \param[in] _visible True to show the layer
+    public: Q_INVOKABLE void SetLayerVisible(const int _layer,
+        const bool _visible);
+
+    /// \brief Enable or disable adaptive resolution scaling of the
+    /// render target
+    /// \param[in] _enabled True to enable dynamic resolution
+    public: void SetDynamicResolution(const bool _enabled);
+
+    /// \brief Set the frame time dynamic resolution steers toward
+    /// \param[in] _ms Target frame time in milliseconds
+    public: void SetTargetFrameTime(const double _ms);
+
+    /// \brief Set the scheduling priority the render thread starts with
+    /// \param[in] _priority Thread priority
+    public: void SetThreadPriority(const QThread::Priority _priority);
+
+    /// \brief Pin the render thread to a CPU core
+    /// \param[in] _core Core index, or -1 to leave scheduling to the OS
+    public: void SetThreadAffinity(const int _core);
+
+    /// \brief Set the directory to continuously capture rendered frames
+    /// into, creating it if needed
+    /// \param[in] _path Capture directory, empty to disable capture
+    public: void SetCapturePath(const std::string &_path);
+
     /// \brief Set scene service to use in this render window
     /// A service call will be made using ign-transport to get scene
     /// data using this service
@@ -257,9 +468,21 @@ namespace plugins
     /// \param[in] _topic Scene topic
     public: void SetSceneTopic(const std::string &_topic);
 
+    /// \brief Get the latest aggregated frame timing statistics
+    /// \return Per-stage timing averages and maxima in ms
+    public: QVariantMap FrameStats() const;
+
+    /// \brief Signal emitted when the frame timing statistics changed
+    signals: void FrameStatsChanged();
+
     /// \brief Slot called when thread is ready to be started
     public Q_SLOTS: void Ready();
 
+    /// \brief Slot called when the render thread produced a new frame
+    /// timing aggregate
+    /// \param[in] _stats Per-stage timing averages and maxima in ms
+    private Q_SLOTS: void OnFrameStats(const QVariantMap &_stats);
+
     // Documentation inherited
     protected: virtual void mousePressEvent(QMouseEvent *_e) override;
 
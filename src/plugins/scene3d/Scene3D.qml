@@ -35,6 +35,30 @@ Rectangle {
     anchors.fill: parent
   }
 
+  /*
+   * Visibility layer toggles. Each checkbox flips one bit of the
+   * camera's visibility mask, hiding a whole category of visuals at
+   * once.
+   */
+  Column {
+    anchors.top: parent.top
+    anchors.right: parent.right
+    anchors.margins: 10
+    spacing: -15
+
+    CheckBox {
+      text: qsTr("Collisions")
+      checked: true
+      onClicked: renderWindow.SetLayerVisible(1, checked)
+    }
+
+    CheckBox {
+      text: qsTr("Debug")
+      checked: true
+      onClicked: renderWindow.SetLayerVisible(2, checked)
+    }
+  }
+
   /*
    * Gamma correction for sRGB output. Enabled when engine is set to ogre2
    */
@@ -15,12 +15,40 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Profiler.hh>
+#include <ignition/common/Util.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/msgs/Factory.hh>
+
+#ifdef _MSC_VER
+#pragma warning(push, 0)
+#endif
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/text_format.h>
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
 
 #include "ignition/gui/Application.hh"
+#include "ignition/gui/Helpers.hh"
 #include "TopicEcho.hh"
 
 namespace ignition
@@ -29,27 +57,652 @@ namespace gui
 {
 namespace plugins
 {
+  /// \brief A filter expression compiled from its text form once, when
+  /// set, so evaluating it per message only walks field descriptors.
+  /// Two forms are supported:
+  ///
+  /// * predicate, e.g. "pose position x > 2.0" written as
+  ///   "pose.position.x > 2.0": messages whose field fails the
+  ///   comparison are dropped before any formatting.
+  /// * projection, e.g. "select: velocity": all messages pass, but only
+  ///   the given field is rendered.
+  struct FilterExpr
+  {
+    /// \brief Comparison operators for predicates
+    public: enum Op
+    {
+      /// \brief No comparison
+      NONE,
+      /// \brief Greater than
+      GT,
+      /// \brief Greater than or equal
+      GE,
+      /// \brief Less than
+      LT,
+      /// \brief Less than or equal
+      LE,
+      /// \brief Equal
+      EQ,
+      /// \brief Not equal
+      NE
+    };
+
+    /// \brief True when there is an expression to apply
+    public: bool active = false;
+
+    /// \brief True for projections, false for predicates
+    public: bool projection = false;
+
+    /// \brief Field path, one entry per nesting level
+    public: std::vector<std::string> path;
+
+    /// \brief Comparison operator, for predicates
+    public: Op op = NONE;
+
+    /// \brief Right-hand side value, for predicates
+    public: double value = 0.0;
+  };
+
+  /// \brief Strip leading and trailing whitespace
+  /// \param[in] _text Input text
+  /// \return Trimmed text
+  std::string TrimmedCopy(const std::string &_text)
+  {
+    auto begin = _text.find_first_not_of(" \t");
+    if (begin == std::string::npos)
+      return "";
+    auto end = _text.find_last_not_of(" \t");
+    return _text.substr(begin, end - begin + 1);
+  }
+
+  /// \brief Split a dotted field path into its components
+  /// \param[in] _path Path like "pose.position.x"
+  /// \return Components, empty if any component is empty
+  std::vector<std::string> SplitPath(const std::string &_path)
+  {
+    std::vector<std::string> result;
+    size_t begin = 0;
+    while (begin <= _path.size())
+    {
+      auto end = _path.find('.', begin);
+      if (end == std::string::npos)
+        end = _path.size();
+      auto component = TrimmedCopy(_path.substr(begin, end - begin));
+      if (component.empty())
+        return {};
+      result.push_back(component);
+      begin = end + 1;
+    }
+    return result;
+  }
+
+  /// \brief Compile a filter expression from text
+  /// \param[in] _text Expression text; empty deactivates filtering
+  /// \param[out] _expr Compiled expression
+  /// \return True if the text was understood
+  bool CompileFilter(const std::string &_text, FilterExpr &_expr)
+  {
+    _expr = FilterExpr();
+
+    auto text = TrimmedCopy(_text);
+    if (text.empty())
+      return true;
+
+    const std::string selectPrefix = "select:";
+    if (text.compare(0, selectPrefix.size(), selectPrefix) == 0)
+    {
+      _expr.path = SplitPath(text.substr(selectPrefix.size()));
+      if (_expr.path.empty())
+        return false;
+      _expr.projection = true;
+      _expr.active = true;
+      return true;
+    }
+
+    // two-character operators must be checked first
+    static const std::vector<std::pair<std::string, FilterExpr::Op>> ops =
+    {
+      {">=", FilterExpr::GE}, {"<=", FilterExpr::LE},
+      {"==", FilterExpr::EQ}, {"!=", FilterExpr::NE},
+      {">", FilterExpr::GT}, {"<", FilterExpr::LT}
+    };
+    for (const auto &op : ops)
+    {
+      auto pos = text.find(op.first);
+      if (pos == std::string::npos)
+        continue;
+
+      _expr.path = SplitPath(text.substr(0, pos));
+      if (_expr.path.empty())
+        return false;
+      try
+      {
+        _expr.value = std::stod(text.substr(pos + op.first.size()));
+      }
+      catch (const std::exception &)
+      {
+        return false;
+      }
+      _expr.op = op.second;
+      _expr.active = true;
+      return true;
+    }
+
+    // a bare field path acts as a projection
+    _expr.path = SplitPath(text);
+    if (_expr.path.empty())
+      return false;
+    _expr.projection = true;
+    _expr.active = true;
+    return true;
+  }
+
+  /// \brief Read a numeric field through reflection, without any string
+  /// conversion
+  /// \param[in] _msg Message to read from
+  /// \param[in] _path Field path
+  /// \param[out] _value Field value converted to double
+  /// \return True if the path leads to a numeric singular field
+  bool NumericField(const google::protobuf::Message &_msg,
+      const std::vector<std::string> &_path, double &_value)
+  {
+    namespace gp = google::protobuf;
+    const gp::Message *msg = &_msg;
+    for (size_t i = 0; i < _path.size(); ++i)
+    {
+      auto *field = msg->GetDescriptor()->FindFieldByName(_path[i]);
+      if (!field || field->is_repeated())
+        return false;
+
+      auto *reflection = msg->GetReflection();
+      if (i + 1 < _path.size())
+      {
+        if (field->cpp_type() != gp::FieldDescriptor::CPPTYPE_MESSAGE)
+          return false;
+        msg = &reflection->GetMessage(*msg, field);
+        continue;
+      }
+
+      switch (field->cpp_type())
+      {
+        case gp::FieldDescriptor::CPPTYPE_DOUBLE:
+          _value = reflection->GetDouble(*msg, field);
+          return true;
+        case gp::FieldDescriptor::CPPTYPE_FLOAT:
+          _value = reflection->GetFloat(*msg, field);
+          return true;
+        case gp::FieldDescriptor::CPPTYPE_INT32:
+          _value = reflection->GetInt32(*msg, field);
+          return true;
+        case gp::FieldDescriptor::CPPTYPE_INT64:
+          _value = reflection->GetInt64(*msg, field);
+          return true;
+        case gp::FieldDescriptor::CPPTYPE_UINT32:
+          _value = reflection->GetUInt32(*msg, field);
+          return true;
+        case gp::FieldDescriptor::CPPTYPE_UINT64:
+          _value = reflection->GetUInt64(*msg, field);
+          return true;
+        case gp::FieldDescriptor::CPPTYPE_BOOL:
+          _value = reflection->GetBool(*msg, field) ? 1.0 : 0.0;
+          return true;
+        case gp::FieldDescriptor::CPPTYPE_ENUM:
+          _value = reflection->GetEnumValue(*msg, field);
+          return true;
+        default:
+          return false;
+      }
+    }
+    return false;
+  }
+
+  /// \brief Evaluate a compiled predicate against a message
+  /// \param[in] _expr Compiled expression, must be an active predicate
+  /// \param[in] _msg Message to test
+  /// \return True if the message passes
+  bool EvalPredicate(const FilterExpr &_expr,
+      const google::protobuf::Message &_msg)
+  {
+    double value;
+    if (!NumericField(_msg, _expr.path, value))
+      return false;
+
+    switch (_expr.op)
+    {
+      case FilterExpr::GT:
+        return value > _expr.value;
+      case FilterExpr::GE:
+        return value >= _expr.value;
+      case FilterExpr::LT:
+        return value < _expr.value;
+      case FilterExpr::LE:
+        return value <= _expr.value;
+      case FilterExpr::EQ:
+        return ignition::math::equal(value, _expr.value);
+      case FilterExpr::NE:
+        return !ignition::math::equal(value, _expr.value);
+      default:
+        return true;
+    }
+  }
+
+  /// \brief Fixed-capacity list model backed by a ring buffer. Appending
+  /// and evicting are O(1): once full, the oldest row is overwritten in
+  /// place and a single dataChanged covering the window is emitted, so
+  /// high-rate topics don't shift the whole model and re-signal the view
+  /// per row the way QStringListModel::removeRows does.
+  ///
+  /// Rows hold the serialized message, not text: protobuf's DebugString
+  /// is by far the most expensive step of echoing, so it only runs when
+  /// the view actually asks for a row, and the result is cached until
+  /// the slot is overwritten.
+  class MsgRingModel : public QAbstractListModel
+  {
+    /// \brief A buffered message
+    public: struct Entry
+    {
+      /// \brief Serialized message
+      public: QByteArray data;
+
+      /// \brief Message type name, e.g. 'ignition.msgs.StringMsg'
+      public: QString type;
+
+      /// \brief Rendered text, filled on first display
+      public: mutable QString text;
+
+      /// \brief True once text has been rendered for the current data
+      public: mutable bool rendered = false;
+    };
+
+    // Documentation inherited
+    public: int rowCount(const QModelIndex &_parent = QModelIndex()) const
+        override
+    {
+      if (_parent.isValid())
+        return 0;
+      return this->count;
+    }
+
+    // Documentation inherited
+    public: QVariant data(const QModelIndex &_index, int _role) const
+        override
+    {
+      if (_role != Qt::DisplayRole || _index.row() < 0 ||
+          _index.row() >= this->count)
+      {
+        return QVariant();
+      }
+
+      const Entry &entry =
+          this->msgs[(this->head + _index.row()) % this->msgs.size()];
+      if (!entry.rendered)
+      {
+        auto msg = this->RenderMsg(entry.type.toStdString());
+        if (msg &&
+            msg->ParseFromArray(entry.data.constData(), entry.data.size()))
+        {
+          entry.text = this->projection.empty() ?
+              QString::fromStdString(msg->DebugString()) :
+              this->RenderProjection(*msg);
+        }
+        else
+        {
+          entry.text = tr("Unable to parse message of type [%1]")
+              .arg(entry.type);
+        }
+        entry.rendered = true;
+      }
+      return entry.text;
+    }
+
+    /// \brief Only render the given field instead of whole messages
+    /// \param[in] _path Field path, empty to render whole messages
+    public: void SetProjection(const std::vector<std::string> &_path)
+    {
+      this->projection = _path;
+
+      // already-buffered messages re-render on next display
+      for (auto &entry : this->msgs)
+        entry.rendered = false;
+      if (this->count > 0)
+        this->dataChanged(this->index(0), this->index(this->count - 1));
+    }
+
+    /// \brief Append a serialized message, evicting the oldest one when
+    /// full
+    /// \param[in] _data Serialized message
+    /// \param[in] _type Message type name
+    public: void Push(const QByteArray &_data, const QString &_type)
+    {
+      if (this->count < static_cast<int>(this->msgs.size()))
+      {
+        this->beginInsertRows(QModelIndex(), this->count, this->count);
+        auto &entry =
+            this->msgs[(this->head + this->count) % this->msgs.size()];
+        entry.data = _data;
+        entry.type = _type;
+        entry.rendered = false;
+        ++this->count;
+        this->endInsertRows();
+        return;
+      }
+
+      // overwrite the oldest row in place; to the view every row changed,
+      // but the structure didn't, so one coalesced signal is enough
+      auto &entry = this->msgs[this->head];
+      entry.data = _data;
+      entry.type = _type;
+      entry.rendered = false;
+      this->head = (this->head + 1) % this->msgs.size();
+      this->dataChanged(this->index(0), this->index(this->count - 1));
+    }
+
+    /// \brief Change how many messages are kept. Existing messages are
+    /// discarded.
+    /// \param[in] _capacity Maximum number of messages
+    public: void SetCapacity(const unsigned int _capacity)
+    {
+      this->beginResetModel();
+      this->msgs.assign(std::max(_capacity, 1u), Entry());
+      this->head = 0;
+      this->count = 0;
+      this->endResetModel();
+    }
+
+    /// \brief Discard all messages
+    public: void Clear()
+    {
+      this->beginResetModel();
+      this->head = 0;
+      this->count = 0;
+      this->endResetModel();
+    }
+
+    /// \brief Render the projected field of a message
+    /// \param[in] _msg Parsed message
+    /// \return Field text, or a short notice when the path doesn't fit
+    /// the message type
+    private: QString RenderProjection(const google::protobuf::Message &_msg)
+        const
+    {
+      namespace gp = google::protobuf;
+      const gp::Message *msg = &_msg;
+      const gp::FieldDescriptor *field = nullptr;
+      for (size_t i = 0; i < this->projection.size(); ++i)
+      {
+        auto component = QString::fromStdString(this->projection[i]);
+        field = msg->GetDescriptor()->FindFieldByName(this->projection[i]);
+        if (!field)
+        {
+          return tr("No field [%1] in type [%2]").arg(component,
+              QString::fromStdString(msg->GetTypeName()));
+        }
+        if (i + 1 < this->projection.size())
+        {
+          if (field->is_repeated() ||
+              field->cpp_type() != gp::FieldDescriptor::CPPTYPE_MESSAGE)
+          {
+            return tr("Can't descend into field [%1]").arg(component);
+          }
+          msg = &msg->GetReflection()->GetMessage(*msg, field);
+        }
+      }
+
+      if (!field->is_repeated() &&
+          field->cpp_type() == gp::FieldDescriptor::CPPTYPE_MESSAGE)
+      {
+        return QString::fromStdString(
+            msg->GetReflection()->GetMessage(*msg, field).DebugString());
+      }
+
+      std::string out;
+      if (field->is_repeated())
+      {
+        int size = msg->GetReflection()->FieldSize(*msg, field);
+        for (int i = 0; i < size; ++i)
+        {
+          std::string element;
+          gp::TextFormat::PrintFieldValueToString(*msg, field, i, &element);
+          out += element;
+          out += "\n";
+        }
+      }
+      else
+      {
+        gp::TextFormat::PrintFieldValueToString(*msg, field, -1, &out);
+      }
+      return QString::fromStdString(out);
+    }
+
+    /// \brief Get a scratch message of the given type to parse into,
+    /// reusing the previous one while the type doesn't change
+    /// \param[in] _type Message type name
+    /// \return Scratch message, or nullptr for unknown types
+    private: google::protobuf::Message *RenderMsg(const std::string &_type)
+        const
+    {
+      if (_type != this->renderType || !this->renderMsg)
+      {
+        this->renderMsg = msgs::Factory::New(_type);
+        this->renderType = _type;
+      }
+      return this->renderMsg.get();
+    }
+
+    /// \brief Message storage, sized to capacity
+    private: std::vector<Entry> msgs{10, Entry()};
+
+    /// \brief Index of the oldest message
+    private: int head = 0;
+
+    /// \brief Number of messages held
+    private: int count = 0;
+
+    /// \brief Field path to render instead of whole messages, empty for
+    /// no projection
+    private: std::vector<std::string> projection;
+
+    /// \brief Scratch message used to render text
+    private: mutable std::unique_ptr<google::protobuf::Message> renderMsg;
+
+    /// \brief Type of renderMsg
+    private: mutable std::string renderType;
+  };
+
+  /// \brief A serialized message captured while paused
+  struct CapturedMsg
+  {
+    /// \brief Serialized message
+    public: std::string data;
+
+    /// \brief Message type name
+    public: std::string type;
+  };
+
+  /// \brief Most messages the record queue holds before the subscriber
+  /// drops instead of blocking on the disk
+  static const std::size_t kRecordQueueCapacity{8192u};
+
+  /// \brief Size at which a recording file rotates to its next part,
+  /// in bytes
+  static const std::size_t kRecordFileMaxSize{64u * 1024u * 1024u};
+
+  /// \brief A message waiting for the background recorder
+  struct RecordedMsg
+  {
+    /// \brief Receive time, nanoseconds since the system clock epoch
+    public: int64_t stampNs = 0;
+
+    /// \brief Message type name
+    public: std::string type;
+
+    /// \brief Serialized message
+    public: std::string data;
+  };
+
   class TopicEchoPrivate
   {
     /// \brief Topic
     public: QString topic{"/echo"};
 
     /// \brief A list of text data.
-    public: QStringListModel msgList;
-
-    /// \brief Size of the text buffer. The size is the number of
-    /// messages.
-    public: unsigned int buffer{10u};
+    public: MsgRingModel msgList;
 
     /// \brief Flag used to pause message parsing.
     public: bool paused{false};
 
+    /// \brief Filter expression as typed by the user.
+    public: QString filterText;
+
+    /// \brief Compiled filter, applied before any formatting.
+    public: FilterExpr filter;
+
+    /// \brief Ring of messages captured while paused, so resuming shows
+    /// recent history instead of a gap. Written lock-free by the single
+    /// transport thread: the slot is filled first, then captureCount is
+    /// bumped with release ordering, so the drain on resume only reads
+    /// fully-written entries.
+    public: std::vector<CapturedMsg> captureRing{100};
+
+    /// \brief Messages captured since pausing
+    public: std::atomic<uint64_t> captureCount{0};
+
+    /// \brief Messages received since subscribing, paused or not
+    public: std::atomic<uint64_t> msgCount{0};
+
+    /// \brief Payload bytes received since subscribing
+    public: std::atomic<uint64_t> byteCount{0};
+
+    /// \brief Message rate over the last metering window, in msgs/s
+    public: double msgRate{0.0};
+
+    /// \brief Bandwidth over the last metering window, in MB/s
+    public: double bandwidth{0.0};
+
+    /// \brief Counter values at the end of the previous metering window
+    public: uint64_t lastMsgCount{0u};
+
+    /// \brief See lastMsgCount
+    public: uint64_t lastByteCount{0u};
+
+    /// \brief When the previous metering window ended
+    public: std::chrono::steady_clock::time_point lastRateTime;
+
     /// \brief Mutex to protect message buffer.
     public: std::mutex mutex;
 
     /// \brief Node for communication
     public: ignition::transport::Node node;
+
+    /// \brief True while recording to disk; read by the transport thread
+    public: std::atomic<bool> recording{false};
+
+    /// \brief Messages waiting for the writer, bounded by
+    /// kRecordQueueCapacity; newer messages are dropped when full so the
+    /// subscriber never blocks on the disk
+    public: std::deque<RecordedMsg> recordQueue;
+
+    /// \brief Mutex protecting recordQueue
+    public: std::mutex recordMutex;
+
+    /// \brief Wakes the writer when messages arrive or recording stops
+    public: std::condition_variable recordCv;
+
+    /// \brief Background writer thread
+    public: std::thread recordThread;
+
+    /// \brief Base path of the current recording, without the part
+    /// suffix
+    public: std::string recordBase;
+
+    /// \brief Index of the part file currently being written. Atomic
+    /// because the writer thread bumps it while the GUI thread shows it.
+    public: std::atomic<unsigned int> recordPart{0u};
+
+    /// \brief Messages written to disk since recording started
+    public: std::atomic<uint64_t> recordedCount{0};
+
+    /// \brief Messages dropped because the record queue was full
+    public: std::atomic<uint64_t> recordDroppedCount{0};
+
+    /// \brief Summary line shown in the panel while recording
+    public: QString recordInfo;
+
+    /// \brief Body of the background writer thread. Batches the queue
+    /// out under the lock, appends each message as a binary record
+    /// (receive stamp, length-prefixed type name, length-prefixed
+    /// payload) through the stream's buffer, and rotates to the next
+    /// part file at kRecordFileMaxSize.
+    public: void RecordLoop();
   };
+
+  /////////////////////////////////////////////////
+  void TopicEchoPrivate::RecordLoop()
+  {
+    std::ofstream file;
+    std::size_t fileSize = 0u;
+    std::deque<RecordedMsg> batch;
+
+    auto openPart = [&]()
+    {
+      const auto path = this->recordBase + "." +
+          std::to_string(this->recordPart.load(std::memory_order_relaxed)) +
+          ".tlog";
+      file.open(path, std::ios::binary | std::ios::trunc);
+      fileSize = 0u;
+      if (!file)
+        ignerr << "Can't open recording file [" << path << "]" << std::endl;
+      else
+        ignmsg << "Recording to [" << path << "]" << std::endl;
+    };
+    openPart();
+
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(this->recordMutex);
+        this->recordCv.wait(lock, [this]()
+            {
+              return !this->recordQueue.empty() ||
+                  !this->recording.load(std::memory_order_relaxed);
+            });
+        batch.swap(this->recordQueue);
+      }
+
+      for (const auto &msg : batch)
+      {
+        const uint32_t typeSize = msg.type.size();
+        const uint32_t dataSize = msg.data.size();
+        file.write(reinterpret_cast<const char *>(&msg.stampNs),
+            sizeof(msg.stampNs));
+        file.write(reinterpret_cast<const char *>(&typeSize),
+            sizeof(typeSize));
+        file.write(msg.type.data(), typeSize);
+        file.write(reinterpret_cast<const char *>(&dataSize),
+            sizeof(dataSize));
+        file.write(msg.data.data(), dataSize);
+        fileSize += sizeof(msg.stampNs) + sizeof(typeSize) +
+            sizeof(dataSize) + typeSize + dataSize;
+        this->recordedCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (fileSize >= kRecordFileMaxSize)
+        {
+          file.close();
+          ++this->recordPart;
+          openPart();
+        }
+      }
+      batch.clear();
+
+      if (!this->recording.load(std::memory_order_relaxed))
+      {
+        // the producer has stopped; one empty drain above means done
+        std::lock_guard<std::mutex> lock(this->recordMutex);
+        if (this->recordQueue.empty())
+          break;
+      }
+    }
+  }
 }
 }
 }
@@ -70,6 +723,16 @@ TopicEcho::TopicEcho()
 /////////////////////////////////////////////////
 TopicEcho::~TopicEcho()
 {
+  this->SetRecording(false);
+}
+
+/////////////////////////////////////////////////
+void TopicEcho::Shutdown()
+{
+  // Transport-only cleanup, this runs on a teardown worker thread
+  // while the object is destroyed later on the GUI thread
+  for (auto const &sub : this->dataPtr->node.SubscribedTopics())
+    this->dataPtr->node.Unsubscribe(sub);
 }
 
 /////////////////////////////////////////////////
@@ -78,8 +741,17 @@ void TopicEcho::LoadConfig(const tinyxml2::XMLElement */*_pluginElem*/)
   if (this->title.empty())
     this->title = "Topic echo";
 
-  this->connect(this, SIGNAL(AddMsg(QString)), this, SLOT(OnAddMsg(QString)),
-          Qt::QueuedConnection);
+  this->connect(this, SIGNAL(AddMsg(QByteArray, QString)), this,
+          SLOT(OnAddMsg(QByteArray, QString)), Qt::QueuedConnection);
+
+  this->dataPtr->lastRateTime = std::chrono::steady_clock::now();
+
+  // Rate updates once a second, on the wakeup shared with the other
+  // plugins' periodic refreshes
+  App()->AddUpdateCallback(this, 1000, [this]()
+  {
+    this->UpdateRates();
+  });
 }
 
 /////////////////////////////////////////////////
@@ -88,8 +760,7 @@ void TopicEcho::Stop()
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Erase all previous messages
-  this->dataPtr->msgList.removeRows(0,
-      this->dataPtr->msgList.rowCount());
+  this->dataPtr->msgList.Clear();
 
   // Unsubscribe
   for (auto const &sub : this->dataPtr->node.SubscribedTopics())
@@ -117,31 +788,77 @@ void TopicEcho::OnEcho(const bool _checked)
 /////////////////////////////////////////////////
 void TopicEcho::OnMessage(const google::protobuf::Message &_msg)
 {
+  IGN_PROFILE("TopicEcho::OnMessage");
+
+  this->dataPtr->msgCount.fetch_add(1, std::memory_order_relaxed);
+  this->dataPtr->byteCount.fetch_add(_msg.ByteSizeLong(),
+      std::memory_order_relaxed);
+
+  // Recording spools the raw serialized message to the background
+  // writer; the callback only pays for the serialization and an
+  // enqueue, and drops instead of blocking when the writer is behind
+  if (this->dataPtr->recording.load(std::memory_order_relaxed))
+  {
+    RecordedMsg record;
+    record.stampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record.type = _msg.GetTypeName();
+    _msg.SerializeToString(&record.data);
+
+    bool enqueued = false;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->recordMutex);
+      if (this->dataPtr->recordQueue.size() < kRecordQueueCapacity)
+      {
+        this->dataPtr->recordQueue.push_back(std::move(record));
+        enqueued = true;
+      }
+    }
+    if (enqueued)
+      this->dataPtr->recordCv.notify_one();
+    else
+      this->dataPtr->recordDroppedCount.fetch_add(1,
+          std::memory_order_relaxed);
+  }
+
   if (this->dataPtr->paused)
+  {
+    // capture into the ring without taking any lock, so pausing keeps
+    // the subscriber near-free no matter the rate
+    auto &slot = this->dataPtr->captureRing[
+        this->dataPtr->captureCount.load(std::memory_order_relaxed) %
+        this->dataPtr->captureRing.size()];
+    slot.type = _msg.GetTypeName();
+    _msg.SerializeToString(&slot.data);
+    this->dataPtr->captureCount.fetch_add(1, std::memory_order_release);
     return;
+  }
 
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  this->AddMsg(QString::fromStdString(_msg.DebugString()));
+  // Drop non-matching messages here, on the binary message, before
+  // paying for serialization or any string conversion
+  if (this->dataPtr->filter.active && !this->dataPtr->filter.projection &&
+      !EvalPredicate(this->dataPtr->filter, _msg))
+  {
+    return;
+  }
+
+  // Only serialize here: turning the message into text costs orders of
+  // magnitude more and is deferred until the view displays the row
+  std::string data;
+  _msg.SerializeToString(&data);
+  this->AddMsg(QByteArray(data.c_str(), data.size()),
+      internedQString(_msg.GetTypeName()));
 }
 
 /////////////////////////////////////////////////
-void TopicEcho::OnAddMsg(QString _msg)
+void TopicEcho::OnAddMsg(QByteArray _data, QString _type)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  // Append msg to list
-  if (this->dataPtr->msgList.insertRow(this->dataPtr->msgList.rowCount()))
-  {
-    auto index = this->dataPtr->msgList.index(
-        this->dataPtr->msgList.rowCount() - 1, 0);
-    this->dataPtr->msgList.setData(index, _msg);
-  }
-
-  // Remove items if the list is too long.
-  auto diff = this->dataPtr->msgList.rowCount() -
-      this->dataPtr->buffer;
-  this->dataPtr->msgList.removeRows(0, diff);
+  // Append msg to list; the model evicts the oldest one when full
+  this->dataPtr->msgList.Push(_data, _type);
 }
 
 /////////////////////////////////////////////////
@@ -157,10 +874,34 @@ void TopicEcho::SetTopic(const QString &_topic)
   this->TopicChanged();
 }
 
+/////////////////////////////////////////////////
+QString TopicEcho::Filter() const
+{
+  return this->dataPtr->filterText;
+}
+
+/////////////////////////////////////////////////
+void TopicEcho::SetFilter(const QString &_filter)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->filterText = _filter;
+    if (!CompileFilter(_filter.toStdString(), this->dataPtr->filter))
+    {
+      ignwarn << "Can't parse filter [" << _filter.toStdString()
+              << "], showing all messages." << std::endl;
+    }
+    this->dataPtr->msgList.SetProjection(this->dataPtr->filter.projection ?
+        this->dataPtr->filter.path : std::vector<std::string>());
+  }
+  this->FilterChanged();
+}
+
 /////////////////////////////////////////////////
 void TopicEcho::OnBuffer(const unsigned int _buffer)
 {
-  this->dataPtr->buffer = _buffer;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->msgList.SetCapacity(_buffer);
 }
 
 /////////////////////////////////////////////////
@@ -173,10 +914,139 @@ bool TopicEcho::Paused() const
 /////////////////////////////////////////////////
 void TopicEcho::SetPaused(const bool &_paused)
 {
+  const bool resuming = this->dataPtr->paused && !_paused;
+
+  if (_paused)
+    this->dataPtr->captureCount.store(0, std::memory_order_relaxed);
+
+  // flip the flag first so the subscriber goes back to signaling; the
+  // drain below only trusts entries published before the acquire load
   this->dataPtr->paused = _paused;
+
+  if (resuming)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    const uint64_t end =
+        this->dataPtr->captureCount.load(std::memory_order_acquire);
+    const uint64_t size = this->dataPtr->captureRing.size();
+
+    // A capture that passed the paused check just before the flip may
+    // still be writing slot end % size — the same slot as the oldest
+    // retained entry once the ring has wrapped. Sacrifice that one
+    // entry instead of reading a string while it's being assigned.
+    for (uint64_t i = end > size ? end - size + 1 : 0; i < end; ++i)
+    {
+      const auto &slot = this->dataPtr->captureRing[i % size];
+      this->dataPtr->msgList.Push(
+          QByteArray(slot.data.c_str(), slot.data.size()),
+          internedQString(slot.type));
+    }
+  }
+
   this->PausedChanged();
 }
 
+/////////////////////////////////////////////////
+bool TopicEcho::Recording() const
+{
+  return this->dataPtr->recording.load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void TopicEcho::SetRecording(const bool &_recording)
+{
+  if (_recording == this->dataPtr->recording.load(std::memory_order_relaxed))
+    return;
+
+  if (_recording)
+  {
+    // one file set per recording, named after the topic and start time
+    std::string home;
+    common::env(IGN_HOMEDIR, home);
+    const auto dir = common::joinPaths(home, ".ignition", "gui",
+        "recordings");
+    common::createDirectories(dir);
+
+    auto topic = this->dataPtr->topic.toStdString();
+    std::replace(topic.begin(), topic.end(), '/', '_');
+    const auto stamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    this->dataPtr->recordBase = common::joinPaths(dir,
+        "topic_echo" + topic + "_" + std::to_string(stamp));
+    this->dataPtr->recordPart = 0u;
+    this->dataPtr->recordedCount.store(0, std::memory_order_relaxed);
+    this->dataPtr->recordDroppedCount.store(0, std::memory_order_relaxed);
+
+    this->dataPtr->recording.store(true, std::memory_order_relaxed);
+    this->dataPtr->recordThread = std::thread(&TopicEchoPrivate::RecordLoop,
+        this->dataPtr.get());
+  }
+  else
+  {
+    this->dataPtr->recording.store(false, std::memory_order_relaxed);
+    this->dataPtr->recordCv.notify_one();
+    if (this->dataPtr->recordThread.joinable())
+      this->dataPtr->recordThread.join();
+
+    this->dataPtr->recordInfo.clear();
+    this->RecordInfoChanged();
+  }
+
+  this->RecordingChanged();
+}
+
+/////////////////////////////////////////////////
+QString TopicEcho::RecordInfo() const
+{
+  return this->dataPtr->recordInfo;
+}
+
+/////////////////////////////////////////////////
+double TopicEcho::MsgRate() const
+{
+  return this->dataPtr->msgRate;
+}
+
+/////////////////////////////////////////////////
+double TopicEcho::Bandwidth() const
+{
+  return this->dataPtr->bandwidth;
+}
+
+/////////////////////////////////////////////////
+void TopicEcho::UpdateRates()
+{
+  const auto now = std::chrono::steady_clock::now();
+  const double elapsed = std::chrono::duration<double>(
+      now - this->dataPtr->lastRateTime).count();
+  if (elapsed <= 0.0)
+    return;
+
+  const uint64_t msgs = this->dataPtr->msgCount.load(
+      std::memory_order_relaxed);
+  const uint64_t bytes = this->dataPtr->byteCount.load(
+      std::memory_order_relaxed);
+
+  this->dataPtr->msgRate = (msgs - this->dataPtr->lastMsgCount) / elapsed;
+  this->dataPtr->bandwidth =
+      (bytes - this->dataPtr->lastByteCount) / elapsed / 1e6;
+
+  this->dataPtr->lastMsgCount = msgs;
+  this->dataPtr->lastByteCount = bytes;
+  this->dataPtr->lastRateTime = now;
+  this->RateChanged();
+
+  if (this->dataPtr->recording.load(std::memory_order_relaxed))
+  {
+    this->dataPtr->recordInfo = tr("Recorded %1 msgs (%2 dropped), part %3")
+        .arg(this->dataPtr->recordedCount.load(std::memory_order_relaxed))
+        .arg(this->dataPtr->recordDroppedCount.load(
+            std::memory_order_relaxed))
+        .arg(this->dataPtr->recordPart);
+    this->RecordInfoChanged();
+  }
+}
+
 // Register this plugin
 IGNITION_ADD_PLUGIN(ignition::gui::plugins::TopicEcho,
                     ignition::gui::Plugin)
@@ -62,6 +62,45 @@ namespace plugins
       NOTIFY PausedChanged
     )
 
+    /// \brief Filter expression, either a predicate like
+    /// "pose.position.x > 2.0" or a projection like "select: velocity"
+    Q_PROPERTY(
+      QString filter
+      READ Filter
+      WRITE SetFilter
+      NOTIFY FilterChanged
+    )
+
+    /// \brief True while messages are being recorded to disk
+    Q_PROPERTY(
+      bool recording
+      READ Recording
+      WRITE SetRecording
+      NOTIFY RecordingChanged
+    )
+
+    /// \brief One-line summary of the recording: file, messages written
+    /// and dropped. Empty while not recording.
+    Q_PROPERTY(
+      QString recordInfo
+      READ RecordInfo
+      NOTIFY RecordInfoChanged
+    )
+
+    /// \brief Message rate over the last second, in msgs/s
+    Q_PROPERTY(
+      double msgRate
+      READ MsgRate
+      NOTIFY RateChanged
+    )
+
+    /// \brief Bandwidth over the last second, in MB/s
+    Q_PROPERTY(
+      double bandwidth
+      READ Bandwidth
+      NOTIFY RateChanged
+    )
+
     /// \brief Constructor
     public: TopicEcho();
 
@@ -71,6 +110,9 @@ namespace plugins
     // Documentation inherited
     public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem);
 
+    // Documentation inherited
+    public: virtual void Shutdown();
+
     /// \brief Get the topic as a string, for example
     /// '/echo'
     /// \return Topic
@@ -84,6 +126,19 @@ namespace plugins
     /// \brief Notify that topic has changed
     signals: void TopicChanged();
 
+    /// \brief Get the filter expression
+    /// \return Filter expression
+    public: Q_INVOKABLE QString Filter() const;
+
+    /// \brief Set the filter expression. Predicates drop non-matching
+    /// messages before any formatting; projections render only the
+    /// given field.
+    /// \param[in] _filter Filter expression, empty to show everything
+    public: Q_INVOKABLE void SetFilter(const QString &_filter);
+
+    /// \brief Notify that the filter has changed
+    signals: void FilterChanged();
+
     public slots: void OnBuffer(const unsigned int _steps);
 
     /// \brief Get whether it is paused
@@ -97,9 +152,44 @@ namespace plugins
     /// \brief Notify that paused has changed
     signals: void PausedChanged();
 
+    /// \brief Get whether messages are being recorded to disk
+    /// \return True if recording
+    public: Q_INVOKABLE bool Recording() const;
+
+    /// \brief Start or stop recording messages to disk. Raw serialized
+    /// messages are spooled through a bounded queue to a background
+    /// writer, so the subscriber only pays for an enqueue.
+    /// \param[in] _recording True to record
+    public: Q_INVOKABLE void SetRecording(const bool &_recording);
+
+    /// \brief Notify that recording has changed
+    signals: void RecordingChanged();
+
+    /// \brief Get the recording summary line
+    /// \return Summary text, empty while not recording
+    public: Q_INVOKABLE QString RecordInfo() const;
+
+    /// \brief Notify that the recording summary has been updated
+    signals: void RecordInfoChanged();
+
+    /// \brief Get the message rate over the last second
+    /// \return Rate in msgs/s
+    public: Q_INVOKABLE double MsgRate() const;
+
+    /// \brief Get the bandwidth over the last second
+    /// \return Bandwidth in MB/s
+    public: Q_INVOKABLE double Bandwidth() const;
+
+    /// \brief Notify that the rate and bandwidth have been updated
+    signals: void RateChanged();
+
+    /// \brief Recompute rate and bandwidth from the message counters.
+    private slots: void UpdateRates();
+
     /// \brief Signal to add a message to the GUI list.
-    /// \param[in] _msg Text message to add.
-    signals: void AddMsg(QString _msg);
+    /// \param[in] _data Serialized message to add.
+    /// \param[in] _type Message type name.
+    signals: void AddMsg(QByteArray _data, QString _type);
 
     /// \brief Receives incoming text messages.
     /// \param[in] _msg New text message.
@@ -112,8 +202,9 @@ namespace plugins
     public slots: void OnEcho(const bool _checked);
 
     /// \brief Callback from the ::AddMsg signal.
-    /// \param[in] _msg Message to add to the list.
-    private slots: void OnAddMsg(QString _msg);
+    /// \param[in] _data Serialized message to add to the list.
+    /// \param[in] _type Message type name.
+    private slots: void OnAddMsg(QByteArray _data, QString _type);
 
     /// \internal
     /// \brief Pointer to private data.
@@ -58,6 +58,25 @@ Rectangle {
       }
     }
 
+    Label {
+      text: "Filter"
+    }
+
+    TextField {
+      id: filterField
+      width: topicEcho.parent.width - 20
+      text: TopicEcho.filter
+      placeholderText: qsTr("e.g. pose.position.x > 2.0 or select: velocity")
+      selectByMouse: true
+      onEditingFinished: {
+        TopicEcho.filter = text
+      }
+      ToolTip.visible: hovered
+      ToolTip.delay: tooltipDelay
+      ToolTip.timeout: tooltipTimeout
+      ToolTip.text: qsTr("Drop messages failing a comparison, or show only one field")
+    }
+
     Label {
       text: "Buffer"
     }
@@ -70,12 +89,37 @@ Rectangle {
       }
     }
 
-    CheckBox {
-      text: qsTr("Pause")
-      checked: TopicEcho.paused
-      onClicked: {
-        TopicEcho.SetPaused(checked)
+    Row {
+      CheckBox {
+        text: qsTr("Pause")
+        checked: TopicEcho.paused
+        onClicked: {
+          TopicEcho.SetPaused(checked)
+        }
       }
+
+      CheckBox {
+        text: qsTr("Record")
+        checked: TopicEcho.recording
+        onClicked: {
+          TopicEcho.SetRecording(checked)
+        }
+        ToolTip.visible: hovered
+        ToolTip.delay: tooltipDelay
+        ToolTip.timeout: tooltipTimeout
+        ToolTip.text: qsTr("Spool raw serialized messages to rotating files under ~/.ignition/gui/recordings")
+      }
+    }
+
+    Label {
+      visible: TopicEcho.recordInfo.length > 0
+      text: TopicEcho.recordInfo
+    }
+
+    Label {
+      id: rateLabel
+      text: TopicEcho.msgRate.toFixed(1) + " msgs/s  " +
+            TopicEcho.bandwidth.toFixed(2) + " MB/s"
     }
 
     Label {
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <ignition/common/Console.hh>
+#include <ignition/plugin/Register.hh>
+
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/SubscriptionStats.hh"
+#include "TopicStats.hh"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class TopicStatsPrivate
+  {
+    /// \brief Current stats table, one map per subscription
+    public: QVariantList stats;
+
+    /// \brief Table refresh rate, in Hz
+    public: double updateRate{1.0};
+  };
+}
+}
+}
+
+using namespace ignition;
+using namespace gui;
+using namespace plugins;
+
+/////////////////////////////////////////////////
+TopicStats::TopicStats()
+  : Plugin(), dataPtr(new TopicStatsPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+TopicStats::~TopicStats()
+{
+}
+
+/////////////////////////////////////////////////
+void TopicStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
+{
+  // Default name in case user didn't define one
+  if (this->title.empty())
+    this->title = "Topic stats";
+
+  if (_pluginElem)
+  {
+    if (auto rateElem = _pluginElem->FirstChildElement("update_rate"))
+    {
+      rateElem->QueryDoubleText(&this->dataPtr->updateRate);
+      if (this->dataPtr->updateRate <= 0.0)
+      {
+        ignwarn << "Ignoring <update_rate> [" << this->dataPtr->updateRate
+                << "], must be positive." << std::endl;
+        this->dataPtr->updateRate = 1.0;
+      }
+    }
+  }
+
+  // Refresh on the wakeup shared with the other plugins' periodic
+  // updates
+  App()->AddUpdateCallback(this,
+      static_cast<int>(1000.0 / this->dataPtr->updateRate), [this]()
+      {
+        this->UpdateStats();
+      });
+
+  this->UpdateStats();
+}
+
+/////////////////////////////////////////////////
+QVariantList TopicStats::Stats() const
+{
+  return this->dataPtr->stats;
+}
+
+/////////////////////////////////////////////////
+void TopicStats::UpdateStats()
+{
+  auto app = App();
+  if (nullptr == app)
+    return;
+
+  QVariantList stats;
+  for (const auto &metrics : app->SubscriptionMetrics()->AllMetrics())
+  {
+    QVariantMap row;
+    row["topic"] = QString::fromStdString(metrics->topic);
+    row["label"] = QString::fromStdString(metrics->label);
+    row["count"] = static_cast<qulonglong>(metrics->execution.Count());
+    row["execP50"] = metrics->execution.PercentileMs(50.0);
+    row["execP99"] = metrics->execution.PercentileMs(99.0);
+    row["execMax"] = metrics->execution.MaxMs();
+    row["queueP50"] = metrics->queueDelay.PercentileMs(50.0);
+    row["queueP99"] = metrics->queueDelay.PercentileMs(99.0);
+    row["queueMax"] = metrics->queueDelay.MaxMs();
+    stats.append(row);
+  }
+
+  this->dataPtr->stats = stats;
+  this->StatsChanged();
+}
+
+// Register this plugin
+IGNITION_ADD_PLUGIN(ignition::gui::plugins::TopicStats,
+                    ignition::gui::Plugin)
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_GUI_PLUGINS_TOPICSTATS_HH_
+#define IGNITION_GUI_PLUGINS_TOPICSTATS_HH_
+
+#include <memory>
+
+#include "ignition/gui/Plugin.hh"
+
+namespace ignition
+{
+namespace gui
+{
+namespace plugins
+{
+  class TopicStatsPrivate;
+
+  /// \brief Live table of callback latency metrics for every
+  /// subscription made through Application::Subscribe. Each row shows
+  /// the topic, the subscribing plugin, the message count and
+  /// percentiles of both callback execution time and GUI queue delay,
+  /// so the plugin dragging a laggy interface down can be spotted at a
+  /// glance.
+  ///
+  /// ## Configuration
+  ///
+  /// * \<update_rate\> : Table refresh rate in Hz, defaults to 1.
+  class TopicStats : public Plugin
+  {
+    Q_OBJECT
+
+    /// \brief Stats table
+    Q_PROPERTY(
+      QVariantList stats
+      READ Stats
+      NOTIFY StatsChanged
+    )
+
+    /// \brief Constructor
+    public: TopicStats();
+
+    /// \brief Destructor
+    public: virtual ~TopicStats();
+
+    // Documentation inherited
+    public: virtual void LoadConfig(const tinyxml2::XMLElement *_pluginElem);
+
+    /// \brief Get the stats table, one map per subscription.
+    /// \return The table.
+    public: QVariantList Stats() const;
+
+    /// \brief Notify that the stats table changed.
+    signals: void StatsChanged();
+
+    /// \brief Rebuild the table from the metrics registry.
+    public slots: void UpdateStats();
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<TopicStatsPrivate> dataPtr;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+import QtQuick.Layouts 1.3
+
+Rectangle {
+  id: topicStats
+  color: "transparent"
+  Layout.minimumWidth: 550
+  Layout.minimumHeight: 200
+
+  // Column widths, shared by the header and the rows
+  property int topicWidth: 170
+  property int labelWidth: 110
+  property int countWidth: 60
+  property int msWidth: 50
+
+  function ms(value) {
+    return value.toFixed(value < 10 ? 2 : 1)
+  }
+
+  ColumnLayout {
+    anchors.fill: parent
+    anchors.margins: 10
+    spacing: 0
+
+    RowLayout {
+      Label {
+        text: "Topic / plugin"
+        font.bold: true
+        Layout.preferredWidth: topicWidth + labelWidth
+      }
+      Label {
+        text: "Msgs"
+        font.bold: true
+        Layout.preferredWidth: countWidth
+      }
+      Label {
+        text: "Exec p50/p99/max (ms)"
+        font.bold: true
+        Layout.preferredWidth: 3 * msWidth
+      }
+      Label {
+        text: "Queue p50/p99/max (ms)"
+        font.bold: true
+        Layout.fillWidth: true
+      }
+    }
+
+    ListView {
+      id: statsView
+      Layout.fillWidth: true
+      Layout.fillHeight: true
+      clip: true
+      model: TopicStats.stats
+
+      ScrollBar.vertical: ScrollBar {
+        policy: ScrollBar.AsNeeded
+      }
+
+      delegate: RowLayout {
+        width: statsView.width
+        Column {
+          Layout.preferredWidth: topicWidth + labelWidth
+          Label {
+            text: modelData.topic
+            elide: Text.ElideMiddle
+            width: parent.width
+          }
+          Label {
+            text: modelData.label
+            font.pixelSize: 10
+            opacity: 0.7
+            elide: Text.ElideRight
+            width: parent.width
+          }
+        }
+        Label {
+          text: modelData.count
+          Layout.preferredWidth: countWidth
+        }
+        Label {
+          text: ms(modelData.execP50) + " / " + ms(modelData.execP99) +
+              " / " + ms(modelData.execMax)
+          Layout.preferredWidth: 3 * msWidth
+        }
+        Label {
+          text: ms(modelData.queueP50) + " / " + ms(modelData.queueP99) +
+              " / " + ms(modelData.queueMax)
+          Layout.fillWidth: true
+        }
+      }
+    }
+
+    Label {
+      visible: statsView.count === 0
+      text: "No instrumented subscriptions yet"
+      font.italic: true
+    }
+  }
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <ignition/common/Console.hh>
+#include <ignition/msgs/stringmsg.pb.h>
+#include <ignition/transport/Node.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/Plugin.hh"
+#include "ignition/gui/MainWindow.hh"
+#include "TopicStats.hh"
+
+int g_argc = 1;
+char **g_argv = new char *[g_argc];
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+TEST(TopicStatsTest, Load)
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  EXPECT_TRUE(app.LoadPlugin("TopicStats"));
+
+  // Get main window
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  // Get plugin
+  auto plugins = win->findChildren<Plugin *>();
+  EXPECT_EQ(plugins.size(), 1);
+
+  auto plugin = plugins[0];
+  EXPECT_EQ(plugin->Title(), "Topic stats");
+
+  // Cleanup
+  plugins.clear();
+}
+
+/////////////////////////////////////////////////
+TEST(TopicStatsTest, Stats)
+{
+  common::Console::SetVerbosity(4);
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  EXPECT_TRUE(app.LoadPlugin("TopicStats"));
+
+  // Get plugin
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  auto plugins = win->findChildren<plugins::TopicStats *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  // No instrumented subscriptions yet
+  EXPECT_TRUE(plugin->Stats().isEmpty());
+
+  // An instrumented subscription
+  bool received{false};
+  EXPECT_TRUE(app.Subscribe<msgs::StringMsg>("/topic_stats_test",
+      "Test subscriber", [&received](const msgs::StringMsg &)
+      {
+        received = true;
+      }));
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::StringMsg>("/topic_stats_test");
+
+  msgs::StringMsg msg;
+  msg.set_data("hello");
+  pub.Publish(msg);
+
+  int sleep = 0;
+  int maxSleep = 30;
+  while (!received && sleep < maxSleep)
+  {
+    QCoreApplication::processEvents();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sleep++;
+  }
+  EXPECT_TRUE(received);
+
+  // The subscription shows up with its message counted
+  plugin->UpdateStats();
+  auto stats = plugin->Stats();
+  ASSERT_EQ(stats.size(), 1);
+  auto row = stats[0].toMap();
+  EXPECT_EQ(row["topic"].toString(), "/topic_stats_test");
+  EXPECT_EQ(row["label"].toString(), "Test subscriber");
+  EXPECT_GE(row["count"].toULongLong(), 1u);
+  EXPECT_GT(row["execMax"].toDouble(), 0.0);
+
+  // Cleanup
+  plugins.clear();
+}
@@ -15,7 +15,10 @@
  *
 */
 
+#include <chrono>
+
 #include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/common/Time.hh>
 
@@ -46,6 +49,23 @@ namespace plugins
 
     /// \brief True for paused
     public: bool pause{true};
+
+    /// \brief True while a play or pause request is awaiting its
+    /// response. Stats arriving meanwhile still carry the old state,
+    /// so reconciliation is held off until the response lands.
+    public: bool controlInFlight{false};
+
+    /// \brief True while a step request is waiting for its response.
+    /// Only one request is in flight at a time; further steps coalesce
+    /// into pendingSteps.
+    public: bool stepInFlight{false};
+
+    /// \brief Steps requested while a request was in flight
+    public: unsigned int pendingSteps{0u};
+
+    /// \brief Round-trip time of the last completed control request,
+    /// in milliseconds
+    public: double latency{0.0};
   };
 }
 }
@@ -142,8 +162,16 @@ void WorldControl::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 /////////////////////////////////////////////////
 void WorldControl::ProcessMsg()
 {
+  IGN_PROFILE("WorldControl::ProcessMsg");
+
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
 
+  // The UI already flipped optimistically when the button was clicked;
+  // stats published before the server processed the request would snap
+  // it back, so reconciliation waits for the response
+  if (this->dataPtr->controlInFlight)
+    return;
+
   if (!this->dataPtr->pause && this->dataPtr->msg.paused())
     this->paused();
   else if (this->dataPtr->pause && !this->dataPtr->msg.paused())
@@ -163,32 +191,70 @@ void WorldControl::OnWorldStatsMsg(const ignition::msgs::WorldStatistics &_msg)
 /////////////////////////////////////////////////
 void WorldControl::OnPlay()
 {
+  // Flip the UI on the click, not on the round trip; the response
+  // below only has to undo it in the rare failure case
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->pause = false;
+    this->dataPtr->controlInFlight = true;
+  }
+  this->playing();
+
+  const auto start = std::chrono::steady_clock::now();
   std::function<void(const ignition::msgs::Boolean &, const bool)> cb =
-      [this](const ignition::msgs::Boolean &/*_rep*/, const bool _result)
+      [this, start](const ignition::msgs::Boolean &/*_rep*/,
+      const bool _result)
   {
-    if (_result)
-      QMetaObject::invokeMethod(this, "playing");
+    QMetaObject::invokeMethod(this, "SetLatency", Qt::QueuedConnection,
+        Q_ARG(double, std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count()));
+
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->controlInFlight = false;
+    if (!_result)
+    {
+      ignwarn << "Play request failed, reverting to paused" << std::endl;
+      this->dataPtr->pause = true;
+      QMetaObject::invokeMethod(this, "paused");
+    }
   };
 
   ignition::msgs::WorldControl req;
   req.set_pause(false);
-  this->dataPtr->pause = false;
   this->dataPtr->node.Request(this->dataPtr->controlService, req, cb);
 }
 
 /////////////////////////////////////////////////
 void WorldControl::OnPause()
 {
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->pause = true;
+    this->dataPtr->controlInFlight = true;
+  }
+  this->paused();
+
+  const auto start = std::chrono::steady_clock::now();
   std::function<void(const ignition::msgs::Boolean &, const bool)> cb =
-      [this](const ignition::msgs::Boolean &/*_rep*/, const bool _result)
+      [this, start](const ignition::msgs::Boolean &/*_rep*/,
+      const bool _result)
   {
-    if (_result)
-      QMetaObject::invokeMethod(this, "paused");
+    QMetaObject::invokeMethod(this, "SetLatency", Qt::QueuedConnection,
+        Q_ARG(double, std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count()));
+
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->controlInFlight = false;
+    if (!_result)
+    {
+      ignwarn << "Pause request failed, reverting to playing" << std::endl;
+      this->dataPtr->pause = false;
+      QMetaObject::invokeMethod(this, "playing");
+    }
   };
 
   ignition::msgs::WorldControl req;
   req.set_pause(true);
-  this->dataPtr->pause = true;
   this->dataPtr->node.Request(this->dataPtr->controlService, req, cb);
 }
 
@@ -201,17 +267,56 @@ void WorldControl::OnStepCount(const unsigned int _steps)
 /////////////////////////////////////////////////
 void WorldControl::OnStep()
 {
-  std::function<void(const ignition::msgs::Boolean &, const bool)> cb =
-      [](const ignition::msgs::Boolean &/*_rep*/, const bool /*_result*/)
-  {
-  };
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
 
+  // Rapid stepping used to queue one request per click; instead,
+  // accumulate while a request is in flight and let its response send
+  // everything pending as one multi-step request
+  this->dataPtr->pendingSteps += this->dataPtr->multiStep;
+  if (!this->dataPtr->stepInFlight)
+    this->SendPendingSteps();
+}
+
+/////////////////////////////////////////////////
+void WorldControl::SendPendingSteps()
+{
+  // caller holds the mutex
   ignition::msgs::WorldControl req;
   req.set_pause(this->dataPtr->pause);
-  req.set_multi_step(this->dataPtr->multiStep);
+  req.set_multi_step(this->dataPtr->pendingSteps);
+  this->dataPtr->pendingSteps = 0u;
+  this->dataPtr->stepInFlight = true;
+
+  const auto start = std::chrono::steady_clock::now();
+  std::function<void(const ignition::msgs::Boolean &, const bool)> cb =
+      [this, start](const ignition::msgs::Boolean &/*_rep*/,
+      const bool /*_result*/)
+  {
+    QMetaObject::invokeMethod(this, "SetLatency", Qt::QueuedConnection,
+        Q_ARG(double, std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count()));
+
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stepInFlight = false;
+    if (this->dataPtr->pendingSteps > 0u)
+      this->SendPendingSteps();
+  };
   this->dataPtr->node.Request(this->dataPtr->controlService, req, cb);
 }
 
+/////////////////////////////////////////////////
+double WorldControl::Latency() const
+{
+  return this->dataPtr->latency;
+}
+
+/////////////////////////////////////////////////
+void WorldControl::SetLatency(const double _latency)
+{
+  this->dataPtr->latency = _latency;
+  this->LatencyChanged();
+}
+
 // Register this plugin
 IGNITION_ADD_PLUGIN(ignition::gui::plugins::WorldControl,
                     ignition::gui::Plugin)
@@ -57,6 +57,14 @@ namespace plugins
   {
     Q_OBJECT
 
+    /// \brief Round-trip time of the last completed control request,
+    /// in milliseconds
+    Q_PROPERTY(
+      double latency
+      READ Latency
+      NOTIFY LatencyChanged
+    )
+
     /// \brief Constructor
     public: WorldControl();
 
@@ -88,6 +96,23 @@ namespace plugins
     /// \brief Notify that it's now paused.
     signals: void paused();
 
+    /// \brief Get the round-trip time of the last completed control
+    /// request
+    /// \return Latency in milliseconds
+    public: Q_INVOKABLE double Latency() const;
+
+    /// \brief Notify that the latency has been updated
+    signals: void LatencyChanged();
+
+    /// \brief Record a request round trip. Queued from the response
+    /// callback.
+    /// \param[in] _latency Latency in milliseconds
+    private slots: void SetLatency(const double _latency);
+
+    /// \brief Send all accumulated steps as one multi-step request.
+    /// The caller must hold the message mutex.
+    private: void SendPendingSteps();
+
     /// \brief Subscriber callback when new world statistics are received
     private: void OnWorldStatsMsg(const ignition::msgs::WorldStatistics &_msg);
 
@@ -134,6 +134,13 @@ RowLayout {
       }
       Material.background: Material.primary
 
+      ToolTip.visible: hovered
+      ToolTip.delay: 500
+      ToolTip.timeout: 1000
+      ToolTip.text: WorldControl.latency > 0 ?
+          qsTr("Step (last round trip: ") +
+          WorldControl.latency.toFixed(1) + " ms)" : qsTr("Step")
+
       function windowPos() {
         return mapToItem(worldControl.parent.card().parent, 0, 0);
       }
@@ -15,9 +15,23 @@
  *
 */
 
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
 #include <ignition/plugin/Register.hh>
 #include <ignition/common/Time.hh>
+#include <ignition/math/Helpers.hh>
+
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/Helpers.hh"
 
 #include "WorldStats.hh"
 
@@ -27,6 +41,113 @@ namespace gui
 {
 namespace plugins
 {
+  /// \brief Fixed-capacity ring buffer of samples with rolling
+  /// minimum / average / maximum maintained incrementally. Pushing is
+  /// O(1) amortized and never rescans the buffer: the average comes
+  /// from a running sum and the extrema from monotonic deques whose
+  /// entries are dropped as they age out of the window.
+  class RollingStats
+  {
+    /// \brief Constructor
+    /// \param[in] _capacity Number of samples the window holds
+    public: explicit RollingStats(const std::size_t _capacity)
+        : capacity(_capacity)
+    {
+      this->samples.reserve(_capacity);
+    }
+
+    /// \brief Add a sample, evicting the oldest when the window is full
+    /// \param[in] _value Sample value
+    public: void Push(const double _value)
+    {
+      if (this->samples.size() == this->capacity)
+      {
+        // the slot at head holds the oldest sample
+        const auto oldestSeq = this->next - this->capacity;
+        this->sum -= this->samples[this->head];
+        if (!this->minima.empty() && this->minima.front().first == oldestSeq)
+          this->minima.pop_front();
+        if (!this->maxima.empty() && this->maxima.front().first == oldestSeq)
+          this->maxima.pop_front();
+        this->samples[this->head] = _value;
+      }
+      else
+      {
+        this->samples.push_back(_value);
+      }
+      this->head = (this->head + 1) % this->capacity;
+      this->sum += _value;
+
+      // samples that can never again be an extremum leave the deques now,
+      // so the fronts always hold the window's min and max
+      while (!this->minima.empty() && this->minima.back().second >= _value)
+        this->minima.pop_back();
+      this->minima.push_back({this->next, _value});
+
+      while (!this->maxima.empty() && this->maxima.back().second <= _value)
+        this->maxima.pop_back();
+      this->maxima.push_back({this->next, _value});
+
+      ++this->next;
+    }
+
+    /// \brief Get the smallest sample in the window
+    /// \return Minimum, or zero when empty
+    public: double Min() const
+    {
+      return this->minima.empty() ? 0.0 : this->minima.front().second;
+    }
+
+    /// \brief Get the largest sample in the window
+    /// \return Maximum, or zero when empty
+    public: double Max() const
+    {
+      return this->maxima.empty() ? 0.0 : this->maxima.front().second;
+    }
+
+    /// \brief Get the average of the window
+    /// \return Average, or zero when empty
+    public: double Avg() const
+    {
+      return this->samples.empty() ? 0.0 : this->sum / this->samples.size();
+    }
+
+    /// \brief Copy the window into a QML-friendly list, oldest first
+    /// \return Sample values
+    public: QVariantList History() const
+    {
+      QVariantList result;
+      result.reserve(static_cast<int>(this->samples.size()));
+      const auto start =
+          this->samples.size() == this->capacity ? this->head : 0u;
+      for (std::size_t i = 0; i < this->samples.size(); ++i)
+        result.append(this->samples[(start + i) % this->capacity]);
+      return result;
+    }
+
+    /// \brief Number of samples the window holds
+    private: std::size_t capacity;
+
+    /// \brief Sample storage, a ring once capacity is reached
+    private: std::vector<double> samples;
+
+    /// \brief Index of the oldest sample once the ring is full
+    private: std::size_t head{0};
+
+    /// \brief Running sum of the window
+    private: double sum{0.0};
+
+    /// \brief Sequence number of the next sample, used to age deque
+    /// entries out of the window
+    private: uint64_t next{0};
+
+    /// \brief Candidates for the window minimum, increasing values
+    private: std::deque<std::pair<uint64_t, double>> minima;
+
+    /// \brief Candidates for the window maximum, decreasing values
+    private: std::deque<std::pair<uint64_t, double>> maxima;
+  };
+
   class WorldStatsPrivate
   {
     /// \brief Message holding latest world statistics
@@ -35,8 +156,17 @@ namespace plugins
     /// \brief Mutex to protect msg
     public: std::recursive_mutex mutex;
 
-    /// \brief Communication node
-    public: ignition::transport::Node node;
+    /// \brief Communication node. Points at the node shared by all
+    /// plugins when there is an application, otherwise at fallbackNode.
+    public: ignition::transport::Node *node{nullptr};
+
+    /// \brief Node owned by this plugin, only created when there is no
+    /// application to share one with.
+    public: std::unique_ptr<ignition::transport::Node> fallbackNode;
+
+    /// \brief Topic subscribed to, so the destructor can remove this
+    /// plugin's handler from the shared node.
+    public: std::string topic;
 
     /// \brief Holds real time factor
     public: QString realTimeFactor;
@@ -49,6 +179,47 @@ namespace plugins
 
     /// \brief Holds iterations
     public: QString iterations;
+
+    /// \brief True when msg holds stats that haven't been displayed yet
+    public: bool msgDirty{false};
+
+    /// \brief True while a ProcessMsg call is queued, so messages
+    /// arriving faster than the display rate coalesce instead of piling
+    /// up dispatches
+    public: bool processScheduled{false};
+
+    /// \brief Maximum display update rate, in Hz
+    public: double updateRate{20.0};
+
+    /// \brief Earliest time the display may be updated again
+    public: std::chrono::steady_clock::time_point nextUpdate;
+
+    /// \brief Last displayed sim time, to skip re-formatting
+    public: std::pair<int64_t, int32_t> lastSimTime{-1, -1};
+
+    /// \brief Last displayed real time, to skip re-formatting
+    public: std::pair<int64_t, int32_t> lastRealTime{-1, -1};
+
+    /// \brief Last displayed real time factor, to skip re-formatting
+    public: double lastRtf{-std::numeric_limits<double>::max()};
+
+    /// \brief Last displayed iteration count, to skip re-formatting
+    public: uint64_t lastIterations{std::numeric_limits<uint64_t>::max()};
+
+    /// \brief Rolling window of real time factor samples, one per
+    /// received message
+    public: RollingStats rtfHistory{180};
+
+    /// \brief Rolling window of iterations-per-real-second samples
+    public: RollingStats iterationRateHistory{180};
+
+    /// \brief Iteration count of the previous message, to derive the
+    /// iteration rate
+    public: uint64_t prevIterations{0};
+
+    /// \brief Real time of the previous message in seconds, to derive
+    /// the iteration rate. Negative until the first message.
+    public: double prevRealTime{-1.0};
   };
 }
 }
@@ -67,6 +238,9 @@ WorldStats::WorldStats()
 /////////////////////////////////////////////////
 WorldStats::~WorldStats()
 {
+  // The shared node outlives this plugin, so remove our handler from it
+  if (nullptr != this->dataPtr->node && !this->dataPtr->topic.empty())
+    this->dataPtr->node->Unsubscribe(this->dataPtr->topic);
 }
 
 /////////////////////////////////////////////////
@@ -96,12 +270,45 @@ void WorldStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
     return;
   }
 
-  if (!this->dataPtr->node.Subscribe(topic, &WorldStats::OnWorldStatsMsg,
-      this))
+  // Subscribe on the node shared by all plugins, so this plugin adds no
+  // transport threads of its own. Going through the application also
+  // records this subscription's callback latency for diagnostics.
+  bool subscribed{false};
+  if (auto app = App())
+  {
+    this->dataPtr->node = app->TransportNode();
+    subscribed = app->Subscribe<ignition::msgs::WorldStatistics>(topic,
+        this->title, [this](const ignition::msgs::WorldStatistics &_msg)
+        {
+          this->OnWorldStatsMsg(_msg);
+        });
+  }
+  else
+  {
+    this->dataPtr->fallbackNode.reset(new ignition::transport::Node());
+    this->dataPtr->node = this->dataPtr->fallbackNode.get();
+    subscribed = this->dataPtr->node->Subscribe(topic,
+        &WorldStats::OnWorldStatsMsg, this);
+  }
+
+  if (!subscribed)
   {
     ignerr << "Failed to subscribe to [" << topic << "]" << std::endl;
     return;
   }
+  this->dataPtr->topic = topic;
+
+  // Update rate
+  if (auto rateElem = _pluginElem->FirstChildElement("update_rate"))
+  {
+    rateElem->QueryDoubleText(&this->dataPtr->updateRate);
+    if (this->dataPtr->updateRate <= 0.0)
+    {
+      ignwarn << "Ignoring <update_rate> [" << this->dataPtr->updateRate
+              << "], must be positive." << std::endl;
+      this->dataPtr->updateRate = 20.0;
+    }
+  }
 
   // Sim time
   if (auto simTimeElem = _pluginElem->FirstChildElement("sim_time"))
@@ -149,8 +356,33 @@ void WorldStats::LoadConfig(const tinyxml2::XMLElement *_pluginElem)
 /////////////////////////////////////////////////
 void WorldStats::ProcessMsg()
 {
+  IGN_PROFILE("WorldStats::ProcessMsg");
+
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
 
+  if (!this->dataPtr->msgDirty)
+  {
+    this->dataPtr->processScheduled = false;
+    return;
+  }
+
+  // Throttle to the display rate: faster stats coalesce into the stored
+  // message and one retry is scheduled for when the window opens
+  const auto now = std::chrono::steady_clock::now();
+  if (now < this->dataPtr->nextUpdate)
+  {
+    const auto remaining =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+        this->dataPtr->nextUpdate - now).count();
+    QTimer::singleShot(remaining + 1, this, SLOT(ProcessMsg()));
+    return;
+  }
+  this->dataPtr->nextUpdate = now + std::chrono::duration_cast<
+      std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / this->dataPtr->updateRate));
+  this->dataPtr->msgDirty = false;
+  this->dataPtr->processScheduled = false;
+
   ignition::common::Time time;
 
   if (this->dataPtr->msg.has_sim_time())
@@ -158,7 +390,13 @@ void WorldStats::ProcessMsg()
     time.sec = this->dataPtr->msg.sim_time().sec();
     time.nsec = this->dataPtr->msg.sim_time().nsec();
 
-    this->SetSimTime(QString::fromStdString(time.FormattedString()));
+    // only re-format fields whose value actually changed
+    const std::pair<int64_t, int32_t> simTime{time.sec, time.nsec};
+    if (simTime != this->dataPtr->lastSimTime)
+    {
+      this->dataPtr->lastSimTime = simTime;
+      this->SetSimTime(QString::fromStdString(formattedTime(time)));
+    }
   }
 
   if (this->dataPtr->msg.has_real_time())
@@ -166,18 +404,33 @@ void WorldStats::ProcessMsg()
     time.sec = this->dataPtr->msg.real_time().sec();
     time.nsec = this->dataPtr->msg.real_time().nsec();
 
-    this->SetRealTime(QString::fromStdString(time.FormattedString()));
+    const std::pair<int64_t, int32_t> realTime{time.sec, time.nsec};
+    if (realTime != this->dataPtr->lastRealTime)
+    {
+      this->dataPtr->lastRealTime = realTime;
+      this->SetRealTime(QString::fromStdString(formattedTime(time)));
+    }
   }
 
   {
     // RTF as a percentage.
     double rtf = this->dataPtr->msg.real_time_factor() * 100;
-    this->SetRealTimeFactor(QString::number(rtf, 'f', 2) + " %");
+    if (!ignition::math::equal(rtf, this->dataPtr->lastRtf))
+    {
+      this->dataPtr->lastRtf = rtf;
+      this->SetRealTimeFactor(QString::number(rtf, 'f', 2) + " %");
+    }
   }
 
+  if (this->dataPtr->msg.iterations() != this->dataPtr->lastIterations)
   {
+    this->dataPtr->lastIterations = this->dataPtr->msg.iterations();
     this->SetIterations(QString::number(this->dataPtr->msg.iterations()));
   }
+
+  // the sparkline repaints at the display rate, though the history is
+  // sampled every message
+  this->RtfHistoryChanged();
 }
 
 /////////////////////////////////////////////////
@@ -186,6 +439,29 @@ void WorldStats::OnWorldStatsMsg(const ignition::msgs::WorldStatistics &_msg)
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
 
   this->dataPtr->msg.CopyFrom(_msg);
+  this->dataPtr->msgDirty = true;
+
+  // sample the history here rather than in ProcessMsg, so transient
+  // slowdowns register even when the display is throttled
+  this->dataPtr->rtfHistory.Push(_msg.real_time_factor());
+
+  const double realTime =
+      _msg.real_time().sec() + _msg.real_time().nsec() * 1e-9;
+  if (this->dataPtr->prevRealTime >= 0.0 &&
+      realTime > this->dataPtr->prevRealTime &&
+      _msg.iterations() >= this->dataPtr->prevIterations)
+  {
+    this->dataPtr->iterationRateHistory.Push(
+        (_msg.iterations() - this->dataPtr->prevIterations) /
+        (realTime - this->dataPtr->prevRealTime));
+  }
+  this->dataPtr->prevRealTime = realTime;
+  this->dataPtr->prevIterations = _msg.iterations();
+
+  // one dispatch in flight is enough; it always shows the latest stats
+  if (this->dataPtr->processScheduled)
+    return;
+  this->dataPtr->processScheduled = true;
   QMetaObject::invokeMethod(this, "ProcessMsg");
 }
 
@@ -228,6 +504,41 @@ void WorldStats::SetRealTime(const QString &_realTime)
   this->RealTimeChanged();
 }
 
+/////////////////////////////////////////////////
+QVariantList WorldStats::RtfHistory() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->rtfHistory.History();
+}
+
+/////////////////////////////////////////////////
+QVariantList WorldStats::IterationRateHistory() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->iterationRateHistory.History();
+}
+
+/////////////////////////////////////////////////
+double WorldStats::RtfMin() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->rtfHistory.Min();
+}
+
+/////////////////////////////////////////////////
+double WorldStats::RtfAvg() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->rtfHistory.Avg();
+}
+
+/////////////////////////////////////////////////
+double WorldStats::RtfMax() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->rtfHistory.Max();
+}
+
 /////////////////////////////////////////////////
 QString WorldStats::Iterations() const
 {
@@ -55,8 +55,12 @@ namespace plugins
   ///                  default.
   /// * \<real_time\> : True to display a real time widget, false by default.
   /// * \<real_time_factor\> : True to display a real time factor widget,
+  ///                          with a sparkline of its recent history,
   ///                          false by default.
   /// * \<topic\> : Topic to receive world statistics, required.
+  /// * \<update_rate\> : Maximum display update rate in Hz, 20 by default.
+  ///                     Stats arriving faster are coalesced and the
+  ///                     latest values shown when the window opens.
   class WorldStats_EXPORTS_API WorldStats: public ignition::gui::Plugin
   {
     Q_OBJECT
@@ -149,6 +153,34 @@ namespace plugins
     /// \brief Notify that message type has changed
     signals: void IterationsChanged();
 
+    /// \brief Get the rolling window of real time factor samples,
+    /// oldest first. Constant memory: one sample per received message,
+    /// oldest evicted once the window is full.
+    /// \return Real time factor samples
+    public: Q_INVOKABLE QVariantList RtfHistory() const;
+
+    /// \brief Get the rolling window of iterations-per-real-second
+    /// samples, oldest first
+    /// \return Iteration rate samples
+    public: Q_INVOKABLE QVariantList IterationRateHistory() const;
+
+    /// \brief Get the smallest real time factor in the window,
+    /// maintained incrementally as samples arrive
+    /// \return Minimum real time factor
+    public: Q_INVOKABLE double RtfMin() const;
+
+    /// \brief Get the average real time factor over the window
+    /// \return Average real time factor
+    public: Q_INVOKABLE double RtfAvg() const;
+
+    /// \brief Get the largest real time factor in the window
+    /// \return Maximum real time factor
+    public: Q_INVOKABLE double RtfMax() const;
+
+    /// \brief Notify that new history samples are available. Emitted at
+    /// the display rate, not once per message.
+    signals: void RtfHistoryChanged();
+
     /// \brief Subscriber callback when new world statistics are received
     private: void OnWorldStatsMsg(const ignition::msgs::WorldStatistics &_msg);
 
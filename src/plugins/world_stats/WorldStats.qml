@@ -171,6 +171,71 @@ Rectangle {
         Layout.alignment: Qt.AlignRight
       }
 
+      /**
+       * RTF sparkline: recent history, so transient slowdowns are
+       * visible after the fact
+       */
+      Canvas {
+        id: rtfSparkline
+        visible: showRealTimeFactor
+        Layout.columnSpan: 2
+        Layout.fillWidth: true
+        Layout.preferredHeight: 30
+
+        Connections {
+          target: WorldStats
+          onRtfHistoryChanged: {
+            rtfSparkline.requestPaint()
+            rtfRange.text = "min " + (100 * WorldStats.RtfMin()).toFixed(0) +
+                " / avg " + (100 * WorldStats.RtfAvg()).toFixed(0) +
+                " / max " + (100 * WorldStats.RtfMax()).toFixed(0) + " %"
+          }
+        }
+
+        onPaint: {
+          var ctx = getContext("2d")
+          ctx.clearRect(0, 0, width, height)
+
+          var history = WorldStats.RtfHistory()
+          if (history.length < 2)
+            return
+
+          // scale so both the full range and the 100% line fit
+          var lo = Math.min(WorldStats.RtfMin(), 0.0)
+          var hi = Math.max(WorldStats.RtfMax(), 1.0)
+          var span = Math.max(hi - lo, 1e-6)
+
+          // reference line at RTF = 1
+          var refY = height - 1 - (1.0 - lo) / span * (height - 2)
+          ctx.strokeStyle = "#55808080"
+          ctx.beginPath()
+          ctx.moveTo(0, refY)
+          ctx.lineTo(width, refY)
+          ctx.stroke()
+
+          ctx.strokeStyle = Material.accent
+          ctx.beginPath()
+          for (var i = 0; i < history.length; ++i)
+          {
+            var x = i / (history.length - 1) * width
+            var y = height - 1 - (history[i] - lo) / span * (height - 2)
+            if (i === 0)
+              ctx.moveTo(x, y)
+            else
+              ctx.lineTo(x, y)
+          }
+          ctx.stroke()
+        }
+      }
+      Label {
+        id: rtfRange
+        visible: showRealTimeFactor
+        Layout.columnSpan: 2
+        Layout.alignment: Qt.AlignRight
+        font.pixelSize: 10
+        text: ""
+      }
+
       /**
        * Sim time
        */
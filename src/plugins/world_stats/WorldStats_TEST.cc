@@ -167,5 +167,13 @@ TEST(WorldStatsTest, WorldStats)
   EXPECT_EQ(plugin->SimTime().toStdString(), "00 01:00:00.123");
   EXPECT_EQ(plugin->RealTime().toStdString(), "01 00:00:00.001");
   EXPECT_EQ(plugin->RealTimeFactor().toStdString(), "100.00 %");
+
+  // History holds one RTF sample per message, with rolling stats
+  auto history = plugin->RtfHistory();
+  EXPECT_GE(history.size(), 1);
+  EXPECT_DOUBLE_EQ(plugin->RtfMax(), 1.0);
+  EXPECT_LE(plugin->RtfMin(), plugin->RtfAvg());
+  EXPECT_LE(plugin->RtfAvg(), plugin->RtfMax());
+  EXPECT_DOUBLE_EQ(history.last().toDouble(), 1.0);
 }
 
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+/// \file Transport load generator for GUI stress testing.
+///
+/// Publishes a configurable mix of the streams operator stations
+/// consume — world statistics, pose vectors, image feeds — against a
+/// running `ign gui` instance, so degradation points can be found with
+/// repeatable numbers instead of ad-hoc scripts. While running it
+/// relays samples from the GUI's /gui/telemetry topic (enable telemetry
+/// on the window to get them) and on exit prints the achieved rate per
+/// stream next to its target.
+///
+/// Example, roughly one busy simulation:
+///   gui_load_generator --stats-hz 10 --pose-hz 60 --pose-entities 500 \
+///       --image-streams 2 --duration 60
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ignition/msgs/image.pb.h>
+#include <ignition/msgs/pose_v.pb.h>
+#include <ignition/msgs/stringmsg.pb.h>
+#include <ignition/msgs/world_stats.pb.h>
+#include <ignition/transport/Node.hh>
+
+using namespace ignition;
+
+/// \brief One paced publisher stream.
+struct Stream
+{
+  /// \brief Stream name for the report.
+  std::string name;
+
+  /// \brief Target rate in Hz.
+  double hz{0};
+
+  /// \brief Messages actually published.
+  std::atomic<int64_t> published{0};
+
+  /// \brief Worker publishing the stream.
+  std::thread worker;
+};
+
+/////////////////////////////////////////////////
+/// \brief Run a paced publish loop until _running clears.
+/// \param[in] _stream Stream being driven, for pacing and counting.
+/// \param[in] _running Cleared when the run is over.
+/// \param[in] _publish Publishes one message; receives the sequence
+/// number.
+void RunStream(Stream &_stream, const std::atomic<bool> &_running,
+    const std::function<void(int64_t)> &_publish)
+{
+  const auto period = std::chrono::nanoseconds(
+      static_cast<int64_t>(1e9 / _stream.hz));
+  auto next = std::chrono::steady_clock::now();
+
+  while (_running)
+  {
+    _publish(_stream.published);
+    ++_stream.published;
+
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get an option's value from the command line.
+/// \param[in] _argc Argument count.
+/// \param[in] _argv Arguments.
+/// \param[in] _name Option name, including dashes.
+/// \param[in] _default Value when the option is absent.
+/// \return The option value.
+std::string Option(int _argc, char **_argv, const std::string &_name,
+    const std::string &_default)
+{
+  for (int i = 1; i + 1 < _argc; ++i)
+  {
+    if (_name == _argv[i])
+      return _argv[i + 1];
+  }
+  return _default;
+}
+
+/////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  for (int i = 1; i < _argc; ++i)
+  {
+    if (std::string("--help") == _argv[i] || std::string("-h") == _argv[i])
+    {
+      std::cout << "Usage: gui_load_generator [options]\n"
+          << "  --stats-hz N          World statistics rate (default 10)\n"
+          << "  --stats-topic T       Statistics topic (/world_stats)\n"
+          << "  --pose-hz N           Pose vector rate (default 60)\n"
+          << "  --pose-entities M     Entities per pose message (100)\n"
+          << "  --pose-topic T        Pose topic (/pose)\n"
+          << "  --image-streams K     Number of image feeds (1)\n"
+          << "  --image-hz N          Rate per image feed (30)\n"
+          << "  --image-width W       Image width (640)\n"
+          << "  --image-height H     Image height (480)\n"
+          << "  --image-topic-prefix P  Feed topics P0, P1, ... (/image)\n"
+          << "  --duration S          Seconds to run, 0 for forever (30)\n"
+          << "A rate of 0 disables a stream." << std::endl;
+      return 0;
+    }
+  }
+
+  const double statsHz = std::atof(
+      Option(_argc, _argv, "--stats-hz", "10").c_str());
+  const std::string statsTopic =
+      Option(_argc, _argv, "--stats-topic", "/world_stats");
+  const double poseHz = std::atof(
+      Option(_argc, _argv, "--pose-hz", "60").c_str());
+  const int poseEntities = std::atoi(
+      Option(_argc, _argv, "--pose-entities", "100").c_str());
+  const std::string poseTopic = Option(_argc, _argv, "--pose-topic", "/pose");
+  const int imageStreams = std::atoi(
+      Option(_argc, _argv, "--image-streams", "1").c_str());
+  const double imageHz = std::atof(
+      Option(_argc, _argv, "--image-hz", "30").c_str());
+  const int imageWidth = std::atoi(
+      Option(_argc, _argv, "--image-width", "640").c_str());
+  const int imageHeight = std::atoi(
+      Option(_argc, _argv, "--image-height", "480").c_str());
+  const std::string imagePrefix =
+      Option(_argc, _argv, "--image-topic-prefix", "/image");
+  const int duration = std::atoi(
+      Option(_argc, _argv, "--duration", "30").c_str());
+
+  transport::Node node;
+  std::atomic<bool> running{true};
+  std::vector<std::unique_ptr<Stream>> streams;
+
+  // Relay whatever the GUI reports about itself while under load
+  node.Subscribe<msgs::StringMsg>("/gui/telemetry",
+      std::function<void(const msgs::StringMsg &)>(
+      [](const msgs::StringMsg &_msg)
+      {
+        std::cout << "[telemetry] " << _msg.data() << std::endl;
+      }));
+
+  if (statsHz > 0)
+  {
+    auto stream = std::make_unique<Stream>();
+    stream->name = "world_stats";
+    stream->hz = statsHz;
+
+    auto pub = node.Advertise<msgs::WorldStatistics>(statsTopic);
+    stream->worker = std::thread([&running, pub, statsHz,
+        stream = stream.get()]() mutable
+    {
+      RunStream(*stream, running, [&pub, statsHz](int64_t _seq)
+      {
+        msgs::WorldStatistics msg;
+        msg.set_iterations(_seq);
+        msg.set_real_time_factor(1.0);
+        msg.mutable_sim_time()->set_sec(_seq / statsHz);
+        msg.mutable_real_time()->set_sec(_seq / statsHz);
+        pub.Publish(msg);
+      });
+    });
+    streams.push_back(std::move(stream));
+  }
+
+  if (poseHz > 0 && poseEntities > 0)
+  {
+    auto stream = std::make_unique<Stream>();
+    stream->name = "pose_v";
+    stream->hz = poseHz;
+
+    auto pub = node.Advertise<msgs::Pose_V>(poseTopic);
+    stream->worker = std::thread([&running, pub, poseEntities,
+        stream = stream.get()]() mutable
+    {
+      // One message reused per frame, like a simulator would
+      msgs::Pose_V msg;
+      for (int i = 0; i < poseEntities; ++i)
+      {
+        auto pose = msg.add_pose();
+        pose->set_id(i);
+        pose->mutable_orientation()->set_w(1);
+      }
+
+      RunStream(*stream, running, [&](int64_t _seq)
+      {
+        for (int i = 0; i < poseEntities; ++i)
+          msg.mutable_pose(i)->mutable_position()->set_x(_seq * 0.001);
+        pub.Publish(msg);
+      });
+    });
+    streams.push_back(std::move(stream));
+  }
+
+  for (int k = 0; k < imageStreams && imageHz > 0; ++k)
+  {
+    auto stream = std::make_unique<Stream>();
+    stream->name = "image_" + std::to_string(k);
+    stream->hz = imageHz;
+
+    auto pub = node.Advertise<msgs::Image>(imagePrefix + std::to_string(k));
+    stream->worker = std::thread([&running, pub, imageWidth, imageHeight,
+        stream = stream.get()]() mutable
+    {
+      msgs::Image msg;
+      msg.set_width(imageWidth);
+      msg.set_height(imageHeight);
+      msg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+      msg.set_step(imageWidth * 3);
+      msg.mutable_data()->resize(imageWidth * imageHeight * 3);
+
+      RunStream(*stream, running, [&](int64_t _seq)
+      {
+        // Vary the payload so nothing along the way can cache it
+        (*msg.mutable_data())[0] = static_cast<char>(_seq);
+        pub.Publish(msg);
+      });
+    });
+    streams.push_back(std::move(stream));
+  }
+
+  if (streams.empty())
+  {
+    std::cerr << "All streams disabled, nothing to do." << std::endl;
+    return -1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  if (duration > 0)
+    std::this_thread::sleep_for(std::chrono::seconds(duration));
+  else
+    transport::waitForShutdown();
+
+  running = false;
+  for (auto &stream : streams)
+    stream->worker.join();
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start).count() / 1000.0;
+
+  for (const auto &stream : streams)
+  {
+    std::cout << "{\"name\": \"" << stream->name
+              << "\", \"target_hz\": " << stream->hz
+              << ", \"achieved_hz\": " << stream->published / elapsed
+              << ", \"published\": " << stream->published
+              << "}" << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/msgs/pose_v.pb.h>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/Conversions.hh"
+#include "ignition/gui/Enums.hh"
+#include "ignition/gui/Helpers.hh"
+#include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/SearchModel.hh"
+
+int g_argc = 1;
+char **g_argv = new char *[g_argc];
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Time _work over _iterations runs and print the mean as one
+/// JSON line, so dashboard scripts can scrape and trend the output:
+/// {"name": "...", "iterations": N, "mean_us": X}
+/// \param[in] _name Benchmark name.
+/// \param[in] _iterations How many times to run the work.
+/// \param[in] _work The work to measure.
+void Benchmark(const std::string &_name, const int _iterations,
+    const std::function<void()> &_work)
+{
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < _iterations; ++i)
+    _work();
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count();
+
+  std::cout << "{\"name\": \"" << _name
+            << "\", \"iterations\": " << _iterations
+            << ", \"mean_us\": " << (elapsed / 1000.0) / _iterations
+            << "}" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(CoreBenchmarks, SearchModelFilter)
+{
+  common::Console::SetVerbosity(4);
+
+  // Nested source model, sized below the threshold where SearchModel
+  // moves filtering off-thread, so the synchronous path is what's timed
+  auto sourceModel = new QStandardItemModel();
+  for (int i = 0; i < 40; ++i)
+  {
+    auto top = new QStandardItem();
+    top->setData(QString("topic_%1").arg(i), DataRole::DISPLAY_NAME);
+    sourceModel->insertRow(i, top);
+
+    for (int j = 0; j < 10; ++j)
+    {
+      auto child = new QStandardItem();
+      child->setData(QString("field_%1_%2").arg(i).arg(j),
+          DataRole::DISPLAY_NAME);
+      top->appendRow(child);
+    }
+  }
+
+  SearchModel searchModel;
+  searchModel.setFilterRole(DataRole::DISPLAY_NAME);
+  searchModel.setSourceModel(sourceModel);
+
+  // Alternate searches so each pass re-filters instead of hitting the
+  // memoized verdicts
+  int pass{0};
+  Benchmark("SearchModel_filter", 200, [&]
+  {
+    searchModel.SetSearch(pass++ % 2 ? "field_3" : "topic_2");
+    EXPECT_GT(searchModel.rowCount(), 0);
+  });
+
+  delete sourceModel;
+}
+
+/////////////////////////////////////////////////
+TEST(CoreBenchmarks, Conversions)
+{
+  math::Color color(0.1, 0.2, 0.3, 1.0);
+  math::Vector3d vec(1, 2, 3);
+
+  Benchmark("convert_color_roundtrip", 100000, [&]
+  {
+    auto qt = convert(color);
+    color = convert(qt);
+  });
+
+  Benchmark("convert_vector3_roundtrip", 100000, [&]
+  {
+    auto qt = convert(vec);
+    vec = convert(qt);
+  });
+
+  // Scene-sized pose vector, converted into reused batch buffers the
+  // way Scene3D ingests it every frame
+  msgs::Pose_V poseMsg;
+  for (int i = 0; i < 200; ++i)
+  {
+    auto pose = poseMsg.add_pose();
+    pose->set_id(i);
+    pose->mutable_position()->set_x(i);
+    pose->mutable_orientation()->set_w(1);
+  }
+
+  BatchedPoses batch;
+  Benchmark("convert_pose_v_200", 10000, [&]
+  {
+    convert(poseMsg, batch);
+  });
+  EXPECT_EQ(batch.ids.size(), 200u);
+}
+
+/////////////////////////////////////////////////
+TEST(CoreBenchmarks, WindowConfigXml)
+{
+  WindowConfig config;
+  config.posX = 100;
+  config.posY = 100;
+  config.width = 1000;
+  config.height = 600;
+  config.materialTheme = "Dark";
+  config.materialPrimary = "#0000ff";
+
+  std::string xml;
+  Benchmark("window_config_xml_string", 10000, [&]
+  {
+    xml = config.XMLString();
+  });
+  EXPECT_FALSE(xml.empty());
+
+  Benchmark("window_config_merge_from_xml", 10000, [&]
+  {
+    EXPECT_TRUE(config.MergeFromXML(xml));
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreBenchmarks, LoadPlugin)
+{
+  Application app(g_argc, g_argv);
+
+  // First load pays for discovery and dlopen; repeats measure the
+  // cached path
+  Benchmark("load_plugin_publisher_first", 1, [&]
+  {
+    EXPECT_TRUE(app.LoadPlugin("Publisher"));
+  });
+
+  Benchmark("load_plugin_publisher_cached", 10, [&]
+  {
+    EXPECT_TRUE(app.LoadPlugin("Publisher"));
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreBenchmarks, Helpers)
+{
+  std::vector<std::string> keys =
+      {"mass", "cast_shadows", "ixx", "limit_lower", "pos", "custom_key"};
+
+  Benchmark("human_readable", 100000, [&]
+  {
+    for (const auto &key : keys)
+      EXPECT_FALSE(humanReadable(key).empty());
+  });
+
+  Benchmark("unit_from_key", 100000, [&]
+  {
+    for (const auto &key : keys)
+      unitFromKey(key, "PRISMATIC");
+  });
+}
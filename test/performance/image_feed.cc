@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <tinyxml2.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <ignition/common/Console.hh>
+#include <ignition/msgs/image.pb.h>
+#include <ignition/transport/Node.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/Plugin.hh"
+
+int g_argc = 1;
+char **g_argv = new char *[g_argc];
+
+using namespace ignition;
+using namespace gui;
+
+/////////////////////////////////////////////////
+/// \brief Build a synthetic image of the given format, with a payload
+/// sized to match.
+/// \param[in] _format Pixel format.
+/// \param[in] _width Width in px.
+/// \param[in] _height Height in px.
+/// \return The image message.
+msgs::Image SyntheticImage(const msgs::PixelFormatType _format,
+    const int _width, const int _height)
+{
+  int bytesPerPixel{1};
+  switch (_format)
+  {
+    case msgs::PixelFormatType::RGB_INT8:
+      bytesPerPixel = 3;
+      break;
+    case msgs::PixelFormatType::R_FLOAT32:
+      bytesPerPixel = 4;
+      break;
+    case msgs::PixelFormatType::L_INT16:
+      bytesPerPixel = 2;
+      break;
+    default:
+      break;
+  }
+
+  msgs::Image msg;
+  msg.set_width(_width);
+  msg.set_height(_height);
+  msg.set_pixel_format_type(_format);
+  msg.set_step(_width * bytesPerPixel);
+
+  std::string data(_width * _height * bytesPerPixel, '\0');
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i);
+  msg.set_data(data);
+
+  return msg;
+}
+
+/////////////////////////////////////////////////
+/// \brief Publish _frames frames one at a time, waiting for the
+/// display's newImage signal after each, and report the mean
+/// publish-to-image latency. That spans transport delivery, the single
+/// deserialization and the per-format conversion.
+/// \param[in] _plugin The loaded display plugin.
+/// \param[in] _pub Publisher on the display's topic.
+/// \param[in] _msg Frame to publish.
+/// \param[in] _name Name for the JSON report line.
+/// \param[in] _frames How many frames to measure.
+void MeasureFormat(Plugin *_plugin, transport::Node::Publisher &_pub,
+    const msgs::Image &_msg, const std::string &_name, const int _frames)
+{
+  QEventLoop loop;
+  QTimer timer;
+  timer.setSingleShot(true);
+
+  // The display isn't exported, so hook its signal by name
+  QObject::connect(_plugin, SIGNAL(newImage()), &loop, SLOT(quit()));
+  QObject::connect(&timer, SIGNAL(timeout()), &loop, SLOT(quit()));
+
+  int processed{0};
+  int64_t busyNs{0};
+  for (int i = 0; i < _frames; ++i)
+  {
+    auto start = std::chrono::steady_clock::now();
+    _pub.Publish(_msg);
+    timer.start(1000);
+    loop.exec();
+
+    // Timer still running means newImage interrupted the wait
+    if (timer.isActive())
+    {
+      timer.stop();
+      ++processed;
+      busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start).count();
+    }
+  }
+
+  std::cout << "{\"name\": \"" << _name
+            << "\", \"frames\": " << _frames
+            << ", \"processed\": " << processed
+            << ", \"mean_latency_us\": "
+            << (processed ? (busyNs / 1000.0) / processed : -1)
+            << "}" << std::endl;
+
+  EXPECT_EQ(processed, _frames) << _name;
+}
+
+/////////////////////////////////////////////////
+/// \brief Publish a burst of frames back to back, then drain the event
+/// loop counting how many conversions actually ran. The display
+/// coalesces under load — latest frame wins — so the gap between sent
+/// and processed is the coalescing rate at max publisher speed.
+/// \param[in] _plugin The loaded display plugin.
+/// \param[in] _pub Publisher on the display's topic.
+/// \param[in] _msg Frame to publish.
+/// \param[in] _name Name for the JSON report line.
+/// \param[in] _frames Burst size.
+void MeasureBurst(Plugin *_plugin, transport::Node::Publisher &_pub,
+    const msgs::Image &_msg, const std::string &_name, const int _frames)
+{
+  QEventLoop loop;
+  QTimer timer;
+  timer.setSingleShot(true);
+
+  QObject::connect(_plugin, SIGNAL(newImage()), &loop, SLOT(quit()));
+  QObject::connect(&timer, SIGNAL(timeout()), &loop, SLOT(quit()));
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < _frames; ++i)
+    _pub.Publish(_msg);
+
+  int processed{0};
+  while (true)
+  {
+    timer.start(500);
+    loop.exec();
+    if (!timer.isActive())
+      break;
+    timer.stop();
+    ++processed;
+  }
+  auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count();
+
+  std::cout << "{\"name\": \"" << _name
+            << "\", \"sent\": " << _frames
+            << ", \"processed\": " << processed
+            << ", \"coalesced\": " << _frames - processed
+            << ", \"duration_ms\": " << elapsedNs / 1e6
+            << "}" << std::endl;
+
+  EXPECT_GT(processed, 0) << _name;
+}
+
+/////////////////////////////////////////////////
+TEST(ImageFeed, Throughput)
+{
+  common::Console::SetVerbosity(4);
+
+  const std::string topic{"/image_feed_test"};
+
+  Application app(g_argc, g_argv);
+
+  // Display locked to the feed topic
+  std::string pluginStr =
+      "<plugin filename=\"ImageDisplay\">"
+        "<topic>" + topic + "</topic>"
+        "<topic_picker>false</topic_picker>"
+      "</plugin>";
+  tinyxml2::XMLDocument pluginDoc;
+  pluginDoc.Parse(pluginStr.c_str());
+  ASSERT_TRUE(app.LoadPlugin("ImageDisplay",
+      pluginDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+
+  auto plugins = win->findChildren<Plugin *>();
+  ASSERT_EQ(plugins.size(), 1);
+  auto plugin = plugins[0];
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Image>(topic);
+
+  // Wait for the display's subscription to connect
+  for (int sleep = 0; sleep < 50 && !pub.HasConnections(); ++sleep)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_TRUE(pub.HasConnections());
+
+  // Per-format conversion latency at VGA
+  MeasureFormat(plugin, pub,
+      SyntheticImage(msgs::PixelFormatType::RGB_INT8, 640, 480),
+      "image_rgb_int8_640x480", 50);
+  MeasureFormat(plugin, pub,
+      SyntheticImage(msgs::PixelFormatType::R_FLOAT32, 640, 480),
+      "image_r_float32_640x480", 50);
+  MeasureFormat(plugin, pub,
+      SyntheticImage(msgs::PixelFormatType::L_INT16, 640, 480),
+      "image_l_int16_640x480", 50);
+  MeasureFormat(plugin, pub,
+      SyntheticImage(msgs::PixelFormatType::BAYER_RGGB8, 640, 480),
+      "image_bayer_rggb8_640x480", 50);
+
+  // Resolution scaling on the most common format
+  MeasureFormat(plugin, pub,
+      SyntheticImage(msgs::PixelFormatType::RGB_INT8, 1280, 960),
+      "image_rgb_int8_1280x960", 50);
+
+  // Coalescing under an unpaced publisher
+  MeasureBurst(plugin, pub,
+      SyntheticImage(msgs::PixelFormatType::RGB_INT8, 640, 480),
+      "image_rgb_int8_burst", 100);
+}
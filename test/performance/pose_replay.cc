@@ -0,0 +1,381 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/msgs/pose_v.pb.h>
+#include <ignition/msgs/scene.pb.h>
+#include <ignition/transport/Node.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Helpers.hh"
+
+using namespace ignition;
+
+/// \brief Magic header identifying a pose stream log file.
+static const char kLogMagic[] = "IGNPOSELOG1";
+
+/////////////////////////////////////////////////
+/// \brief A recorded pose / scene message stream which can be saved to
+/// a compact binary log and replayed over transport at a configurable
+/// speed. Scene3D's scene manager ingests data through its pose and
+/// scene topics, so replaying a captured stream reproduces a live
+/// simulator session without one.
+class PoseStreamLog
+{
+  /// \brief One recorded message.
+  public: struct Record
+  {
+    /// \brief Time offset from the start of the recording.
+    int64_t stampNs{0};
+
+    /// \brief True for scene messages, false for pose messages.
+    bool scene{false};
+
+    /// \brief Serialized message payload.
+    std::string data;
+  };
+
+  /// \brief Statistics from one replay run.
+  public: struct ReplayStats
+  {
+    /// \brief Number of messages published.
+    int published{0};
+
+    /// \brief Messages which couldn't be published on schedule: the
+    /// pacing sleep was already past their deadline when reached.
+    int late{0};
+
+    /// \brief Largest deviation from a message's schedule, in ns.
+    int64_t maxLatenessNs{0};
+
+    /// \brief Total replay duration in ns.
+    int64_t durationNs{0};
+  };
+
+  /// \brief Append a message to the log.
+  /// \param[in] _stampNs Offset from recording start.
+  /// \param[in] _scene True for a scene message.
+  /// \param[in] _data Serialized payload.
+  public: void Add(const int64_t _stampNs, const bool _scene,
+      std::string _data)
+  {
+    this->records.push_back({_stampNs, _scene, std::move(_data)});
+  }
+
+  /// \brief Start recording from live topics. Messages are stored
+  /// serialized, stamped with their arrival offset.
+  /// \param[in] _node Node to subscribe with.
+  /// \param[in] _poseTopic Pose vector topic.
+  /// \param[in] _sceneTopic Scene topic.
+  /// \return True if both subscriptions succeeded.
+  public: bool Record(transport::Node &_node, const std::string &_poseTopic,
+      const std::string &_sceneTopic)
+  {
+    this->recordStart = std::chrono::steady_clock::now();
+
+    auto stampNow = [this]()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - this->recordStart).count();
+    };
+
+    bool ok = _node.SubscribeRaw(_poseTopic,
+        [this, stampNow](const char *_msgData, const size_t _size,
+            const transport::MessageInfo &)
+        {
+          this->Add(stampNow(), false, std::string(_msgData, _size));
+        }, msgs::Pose_V().GetTypeName());
+
+    return _node.SubscribeRaw(_sceneTopic,
+        [this, stampNow](const char *_msgData, const size_t _size,
+            const transport::MessageInfo &)
+        {
+          this->Add(stampNow(), true, std::string(_msgData, _size));
+        }, msgs::Scene().GetTypeName()) && ok;
+  }
+
+  /// \brief Save the log to a binary file.
+  /// \param[in] _path File to write.
+  /// \return True if the file was written.
+  public: bool Save(const std::string &_path) const
+  {
+    std::ofstream file(_path, std::ios::binary);
+    if (!file)
+      return false;
+
+    file.write(kLogMagic, sizeof(kLogMagic));
+    for (const auto &record : this->records)
+    {
+      const uint8_t type = record.scene ? 1 : 0;
+      const auto size = static_cast<uint32_t>(record.data.size());
+      file.write(reinterpret_cast<const char *>(&record.stampNs),
+          sizeof(record.stampNs));
+      file.write(reinterpret_cast<const char *>(&type), sizeof(type));
+      file.write(reinterpret_cast<const char *>(&size), sizeof(size));
+      file.write(record.data.data(), size);
+    }
+    return file.good();
+  }
+
+  /// \brief Load a log written by Save, replacing the current content.
+  /// \param[in] _path File to read.
+  /// \return True if the file was a valid log.
+  public: bool Load(const std::string &_path)
+  {
+    std::ifstream file(_path, std::ios::binary);
+    if (!file)
+      return false;
+
+    char magic[sizeof(kLogMagic)];
+    file.read(magic, sizeof(magic));
+    if (!file || 0 != memcmp(magic, kLogMagic, sizeof(magic)))
+      return false;
+
+    this->records.clear();
+    while (true)
+    {
+      Record record;
+      uint8_t type{0};
+      uint32_t size{0};
+      file.read(reinterpret_cast<char *>(&record.stampNs),
+          sizeof(record.stampNs));
+      if (!file)
+        break;
+      file.read(reinterpret_cast<char *>(&type), sizeof(type));
+      file.read(reinterpret_cast<char *>(&size), sizeof(size));
+      if (!file)
+        return false;
+
+      record.scene = (type == 1);
+      record.data.resize(size);
+      file.read(&record.data[0], size);
+      if (!file)
+        return false;
+
+      this->records.push_back(std::move(record));
+    }
+    return true;
+  }
+
+  /// \brief Replay the log over transport, keeping each message's
+  /// recorded schedule scaled by a speed multiplier.
+  /// \param[in] _node Node to publish with.
+  /// \param[in] _poseTopic Pose vector topic.
+  /// \param[in] _sceneTopic Scene topic.
+  /// \param[in] _multiplier Speed multiplier: 1.0 replays in real time,
+  /// 2.0 twice as fast; zero or negative publishes at maximum rate.
+  /// \return Replay statistics.
+  public: ReplayStats Replay(transport::Node &_node,
+      const std::string &_poseTopic, const std::string &_sceneTopic,
+      const double _multiplier) const
+  {
+    ReplayStats stats;
+
+    auto posePub = _node.Advertise<msgs::Pose_V>(_poseTopic);
+    auto scenePub = _node.Advertise<msgs::Scene>(_sceneTopic);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto &record : this->records)
+    {
+      if (_multiplier > 0)
+      {
+        const auto deadline = start + std::chrono::nanoseconds(
+            static_cast<int64_t>(record.stampNs / _multiplier));
+        const auto now = std::chrono::steady_clock::now();
+        if (now > deadline)
+        {
+          ++stats.late;
+          stats.maxLatenessNs = std::max<int64_t>(stats.maxLatenessNs,
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+              now - deadline).count());
+        }
+        else
+        {
+          std::this_thread::sleep_until(deadline);
+        }
+      }
+
+      // Publish the serialized payload through the typed publisher so
+      // subscribers see ordinary messages
+      if (record.scene)
+      {
+        msgs::Scene msg;
+        if (msg.ParseFromString(record.data))
+          scenePub.Publish(msg);
+      }
+      else
+      {
+        msgs::Pose_V msg;
+        if (msg.ParseFromString(record.data))
+          posePub.Publish(msg);
+      }
+      ++stats.published;
+    }
+
+    stats.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    return stats;
+  }
+
+  /// \brief Number of records in the log.
+  /// \return The record count.
+  public: size_t Size() const
+  {
+    return this->records.size();
+  }
+
+  /// \brief Recorded messages, in arrival order.
+  private: std::vector<Record> records;
+
+  /// \brief When recording started.
+  private: std::chrono::steady_clock::time_point recordStart;
+};
+
+/////////////////////////////////////////////////
+/// \brief Print one replay's statistics as a JSON line for trending.
+/// \param[in] _name Run name.
+/// \param[in] _stats The statistics to print.
+void PrintStats(const std::string &_name,
+    const PoseStreamLog::ReplayStats &_stats)
+{
+  std::cout << "{\"name\": \"" << _name
+            << "\", \"published\": " << _stats.published
+            << ", \"late\": " << _stats.late
+            << ", \"max_lateness_us\": " << _stats.maxLatenessNs / 1000.0
+            << ", \"duration_ms\": " << _stats.durationNs / 1e6
+            << "}" << std::endl;
+}
+
+/////////////////////////////////////////////////
+/// \brief Build a synthetic stream: one scene message followed by pose
+/// updates for _entityCount entities at _hz for _frames frames.
+/// \param[in] _entityCount Entities per pose message.
+/// \param[in] _hz Frame rate of the synthetic stream.
+/// \param[in] _frames Number of pose frames.
+/// \return The synthetic log.
+PoseStreamLog SyntheticStream(const int _entityCount, const int _hz,
+    const int _frames)
+{
+  PoseStreamLog log;
+
+  msgs::Scene scene;
+  scene.set_name("synthetic");
+  log.Add(0, true, scene.SerializeAsString());
+
+  const int64_t periodNs = 1000000000ll / _hz;
+  for (int frame = 0; frame < _frames; ++frame)
+  {
+    msgs::Pose_V msg;
+    for (int i = 0; i < _entityCount; ++i)
+    {
+      auto pose = msg.add_pose();
+      pose->set_id(i);
+      pose->mutable_position()->set_x(frame * 0.01);
+      pose->mutable_position()->set_y(i);
+      pose->mutable_orientation()->set_w(1);
+    }
+    log.Add((frame + 1) * periodNs, false, msg.SerializeAsString());
+  }
+  return log;
+}
+
+/////////////////////////////////////////////////
+TEST(PoseReplay, RoundTripAndReplay)
+{
+  common::Console::SetVerbosity(4);
+
+  const std::string poseTopic{"/pose_replay_test/pose"};
+  const std::string sceneTopic{"/pose_replay_test/scene"};
+
+  // 200 entities at 120 Hz for half a second of stream time
+  auto log = SyntheticStream(200, 120, 60);
+  ASSERT_EQ(log.Size(), 61u);
+
+  // Binary round trip
+  auto path = gui::uniqueFilePath("/tmp/pose_replay_test", "log");
+  ASSERT_TRUE(log.Save(path));
+
+  PoseStreamLog loaded;
+  ASSERT_TRUE(loaded.Load(path));
+  EXPECT_EQ(loaded.Size(), log.Size());
+
+  // Count deliveries on the receiving end, the way the scene manager
+  // would see them
+  transport::Node subNode;
+  std::atomic<int> posesReceived{0};
+  std::atomic<int> scenesReceived{0};
+  ASSERT_TRUE(subNode.Subscribe<msgs::Pose_V>(poseTopic,
+      std::function<void(const msgs::Pose_V &)>(
+      [&](const msgs::Pose_V &_msg)
+      {
+        EXPECT_EQ(_msg.pose_size(), 200);
+        ++posesReceived;
+      })));
+  ASSERT_TRUE(subNode.Subscribe<msgs::Scene>(sceneTopic,
+      std::function<void(const msgs::Scene &)>(
+      [&](const msgs::Scene &)
+      {
+        ++scenesReceived;
+      })));
+
+  transport::Node pubNode;
+
+  // Real-time replay: the stream is 0.5 s long, so the run should take
+  // about that and stay on schedule
+  auto stats = loaded.Replay(pubNode, poseTopic, sceneTopic, 1.0);
+  PrintStats("replay_1x", stats);
+  EXPECT_EQ(stats.published, 61);
+  EXPECT_GE(stats.durationNs, 400000000ll);
+
+  // Fast replay
+  stats = loaded.Replay(pubNode, poseTopic, sceneTopic, 4.0);
+  PrintStats("replay_4x", stats);
+
+  // Max-rate replay: no pacing at all
+  stats = loaded.Replay(pubNode, poseTopic, sceneTopic, 0.0);
+  PrintStats("replay_max", stats);
+  EXPECT_EQ(stats.late, 0);
+
+  // Give the last messages time to arrive, then check for drops
+  for (int sleep = 0; sleep < 50 && posesReceived < 180; ++sleep)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::cout << "{\"name\": \"replay_delivery\", \"poses_sent\": 180"
+            << ", \"poses_received\": " << posesReceived
+            << ", \"scenes_received\": " << scenesReceived
+            << "}" << std::endl;
+
+  // Loopback transport shouldn't drop the paced replays; the max-rate
+  // one may, which is what the dropped count is for
+  EXPECT_GE(posesReceived, 120);
+  EXPECT_GE(scenesReceived, 2);
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+/// \file Long-run soak harness.
+///
+/// Runs a full Application with a representative plugin set against
+/// in-process transport load for a configurable time, sampling resident
+/// memory, open file descriptors and event dispatch latency along the
+/// way. The run fails when memory or descriptor counts creep up between
+/// the start and the end of the window — the automated reproducer for
+/// the multi-day RSS creep chased by hand every release.
+///
+/// The default duration keeps the performance suite fast; release soaks
+/// set IGN_GUI_SOAK_SECONDS (or use the `soak` build target) to run for
+/// hours.
+
+#include <gtest/gtest.h>
+#include <tinyxml2.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#  include <dirent.h>
+#  include <unistd.h>
+#endif
+
+#include <ignition/common/Console.hh>
+#include <ignition/msgs/image.pb.h>
+#include <ignition/msgs/world_stats.pb.h>
+#include <ignition/transport/Node.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/MainWindow.hh"
+#include "ignition/gui/Plugin.hh"
+
+int g_argc = 1;
+char **g_argv = new char *[g_argc];
+
+using namespace ignition;
+using namespace gui;
+
+/// \brief How often process state is sampled.
+static const int kSamplePeriodMs{1000};
+
+/// \brief Allowed resident growth between the first and last third of
+/// the run before the harness fails: a fraction of the baseline plus a
+/// fixed allowance for caches that fill once.
+static const double kRssGrowthFraction{0.2};
+static const int64_t kRssGrowthFloorKb{10 * 1024};
+
+/// \brief Allowed file descriptor growth between the first and last
+/// third of the run.
+static const int kFdGrowthAllowance{8};
+
+/// \brief One process state sample.
+struct Sample
+{
+  /// \brief Resident set size in kB, -1 where unsupported.
+  int64_t rssKb{-1};
+
+  /// \brief Open file descriptors, -1 where unsupported.
+  int fds{-1};
+};
+
+/// \brief Histogram of event dispatch latencies. One bucket per order
+/// of magnitude, so a drifting tail is visible without storing every
+/// sample.
+struct LatencyHistogram
+{
+  /// \brief Bucket upper bounds in ms; the last bucket is unbounded.
+  const std::vector<double> bounds{1.0, 5.0, 20.0, 100.0};
+
+  /// \brief Sample count per bucket.
+  std::vector<int64_t> counts = std::vector<int64_t>(5, 0);
+
+  /// \brief Add a sample.
+  /// \param[in] _ms Latency in ms.
+  public: void Add(const double _ms)
+  {
+    std::size_t i = 0;
+    while (i < this->bounds.size() && _ms >= this->bounds[i])
+      ++i;
+    ++this->counts[i];
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Read the process' resident set size.
+/// \return RSS in kB, or -1 where /proc isn't available.
+int64_t RssKb()
+{
+#ifdef __linux__
+  std::ifstream statm("/proc/self/statm");
+  int64_t size{0}, resident{0};
+  if (!(statm >> size >> resident))
+    return -1;
+  return resident * sysconf(_SC_PAGESIZE) / 1024;
+#else
+  return -1;
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the process' open file descriptors.
+/// \return Descriptor count, or -1 where /proc isn't available.
+int FdCount()
+{
+#ifdef __linux__
+  auto dir = opendir("/proc/self/fd");
+  if (nullptr == dir)
+    return -1;
+  int count{0};
+  while (readdir(dir) != nullptr)
+    ++count;
+  closedir(dir);
+  return count - 2;
+#else
+  return -1;
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Median of one field over a range of samples.
+/// \param[in] _samples All samples.
+/// \param[in] _from First index of the range.
+/// \param[in] _to One past the last index.
+/// \param[in] _field Field extractor.
+/// \return The median.
+template <typename Field>
+int64_t Median(const std::vector<Sample> &_samples, const std::size_t _from,
+    const std::size_t _to, Field _field)
+{
+  std::vector<int64_t> values;
+  values.reserve(_to - _from);
+  for (auto i = _from; i < _to; ++i)
+    values.push_back(_field(_samples[i]));
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+/////////////////////////////////////////////////
+TEST(SoakTest, LongRun)
+{
+  common::Console::SetVerbosity(4);
+
+  int durationSec{30};
+  if (auto env = std::getenv("IGN_GUI_SOAK_SECONDS"))
+    durationSec = std::max(10, std::atoi(env));
+
+  Application app(g_argc, g_argv);
+  app.AddPluginPath(std::string(PROJECT_BINARY_PATH) + "/lib");
+
+  // Representative operator console: stats panel plus an image feed
+  const std::string statsStr =
+      "<plugin filename=\"WorldStats\">"
+        "<sim_time>true</sim_time>"
+        "<real_time>true</real_time>"
+        "<real_time_factor>true</real_time_factor>"
+        "<topic>/soak_stats</topic>"
+      "</plugin>";
+  tinyxml2::XMLDocument statsDoc;
+  statsDoc.Parse(statsStr.c_str());
+  ASSERT_TRUE(app.LoadPlugin("WorldStats",
+      statsDoc.FirstChildElement("plugin")));
+
+  const std::string imageStr =
+      "<plugin filename=\"ImageDisplay\">"
+        "<topic>/soak_image</topic>"
+        "<topic_picker>false</topic_picker>"
+      "</plugin>";
+  tinyxml2::XMLDocument imageDoc;
+  imageDoc.Parse(imageStr.c_str());
+  ASSERT_TRUE(app.LoadPlugin("ImageDisplay",
+      imageDoc.FirstChildElement("plugin")));
+
+  auto win = app.findChild<MainWindow *>();
+  ASSERT_NE(nullptr, win);
+  win->QuickWindow()->show();
+
+  // In-process load, paced like the standalone generator's defaults
+  std::atomic<bool> running{true};
+
+  std::thread statsWorker([&running]()
+  {
+    transport::Node node;
+    auto pub = node.Advertise<msgs::WorldStatistics>("/soak_stats");
+    int64_t seq{0};
+    auto next = std::chrono::steady_clock::now();
+    while (running)
+    {
+      msgs::WorldStatistics msg;
+      msg.mutable_sim_time()->set_sec(seq);
+      msg.mutable_real_time()->set_sec(seq);
+      msg.set_iterations(seq * 1000);
+      msg.set_real_time_factor(0.9 + 0.1 * (seq % 2));
+      pub.Publish(msg);
+      ++seq;
+      next += std::chrono::milliseconds(100);
+      std::this_thread::sleep_until(next);
+    }
+  });
+
+  std::thread imageWorker([&running]()
+  {
+    transport::Node node;
+    auto pub = node.Advertise<msgs::Image>("/soak_image");
+    msgs::Image msg;
+    msg.set_width(320);
+    msg.set_height(240);
+    msg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+    msg.set_step(320 * 3);
+    std::string data(320 * 240 * 3, '\0');
+    int64_t seq{0};
+    auto next = std::chrono::steady_clock::now();
+    while (running)
+    {
+      // vary the payload so nothing short-circuits on identical frames
+      data[static_cast<size_t>(seq) % data.size()] =
+          static_cast<char>(seq);
+      msg.set_data(data);
+      pub.Publish(msg);
+      ++seq;
+      next += std::chrono::milliseconds(66);
+      std::this_thread::sleep_until(next);
+    }
+  });
+
+  // Drive the event loop ourselves so dispatch latency can be measured:
+  // each tick dispatches everything queued since the last one, and the
+  // histogram records how long that took plus how late the tick fired.
+  std::vector<Sample> samples;
+  LatencyHistogram dispatch;
+  LatencyHistogram lateness;
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto end = start + std::chrono::seconds(durationSec);
+  auto nextTick = start;
+  auto nextSample = start;
+  while (std::chrono::steady_clock::now() < end)
+  {
+    const auto tickStart = std::chrono::steady_clock::now();
+    lateness.Add(std::chrono::duration<double, std::milli>(
+        tickStart - nextTick).count());
+
+    QCoreApplication::processEvents();
+    dispatch.Add(std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - tickStart).count());
+
+    if (tickStart >= nextSample)
+    {
+      samples.push_back({RssKb(), FdCount()});
+      nextSample += std::chrono::milliseconds(kSamplePeriodMs);
+    }
+
+    nextTick += std::chrono::milliseconds(20);
+    std::this_thread::sleep_until(nextTick);
+  }
+
+  running = false;
+  statsWorker.join();
+  imageWorker.join();
+
+  ASSERT_GE(samples.size(), 9u);
+
+  // Medians of the first and last third, so startup allocation and
+  // single samples taken mid-spike don't decide the verdict
+  const auto third = samples.size() / 3;
+  auto rss = [](const Sample &_s) { return _s.rssKb; };
+  auto fds = [](const Sample &_s) { return static_cast<int64_t>(_s.fds); };
+  const auto rssFirst = Median(samples, 0, third, rss);
+  const auto rssLast = Median(samples, samples.size() - third,
+      samples.size(), rss);
+  const auto fdFirst = Median(samples, 0, third, fds);
+  const auto fdLast = Median(samples, samples.size() - third,
+      samples.size(), fds);
+
+  std::cout << "{\"name\": \"soak\""
+            << ", \"duration_s\": " << durationSec
+            << ", \"rss_first_kb\": " << rssFirst
+            << ", \"rss_last_kb\": " << rssLast
+            << ", \"fd_first\": " << fdFirst
+            << ", \"fd_last\": " << fdLast
+            << "}" << std::endl;
+
+  auto printHistogram = [](const std::string &_name,
+      const LatencyHistogram &_hist)
+  {
+    std::cout << "{\"name\": \"" << _name << "\", \"buckets_ms\": "
+              << "[1, 5, 20, 100], \"counts\": [";
+    for (std::size_t i = 0; i < _hist.counts.size(); ++i)
+      std::cout << (i ? ", " : "") << _hist.counts[i];
+    std::cout << "]}" << std::endl;
+  };
+  printHistogram("soak_dispatch_latency", dispatch);
+  printHistogram("soak_tick_lateness", lateness);
+
+  if (rssFirst < 0 || fdFirst < 0)
+  {
+    std::cout << "Process sampling not supported on this platform, "
+              << "growth checks skipped" << std::endl;
+    return;
+  }
+
+  // The actual leak checks: resident memory and descriptor counts must
+  // level off, not keep climbing through the run
+  EXPECT_LE(rssLast, rssFirst +
+      std::max(static_cast<int64_t>(rssFirst * kRssGrowthFraction),
+      kRssGrowthFloorKb))
+      << "resident memory grew monotonically during the soak";
+  EXPECT_LE(fdLast, fdFirst + kFdGrowthAllowance)
+      << "file descriptors leaked during the soak";
+}
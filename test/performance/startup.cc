@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include <ignition/common/Console.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ignition/gui/Application.hh"
+#include "ignition/gui/MainWindow.hh"
+
+int g_argc = 1;
+char **g_argv = new char *[g_argc];
+
+using namespace ignition;
+using namespace gui;
+
+/// \brief Startup budgets in ms. These are deliberately generous — CI
+/// machines are slow and shared — so they trip on a startup that
+/// doubled, not on millisecond noise. When lowering them, measure on
+/// the slowest supported CI worker first.
+static const int64_t kEmptyWindowBudgetMs{10000};
+static const int64_t kReferenceConfigBudgetMs{20000};
+
+/////////////////////////////////////////////////
+/// \brief Measure the time from application construction to the first
+/// frame presented by the main window.
+/// \param[in] _setup Called between construction and the wait, e.g. to
+/// load a configuration file.
+/// \return Elapsed time in ms, or -1 if no frame arrived.
+int64_t TimeToFirstFrame(const std::function<void(Application &)> &_setup)
+{
+  auto start = std::chrono::steady_clock::now();
+
+  Application app(g_argc, g_argv);
+  _setup(app);
+
+  auto win = app.findChild<MainWindow *>();
+  if (nullptr == win || nullptr == win->QuickWindow())
+    return -1;
+
+  QEventLoop loop;
+  QTimer timer;
+  timer.setSingleShot(true);
+
+  // frameSwapped comes from the render thread, so queue the quit back
+  // onto this one
+  QObject::connect(win->QuickWindow(), &QQuickWindow::frameSwapped,
+      &loop, &QEventLoop::quit, Qt::QueuedConnection);
+  QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+  timer.start(30000);
+  loop.exec();
+
+  if (!timer.isActive())
+    return -1;
+  timer.stop();
+
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start).count();
+}
+
+/////////////////////////////////////////////////
+TEST(Startup, EmptyWindow)
+{
+  common::Console::SetVerbosity(4);
+
+  auto elapsed = TimeToFirstFrame([](Application &)
+  {
+  });
+
+  std::cout << "{\"name\": \"startup_empty_window\", \"first_frame_ms\": "
+            << elapsed << ", \"budget_ms\": " << kEmptyWindowBudgetMs
+            << "}" << std::endl;
+
+  ASSERT_GE(elapsed, 0) << "Window never presented a frame";
+  EXPECT_LT(elapsed, kEmptyWindowBudgetMs);
+}
+
+/////////////////////////////////////////////////
+TEST(Startup, ReferenceConfig)
+{
+  common::Console::SetVerbosity(4);
+
+  auto elapsed = TimeToFirstFrame([](Application &_app)
+  {
+    EXPECT_TRUE(_app.LoadConfig(std::string(PROJECT_SOURCE_PATH) +
+        "/test/config/startup.config"));
+  });
+
+  std::cout << "{\"name\": \"startup_reference_config\", "
+            << "\"first_frame_ms\": " << elapsed
+            << ", \"budget_ms\": " << kReferenceConfigBudgetMs
+            << "}" << std::endl;
+
+  ASSERT_GE(elapsed, 0) << "Window never presented a frame";
+  EXPECT_LT(elapsed, kReferenceConfigBudgetMs);
+}